@@ -144,6 +144,32 @@ double GetHardwareUnitPowerPercent(ohos::batteryStatistics::ConsumptionType type
     }
     return partStatsPercent;
 }
+
+taihe::array<ohos::batteryStatistics::AppPowerStats> GetAppPowerStatsBatch(taihe::array_view<int32_t> uids)
+{
+    std::vector<int32_t> nativeUids(uids.begin(), uids.end());
+    std::vector<double> appStatsMah;
+    std::vector<double> appStatsPercent;
+    std::vector<uint64_t> totalTimeSecond;
+    BatteryStatsClient::GetInstance().GetAppStatsBatch(nativeUids, {}, appStatsMah, appStatsPercent, totalTimeSecond);
+    StatsError code = BatteryStatsClient::GetInstance().GetLastError();
+    std::vector<ohos::batteryStatistics::AppPowerStats> tmpVector;
+    if (code != StatsError::ERR_OK && g_errorTable.find(code) != g_errorTable.end()) {
+        taihe::set_business_error(static_cast<int32_t>(code), g_errorTable[code]);
+        return taihe::array_view<ohos::batteryStatistics::AppPowerStats>(tmpVector);
+    }
+    tmpVector.reserve(appStatsMah.size());
+    for (size_t i = 0; i < appStatsMah.size(); i++) {
+        ohos::batteryStatistics::AppPowerStats appStats = {
+            .uid = nativeUids[i],
+            .power = appStatsMah[i],
+            .percent = appStatsPercent[i]
+        };
+        tmpVector.push_back(appStats);
+    }
+    STATS_HILOGD(COMP_FWK, "GetAppPowerStatsBatch success, size %{public}zu", tmpVector.size());
+    return taihe::array_view<ohos::batteryStatistics::AppPowerStats>(tmpVector);
+}
 }  // namespace
 
 // Since these macros are auto-generate, lint will cause false positive
@@ -153,4 +179,5 @@ TH_EXPORT_CPP_API_GetAppPowerValue(GetAppPowerValue);
 TH_EXPORT_CPP_API_GetAppPowerPercent(GetAppPowerPercent);
 TH_EXPORT_CPP_API_GetHardwareUnitPowerValue(GetHardwareUnitPowerValue);
 TH_EXPORT_CPP_API_GetHardwareUnitPowerPercent(GetHardwareUnitPowerPercent);
+TH_EXPORT_CPP_API_GetAppPowerStatsBatch(GetAppPowerStatsBatch);
 // NOLINTEND
\ No newline at end of file
@@ -36,10 +36,12 @@ public:
     napi_value GetAppStatsPercent(napi_callback_info& info, uint32_t maxArgc, uint32_t index);
     napi_value GetPartStatsMah(napi_callback_info& info, uint32_t maxArgc, uint32_t index);
     napi_value GetPartStatsPercent(napi_callback_info& info, uint32_t maxArgc, uint32_t index);
+    napi_value GetAppStatsBatch(napi_callback_info& info, uint32_t maxArgc, uint32_t index);
 
 private:
     napi_value GetAppOrPartStats(napi_callback_info& info, uint32_t maxArgc, uint32_t index,
         std::function<double(int32_t, NapiError&)> getAppOrPart);
+    bool GetUidArray(napi_value& value, std::vector<int32_t>& uids);
     napi_env env_ {nullptr};
 };
 } // namespace PowerMgr
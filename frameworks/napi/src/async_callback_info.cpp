@@ -61,16 +61,17 @@ void AsyncCallbackInfo::CreateCallback(napi_env& env, napi_value& callback)
 StatsError AsyncCallbackInfo::AsyncData::GetBatteryStatsInfo()
 {
     statsInfos_.clear();
-    BatteryStatsInfoList nativeStatsInfos = BatteryStatsClient::GetInstance().GetBatteryStats();
+    BatteryStatsTable table;
+    BatteryStatsClient::GetInstance().GetBatteryStatsTable(table);
     StatsError code = BatteryStatsClient::GetInstance().GetLastError();
-    std::transform(
-        nativeStatsInfos.begin(), nativeStatsInfos.end(), std::back_inserter(statsInfos_), [](const auto& item) {
-            StatsInfo statsInfo = {
-                .uid_ = item->GetUid(),
-                .type_ = item->GetConsumptionType(),
-                .power_ = item->GetPower()};
-            return statsInfo;
-        });
+    statsInfos_.reserve(table.uids.size());
+    for (size_t i = 0; i < table.uids.size(); i++) {
+        StatsInfo statsInfo = {
+            .uid_ = table.uids[i],
+            .type_ = table.consumptionTypes[i],
+            .power_ = table.powerMah[i]};
+        statsInfos_.push_back(statsInfo);
+    }
     return code;
 }
 
@@ -133,6 +133,63 @@ napi_value BatteryStats::GetPartStatsPercent(napi_callback_info& info, uint32_t
     });
 }
 
+napi_value BatteryStats::GetAppStatsBatch(napi_callback_info& info, uint32_t maxArgc, uint32_t index)
+{
+    size_t argc = maxArgc;
+    napi_value argv[argc];
+    NapiUtils::GetCallbackInfo(env_, info, argc, argv);
+    NapiError error;
+
+    std::vector<int32_t> uids;
+    if (argc != maxArgc || !GetUidArray(argv[index], uids)) {
+        return error.ThrowError(env_, StatsError::ERR_PARAM_INVALID);
+    }
+
+    std::vector<double> appStatsMah;
+    std::vector<double> appStatsPercent;
+    std::vector<uint64_t> totalTimeSecond;
+    BatteryStatsClient::GetInstance().GetAppStatsBatch(uids, {}, appStatsMah, appStatsPercent, totalTimeSecond);
+    error.Error(BatteryStatsClient::GetInstance().GetLastError());
+    if (error.IsError()) {
+        return error.ThrowError(env_);
+    }
+    STATS_HILOGD(COMP_FWK, "get app stats batch, uid count: %{public}zu", appStatsMah.size());
+
+    napi_value arrRes = nullptr;
+    NAPI_CALL(env_, napi_create_array_with_length(env_, appStatsMah.size(), &arrRes));
+    for (size_t i = 0; i < appStatsMah.size(); i++) {
+        napi_value result = nullptr;
+        napi_create_object(env_, &result);
+        NapiUtils::SetIntValue(env_, "uid", uids[i], result);
+        NapiUtils::SetDoubleValue(env_, "power", appStatsMah[i], result);
+        NapiUtils::SetDoubleValue(env_, "percent", appStatsPercent[i], result);
+        napi_set_element(env_, arrRes, i, result);
+    }
+    return arrRes;
+}
+
+bool BatteryStats::GetUidArray(napi_value& value, std::vector<int32_t>& uids)
+{
+    bool isArray = false;
+    if (napi_is_array(env_, value, &isArray) != napi_ok || !isArray) {
+        return false;
+    }
+    uint32_t length = 0;
+    napi_get_array_length(env_, value, &length);
+    uids.reserve(length);
+    for (uint32_t i = 0; i < length; i++) {
+        napi_value element = nullptr;
+        napi_get_element(env_, value, i, &element);
+        if (!NapiUtils::CheckValueType(env_, element, napi_number)) {
+            return false;
+        }
+        int32_t uid = 0;
+        napi_get_value_int32(env_, element, &uid);
+        uids.push_back(uid);
+    }
+    return true;
+}
+
 napi_value BatteryStats::GetAppOrPartStats(
     napi_callback_info& info, uint32_t maxArgc, uint32_t index, std::function<double(int32_t, NapiError&)> getAppOrPart)
 {
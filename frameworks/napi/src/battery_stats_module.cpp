@@ -78,6 +78,12 @@ static napi_value GetPartStatsPercent(napi_env env, napi_callback_info info)
     return stats.GetPartStatsPercent(info, MAX_ARGC, ARGV_IND_0);
 }
 
+static napi_value GetAppStatsBatch(napi_env env, napi_callback_info info)
+{
+    BatteryStats stats(env);
+    return stats.GetAppStatsBatch(info, MAX_ARGC, ARGV_IND_0);
+}
+
 static napi_value EnumStatsTypeConstructor(napi_env env, napi_callback_info info)
 {
     napi_value thisArg = nullptr;
@@ -141,6 +147,7 @@ static napi_value BatteryStatsInit(napi_env env, napi_value exports)
         DECLARE_NAPI_FUNCTION("getAppPowerPercent", GetAppStatsPercent),
         DECLARE_NAPI_FUNCTION("getHardwareUnitPowerValue", GetPartStatsMah),
         DECLARE_NAPI_FUNCTION("getHardwareUnitPowerPercent", GetPartStatsPercent),
+        DECLARE_NAPI_FUNCTION("getAppPowerStatsBatch", GetAppStatsBatch),
     };
     NAPI_CALL(env, napi_define_properties(env, exports, sizeof(desc) / sizeof(desc[0]), desc));
 
@@ -90,6 +90,25 @@ BatteryStatsInfoList BatteryStatsClient::GetBatteryStats()
     return parcelableEntityList.statsList_;
 }
 
+bool BatteryStatsClient::GetBatteryStatsTable(BatteryStatsTable& table)
+{
+    STATS_HILOGD(COMP_FWK, "Call GetBatteryStatsTable");
+    table = BatteryStatsTable {};
+    if (Connect() != ERR_OK) {
+        lastError_ = StatsError::ERR_CONNECTION_FAIL;
+        return false;
+    }
+    ParcelableBatteryStatsTable parcelableTable;
+    int32_t tempError = INIT_VALUE;
+    proxy_->GetBatteryStatsTableIpc(parcelableTable, tempError);
+    tempError_ = static_cast<StatsError>(tempError);
+    if (tempError_ != StatsError::ERR_OK) {
+        return false;
+    }
+    table = std::move(parcelableTable.table_);
+    return true;
+}
+
 double BatteryStatsClient::GetAppStatsMah(const int32_t& uid)
 {
     STATS_HILOGD(COMP_FWK, "Call GetAppStatsMah");
@@ -178,6 +197,118 @@ uint64_t BatteryStatsClient::GetTotalDataBytes(const StatsUtils::StatsType& stat
     return count;
 }
 
+bool BatteryStatsClient::GetAppStatsBatch(const std::vector<int32_t>& uids,
+    const std::vector<StatsUtils::StatsType>& statsTypes, std::vector<double>& appStatsMah,
+    std::vector<double>& appStatsPercent, std::vector<uint64_t>& totalTimeSecond)
+{
+    STATS_HILOGD(COMP_FWK, "Call GetAppStatsBatch");
+    appStatsMah.clear();
+    appStatsPercent.clear();
+    totalTimeSecond.clear();
+    if (Connect() != ERR_OK) {
+        lastError_ = StatsError::ERR_CONNECTION_FAIL;
+        return false;
+    }
+    std::vector<int32_t> types;
+    types.reserve(statsTypes.size());
+    for (auto statsType : statsTypes) {
+        types.push_back(static_cast<int32_t>(statsType));
+    }
+    std::vector<int64_t> timeSecond;
+    int32_t tempError = INIT_VALUE;
+    proxy_->GetAppStatsBatchIpc(uids, types, appStatsMah, appStatsPercent, timeSecond, tempError);
+    tempError_ = static_cast<StatsError>(tempError);
+    if (tempError_ != StatsError::ERR_OK || appStatsMah.size() != uids.size() ||
+        appStatsPercent.size() != uids.size() || timeSecond.size() != uids.size() * statsTypes.size()) {
+        appStatsMah.clear();
+        appStatsPercent.clear();
+        return false;
+    }
+    totalTimeSecond.assign(timeSecond.begin(), timeSecond.end());
+    return true;
+}
+
+bool BatteryStatsClient::GetStatsHistory(int64_t beginTimeMs, int64_t endTimeMs, BatteryStatsHistoryInfo& history)
+{
+    STATS_HILOGD(COMP_FWK, "Call GetStatsHistory");
+    history = BatteryStatsHistoryInfo {};
+    if (Connect() != ERR_OK) {
+        lastError_ = StatsError::ERR_CONNECTION_FAIL;
+        return false;
+    }
+    std::vector<int32_t> types;
+    int32_t tempError = INIT_VALUE;
+    proxy_->GetStatsHistoryIpc(beginTimeMs, endTimeMs, history.bucketSpanMs, history.bucketStartMs,
+        history.totalPowerMah, history.uids, history.appPowerMah, types, history.partPowerMah, tempError);
+    tempError_ = static_cast<StatsError>(tempError);
+    if (tempError_ != StatsError::ERR_OK || history.totalPowerMah.size() != history.bucketStartMs.size() ||
+        history.appPowerMah.size() != history.uids.size() || history.partPowerMah.size() != types.size()) {
+        history = BatteryStatsHistoryInfo {};
+        return false;
+    }
+    history.consumptionTypes.reserve(types.size());
+    for (auto type : types) {
+        history.consumptionTypes.push_back(static_cast<BatteryStatsInfo::ConsumptionType>(type));
+    }
+    return true;
+}
+
+bool BatteryStatsClient::RegisterStatsCallback(const sptr<IBatteryStatsCallback>& callback, int64_t minIntervalMs,
+    double thresholdMah)
+{
+    STATS_HILOGD(COMP_FWK, "Call RegisterStatsCallback");
+    STATS_RETURN_IF_WITH_RET(callback == nullptr, false);
+    if (Connect() != ERR_OK) {
+        lastError_ = StatsError::ERR_CONNECTION_FAIL;
+        return false;
+    }
+    int32_t tempError = INIT_VALUE;
+    proxy_->RegisterStatsCallbackIpc(callback, minIntervalMs, thresholdMah, tempError);
+    tempError_ = static_cast<StatsError>(tempError);
+    return tempError_ == StatsError::ERR_OK;
+}
+
+bool BatteryStatsClient::UnregisterStatsCallback(const sptr<IBatteryStatsCallback>& callback)
+{
+    STATS_HILOGD(COMP_FWK, "Call UnregisterStatsCallback");
+    STATS_RETURN_IF_WITH_RET(callback == nullptr, false);
+    if (Connect() != ERR_OK) {
+        lastError_ = StatsError::ERR_CONNECTION_FAIL;
+        return false;
+    }
+    int32_t tempError = INIT_VALUE;
+    proxy_->UnregisterStatsCallbackIpc(callback, tempError);
+    tempError_ = static_cast<StatsError>(tempError);
+    return tempError_ == StatsError::ERR_OK;
+}
+
+bool BatteryStatsClient::GetTopWakelocks(uint32_t count, std::vector<BatteryStatsWakelockInfo>& wakelocks,
+    int32_t uid)
+{
+    STATS_HILOGD(COMP_FWK, "Call GetTopWakelocks");
+    wakelocks.clear();
+    if (Connect() != ERR_OK) {
+        lastError_ = StatsError::ERR_CONNECTION_FAIL;
+        return false;
+    }
+    std::vector<int32_t> uids;
+    std::vector<std::string> names;
+    std::vector<int64_t> holdTimeMs;
+    std::vector<bool> isHeld;
+    int32_t tempError = INIT_VALUE;
+    proxy_->GetTopWakelocksIpc(count, uid, uids, names, holdTimeMs, isHeld, tempError);
+    tempError_ = static_cast<StatsError>(tempError);
+    if (tempError_ != StatsError::ERR_OK || names.size() != uids.size() || holdTimeMs.size() != uids.size() ||
+        isHeld.size() != uids.size()) {
+        return false;
+    }
+    wakelocks.reserve(uids.size());
+    for (size_t i = 0; i < uids.size(); i++) {
+        wakelocks.push_back({ uids[i], std::move(names[i]), holdTimeMs[i], isHeld[i] });
+    }
+    return true;
+}
+
 std::string BatteryStatsClient::Dump(const std::vector<std::string>& args)
 {
     STATS_HILOGD(COMP_FWK, "Call Dump");
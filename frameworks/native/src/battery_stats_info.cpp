@@ -15,12 +15,41 @@
 
 #include "battery_stats_info.h"
 
+#include <cstring>
+
 #include "stats_common.h"
 #include "stats_log.h"
 
 namespace OHOS {
 namespace PowerMgr {
 constexpr int32_t PARAM_MAX_NUM = 2000;
+namespace {
+// An entry of the stats table takes the uid, the user id, the consumption type and the power
+constexpr size_t STATS_TABLE_ENTRY_BYTES = sizeof(int32_t) * 3 + sizeof(double);
+
+template<typename T>
+bool WriteColumn(Parcel& parcel, const std::vector<T>& column)
+{
+    // A zero sized buffer is refused by the parcel
+    return column.empty() || parcel.WriteBuffer(column.data(), column.size() * sizeof(T));
+}
+
+template<typename T>
+bool ReadColumn(Parcel& parcel, size_t size, std::vector<T>& column)
+{
+    column.resize(size);
+    if (size == 0) {
+        return true;
+    }
+    const uint8_t* data = parcel.ReadBuffer(size * sizeof(T));
+    if (data == nullptr) {
+        return false;
+    }
+    std::memcpy(column.data(), data, size * sizeof(T));
+    return true;
+}
+} // namespace
+
 bool BatteryStatsInfo::Marshalling(Parcel& parcel) const
 {
     STATS_RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(COMP_FWK, parcel, Int32, uid_, false);
@@ -243,5 +272,49 @@ ParcelableBatteryStatsList* ParcelableBatteryStatsList::Unmarshalling(Parcel& pa
 
     return listPtr.release();
 }
+
+bool ParcelableBatteryStatsTable::Marshalling(Parcel& parcel) const
+{
+    size_t size = table_.uids.size();
+    if (table_.userIds.size() != size || table_.consumptionTypes.size() != size || table_.powerMah.size() != size) {
+        STATS_HILOGE(COMP_FWK, "Stats table is invalid, size=%{public}zu", size);
+        return false;
+    }
+    // Bounded by the room left in the parcel, not by an entry count, so the table of a full device goes through
+    size_t usedBytes = parcel.GetDataSize() + sizeof(int32_t);
+    size_t maxBytes = parcel.GetMaxCapacity();
+    if (usedBytes > maxBytes || size > (maxBytes - usedBytes) / STATS_TABLE_ENTRY_BYTES) {
+        STATS_HILOGE(COMP_FWK, "Stats table does not fit in the parcel, size=%{public}zu", size);
+        return false;
+    }
+    std::vector<int32_t> types(table_.consumptionTypes.begin(), table_.consumptionTypes.end());
+    STATS_RETURN_IF_WRITE_PARCEL_FAILED_WITH_RET(COMP_FWK, parcel, Int32, static_cast<int32_t>(size), false);
+    return WriteColumn(parcel, table_.uids) && WriteColumn(parcel, table_.userIds) && WriteColumn(parcel, types) &&
+        WriteColumn(parcel, table_.powerMah);
+}
+
+ParcelableBatteryStatsTable* ParcelableBatteryStatsTable::Unmarshalling(Parcel& parcel)
+{
+    int32_t size = parcel.ReadInt32();
+    // The columns have to be in the parcel already, a bogus size allocates nothing
+    if (size < 0 || static_cast<size_t>(size) > parcel.GetReadableBytes() / STATS_TABLE_ENTRY_BYTES) {
+        STATS_HILOGE(COMP_FWK, "size is invalid, size=%{public}d", size);
+        return nullptr;
+    }
+    size_t count = static_cast<size_t>(size);
+    auto tablePtr = std::make_unique<ParcelableBatteryStatsTable>();
+    auto& table = tablePtr->table_;
+    std::vector<int32_t> types;
+    if (!ReadColumn(parcel, count, table.uids) || !ReadColumn(parcel, count, table.userIds) ||
+        !ReadColumn(parcel, count, types) || !ReadColumn(parcel, count, table.powerMah)) {
+        STATS_HILOGE(COMP_FWK, "Read stats table failed, size=%{public}d", size);
+        return nullptr;
+    }
+    table.consumptionTypes.reserve(types.size());
+    for (auto type : types) {
+        table.consumptionTypes.push_back(static_cast<BatteryStatsInfo::ConsumptionType>(type));
+    }
+    return tablePtr.release();
+}
 } // namespace PowerMgr
 } // namespace OHOS
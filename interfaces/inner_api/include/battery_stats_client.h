@@ -26,6 +26,7 @@
 #include "battery_stats_errors.h"
 #include "battery_stats_info.h"
 #include "ibattery_stats.h"
+#include "ibattery_stats_callback.h"
 #include "stats_utils.h"
 
 namespace OHOS {
@@ -36,6 +37,10 @@ class BatteryStatsClient final : public DelayedRefSingleton<BatteryStatsClient>
 public:
     DISALLOW_COPY_AND_MOVE(BatteryStatsClient);
     BatteryStatsInfoList GetBatteryStats();
+    /**
+     * Same entries as GetBatteryStats in parallel columns, without one parcel record and one heap object per entry.
+     */
+    bool GetBatteryStatsTable(BatteryStatsTable& table);
     void SetOnBattery(bool isOnBattery);
     double GetAppStatsMah(const int32_t& uid);
     double GetAppStatsPercent(const int32_t& uid);
@@ -43,6 +48,32 @@ public:
     double GetPartStatsPercent(const BatteryStatsInfo::ConsumptionType& type);
     uint64_t GetTotalTimeSecond(const StatsUtils::StatsType& statsType, const int32_t& uid = StatsUtils::INVALID_VALUE);
     uint64_t GetTotalDataBytes(const StatsUtils::StatsType& statsType, const int32_t& uid = StatsUtils::INVALID_VALUE);
+    /**
+     * Queries the power of many apps in one round trip. appStatsMah and appStatsPercent hold one value per uid,
+     * totalTimeSecond holds uids.size() * statsTypes.size() values in row major order.
+     */
+    bool GetAppStatsBatch(const std::vector<int32_t>& uids, const std::vector<StatsUtils::StatsType>& statsTypes,
+        std::vector<double>& appStatsMah, std::vector<double>& appStatsPercent, std::vector<uint64_t>& totalTimeSecond);
+    /**
+     * Queries the power consumed in [beginTimeMs, endTimeMs) of the wall clock. The service keeps 5 minute buckets
+     * for the last day and hourly buckets for the last 30 days, a range starting within the last day gets the
+     * 5 minute buckets.
+     */
+    bool GetStatsHistory(int64_t beginTimeMs, int64_t endTimeMs, BatteryStatsHistoryInfo& history);
+    /**
+     * Registers a callback, usually a BatteryStatsCallbackStub, which is called with the uids whose power changed
+     * by at least thresholdMah, at most once every minIntervalMs. The first call carries every app.
+     * The registration does not survive a restart of the service.
+     */
+    bool RegisterStatsCallback(const sptr<IBatteryStatsCallback>& callback, int64_t minIntervalMs,
+        double thresholdMah);
+    bool UnregisterStatsCallback(const sptr<IBatteryStatsCallback>& callback);
+    /**
+     * Queries the count wakelocks held longest since the last reset, of one uid or of every uid, longest first.
+     * A lock still held counts up to now.
+     */
+    bool GetTopWakelocks(uint32_t count, std::vector<BatteryStatsWakelockInfo>& wakelocks,
+        int32_t uid = StatsUtils::INVALID_VALUE);
     void Reset();
     std::string Dump(const std::vector<std::string>& args);
     StatsError GetLastError();
@@ -20,6 +20,7 @@
 #include <memory>
 #include <parcel.h>
 #include <string>
+#include <vector>
 
 #include "stats_utils.h"
 
@@ -76,6 +77,49 @@ public:
     virtual bool Marshalling(Parcel &parcel) const override;
     static ParcelableBatteryStatsList* Unmarshalling(Parcel &parcel);
 };
+
+/**
+ * The entries of GetBatteryStats as parallel columns, entry i is made of the i-th value of every column.
+ */
+struct BatteryStatsTable {
+    std::vector<int32_t> uids;
+    std::vector<int32_t> userIds;
+    std::vector<BatteryStatsInfo::ConsumptionType> consumptionTypes;
+    std::vector<double> powerMah;
+};
+
+/**
+ * Same as ParcelableBatteryStatsList in the packed format: the entry count, then every column as one raw block.
+ * The entries are only bounded by the capacity of the parcel.
+ */
+class ParcelableBatteryStatsTable : public Parcelable {
+public:
+    BatteryStatsTable table_;
+
+    bool Marshalling(Parcel &parcel) const override;
+    static ParcelableBatteryStatsTable* Unmarshalling(Parcel &parcel);
+};
+
+/**
+ * Power consumed in a time range, the buckets are bucketSpanMs long and start at bucketStartMs.
+ * The uids and the consumption types list only the ones which consumed power in the range.
+ */
+struct BatteryStatsHistoryInfo {
+    int64_t bucketSpanMs = 0;
+    std::vector<int64_t> bucketStartMs;
+    std::vector<double> totalPowerMah;
+    std::vector<int32_t> uids;
+    std::vector<double> appPowerMah;
+    std::vector<BatteryStatsInfo::ConsumptionType> consumptionTypes;
+    std::vector<double> partPowerMah;
+};
+
+struct BatteryStatsWakelockInfo {
+    int32_t uid = StatsUtils::INVALID_VALUE;
+    std::string name;
+    int64_t holdTimeMs = StatsUtils::DEFAULT_VALUE;
+    bool isHeld = false;
+};
 } // namespace PowerMgr
 } // namespace OHOS
 #endif // BATTERY_STATS_INFO_H
\ No newline at end of file
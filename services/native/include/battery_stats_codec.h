@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_STATS_CODEC_H
+#define BATTERY_STATS_CODEC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Little endian fixed width and varint encoding shared by the stats persistence files.
+ */
+class BatteryStatsCodec {
+public:
+    class Reader {
+    public:
+        Reader(const uint8_t* data, size_t size) : pos_(data), end_(data + size) {}
+        ~Reader() = default;
+        size_t GetRemaining() const
+        {
+            return static_cast<size_t>(end_ - pos_);
+        }
+        const uint8_t* GetPosition() const
+        {
+            return pos_;
+        }
+        bool Skip(size_t size);
+        bool GetFixed16(uint16_t& value);
+        bool GetFixed32(uint32_t& value);
+        bool GetFixed64(uint64_t& value);
+        bool GetDouble(double& value);
+        bool GetVarint(uint64_t& value);
+        bool GetSignedVarint(int64_t& value);
+        // Every element takes at least one byte, a larger count can only come from a corrupted file
+        bool GetCount(size_t& count);
+    private:
+        bool GetFixed(uint64_t& value, size_t size);
+        const uint8_t* pos_;
+        const uint8_t* end_;
+    };
+
+    static void PutFixed16(std::string& buffer, uint16_t value);
+    static void PutFixed32(std::string& buffer, uint32_t value);
+    static void PutFixed64(std::string& buffer, uint64_t value);
+    static void SetFixed32(std::string& buffer, size_t offset, uint32_t value);
+    static void PutDouble(std::string& buffer, double value);
+    static void PutVarint(std::string& buffer, uint64_t value);
+    static void PutSignedVarint(std::string& buffer, int64_t value);
+    static uint32_t Crc32(const uint8_t* data, size_t size);
+    // Retries short and interrupted writes until the whole buffer is written
+    static bool WriteAll(int32_t fd, const std::string& buffer);
+    // Reads at most maxSize bytes from the head of the file, fileSize tells whether something was left out
+    static bool ReadFile(const std::string& path, size_t maxSize, std::string& buffer, size_t& fileSize);
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // BATTERY_STATS_CODEC_H
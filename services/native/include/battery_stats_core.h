@@ -16,30 +16,52 @@
 #ifndef BATTERY_STATS_CORE_H
 #define BATTERY_STATS_CORE_H
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <string>
 #include <cstdint>
 #include <iosfwd>
+#include <utility>
+#include <vector>
 
 #include <cJSON.h>
 
+#include "battery_stats_event_log.h"
+#include "battery_stats_event_queue.h"
+#include "battery_stats_history.h"
 #include "battery_stats_info.h"
+#include "battery_stats_journal.h"
+#include "battery_stats_result.h"
+#include "battery_stats_snapshot.h"
+#include "battery_stats_trace.h"
+#include "battery_stats_traffic.h"
+#include "cpu_time_sampler.h"
 #include "entities/battery_stats_entity.h"
+#include "entities/wakelock_entity.h"
+#include "power_profile.h"
+#include "stats_helper.h"
 #include "stats_log.h"
 #include "stats_utils.h"
 
 namespace OHOS {
 namespace PowerMgr {
-class BatteryStatsCore {
+class BatteryStatsCore : public std::enable_shared_from_this<BatteryStatsCore> {
 public:
-    explicit BatteryStatsCore()
+    static constexpr const char* STATS_DIR = "/data/service/el0/stats";
+    // The timers of the core count on the time base, the one of the process when null. The snapshot, journal
+    // and trace of the core are kept in statsDir
+    explicit BatteryStatsCore(std::shared_ptr<StatsHelper::TimeBase> timeBase = nullptr,
+        const std::string& statsDir = STATS_DIR) : timeBase_(timeBase), statsDir_(statsDir)
     {
         STATS_HILOGI(COMP_SVC, "BatteryStatsCore instance is created");
     }
     ~BatteryStatsCore() = default;
     void ComputePower();
     BatteryStatsInfoList GetBatteryStats();
+    // Up to BatteryStatsResult::MAX_AGE_MS stale while timers run, current after any recorded change. A stale
+    // result is computed again on the thread applying the events, not on the reader
+    std::shared_ptr<const BatteryStatsResult> GetStatsResult();
     double GetAppStatsMah(const int32_t& uid);
     double GetAppStatsPercent(const int32_t& uid);
     double GetPartStatsMah(const BatteryStatsInfo::ConsumptionType& type);
@@ -54,14 +76,41 @@ public:
         const std::string& deviceId = "");
     void UpdateStats(StatsUtils::StatsType statsType, int64_t time, int64_t data,
         int32_t uid = StatsUtils::INVALID_VALUE);
+    // Updates the wakelock time of the uid and the time of the named lock
+    void UpdateWakelockStats(StatsUtils::StatsState state, int32_t uid, const std::string& name);
+    std::vector<WakelockEntity::LockInfo> GetTopWakelocks(size_t count, int32_t uid = StatsUtils::INVALID_VALUE);
+    // Records the consumption up to now and answers the range from the history buckets, times are wall clock ms
+    bool GetStatsHistory(int64_t beginTimeMs, int64_t endTimeMs, BatteryStatsHistoryInfo& history);
     std::shared_ptr<BatteryStatsEntity> GetEntity(const BatteryStatsInfo::ConsumptionType& type);
     bool SaveBatteryStatsData();
     bool LoadBatteryStatsData();
+    bool ExportBatteryStatsData(std::string& result);
     void DumpInfo(std::string& result);
     void UpdateDebugInfo(const std::string& info);
+    void UpdateDebugInfo(const StatsUtils::StatsData& data);
     void GetDebugInfo(std::string& result);
     void Reset();
-    bool Init();
+    // The entities compute the power with the profile, null keeps the profile of an earlier Init. The profile of
+    // the entities is fixed once they are created. The debug event log keeps the latest eventLogCapacity events
+    bool Init(std::shared_ptr<const PowerProfile> profile = nullptr,
+        size_t eventLogCapacity = BatteryStatsEventLog::DEFAULT_CAPACITY);
+    // Creates the entities only, for a core fed by hand: no cpu sampler, journal, trace or saved stats
+    bool InitEntities(std::shared_ptr<const PowerProfile> profile = nullptr);
+    // The queue the events reach the core through, flushed before the stats are read
+    void SetEventQueue(std::shared_ptr<BatteryStatsEventQueue> eventQueue);
+    bool StartJournal();
+    void StopJournal();
+    // Records the events the detector gets and the power supply changes until stopped, off by default
+    bool StartTrace();
+    void StopTrace();
+    void RecordTraceEvent(const StatsUtils::StatsData& data);
+    bool StartCpuSampler();
+    void StopCpuSampler();
+    void RequestCpuSample(CpuTimeSampler::Trigger trigger);
+    // Samples the cpu time accumulated under the current power supply state before the state changes
+    void SetOnBattery(bool isOnBattery);
+    // The uid to user id mapping changes when a user is added or removed
+    void InvalidateUserIds();
 private:
     std::shared_ptr<BatteryStatsEntity> audioEntity_;
     std::shared_ptr<BatteryStatsEntity> bluetoothEntity_;
@@ -76,14 +125,42 @@ private:
     std::shared_ptr<BatteryStatsEntity> uidEntity_;
     std::shared_ptr<BatteryStatsEntity> userEntity_;
     std::shared_ptr<BatteryStatsEntity> wifiEntity_;
-    std::shared_ptr<BatteryStatsEntity> wakelockEntity_;
+    std::shared_ptr<WakelockEntity> wakelockEntity_;
     std::shared_ptr<BatteryStatsEntity> alarmEntity_;
     bool isCameraOn_ = false;
     bool isScreenOn_ = false;
     int32_t lastBrightnessLevel_ = StatsUtils::INVALID_VALUE;
     int32_t lastCameraUid_ = StatsUtils::INVALID_VALUE;
-    std::mutex mutex_;
-    std::string debugInfo_;
+    // Serializes every change and read of the entities, recursive as the entities read the core while computing.
+    // The readers of the stats load the published result without locking
+    std::recursive_mutex mutex_;
+    std::shared_ptr<StatsHelper::TimeBase> timeBase_;
+    std::string statsDir_;
+    // Holds mutex_, StatsHelper reads the time base of the core on this thread until it is released
+    class CoreLock {
+    public:
+        explicit CoreLock(BatteryStatsCore& core) : lock_(core.mutex_), scope_(core.timeBase_.get()) {}
+    private:
+        std::lock_guard<std::recursive_mutex> lock_;
+        StatsHelper::TimeBaseScope scope_;
+    };
+    BatteryStatsEventLog eventLog_;
+    BatteryStatsHistory history_;
+    std::atomic<uint64_t> statsVersion_ {0};
+    std::shared_ptr<const BatteryStatsResult> result_;
+    std::atomic<uint64_t> resultHitCount_ {0};
+    std::atomic<uint64_t> resultComputeCount_ {0};
+    std::shared_ptr<BatteryStatsTraffic> traffic_;
+    // Per-uid values of the entities of this core, no other core sees them
+    std::shared_ptr<BatteryStatsUidTable> uidTable_ = std::make_shared<BatteryStatsUidTable>();
+    std::shared_ptr<const PowerProfile> powerProfile_ = std::make_shared<PowerProfile>();
+    // What the entities add up while the core computes the power
+    std::shared_ptr<BatteryStatsEntity::Sums> sums_ = std::make_shared<BatteryStatsEntity::Sums>();
+    std::shared_ptr<BatteryStatsTrace> trace_;
+    std::shared_ptr<BatteryStatsEventQueue> eventQueue_;
+    // Declared last so that the sampler and journal threads are joined before the entities are destroyed
+    std::shared_ptr<CpuTimeSampler> cpuSampler_;
+    std::shared_ptr<BatteryStatsJournal> journal_;
     void UpdateTimer(std::shared_ptr<BatteryStatsEntity> entity, StatsUtils::StatsType statsType,
         StatsUtils::StatsState state, int32_t uid = StatsUtils::INVALID_VALUE);
     void UpdateTimer(std::shared_ptr<BatteryStatsEntity> entity, StatsUtils::StatsType statsType,
@@ -99,9 +176,31 @@ private:
     void UpdatePhoneStats(StatsUtils::StatsType statsType, StatsUtils::StatsState state, int16_t level);
     void UpdateConnectivityStats(StatsUtils::StatsType statsType, StatsUtils::StatsState state, int32_t uid);
     void UpdateCommonStats(StatsUtils::StatsType statsType, StatsUtils::StatsState state, int32_t uid);
+    void ComputePowerLocked();
+    void ResetSums();
+    void PublishResult();
+    bool IsResultFresh(const std::shared_ptr<const BatteryStatsResult>& result) const;
+    template<typename T>
+    std::shared_ptr<T> CreateEntity();
     void CreatePartEntity();
+    void FlushStatsEvents();
+    void SampleCpuTime();
+    void SampleTraffic();
     void CreateAppEntity();
     void UpdateStatsEntity(cJSON* root);
+    bool LoadBatteryStatsJson();
+    void RestorePower(const std::vector<std::pair<int32_t, double>>& powers);
+    void RestoreTimer(StatsUtils::StatsType statsType, int16_t level, int32_t uid, int64_t timeMs);
+    void RestoreCounter(StatsUtils::StatsType statsType, int32_t uid, int64_t count);
+    void RestoreFromSnapshot(const BatteryStatsSnapshot& snapshot);
+    void ReplayJournal(const std::vector<BatteryStatsJournal::Record>& records);
+    bool WriteSnapshot(size_t& snapshotBytes);
+    int64_t GetTimerTotalMs(StatsUtils::StatsType statsType, int16_t level, int32_t uid);
+    void JournalTimer(StatsUtils::StatsType statsType, int16_t level = StatsUtils::INVALID_VALUE,
+        int32_t uid = StatsUtils::INVALID_VALUE);
+    void JournalCounter(StatsUtils::StatsType statsType, int32_t uid);
+    void SaveForSnapshot(BatteryStatsSnapshot& snapshot);
+    std::shared_ptr<BatteryStatsEntity> GetEntityForStatsType(StatsUtils::StatsType statsType);
     void SaveForHardware(cJSON* root);
     void SaveForHardwareInternal(cJSON* hardwareObj);
     void SaveForSoftware(cJSON* root);
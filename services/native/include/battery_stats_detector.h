@@ -26,6 +26,8 @@
 
 namespace OHOS {
 namespace PowerMgr {
+class BatteryStatsCore;
+
 class BatteryStatsDetector {
 public:
     explicit BatteryStatsDetector()
@@ -34,18 +36,11 @@ public:
     }
     ~BatteryStatsDetector() = default;
     void HandleStatsChangedEvent(StatsUtils::StatsData data);
+    // Applies one event to the core, shared with the trace replay
+    static void Dispatch(const std::shared_ptr<BatteryStatsCore>& core, const StatsUtils::StatsData& data);
 private:
-    bool IsDurationRelated(StatsUtils::StatsType type);
-    bool IsStateRelated(StatsUtils::StatsType type);
-    void HandleDebugInfo(StatsUtils::StatsData data);
-    void HandleThermalInfo(StatsUtils::StatsData data, int64_t bootTimeMs, std::string& debugInfo);
-    void HandleBatteryInfo(StatsUtils::StatsData data, int64_t bootTimeMs, std::string& debugInfo);
-    void HandleDisplayInfo(StatsUtils::StatsData data, int64_t bootTimeMs, std::string& debugInfo);
-    void HandleWakelockInfo(StatsUtils::StatsData data, int64_t bootTimeMs, std::string& debugInfo);
-    void HandleWorkschedulerInfo(StatsUtils::StatsData data, int64_t bootTimeMs, std::string& debugInfo);
-    void HandlePhoneInfo(StatsUtils::StatsData data, int64_t bootTimeMs, std::string& debugInfo);
-    void HandleFlashlightInfo(StatsUtils::StatsData data, int64_t bootTimeMs, std::string& debugInfo);
-    void HandleDistributedSchedulerInfo(StatsUtils::StatsData data, int64_t bootTimeMs, std::string& debugInfo);
+    static bool IsDurationRelated(StatsUtils::StatsType type);
+    static bool IsStateRelated(StatsUtils::StatsType type);
 };
 } // namespace PowerMgr
 } // namespace OHOS
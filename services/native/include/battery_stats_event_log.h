@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_STATS_EVENT_LOG_H
+#define BATTERY_STATS_EVENT_LOG_H
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "stats_utils.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Keeps the latest debug events in a ring of fixed size records, the oldest record is dropped when the ring is full.
+ * The records are only turned into text when they are dumped.
+ */
+class BatteryStatsEventLog {
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 512;
+    // About 8 MB of records
+    static constexpr size_t MAX_CAPACITY = 65536;
+    static constexpr size_t TEXT_SIZE = 96;
+    // The name takes at most this much of the text, the additional debug info gets the rest
+    static constexpr size_t NAME_SIZE = 48;
+
+    struct Record {
+        int64_t bootTimeMs;
+        int32_t uid;
+        int32_t pid;
+        int32_t dataType;
+        int32_t dataExtra;
+        int16_t level;
+        int8_t type;
+        int8_t state;
+        uint8_t nameSize;
+        uint8_t infoSize;
+        // The name followed by the additional debug info, neither is terminated
+        char text[TEXT_SIZE];
+    };
+
+    explicit BatteryStatsEventLog(size_t capacity = DEFAULT_CAPACITY);
+    ~BatteryStatsEventLog() = default;
+    BatteryStatsEventLog(const BatteryStatsEventLog&) = delete;
+    BatteryStatsEventLog& operator=(const BatteryStatsEventLog&) = delete;
+    // Returns false for the event types which are not logged
+    bool Append(const StatsUtils::StatsData& data, int64_t bootTimeMs);
+    // Logs free text as the additional debug info of an event without type
+    void AppendText(std::string_view text, int64_t bootTimeMs);
+    void Clear();
+    // Drops the records logged so far
+    void SetCapacity(size_t capacity);
+    size_t GetSize() const;
+    size_t GetCapacity() const;
+    uint64_t GetDroppedCount() const;
+    uint64_t GetTruncatedCount() const;
+    // Formats the records oldest first
+    void DumpInfo(std::string& result) const;
+    static bool IsLogged(StatsUtils::StatsType type);
+private:
+    mutable std::mutex mutex_;
+    std::vector<Record> records_;
+    size_t head_ = 0;
+    size_t size_ = 0;
+    uint64_t droppedCount_ = 0;
+    uint64_t truncatedCount_ = 0;
+    void Push(const Record& record, bool truncated);
+    static bool FillText(Record& record, std::string_view name, std::string_view info);
+    static void FormatRecord(const Record& record, std::string& result);
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // BATTERY_STATS_EVENT_LOG_H
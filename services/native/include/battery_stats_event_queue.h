@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_STATS_EVENT_QUEUE_H
+#define BATTERY_STATS_EVENT_QUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "stats_utils.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Bounded multi-producer single-consumer ring buffer of stats events.
+ * HiSysEvent callbacks push the parsed StatsData without taking any lock, a single consumer
+ * thread drains the ring in batches and applies every record through the handler. Every record is stamped with
+ * the boot and up time when it is pushed and applied at that time, so the queue latency doesn't skew the timers.
+ */
+class BatteryStatsEventQueue {
+public:
+    using EventHandler = std::function<void(const StatsUtils::StatsData& data)>;
+    using SyncTask = std::function<void()>;
+    static constexpr uint32_t DEFAULT_CAPACITY = 4096;
+    static constexpr uint32_t MAX_BATCH_SIZE = 64;
+    static constexpr int64_t DEFAULT_FLUSH_TIMEOUT_MS = 1000;
+
+    explicit BatteryStatsEventQueue(uint32_t capacity = DEFAULT_CAPACITY);
+    ~BatteryStatsEventQueue();
+    bool Start(const EventHandler& handler);
+    void Stop();
+    bool IsRunning() const;
+    bool Push(StatsUtils::StatsData data);
+    bool Flush(int64_t timeoutMs = DEFAULT_FLUSH_TIMEOUT_MS);
+    // Runs the task on the consumer thread once the events pushed before are applied, false if it didn't run
+    bool Sync(const SyncTask& task, int64_t timeoutMs = DEFAULT_FLUSH_TIMEOUT_MS);
+    uint32_t GetCapacity() const;
+    uint64_t GetDepth() const;
+    uint64_t GetDropCount() const;
+    uint64_t GetAppliedCount() const;
+    int64_t GetLastApplyLatencyUs() const;
+    int64_t GetMaxApplyLatencyUs() const;
+    int64_t GetAverageApplyLatencyUs() const;
+    void DumpInfo(std::string& result);
+private:
+    struct Event {
+        StatsUtils::StatsData data;
+        int64_t enqueueTimeUs = StatsUtils::DEFAULT_VALUE;
+        int64_t bootTimeMs = StatsUtils::DEFAULT_VALUE;
+        int64_t upTimeMs = StatsUtils::DEFAULT_VALUE;
+    };
+    struct Slot {
+        std::atomic<uint64_t> sequence {0};
+        Event event;
+    };
+    enum SyncState {
+        SYNC_IDLE = 0,
+        SYNC_PENDING,
+        SYNC_RUNNING,
+        SYNC_DONE,
+    };
+    uint32_t capacity_;
+    uint64_t mask_;
+    std::unique_ptr<Slot[]> slots_;
+    alignas(64) std::atomic<uint64_t> enqueuePos_ {0};
+    alignas(64) std::atomic<uint64_t> dequeuePos_ {0};
+    std::atomic<uint64_t> appliedCount_ {0};
+    std::atomic<uint64_t> dropCount_ {0};
+    std::atomic<int64_t> lastApplyLatencyUs_ {0};
+    std::atomic<int64_t> maxApplyLatencyUs_ {0};
+    std::atomic<int64_t> totalApplyLatencyUs_ {0};
+    std::atomic<bool> running_ {false};
+    std::atomic<bool> consumerWaiting_ {false};
+    // Only the consumer thread touches them, the events are never applied before the time of the previous one
+    int64_t lastBootTimeMs_ = StatsUtils::DEFAULT_VALUE;
+    int64_t lastUpTimeMs_ = StatsUtils::DEFAULT_VALUE;
+    EventHandler handler_;
+    std::thread consumer_;
+    std::mutex waitMutex_;
+    std::condition_variable waitCond_;
+    std::mutex flushMutex_;
+    std::condition_variable flushCond_;
+    // One sync task at a time, the task and its state are guarded by flushMutex_
+    std::mutex syncMutex_;
+    std::atomic<bool> syncPending_ {false};
+    SyncState syncState_ = SYNC_IDLE;
+    uint64_t syncTarget_ = 0;
+    SyncTask syncTask_;
+    bool Pop(std::vector<Event>& batch);
+    void ConsumerLoop();
+    void RunSyncTask();
+    void ApplyBatch(std::vector<Event>& batch);
+    void UpdateApplyLatency(int64_t latencyUs);
+    static int64_t GetSteadyTimeUs();
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // BATTERY_STATS_EVENT_QUEUE_H
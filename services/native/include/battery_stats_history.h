@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_STATS_HISTORY_H
+#define BATTERY_STATS_HISTORY_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "battery_stats_info.h"
+#include "battery_stats_result.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Keeps the power consumed per uid and per consumption type in time buckets, so that a range like the last hour can
+ * be answered from the service instead of diffing the since-reset totals outside.
+ *
+ * Every published result adds what was consumed since the previous one to the current bucket of every tier. A tier
+ * is a ring of fixed-span buckets stored column by column, one float column per uid and per consumption type.
+ * The number of uid columns is capped, a uid with nothing left in any ring gives its column up to a new uid, and
+ * the rest is counted under the "other" uid, StatsUtils::INVALID_VALUE.
+ */
+class BatteryStatsHistory {
+public:
+    struct Tier {
+        int64_t bucketSpanMs;
+        size_t bucketCount;
+    };
+
+    struct Config {
+        // 5 minute buckets for a day and hourly buckets for 30 days
+        Tier fine {5 * 60 * 1000, 288};
+        Tier coarse {60 * 60 * 1000, 720};
+        size_t maxUids = 256;
+    };
+
+    BatteryStatsHistory();
+    explicit BatteryStatsHistory(const Config& config);
+    ~BatteryStatsHistory() = default;
+    BatteryStatsHistory(const BatteryStatsHistory&) = delete;
+    BatteryStatsHistory& operator=(const BatteryStatsHistory&) = delete;
+    // Adds the consumption since the previous result at the given wall time, the first result only sets the baseline
+    void Record(int64_t timeMs, const BatteryStatsResult& result);
+    // The totals restart after a stats reset, the next result is counted from zero
+    void Rebase();
+    // True when the last record is in another fine bucket than the given time
+    bool IsRecordDue(int64_t timeMs) const;
+    /**
+     * Fills the buckets overlapping [beginTimeMs, endTimeMs) from the finest tier which still holds beginTimeMs.
+     * The apps and the parts are the sums over those buckets, the apps in descending order of power.
+     */
+    bool Query(int64_t beginTimeMs, int64_t endTimeMs, BatteryStatsHistoryInfo& history) const;
+    void Clear();
+    void DumpInfo(std::string& result) const;
+private:
+    static constexpr size_t TIER_COUNT = 2;
+    static constexpr size_t PART_COUNT =
+        BatteryStatsInfo::CONSUMPTION_TYPE_ALARM - BatteryStatsInfo::CONSUMPTION_TYPE_APP + 1;
+    static constexpr size_t OTHER_COLUMN = 0;
+
+    struct Ring {
+        Tier tier;
+        int64_t lastBucket = -1;
+        // Bucket number held by each slot
+        std::vector<int64_t> bucketIds;
+        std::vector<float> totalMah;
+        // PART_COUNT columns of bucketCount slots, indexed by the consumption type from CONSUMPTION_TYPE_APP on
+        std::vector<float> partMah;
+        // One column of bucketCount slots per uid column
+        std::vector<float> uidMah;
+    };
+
+    Config config_;
+    mutable std::mutex mutex_;
+    std::array<Ring, TIER_COUNT> rings_;
+    std::vector<int32_t> columnUids_;
+    std::unordered_map<int32_t, size_t> uidColumns_;
+    bool hasBaseline_ = false;
+    int64_t lastRecordTimeMs_ = -1;
+    double lastTotalMah_ = 0.0;
+    std::array<double, PART_COUNT> lastPartMah_ {};
+    std::unordered_map<int32_t, double> lastAppMah_;
+    uint64_t recordCount_ = 0;
+    uint64_t overflowCount_ = 0;
+    static size_t Advance(Ring& ring, int64_t timeMs);
+    size_t GetColumnLocked(int32_t uid);
+    bool IsColumnEmptyLocked(size_t column) const;
+    void ClearLocked();
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // BATTERY_STATS_HISTORY_H
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_STATS_JOURNAL_H
+#define BATTERY_STATS_JOURNAL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "stats_utils.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Append-only write-ahead journal of the stats changes made since the last snapshot.
+ *
+ * Every record carries the absolute total of a timer or counter, so replaying a record twice or replaying records
+ * which are already covered by the snapshot changes nothing. Records are buffered in memory and a background thread
+ * group commits them as one checksummed frame per flush: len(4) crc32(4) records. When the journal grows past the
+ * compact threshold the compact handler writes a full snapshot and the journal is truncated.
+ */
+class BatteryStatsJournal {
+public:
+    // Writes a full snapshot and reports its size
+    using CompactHandler = std::function<bool(size_t& snapshotBytes)>;
+
+    enum RecordType : uint8_t {
+        RECORD_TIMER = 1,
+        RECORD_COUNTER,
+        RECORD_RESET,
+    };
+
+    struct Record {
+        RecordType type = RECORD_TIMER;
+        StatsUtils::StatsType statsType = StatsUtils::STATS_TYPE_INVALID;
+        int16_t level = StatsUtils::INVALID_VALUE;
+        int32_t uid = StatsUtils::INVALID_VALUE;
+        int64_t value = StatsUtils::DEFAULT_VALUE;
+    };
+
+    struct Config {
+        int64_t flushIntervalMs = 5000;
+        size_t flushThresholdBytes = 4 * 1024;
+        size_t compactThresholdBytes = 256 * 1024;
+    };
+
+    explicit BatteryStatsJournal(const std::string& path);
+    BatteryStatsJournal(const std::string& path, const Config& config);
+    ~BatteryStatsJournal();
+    bool Start(const CompactHandler& handler);
+    void Stop();
+    bool IsRunning() const;
+    void AppendTimer(StatsUtils::StatsType statsType, int16_t level, int32_t uid, int64_t totalTimeMs);
+    void AppendCounter(StatsUtils::StatsType statsType, int32_t uid, int64_t totalCount);
+    // Buffers the reset behind the records appended before it, durable once flushed
+    bool AppendReset();
+    bool Flush();
+    bool Compact();
+    // Reads the records after the last reset record, the frames behind a torn or corrupted frame are dropped
+    static bool Replay(const std::string& path, std::vector<Record>& records, bool& hasReset);
+    void SetReplayTimeUs(int64_t replayTimeUs);
+    uint64_t GetRecordBytes() const;
+    uint64_t GetJournalBytesWritten() const;
+    uint64_t GetSnapshotBytesWritten() const;
+    uint64_t GetCompactCount() const;
+    // Bytes written to the journal and the snapshots per logical record byte
+    double GetWriteAmplification() const;
+    void DumpInfo(std::string& result);
+private:
+    std::string path_;
+    Config config_;
+    int32_t fd_ = -1;
+    CompactHandler compactHandler_;
+    std::thread writer_;
+    std::atomic<bool> running_ {false};
+    std::mutex pendingMutex_;
+    std::condition_variable pendingCond_;
+    std::string pending_;
+    std::string frame_;
+    std::mutex ioMutex_;
+    std::atomic<size_t> fileSize_ {0};
+    std::atomic<uint64_t> recordBytes_ {0};
+    std::atomic<uint64_t> journalBytesWritten_ {0};
+    std::atomic<uint64_t> snapshotBytesWritten_ {0};
+    std::atomic<uint64_t> frameCount_ {0};
+    std::atomic<uint64_t> compactCount_ {0};
+    std::atomic<uint64_t> failCount_ {0};
+    std::atomic<int64_t> replayTimeUs_ {0};
+    void AppendRecord(const Record& record);
+    void WriterLoop();
+    bool FlushLocked();
+    bool CompactLocked();
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // BATTERY_STATS_JOURNAL_H
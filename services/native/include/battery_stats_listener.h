@@ -16,10 +16,12 @@
 #ifndef BATTERY_STATS_LISTENER_H
 #define BATTERY_STATS_LISTENER_H
 
+#include <array>
 #include <memory>
 
-#include <cJSON.h>
 #include "hisysevent_listener.h"
+#include "stats_hisysevent.h"
+#include "stats_json_view.h"
 #include "stats_utils.h"
 
 namespace OHOS {
@@ -31,35 +33,57 @@ public:
     void OnEvent(std::shared_ptr<HiviewDFX::HiSysEventRecord> sysEvent) override;
     void OnServiceDied() override;
 private:
-    void ProcessHiSysEventInternal(StatsUtils::StatsData& data, const std::string& eventName, const cJSON* root);
-    void ProcessHiSysEvent(const std::string& eventName, const cJSON* root);
-    void ProcessPhoneEvent(StatsUtils::StatsData& data, const cJSON* root, const std::string& eventName);
-    void ProcessWakelockEvent(StatsUtils::StatsData& data, const cJSON* root);
-    void ProcessWakelockEventInternal(StatsUtils::StatsData& data, const cJSON* root);
-    void ProcessDisplayEvent(StatsUtils::StatsData& data, const cJSON* root, const std::string& eventName);
-    void ProcessBatteryEvent(StatsUtils::StatsData& data, const cJSON* root);
-    void ProcessThermalEvent(StatsUtils::StatsData& data, const cJSON* root);
-    void ProcessThermalEventInternal(StatsUtils::StatsData& data, const cJSON* root);
-    void ProcessPowerWorkschedulerEvent(StatsUtils::StatsData& data, const cJSON* root);
-    void ProcessOthersWorkschedulerEventInternal(StatsUtils::StatsData& data, const cJSON* root);
-    void ProcessOthersWorkschedulerEvent(StatsUtils::StatsData& data, const cJSON* root);
-    void ProcessWorkschedulerEvent(StatsUtils::StatsData& data, const cJSON* root);
-    void ProcessFlashlightEvent(StatsUtils::StatsData& data, const cJSON* root);
-    void ProcessCameraEvent(StatsUtils::StatsData& data, const cJSON* root, const std::string& eventName);
-    void ProcessAudioEvent(StatsUtils::StatsData& data, const cJSON* root);
-    void ProcessSensorEvent(StatsUtils::StatsData& data, const cJSON* root, const std::string& eventName);
-    void ProcessGnssEvent(StatsUtils::StatsData& data, const cJSON* root);
-    void ProcessBluetoothBrEvent(StatsUtils::StatsData& data, const cJSON* root, const std::string& eventName);
-    void ProcessBluetoothBleEvent(StatsUtils::StatsData& data, const cJSON* root, const std::string& eventName);
-    void ProcessBluetoothEvent(StatsUtils::StatsData& data, const cJSON* root, const std::string& eventName);
-    void ProcessWifiEvent(StatsUtils::StatsData& data, const cJSON* root, const std::string& eventName);
-    void ProcessDistributedSchedulerEventInternal(StatsUtils::StatsData& data, const cJSON* root);
-    void ProcessDistributedSchedulerEvent(StatsUtils::StatsData& data, const cJSON* root);
-    void ProcessAlarmEvent(StatsUtils::StatsData& data, const cJSON* root);
-    void ProcessDisplayDebugInfo(StatsUtils::StatsData& data, const cJSON* root);
-    void ProcessDisplayDebugInfoInternal(StatsUtils::StatsData& data, const cJSON* root);
-    void ProcessPhoneDebugInfo(StatsUtils::StatsData& data, const cJSON* root);
+    using EventHandler = void (BatteryStatsListener::*)(StatsUtils::StatsData& data, const StatsJsonView& root,
+        StatsHiSysEvent::HiSysEventType eventType);
+    struct EventEntry {
+        StatsUtils::StatsType statsType = StatsUtils::STATS_TYPE_INVALID;
+        EventHandler handler = nullptr;
+    };
+    using EventTable = std::array<EventEntry, StatsHiSysEvent::HISYSEVENT_TYPE_END>;
+    static const EventTable& GetEventTable();
+    void ProcessHiSysEvent(StatsHiSysEvent::HiSysEventType eventType, const StatsJsonView& root);
+    void ProcessPhoneEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+        StatsHiSysEvent::HiSysEventType eventType);
+    void ProcessWakelockEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+        StatsHiSysEvent::HiSysEventType eventType);
+    void ProcessWakelockEventInternal(StatsUtils::StatsData& data, const StatsJsonView& root);
+    void ProcessDisplayEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+        StatsHiSysEvent::HiSysEventType eventType);
+    void ProcessBatteryEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+        StatsHiSysEvent::HiSysEventType eventType);
+    void ProcessThermalEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+        StatsHiSysEvent::HiSysEventType eventType);
+    void ProcessThermalEventInternal(StatsUtils::StatsData& data, const StatsJsonView& root);
+    void ProcessPowerWorkschedulerEvent(StatsUtils::StatsData& data, const StatsJsonView& root);
+    void ProcessOthersWorkschedulerEventInternal(StatsUtils::StatsData& data, const StatsJsonView& root);
+    void ProcessOthersWorkschedulerEvent(StatsUtils::StatsData& data, const StatsJsonView& root);
+    void ProcessWorkschedulerEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+        StatsHiSysEvent::HiSysEventType eventType);
+    void ProcessFlashlightEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+        StatsHiSysEvent::HiSysEventType eventType);
+    void ProcessCameraEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+        StatsHiSysEvent::HiSysEventType eventType);
+    void ProcessAudioEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+        StatsHiSysEvent::HiSysEventType eventType);
+    void ProcessSensorEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+        StatsHiSysEvent::HiSysEventType eventType);
+    void ProcessGnssEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+        StatsHiSysEvent::HiSysEventType eventType);
+    void ProcessBluetoothBrEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+        StatsHiSysEvent::HiSysEventType eventType);
+    void ProcessBluetoothBleEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+        StatsHiSysEvent::HiSysEventType eventType);
+    void ProcessWifiEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+        StatsHiSysEvent::HiSysEventType eventType);
+    void ProcessDistributedSchedulerEventInternal(StatsUtils::StatsData& data, const StatsJsonView& root);
+    void ProcessDistributedSchedulerEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+        StatsHiSysEvent::HiSysEventType eventType);
+    void ProcessAlarmEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+        StatsHiSysEvent::HiSysEventType eventType);
+    void ProcessDisplayDebugInfo(StatsUtils::StatsData& data, const StatsJsonView& root);
+    void ProcessDisplayDebugInfoInternal(StatsUtils::StatsData& data, const StatsJsonView& root);
+    void ProcessPhoneDebugInfo(StatsUtils::StatsData& data, const StatsJsonView& root);
 };
 } // namespace PowerMgr
 } // namespace OHOS
-#endif // BATTERY_STATS 4_LISTENER_H
\ No newline at end of file
+#endif // BATTERY_STATS 4_LISTENER_H
\ No newline at end of file
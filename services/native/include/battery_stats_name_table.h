@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_STATS_NAME_TABLE_H
+#define BATTERY_STATS_NAME_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Interns names reported by the events, every distinct name is stored once and referred to by a dense 32-bit id.
+ * The number of names is capped, the names arriving once the table is full all share OTHER_ID. No name maps to
+ * OTHER_ID, a name "other" reported by an event gets an id of its own. The table is not locked, the owner serializes
+ * the calls.
+ */
+class BatteryStatsNameTable {
+public:
+    static constexpr uint32_t OTHER_ID = 0;
+    // The name OTHER_ID is shown with
+    static constexpr const char* OTHER_NAME = "other";
+
+    // Capacity counts the interned names, OTHER_ID comes on top of it
+    explicit BatteryStatsNameTable(size_t capacity);
+    ~BatteryStatsNameTable() = default;
+    BatteryStatsNameTable(const BatteryStatsNameTable&) = delete;
+    BatteryStatsNameTable& operator=(const BatteryStatsNameTable&) = delete;
+    uint32_t Intern(std::string_view name);
+    bool Find(std::string_view name, uint32_t& id) const;
+    const std::string& GetName(uint32_t id) const;
+    size_t GetSize() const;
+    size_t GetCapacity() const;
+    uint64_t GetOverflowCount() const;
+    void Clear();
+private:
+    size_t capacity_;
+    uint64_t overflowCount_ = 0;
+    // A deque never moves its elements, so the keys of ids_ can point into the stored names
+    std::deque<std::string> names_;
+    std::unordered_map<std::string_view, uint32_t> ids_;
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // BATTERY_STATS_NAME_TABLE_H
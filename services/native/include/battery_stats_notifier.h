@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_STATS_NOTIFIER_H
+#define BATTERY_STATS_NOTIFIER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "battery_stats_result.h"
+#include "ibattery_stats_callback.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Pushes the app power changes to the registered callbacks instead of letting the clients poll.
+ *
+ * Every subscriber chooses how often it may be called and how much an app has to change before it is reported.
+ * The notifier thread wakes when the first subscriber is due, takes one result for all the due subscribers and
+ * sends each of them the uids whose power moved by the threshold since the value it was last sent. The first push
+ * after registering carries every app. A subscriber whose process dies is dropped through its death recipient.
+ */
+class BatteryStatsNotifier {
+public:
+    using ResultProvider = std::function<std::shared_ptr<const BatteryStatsResult>()>;
+
+    struct Config {
+        // The shortest push interval a subscriber can get
+        int64_t minIntervalMs = 1000;
+        size_t maxSubscribers = 32;
+    };
+
+    BatteryStatsNotifier();
+    explicit BatteryStatsNotifier(const Config& config);
+    ~BatteryStatsNotifier();
+    bool Start(const ResultProvider& provider);
+    void Stop();
+    bool Subscribe(const sptr<IBatteryStatsCallback>& callback, int64_t intervalMs, double thresholdMah);
+    bool Unsubscribe(const sptr<IBatteryStatsCallback>& callback);
+    size_t GetSubscriberCount() const;
+    uint64_t GetPushCount() const;
+    // Pushes the changes in the result to the subscribers due at nowMs, returns the number of callbacks called
+    size_t NotifyDue(int64_t nowMs, const BatteryStatsResult& result);
+private:
+    class CallbackDeathRecipient : public IRemoteObject::DeathRecipient {
+    public:
+        explicit CallbackDeathRecipient(BatteryStatsNotifier& notifier) : notifier_(notifier) {}
+        ~CallbackDeathRecipient() override = default;
+        void OnRemoteDied(const wptr<IRemoteObject>& remote) override;
+    private:
+        BatteryStatsNotifier& notifier_;
+    };
+
+    struct Subscriber {
+        sptr<IBatteryStatsCallback> callback;
+        int64_t intervalMs;
+        double thresholdMah;
+        int64_t nextDueMs;
+        double lastTotalMah = -1.0;
+        std::unordered_map<int32_t, double> lastAppMah;
+    };
+
+    struct Push {
+        sptr<IBatteryStatsCallback> callback;
+        std::vector<int32_t> uids;
+        std::vector<double> appStatsMah;
+        double totalPowerMah;
+    };
+
+    Config config_;
+    ResultProvider provider_;
+    std::thread worker_;
+    std::atomic<bool> running_ {false};
+    mutable std::mutex mutex_;
+    std::condition_variable cond_;
+    bool wakeRequested_ = false;
+    // Keyed by the remote object of the callback
+    std::unordered_map<IRemoteObject*, Subscriber> subscribers_;
+    sptr<IRemoteObject::DeathRecipient> deathRecipient_;
+    uint64_t pushCount_ = 0;
+    void NotifierLoop();
+    // -1 when there is no subscriber to wait for
+    int64_t GetWaitMsLocked(int64_t nowMs) const;
+    bool Remove(IRemoteObject* remote, bool isDead);
+    static bool CollectChanges(Subscriber& subscriber, const std::unordered_map<int32_t, double>& appMah,
+        double totalMah, Push& push);
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // BATTERY_STATS_NOTIFIER_H
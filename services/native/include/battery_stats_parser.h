@@ -20,10 +20,13 @@
 #include <functional>
 #include <iosfwd>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 #include <cJSON.h>
+#include "battery_stats_event_log.h"
+#include "power_profile.h"
 #include "stats_log.h"
 
 namespace OHOS {
@@ -39,15 +42,24 @@ public:
     double GetAveragePowerMa(std::string type, uint16_t level);
     uint16_t GetClusterNum();
     uint16_t GetSpeedNum(uint16_t cluster);
+    std::shared_ptr<const PowerProfile> GetPowerProfile() const;
+    // The optional stats_event_log_capacity of power_average.json, BatteryStatsEventLog::DEFAULT_CAPACITY when
+    // it is missing or out of range
+    size_t GetEventLogCapacity() const;
     bool Init();
     void DumpInfo(std::string& result);
 private:
+    bool LoadAveragePower();
     bool LoadAveragePowerFromFile(const std::string& path);
     void ParsingArray(const std::string& type, const cJSON* array);
+    void ParseEventLogCapacity(const cJSON* item);
+    void CompilePowerProfile();
     std::map<std::string, double> averageMap_;
     std::map<std::string, std::vector<double>> averageVecMap_;
     uint16_t clusterNum_ = 0;
     std::vector<uint16_t> speedNum_;
+    size_t eventLogCapacity_ = BatteryStatsEventLog::DEFAULT_CAPACITY;
+    std::shared_ptr<const PowerProfile> profile_ = std::make_shared<PowerProfile>();
 };
 } // namespace PowerMgr
 } // namespace OHOS
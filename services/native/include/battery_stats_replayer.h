@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_STATS_REPLAYER_H
+#define BATTERY_STATS_REPLAYER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "battery_stats_core.h"
+#include "battery_stats_trace.h"
+#include "power_profile.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Feeds a recorded trace into a core of its own as fast as it can go.
+ *
+ * Every replay starts a new core whose timers count on a fake clock set to the time of each record, so a day of
+ * events takes milliseconds and always ends in the same timers. The clock and the power supply state belong to the
+ * replay core only, the live core of the process and its threads go on as if nothing was replayed.
+ */
+class BatteryStatsReplayer {
+public:
+    struct Result {
+        size_t eventCount = 0;
+        size_t powerSupplyCount = 0;
+        // Time covered by the trace
+        int64_t traceSpanMs = StatsUtils::DEFAULT_VALUE;
+        // Wall time the replay took
+        int64_t replayCostUs = StatsUtils::DEFAULT_VALUE;
+    };
+
+    // The replay cores compute the power with the profile, an empty profile when null
+    explicit BatteryStatsReplayer(std::shared_ptr<const PowerProfile> profile = nullptr);
+    ~BatteryStatsReplayer() = default;
+    // The clock of the core stays at the time of the last record, so the running timers can still be read
+    bool Replay(const std::vector<BatteryStatsTrace::Record>& records, Result& result);
+    bool Replay(const std::string& path, Result& result);
+    // The core of the last replay, null before the first
+    std::shared_ptr<BatteryStatsCore> GetCore() const;
+private:
+    std::shared_ptr<const PowerProfile> profile_;
+    std::shared_ptr<BatteryStatsCore> core_;
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // BATTERY_STATS_REPLAYER_H
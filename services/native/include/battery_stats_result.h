@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_STATS_RESULT_H
+#define BATTERY_STATS_RESULT_H
+
+#include <cstdint>
+#include <unordered_map>
+
+#include "battery_stats_info.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Immutable result of one power computation, indexed by uid and by consumption type.
+ * The core publishes a new result after every computation and the point queries share it until the stats
+ * version moves on, so asking for many apps costs one computation instead of one per query.
+ *
+ * Events, samples and power supply changes move the version on, but running timers keep accumulating without
+ * one. A shared result is therefore up to MAX_AGE_MS old while timers run, the power of a timer which is still
+ * running may lag behind by that much.
+ */
+class BatteryStatsResult {
+public:
+    // A result older than this is computed again even if the version did not change
+    static constexpr int64_t MAX_AGE_MS = 1000;
+    BatteryStatsResult(uint64_t version, int64_t computeTimeMs, const BatteryStatsInfoList& statsInfoList,
+        double totalPowerMah);
+    ~BatteryStatsResult() = default;
+    uint64_t GetVersion() const;
+    int64_t GetComputeTimeMs() const;
+    const BatteryStatsInfoList& GetStatsInfoList() const;
+    double GetTotalPowerMah() const;
+    double GetAppPowerMah(int32_t uid) const;
+    double GetPartPowerMah(BatteryStatsInfo::ConsumptionType type) const;
+private:
+    uint64_t version_;
+    int64_t computeTimeMs_;
+    BatteryStatsInfoList statsInfoList_;
+    double totalPowerMah_;
+    std::unordered_map<int32_t, double> appPowerMap_;
+    std::unordered_map<int32_t, double> partPowerMap_;
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // BATTERY_STATS_RESULT_H
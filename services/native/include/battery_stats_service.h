@@ -23,8 +23,10 @@
 
 #include "battery_stats_core.h"
 #include "battery_stats_detector.h"
+#include "battery_stats_event_queue.h"
 #include "battery_stats_errors.h"
 #include "battery_stats_info.h"
+#include "battery_stats_notifier.h"
 #include "battery_stats_parser.h"
 #include "battery_stats_stub.h"
 
@@ -54,8 +56,22 @@ public:
     int32_t GetTotalDataBytesIpc(int32_t statsType, int32_t uid, uint64_t& totalDataBytes) override;
     int32_t ResetIpc() override;
     int32_t ShellDumpIpc(const std::vector<std::string>& args, uint32_t argc, std::string& dumpShell) override;
+    int32_t GetAppStatsBatchIpc(const std::vector<int32_t>& uids, const std::vector<int32_t>& statsTypes,
+        std::vector<double>& appStatsMah, std::vector<double>& appStatsPercent, std::vector<int64_t>& totalTimeSecond,
+        int32_t& tempError) override;
+    int32_t GetStatsHistoryIpc(int64_t beginTimeMs, int64_t endTimeMs, int64_t& bucketSpanMs,
+        std::vector<int64_t>& bucketStartMs, std::vector<double>& totalPowerMah, std::vector<int32_t>& uids,
+        std::vector<double>& appPowerMah, std::vector<int32_t>& consumptionTypes, std::vector<double>& partPowerMah,
+        int32_t& tempError) override;
+    int32_t RegisterStatsCallbackIpc(const sptr<IBatteryStatsCallback>& callback, int64_t minIntervalMs,
+        double thresholdMah, int32_t& tempError) override;
+    int32_t UnregisterStatsCallbackIpc(const sptr<IBatteryStatsCallback>& callback, int32_t& tempError) override;
+    int32_t GetBatteryStatsTableIpc(ParcelableBatteryStatsTable& batteryStats, int32_t& tempError) override;
+    int32_t GetTopWakelocksIpc(uint32_t count, int32_t uid, std::vector<int32_t>& uids, std::vector<std::string>& names,
+        std::vector<int64_t>& holdTimeMs, std::vector<bool>& isHeld, int32_t& tempError) override;
 
     BatteryStatsInfoList GetBatteryStats();
+    void GetBatteryStatsTable(BatteryStatsTable& table);
     double GetAppStatsMah(const int32_t& uid);
     double GetAppStatsPercent(const int32_t& uid);
     double GetPartStatsMah(const BatteryStatsInfo::ConsumptionType& type);
@@ -65,9 +81,23 @@ public:
     void Reset();
     void SetOnBattery(bool isOnBattery);
     std::string ShellDump(const std::vector<std::string>& args, uint32_t argc);
+    // Answers every uid from one power computation, the time matrix is row major: uids x statsTypes
+    void GetAppStatsBatch(const std::vector<int32_t>& uids, const std::vector<StatsUtils::StatsType>& statsTypes,
+        std::vector<double>& appStatsMah, std::vector<double>& appStatsPercent, std::vector<uint64_t>& totalTimeSecond);
+    // The power consumed in [beginTimeMs, endTimeMs) of the wall clock, bucket by bucket and per app and part
+    void GetStatsHistory(int64_t beginTimeMs, int64_t endTimeMs, BatteryStatsHistoryInfo& history);
+    // Pushes the app power changes to the callback at most every minIntervalMs, see BatteryStatsNotifier
+    bool RegisterStatsCallback(const sptr<IBatteryStatsCallback>& callback, int64_t minIntervalMs,
+        double thresholdMah);
+    bool UnregisterStatsCallback(const sptr<IBatteryStatsCallback>& callback);
+    // The count wakelocks held longest since the reset, of one uid or of every uid, longest first
+    void GetTopWakelocks(uint32_t count, int32_t uid, std::vector<BatteryStatsWakelockInfo>& wakelocks);
+    // Where the core keeps its stats, takes effect on the next OnStart that creates the core
+    void SetStatsDir(const std::string& statsDir);
     std::shared_ptr<BatteryStatsCore> GetBatteryStatsCore() const;
     std::shared_ptr<BatteryStatsParser> GetBatteryStatsParser() const;
     std::shared_ptr<BatteryStatsDetector> GetBatteryStatsDetector() const;
+    std::shared_ptr<BatteryStatsEventQueue> GetBatteryStatsEventQueue() const;
 
     static sptr<BatteryStatsService> GetInstance();
     static void DestroyInstance();
@@ -76,18 +106,26 @@ public:
 private:
 #endif
     static constexpr int32_t DEPENDENCY_CHECK_DELAY_MS = 2000;
+    static constexpr size_t BATCH_MAX_UID_COUNT = 2048;
+    static constexpr size_t BATCH_MAX_CELL_COUNT = 8192;
+    static constexpr uint32_t TOP_WAKELOCK_MAX_COUNT = 256;
     bool Init();
+    std::string statsDir_ = BatteryStatsCore::STATS_DIR;
     std::shared_ptr<BatteryStatsCore> core_;
     std::shared_ptr<BatteryStatsParser> parser_;
     std::shared_ptr<BatteryStatsDetector> detector_;
+    std::shared_ptr<BatteryStatsEventQueue> eventQueue_;
+    std::shared_ptr<BatteryStatsNotifier> notifier_;
     std::shared_ptr<EventFwk::CommonEventSubscriber> subscriberPtr_;
     std::shared_ptr<HiviewDFX::HiSysEventListener> listenerPtr_;
     bool ready_ = false;
     static std::atomic_bool isBootCompleted_;
+    // Serializes the dumps, the stats queries read the result published by the core without locking
     std::mutex mutex_;
     std::atomic_int32_t lastError_ {static_cast<int32_t>(StatsError::ERR_OK)};
     bool SubscribeCommonEvent();
     bool AddHiSysEventListener();
+    void FlushStatsEvents();
     void RegisterBootCompletedCallback();
     static sptr<BatteryStatsService> instance_;
     static std::mutex singletonMutex_;
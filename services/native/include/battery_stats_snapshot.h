@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_STATS_SNAPSHOT_H
+#define BATTERY_STATS_SNAPSHOT_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "stats_utils.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Binary snapshot of the battery stats which survives a reboot.
+ *
+ * Layout, all integers little endian:
+ *   header:  magic(4) version(2) header size(2) payload size(4) payload crc32(4) uid count(4) reserved(4)
+ *   payload: power section, part section, uid section
+ * The power section holds (id, power) pairs where id is a uid or a negative consumption type, the part section
+ * holds (stats type, level, value) triples of the part timers and counters, the uid section holds the sorted
+ * uids followed by one value column per stats type. Integers in the payload are varint encoded, signed ones
+ * zigzag encoded first, uids are delta encoded.
+ */
+class BatteryStatsSnapshot {
+public:
+    static constexpr uint32_t MAGIC = 0x53545342;
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint16_t HEADER_SIZE = 24;
+
+    struct PartValue {
+        StatsUtils::StatsType statsType = StatsUtils::STATS_TYPE_INVALID;
+        int16_t level = StatsUtils::INVALID_VALUE;
+        int64_t value = StatsUtils::DEFAULT_VALUE;
+    };
+
+    struct UidColumn {
+        StatsUtils::StatsType statsType = StatsUtils::STATS_TYPE_INVALID;
+        std::vector<int64_t> values;
+    };
+
+    std::vector<std::pair<int32_t, double>> powers;
+    std::vector<PartValue> partValues;
+    std::vector<int32_t> uids;
+    std::vector<UidColumn> uidColumns;
+
+    bool Encode(std::string& buffer) const;
+    bool Decode(const uint8_t* data, size_t size);
+    bool SaveToFile(const std::string& path, size_t* fileSize = nullptr) const;
+    bool LoadFromFile(const std::string& path);
+    void Clear();
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // BATTERY_STATS_SNAPSHOT_H
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_STATS_TRACE_H
+#define BATTERY_STATS_TRACE_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "stats_utils.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Optional recorder of the stats events as the detector gets them, so that a problem seen in the field can be
+ * replayed by BatteryStatsReplayer exactly as it happened.
+ *
+ * The trace starts with magic(4) version(2) reserved(2) and goes on with checksummed frames like the journal,
+ * len(4) crc32(4) records. A record holds the boot and up time deltas to the previous record as varints and either
+ * the fields of a StatsData or the new power supply state. Records are buffered and written as one frame when the
+ * buffer fills up and when the recording stops, nothing is synced per event. Recording stops by itself when the
+ * trace reaches its size limit.
+ */
+class BatteryStatsTrace {
+public:
+    static constexpr uint32_t MAGIC = 0x43525453;
+    static constexpr uint16_t VERSION = 1;
+
+    enum RecordType : uint8_t {
+        RECORD_EVENT = 1,
+        RECORD_POWER_SUPPLY,
+    };
+
+    struct Record {
+        RecordType type = RECORD_EVENT;
+        int64_t bootTimeMs = StatsUtils::DEFAULT_VALUE;
+        int64_t upTimeMs = StatsUtils::DEFAULT_VALUE;
+        // Set for RECORD_EVENT, the debug info is not recorded
+        StatsUtils::StatsData data;
+        // Set for RECORD_POWER_SUPPLY
+        bool isOnBattery = false;
+    };
+
+    struct Config {
+        size_t flushThresholdBytes = 16 * 1024;
+        size_t maxBytes = 16 * 1024 * 1024;
+    };
+
+    explicit BatteryStatsTrace(const std::string& path);
+    BatteryStatsTrace(const std::string& path, const Config& config);
+    ~BatteryStatsTrace();
+    // Truncates the trace and records the current power supply state as the first record
+    bool Start();
+    void Stop();
+    bool IsRecording() const;
+    void RecordEvent(const StatsUtils::StatsData& data);
+    void RecordPowerSupply(bool isOnBattery);
+    // Reads the records in order, the frames behind a torn or corrupted frame are dropped
+    static bool Read(const std::string& path, std::vector<Record>& records);
+    void DumpInfo(std::string& result);
+private:
+    std::string path_;
+    Config config_;
+    std::atomic<bool> recording_ {false};
+    std::mutex mutex_;
+    int32_t fd_ = -1;
+    std::string pending_;
+    std::string frame_;
+    size_t fileSize_ = 0;
+    int64_t lastBootTimeMs_ = StatsUtils::DEFAULT_VALUE;
+    int64_t lastUpTimeMs_ = StatsUtils::DEFAULT_VALUE;
+    uint64_t recordCount_ = 0;
+    uint64_t failCount_ = 0;
+    void AppendLocked(const Record& record);
+    bool FlushLocked();
+    void StopLocked();
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // BATTERY_STATS_TRACE_H
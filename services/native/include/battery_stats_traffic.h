@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_STATS_TRAFFIC_H
+#define BATTERY_STATS_TRAFFIC_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "stats_utils.h"
+#include "traffic_source.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Counts the network bytes of every uid on Wi-Fi and cellular while on battery.
+ *
+ * Update reads the source and adds what every uid sent and received since the previous read. The counters live in
+ * a fixed open addressing table of atomics, so the entities and the IPC threads read them without a lock while the
+ * sampler thread updates them. A uid keeps its slot once it has one, the uids beyond the capacity are counted under
+ * the "other" uid, StatsUtils::INVALID_VALUE, which only shows up in the totals.
+ */
+class BatteryStatsTraffic {
+public:
+    enum Direction : uint8_t {
+        DIRECTION_RX = 0,
+        DIRECTION_TX,
+        DIRECTION_BUTT,
+    };
+
+    explicit BatteryStatsTraffic(std::unique_ptr<TrafficSource> source, size_t maxUids = 1024);
+    ~BatteryStatsTraffic() = default;
+    BatteryStatsTraffic(const BatteryStatsTraffic&) = delete;
+    BatteryStatsTraffic& operator=(const BatteryStatsTraffic&) = delete;
+    // The first read only sets the baseline
+    bool Update();
+    // Bytes since the last reset, StatsUtils::INVALID_VALUE gives the total over all the uids
+    uint64_t GetBytes(TrafficSource::Network network, Direction direction,
+        int32_t uid = StatsUtils::INVALID_VALUE) const;
+    uint64_t GetBytes(TrafficSource::Network network, int32_t uid = StatsUtils::INVALID_VALUE) const;
+    // Charge of the bytes since the last reset, the coefficients are in mAh per MB
+    double GetPowerMah(TrafficSource::Network network, double rxMahPerMb, double txMahPerMb,
+        int32_t uid = StatsUtils::INVALID_VALUE) const;
+    // Clears the counters of one network, the baseline is kept so nothing is counted twice
+    void Reset(TrafficSource::Network network);
+    void DumpInfo(std::string& result) const;
+private:
+    static constexpr size_t COUNTER_COUNT = TrafficSource::NETWORK_BUTT * DIRECTION_BUTT;
+    static constexpr int32_t EMPTY_UID = StatsUtils::INVALID_VALUE;
+
+    struct Slot {
+        std::atomic<int32_t> uid {EMPTY_UID};
+        std::atomic<uint64_t> bytes[COUNTER_COUNT] {};
+    };
+
+    std::unique_ptr<TrafficSource> source_;
+    size_t maxUids_;
+    size_t capacity_;
+    std::unique_ptr<Slot[]> slots_;
+    std::atomic<size_t> uidCount_ {0};
+    std::atomic<uint64_t> totalBytes_[COUNTER_COUNT] {};
+    std::atomic<uint64_t> updateCount_ {0};
+    std::atomic<uint64_t> overflowCount_ {0};
+    // Serializes the writers, the readers only load the atomics
+    std::mutex updateMutex_;
+    bool hasBaseline_ = false;
+    uint32_t readFailCount_ = 0;
+    // Bytes of the last read, keyed by uid and network
+    std::unordered_map<uint64_t, std::array<uint64_t, DIRECTION_BUTT>> lastBytes_;
+    std::unordered_map<uint64_t, std::array<uint64_t, DIRECTION_BUTT>> currentBytes_;
+    static size_t GetCounter(TrafficSource::Network network, Direction direction);
+    const Slot* FindSlot(int32_t uid) const;
+    Slot* GetOrCreateSlotLocked(int32_t uid);
+    void AddLocked(int32_t uid, TrafficSource::Network network, const std::array<uint64_t, DIRECTION_BUTT>& bytes);
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // BATTERY_STATS_TRAFFIC_H
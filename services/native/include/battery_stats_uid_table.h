@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef BATTERY_STATS_UID_TABLE_H
+#define BATTERY_STATS_UID_TABLE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "stats_helper.h"
+#include "stats_utils.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Per-uid timers, counters and power consumption of all the app entities of one core.
+ * Every uid owns a dense slot, slots are grouped in blocks and each block stores its values column by column,
+ * so a pass over one column walks contiguous memory. A timer or counter column of a block is only allocated once
+ * a uid of the block uses it. Blocks are never moved or freed while the table is alive, the timers and counters
+ * handed out share the ownership of their block.
+ * The table isn't locked, the core owning it serializes every access.
+ */
+class BatteryStatsUidTable {
+public:
+    enum TimerColumn : uint8_t {
+        TIMER_AUDIO_ON = 0,
+        TIMER_BLUETOOTH_BR_SCAN,
+        TIMER_BLUETOOTH_BLE_SCAN,
+        TIMER_FLASHLIGHT_ON,
+        TIMER_GNSS_ON,
+        TIMER_SENSOR_GRAVITY_ON,
+        TIMER_SENSOR_PROXIMITY_ON,
+        TIMER_WAKELOCK_HOLD,
+        TIMER_COLUMN_END
+    };
+
+    enum CounterColumn : uint8_t {
+        COUNTER_ALARM = 0,
+        COUNTER_COLUMN_END
+    };
+
+    enum PowerColumn : uint8_t {
+        POWER_ALARM = 0,
+        POWER_APP,
+        POWER_AUDIO,
+        POWER_BLUETOOTH,
+        POWER_BLUETOOTH_BR_SCAN,
+        POWER_BLUETOOTH_BLE_SCAN,
+        POWER_CAMERA,
+        POWER_CPU,
+        POWER_CPU_ACTIVE,
+        POWER_CPU_CLUSTER,
+        POWER_CPU_SPEED,
+        POWER_FLASHLIGHT,
+        POWER_GNSS,
+        POWER_SENSOR,
+        POWER_SENSOR_GRAVITY,
+        POWER_SENSOR_PROXIMITY,
+        POWER_WAKELOCK,
+        POWER_COLUMN_END
+    };
+
+    enum DataColumn : uint8_t {
+        DATA_CPU_TIME = 0,
+        DATA_COLUMN_END
+    };
+
+    static constexpr uint32_t INVALID_SLOT = UINT32_MAX;
+    static constexpr uint32_t SLOTS_PER_BLOCK = 64;
+
+    BatteryStatsUidTable() = default;
+    ~BatteryStatsUidTable() = default;
+    BatteryStatsUidTable(const BatteryStatsUidTable&) = delete;
+    BatteryStatsUidTable& operator=(const BatteryStatsUidTable&) = delete;
+    // A uid is computed column after column, so the lookups come in runs of the same uid
+    uint32_t FindSlot(int32_t uid) const
+    {
+        return uid == lastFound_.uid ? lastFound_.slot : FindSlotInBuckets(uid);
+    }
+    uint32_t GetOrCreateSlot(int32_t uid);
+    uint32_t GetSlotCount() const;
+    int32_t GetUid(uint32_t slot) const;
+    std::shared_ptr<StatsHelper::ActiveTimer> GetOrCreateTimer(int32_t uid, TimerColumn column);
+    int64_t GetRunningTimeMs(int32_t uid, TimerColumn column);
+    std::shared_ptr<StatsHelper::Counter> GetOrCreateCounter(int32_t uid, CounterColumn column);
+    int64_t GetCount(int32_t uid, CounterColumn column);
+    double GetPower(int32_t uid, PowerColumn column) const;
+    void SetPower(int32_t uid, PowerColumn column, double power);
+    int64_t GetData(int32_t uid, DataColumn column) const;
+    void SetData(int32_t uid, DataColumn column, int64_t data);
+    void ResetColumn(TimerColumn column);
+    void ResetColumn(CounterColumn column);
+    void ResetColumn(PowerColumn column);
+    void ResetColumn(DataColumn column);
+    size_t GetMemoryUsage() const;
+private:
+    template<typename T, size_t N>
+    using Column = std::array<std::array<T, SLOTS_PER_BLOCK>, N>;
+    template<typename T, size_t N>
+    using LazyColumn = std::array<std::unique_ptr<std::array<T, SLOTS_PER_BLOCK>>, N>;
+    struct Block {
+        LazyColumn<StatsHelper::ActiveTimer, TIMER_COLUMN_END> timers;
+        LazyColumn<StatsHelper::Counter, COUNTER_COLUMN_END> counters;
+        Column<double, POWER_COLUMN_END> powers {};
+        Column<int64_t, DATA_COLUMN_END> data {};
+    };
+    struct Bucket {
+        int32_t uid = StatsUtils::INVALID_VALUE;
+        uint32_t slot = INVALID_SLOT;
+    };
+    std::vector<Bucket> buckets_;
+    mutable Bucket lastFound_;
+    std::vector<int32_t> uids_;
+    std::vector<std::shared_ptr<Block>> blocks_;
+    template<typename T, size_t N>
+    static T* GetOrCreateCell(LazyColumn<T, N>& columns, size_t column, uint32_t slot);
+    template<typename T, size_t N>
+    static T* FindCell(const LazyColumn<T, N>& columns, size_t column, uint32_t slot);
+    uint32_t FindSlotInBuckets(int32_t uid) const;
+    void InsertBucket(int32_t uid, uint32_t slot);
+    void Rehash(size_t bucketCount);
+    size_t GetBucketIndex(int32_t uid) const;
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // BATTERY_STATS_UID_TABLE_H
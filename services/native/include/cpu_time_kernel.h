@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CPU_TIME_KERNEL_H
+#define CPU_TIME_KERNEL_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Vector loops over the rows of cpu times. AVX2, SSE2 or NEON is picked at compile time, the scalar loop is the
+ * fallback and the reference the vector loops have to match.
+ */
+class CpuTimeKernel {
+public:
+    // Computes increment = max(current - last, 0) and stores current into last in the same pass. The increments are
+    // added to total, or written over it when replace is set, unless total is null. Returns whether any increment
+    // was negative and clamped.
+    static bool Accumulate(const int64_t* current, int64_t* last, int64_t* total, size_t count, bool replace);
+    static bool AccumulateScalar(const int64_t* current, int64_t* last, int64_t* total, size_t count,
+        bool replace);
+    // Sum of weights[i] * values[i]
+    static double Dot(const double* weights, const int64_t* values, size_t count);
+    static double DotScalar(const double* weights, const int64_t* values, size_t count);
+    static const char* GetIsaName();
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // CPU_TIME_KERNEL_H
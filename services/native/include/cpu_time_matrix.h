@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CPU_TIME_MATRIX_H
+#define CPU_TIME_MATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * One row of cpu times per uid, stored in two contiguous matrices: the absolute times of the last read and the
+ * totals derived from them. A row grows when a read brings more columns than the matrix has, and the columns a read
+ * leaves out keep their times.
+ */
+class CpuTimeMatrix {
+public:
+    enum UpdateMode : uint8_t {
+        // Only remembers the times, the next read is measured against them
+        UPDATE_LAST = 0,
+        // Adds the increments to the totals
+        UPDATE_ACCUMULATE,
+        // Keeps the increments of this read as the totals
+        UPDATE_REPLACE,
+    };
+
+    CpuTimeMatrix() = default;
+    ~CpuTimeMatrix() = default;
+    // Returns false when a time went backwards, its increment is counted as zero
+    bool Update(int32_t uid, const std::vector<int64_t>& times, UpdateMode mode);
+    // The rows stay valid until the next update, nullptr for an unknown uid
+    const int64_t* GetTotals(int32_t uid) const;
+    const int64_t* GetLast(int32_t uid) const;
+    size_t GetWidth() const;
+    size_t GetRowCount() const;
+private:
+    size_t width_ = 0;
+    std::unordered_map<int32_t, size_t> rows_;
+    std::vector<int64_t> last_;
+    std::vector<int64_t> totals_;
+    std::vector<int64_t> padded_;
+    size_t GetOrAddRow(int32_t uid);
+    void Widen(size_t width);
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // CPU_TIME_MATRIX_H
@@ -16,56 +16,52 @@
 #ifndef CPU_TIME_READER
 #define CPU_TIME_READER
 
-#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <vector>
 
+#include "cpu_time_matrix.h"
+#include "cpu_time_source.h"
+
 namespace OHOS {
 namespace PowerMgr {
 class CpuTimeReader {
 public:
-    CpuTimeReader() = default;
+    CpuTimeReader();
+    explicit CpuTimeReader(std::unique_ptr<CpuTimeSource> source);
     ~CpuTimeReader() = default;
     bool Init();
     int64_t GetUidCpuActiveTimeMs(int32_t uid);
     int64_t GetUidCpuClusterTimeMs(int32_t uid, uint32_t cluster);
     int64_t GetUidCpuFreqTimeMs(int32_t uid, uint32_t cluster, uint32_t speed);
+    // Sum of the speed times of the cluster weighted by the average current of each speed
+    double GetUidCpuFreqPowerMaMs(int32_t uid, uint32_t cluster, const double* averageMa, size_t speedNum);
     bool UpdateCpuTime();
+    // Where the speeds of each cluster start in the freq times, see PowerProfile::speedOffsets
+    void SetSpeedOffsets(const std::vector<size_t>& offsets);
+    // The uids the refreshes have seen since the last call, each of them once
+    std::vector<int32_t> TakeSampledUids();
     std::vector<int64_t> GetUidCpuTimeMs(int32_t uid);
     void DumpInfo(std::string& result, int32_t uid);
 
 private:
-    uint32_t wakelockCounts_ = 0;
-    std::map<int32_t, int64_t> activeTimeMap_;
-    std::map<int32_t, std::vector<int64_t>> clusterTimeMap_;
-    std::map<int32_t, std::map<uint32_t, std::vector<int64_t>>> freqTimeMap_;
-    std::map<int32_t, std::vector<int64_t>> uidTimeMap_;
-    std::map<int32_t, int64_t> lastActiveTimeMap_;
-    std::map<int32_t, std::vector<int64_t>> lastClusterTimeMap_;
-    std::map<int32_t, std::map<uint32_t, std::vector<int64_t>>> lastFreqTimeMap_;
-    std::map<int32_t, std::vector<int64_t>> lastUidTimeMap_;
-    std::map<uint16_t, uint16_t> clustersMap_;
-    bool ReadUidCpuActiveTime();
-    bool ReadUidCpuActiveTimeImpl(std::string& line, int32_t uid);
-    bool ReadUidCpuClusterTime();
-    void AddIncrementsToClusterTime(std::vector<int64_t>& clusterTime,
-        const std::vector<int64_t>& increments, const std::vector<uint16_t>& clusters);
-    void ReadPolicy(std::vector<uint16_t>& clusters, std::string& line);
-    bool ReadClusterTimeIncrement(std::vector<int64_t>& clusterTime, std::vector<int64_t>& increments, int32_t uid,
-        std::vector<uint16_t>& clusters, std::string& timeLine);
-    bool ReadUidCpuFreqTime();
-    bool ReadFreqTimeIncrement(std::map<uint32_t, std::vector<int64_t>>& speedTime,
-        std::map<uint32_t, std::vector<int64_t>>& increments, int32_t uid, std::vector<std::string>& splitedTime);
-    bool ProcessFreqTime(std::map<uint32_t, std::vector<int64_t>>& map, std::map<uint32_t,
-        std::vector<int64_t>>& increments, std::map<uint32_t, std::vector<int64_t>>& speedTime, int32_t index,
-        int32_t uid);
-    void DistributeFreqTime(std::map<uint32_t, std::vector<int64_t>>& uidIncrements,
-        std::map<uint32_t, std::vector<int64_t>>& increments);
-    void AddFreqTimeToUid(std::map<uint32_t, std::vector<int64_t>>& uidIncrements, int32_t uid);
-    bool ReadUidCpuTime();
-    void UpdateUidTimeMap(int32_t uid, const std::vector<int64_t>& uidIncrements);
-    bool ReadUidTimeIncrement(std::vector<int64_t>& clusterTime, std::vector<int64_t>& uidIncrements, int32_t uid,
-        std::string& timeLine);
-    void Split(std::string &origin, char delimiter, std::vector<std::string> &splited);
+    // Serializes the refreshes, guards the time source and the uids seen by the running refresh
+    std::mutex updateMutex_;
+    // Guards the time matrices, the power calculation reads them while the sampler thread refreshes them
+    std::mutex mutex_;
+    CpuTimeMatrix activeTime_;
+    CpuTimeMatrix clusterTime_;
+    // The speeds of every cluster one after another, freqClusterOffsets_ holds where each cluster starts
+    CpuTimeMatrix freqTime_;
+    CpuTimeMatrix uidTime_;
+    std::vector<size_t> freqClusterOffsets_;
+    std::unique_ptr<CpuTimeSource> source_;
+    std::vector<int32_t> sampledUids_;
+    bool UpdateCpuTimeLocked();
+    bool ReadUidCpuTimes(CpuTimeSource::TimeType type, CpuTimeMatrix& matrix, CpuTimeMatrix::UpdateMode mode);
+    const int64_t* GetFreqTimes(int32_t uid, uint32_t cluster, size_t& speedNum) const;
+    void UpdateUidMap(int32_t uid);
 };
 } // namespace PowerMgr
 } // namespace OHOS
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CPU_TIME_SAMPLER_H
+#define CPU_TIME_SAMPLER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Refreshes the uid cpu times on a background thread.
+ *
+ * A sample is taken every interval, and earlier when a trigger asks for one. The requests which arrive before the
+ * sampler thread gets to them are served by one sample, and the triggered samples are at least the min interval
+ * apart. A caller which needs fresh times waits for the next sample instead of reading the proc files itself, so
+ * the files are never read on the caller's thread.
+ */
+class CpuTimeSampler {
+public:
+    using SampleHandler = std::function<void()>;
+
+    enum Trigger : uint8_t {
+        TRIGGER_PERIODIC = 0,
+        TRIGGER_SCREEN_OFF,
+        TRIGGER_POWER_SUPPLY,
+        TRIGGER_QUERY,
+        TRIGGER_BUTT,
+    };
+
+    struct Config {
+        int64_t intervalMs = 60 * 1000;
+        int64_t minIntervalMs = 1000;
+        // A query waits for a new sample when the last one is older than this
+        int64_t queryMaxAgeMs = 5000;
+        int64_t waitTimeoutMs = 500;
+    };
+
+    CpuTimeSampler();
+    explicit CpuTimeSampler(const Config& config);
+    ~CpuTimeSampler();
+    bool Start(const SampleHandler& handler);
+    void Stop();
+    bool IsRunning() const;
+    // Asks for a sample and returns at once
+    void RequestSample(Trigger trigger);
+    // Asks for a sample, skipping the min interval, and waits until a sample started after the request is done
+    bool WaitForSample(Trigger trigger, int64_t timeoutMs);
+    // Waits for a new sample only when the last one is older than the query max age
+    bool SampleIfStale();
+    // Milliseconds since the last sample was started, -1 when nothing has been sampled yet
+    int64_t GetStalenessMs() const;
+    uint64_t GetSampleCount() const;
+    uint64_t GetCoalescedCount() const;
+    void DumpInfo(std::string& result);
+private:
+    Config config_;
+    SampleHandler handler_;
+    std::thread worker_;
+    std::atomic<bool> running_ {false};
+    std::mutex mutex_;
+    std::condition_variable requestCond_;
+    std::condition_variable sampleCond_;
+    bool requested_ = false;
+    bool urgent_ = false;
+    Trigger pendingTrigger_ = TRIGGER_PERIODIC;
+    uint64_t startedCount_ = 0;
+    uint64_t finishedCount_ = 0;
+    std::atomic<int64_t> lastSampleTimeMs_ {-1};
+    std::atomic<int64_t> lastCostUs_ {0};
+    std::atomic<int64_t> maxCostUs_ {0};
+    std::atomic<int64_t> totalCostUs_ {0};
+    std::atomic<uint64_t> sampleCount_ {0};
+    std::atomic<uint64_t> coalescedCount_ {0};
+    std::atomic<uint64_t> waitTimeoutCount_ {0};
+    std::atomic<uint64_t> triggerCounts_[TRIGGER_BUTT] {};
+    void RequestLocked(Trigger trigger, bool urgent);
+    void SamplerLoop();
+    void Sample(Trigger trigger);
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // CPU_TIME_SAMPLER_H
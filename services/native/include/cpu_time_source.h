@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CPU_TIME_SOURCE_H
+#define CPU_TIME_SOURCE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "proc_file_reader.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Where CpuTimeReader gets the per uid cpu times from. A source only reports the absolute times since boot, turning
+ * them into increments is left to the reader so that every source shares the same delta logic.
+ */
+class CpuTimeSource {
+public:
+    enum TimeType : uint8_t {
+        // Concurrent active time, one value in ms
+        TIME_TYPE_ACTIVE = 0,
+        // Concurrent time of every cluster in ms
+        TIME_TYPE_CLUSTER,
+        // Time of every cluster and speed in ms, the speeds of cluster 0 come first
+        TIME_TYPE_FREQ,
+        // User and system time in us
+        TIME_TYPE_UID,
+        TIME_TYPE_BUTT,
+    };
+
+    // Gets the times of one uid, returning false stops the read
+    using Visitor = std::function<bool(int32_t uid, const std::vector<int64_t>& times)>;
+
+    virtual ~CpuTimeSource() = default;
+    virtual const char* GetName() const = 0;
+    // Called once per refresh before the times are read
+    virtual bool Prepare()
+    {
+        return true;
+    }
+    virtual bool Read(TimeType type, const Visitor& visitor) = 0;
+    // Prefers the packed binary times when the kernel exports them and falls back to the proc text files
+    static std::unique_ptr<CpuTimeSource> Create();
+};
+
+/**
+ * Parses the proc text files, /proc/uid_concurrent_active_time and the like.
+ */
+class ProcCpuTimeSource : public CpuTimeSource {
+public:
+    ProcCpuTimeSource() = default;
+    ~ProcCpuTimeSource() override = default;
+    const char* GetName() const override;
+    bool Read(TimeType type, const Visitor& visitor) override;
+private:
+    ProcFileReader procReader_;
+    std::vector<uint16_t> clusterCores_;
+    std::vector<int64_t> times_;
+    bool ParseTimes(TimeType type, std::string_view timeField);
+    void ParsePolicy(std::string_view line);
+};
+
+/**
+ * Reads fixed-width little-endian uid records, as dumped from a pinned BPF map or by a vendor kernel module:
+ *   header: magic(4) version(2) clusterCount(2) freqCount(2) reserved(2) recordCount(4)
+ *   record: uid(4) reserved(4) activeMs(8) clusterMs(8 * clusterCount) freqMs(8 * freqCount) userUs(8) systemUs(8)
+ */
+class BinaryCpuTimeSource : public CpuTimeSource {
+public:
+    static constexpr uint32_t MAGIC = 0x42544355; // "UCTB"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 16;
+
+    explicit BinaryCpuTimeSource(const std::string& path);
+    ~BinaryCpuTimeSource() override = default;
+    const char* GetName() const override;
+    bool Prepare() override;
+    bool Read(TimeType type, const Visitor& visitor) override;
+    static size_t GetRecordSize(uint16_t clusterCount, uint16_t freqCount);
+protected:
+    std::string path_;
+    ProcFileReader fileReader_;
+    // Parses the dump starting at offset and reports where the next one would start
+    bool SelectFrame(size_t offset, size_t& frameSize);
+private:
+    size_t frameOffset_ = 0;
+    uint16_t clusterCount_ = 0;
+    uint16_t freqCount_ = 0;
+    uint32_t recordCount_ = 0;
+    bool ready_ = false;
+    std::vector<int64_t> times_;
+};
+
+/**
+ * Replays a file of back to back binary dumps, every refresh moves on to the next dump. Meant for tests.
+ */
+class ReplayCpuTimeSource : public BinaryCpuTimeSource {
+public:
+    explicit ReplayCpuTimeSource(const std::string& path);
+    ~ReplayCpuTimeSource() override = default;
+    const char* GetName() const override;
+    bool Prepare() override;
+private:
+    bool loaded_ = false;
+    size_t nextOffset_ = 0;
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // CPU_TIME_SOURCE_H
@@ -16,8 +16,6 @@
 #ifndef ALARM_ENTITY_H
 #define ALARM_ENTITY_H
 
-#include <map>
-
 #include "entities/battery_stats_entity.h"
 
 namespace OHOS {
@@ -33,9 +31,6 @@ public:
     std::shared_ptr<StatsHelper::Counter> GetOrCreateCounter(StatsUtils::StatsType statsType,
         int32_t uid = StatsUtils::INVALID_VALUE) override;
     void Reset() override;
-private:
-    std::map<int32_t, std::shared_ptr<StatsHelper::Counter>> alarmCounterMap_;
-    std::map<int32_t, double> alarmPowerMap_;
 };
 } // namespace PowerMgr
 } // namespace OHOS
@@ -20,14 +20,36 @@
 #include <iosfwd>
 #include <memory>
 #include <vector>
+#include "battery_stats_traffic.h"
+#include "battery_stats_uid_table.h"
+#include "power_profile.h"
 #include "stats_utils.h"
 #include "stats_helper.h"
 #include "battery_stats_info.h"
 
 namespace OHOS {
 namespace PowerMgr {
+class BatteryStatsCore;
+
 class BatteryStatsEntity {
 public:
+    // What one computation of the entities of a core adds up
+    struct Sums {
+        double totalPowerMah = StatsUtils::DEFAULT_VALUE;
+        BatteryStatsInfoList statsInfoList;
+    };
+
+    // What the entities of one core share, the core hands it to every entity it creates. An entity created on its
+    // own keeps a table, a profile and sums of its own and has no other entities to ask
+    struct Context {
+        std::weak_ptr<BatteryStatsCore> core;
+        std::shared_ptr<BatteryStatsUidTable> uidTable;
+        // The wifi and phone entities read their bytes from it
+        std::shared_ptr<BatteryStatsTraffic> traffic;
+        std::shared_ptr<const PowerProfile> powerProfile;
+        std::shared_ptr<Sums> sums;
+    };
+
     BatteryStatsEntity() = default;
     virtual ~BatteryStatsEntity() = default;
     virtual double GetEntityPowerMah(int32_t uidOrUserId = StatsUtils::INVALID_VALUE) = 0;
@@ -49,20 +71,24 @@ public:
         int32_t uid = StatsUtils::INVALID_VALUE);
     virtual void AggregateUserPowerMah(int32_t userId, double power);
     virtual void UpdateUidMap(int32_t uid);
+    // The running delta is +1 when a timer of the uid in the part started and -1 when one stopped
+    virtual void MarkUidDirty(int32_t uid, BatteryStatsInfo::ConsumptionType type, int32_t runningDelta = 0);
     virtual int64_t GetCpuTimeMs(int32_t uid);
     virtual void UpdateCpuTime();
     virtual std::vector<int32_t> GetUids();
+    virtual void InvalidateUserIds();
     virtual void DumpInfo(std::string& result, int32_t uid = StatsUtils::INVALID_VALUE);
     BatteryStatsInfo::ConsumptionType GetConsumptionType();
-    static double GetTotalPowerMah();
-    static void ResetStatsEntity();
-    static BatteryStatsInfoList GetStatsInfoList();
-    static void UpdateStatsInfoList(std::shared_ptr<BatteryStatsInfo> info);
+    // Set before the first Calculate, what the context leaves empty is kept
+    void SetContext(const Context& context);
 protected:
-    static double totalPowerMah_;
-    static BatteryStatsInfoList statsInfoList_;
+    std::weak_ptr<BatteryStatsCore> core_;
+    std::shared_ptr<BatteryStatsUidTable> uidTable_ = std::make_shared<BatteryStatsUidTable>();
+    std::shared_ptr<BatteryStatsTraffic> traffic_;
+    std::shared_ptr<const PowerProfile> powerProfile_ = std::make_shared<PowerProfile>();
+    std::shared_ptr<Sums> sums_ = std::make_shared<Sums>();
     BatteryStatsInfo::ConsumptionType consumptionType_ = BatteryStatsInfo::CONSUMPTION_TYPE_INVALID;
 };
 } // namespace PowerMgr
 } // namespace OHOS
-#endif // BATTERY_BATTERY_STATS_ENTITY_H
\ No newline at end of file
+#endif // BATTERY_BATTERY_STATS_ENTITY_H
\ No newline at end of file
@@ -16,8 +16,6 @@
 #ifndef BLUETOOTH_ENTITY_H
 #define BLUETOOTH_ENTITY_H
 
-#include <map>
-
 #include "entities/battery_stats_entity.h"
 
 namespace OHOS {
@@ -52,14 +50,9 @@ private:
     double bluetoothBrPowerMah_ = StatsUtils::DEFAULT_VALUE;
     double bluetoothBlePowerMah_ = StatsUtils::DEFAULT_VALUE;
     double bluetoothPowerMah_ = StatsUtils::DEFAULT_VALUE;
-    std::map<int32_t, double> appBluetoothBrPowerMap_;
-    std::map<int32_t, double> appBluetoothBlePowerMap_;
-    std::map<int32_t, double> appBluetoothPowerMap_;
     std::shared_ptr<StatsHelper::ActiveTimer> bluetoothBrOnTimer_;
     std::shared_ptr<StatsHelper::ActiveTimer> bluetoothBleOnTimer_;
-    std::map<int32_t, std::shared_ptr<StatsHelper::ActiveTimer>> appBluetoothBrScanTimerMap_;
-    std::map<int32_t, std::shared_ptr<StatsHelper::ActiveTimer>> appBluetoothBleScanTimerMap_;
 };
 } // namespace PowerMgr
 } // namespace OHOS
-#endif // BLUETOOTH_ENTITY_H
\ No newline at end of file
+#endif // BLUETOOTH_ENTITY_H
\ No newline at end of file
@@ -37,8 +37,7 @@ public:
     void Reset() override;
 private:
     std::map<std::string, std::map<int32_t, std::shared_ptr<StatsHelper::ActiveTimer>>> cameraTimerMap_;
-    std::map<int32_t, double> cameraPowerMap_;
 };
 } // namespace PowerMgr
 } // namespace OHOS
-#endif // CAMERA_ENTITY_H
\ No newline at end of file
+#endif // CAMERA_ENTITY_H
\ No newline at end of file
@@ -16,8 +16,6 @@
 #ifndef CPU_ENTITY_H
 #define CPU_ENTITY_H
 
-#include <map>
-
 #include "cpu_time_reader.h"
 #include "entities/battery_stats_entity.h"
 #include "stats_helper.h"
@@ -37,15 +35,10 @@ public:
     void UpdateCpuTime() override;
 private:
     std::shared_ptr<CpuTimeReader> cpuReader_;
-    std::map<int32_t, int64_t> cpuTimeMap_;
-    std::map<int32_t, double> cpuTotalPowerMap_;
-    std::map<int32_t, double> cpuActivePowerMap_;
-    std::map<int32_t, double> cpuClusterPowerMap_;
-    std::map<int32_t, double> cpuSpeedPowerMap_;
     double CalculateCpuActivePower(int32_t uid);
     double CalculateCpuClusterPower(int32_t uid);
     double CalculateCpuSpeedPower(int32_t uid);
 };
 } // namespace PowerMgr
 } // namespace OHOS
-#endif // CPU_ENTITY_H
\ No newline at end of file
+#endif // CPU_ENTITY_H
\ No newline at end of file
@@ -16,8 +16,6 @@
 #ifndef FLASHLIGHT_ENTITY_H
 #define FLASHLIGHT_ENTITY_H
 
-#include <map>
-
 #include "entities/battery_stats_entity.h"
 #include "stats_helper.h"
 
@@ -35,10 +33,7 @@ public:
     std::shared_ptr<StatsHelper::ActiveTimer> GetOrCreateTimer(int32_t uid, StatsUtils::StatsType statsType,
         int16_t level = StatsUtils::INVALID_VALUE) override;
     void Reset() override;
-private:
-    std::map<int32_t, std::shared_ptr<StatsHelper::ActiveTimer>> flashlightTimerMap_;
-    std::map<int32_t, double> flashlightPowerMap_;
 };
 } // namespace PowerMgr
 } // namespace OHOS
-#endif // FLASHLIGHT_ENTITY_H
\ No newline at end of file
+#endif // FLASHLIGHT_ENTITY_H
\ No newline at end of file
@@ -16,8 +16,6 @@
 #ifndef SENSOR_ENTITY_H
 #define SENSOR_ENTITY_H
 
-#include <map>
-
 #include "entities/battery_stats_entity.h"
 #include "stats_helper.h"
 
@@ -36,14 +34,9 @@ public:
         int16_t level = StatsUtils::INVALID_VALUE) override;
     void Reset() override;
 private:
-    std::map<int32_t, std::shared_ptr<StatsHelper::ActiveTimer>> gravityTimerMap_;
-    std::map<int32_t, std::shared_ptr<StatsHelper::ActiveTimer>> proximityTimerMap_;
-    std::map<int32_t, double> sensorTotalPowerMap_;
-    std::map<int32_t, double> gravityPowerMap_;
-    std::map<int32_t, double> proximityPowerMap_;
     double CalculateGravity(int32_t uid);
     double CalculateProximity(int32_t uid);
 };
 } // namespace PowerMgr
 } // namespace OHOS
-#endif // SENSOR_ENTITY_H
\ No newline at end of file
+#endif // SENSOR_ENTITY_H
\ No newline at end of file
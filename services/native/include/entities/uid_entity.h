@@ -16,8 +16,9 @@
 #ifndef UID_ENTITY_H
 #define UID_ENTITY_H
 
-#include <map>
+#include <array>
 #include <mutex>
+#include <vector>
 
 #include "entities/battery_stats_entity.h"
 #include "stats_helper.h"
@@ -33,20 +34,41 @@ public:
     double GetStatsPowerMah(StatsUtils::StatsType statsType, int32_t uid = StatsUtils::INVALID_VALUE)
         override;
     void UpdateUidMap(int32_t uid) override;
+    void MarkUidDirty(int32_t uid, BatteryStatsInfo::ConsumptionType type, int32_t runningDelta = 0) override;
     std::vector<int32_t> GetUids() override;
+    // Drops the cached user ids, called when a user is added or removed
+    void InvalidateUserIds() override;
     void Reset() override;
     void DumpInfo(std::string& result, int32_t uid = StatsUtils::INVALID_VALUE) override;
 private:
+    static constexpr size_t PART_COUNT =
+        BatteryStatsInfo::CONSUMPTION_TYPE_ALARM - BatteryStatsInfo::CONSUMPTION_TYPE_APP + 1;
+    struct UidState {
+        bool isApp = false;
+        // Parts whose power kept in the uid table is stale, one bit per consumption type
+        uint32_t dirtyParts = 0;
+        // Running timers per part, e.g. one per camera device, the parts with any keep accumulating time and are
+        // recalculated every time
+        std::array<uint16_t, PART_COUNT> runningCounts {};
+        // Resolved once per uid instead of on every calculation
+        bool hasUserId = false;
+        int32_t userId = StatsUtils::INVALID_VALUE;
+    };
     std::mutex uidEntityMutex_;
-    std::map<int32_t, double> uidPowerMap_;
+    // Indexed by the slot of the uid in the uid table
+    std::vector<UidState> uidStates_;
+    UidState* GetUidStateLocked(int32_t uid);
+    std::vector<int32_t> GetUidsLocked();
+    int32_t GetUserIdLocked(int32_t uid, UidState& state);
     void AddtoStatsList(int32_t uid, double power);
     double GetPowerForCommon(StatsUtils::StatsType statsType, int32_t uid);
     double GetPowerForConnectivity(StatsUtils::StatsType statsType, int32_t uid);
     void DumpForBluetooth(int32_t uid, std::string& result);
     void DumpForCommon(int32_t uid, std::string& result);
-    double CalculateForConnectivity(int32_t uid);
-    double CalculateForCommon(int32_t uid);
+    double CalculateForConnectivity(int32_t uid, UidState& state);
+    double CalculateForCommon(int32_t uid, UidState& state);
+    double CalculateForPart(int32_t uid, UidState& state, const std::shared_ptr<BatteryStatsEntity>& entity);
 };
 } // namespace PowerMgr
 } // namespace OHOS
-#endif // UID_ENTITY_H
\ No newline at end of file
+#endif // UID_ENTITY_H
\ No newline at end of file
@@ -16,7 +16,8 @@
 #ifndef USER_ENTITY_H
 #define USER_ENTITY_H
 
-#include <map>
+#include <utility>
+#include <vector>
 
 #include "entities/battery_stats_entity.h"
 #include "entities/uid_entity.h"
@@ -32,7 +33,9 @@ public:
     void Calculate(int32_t uid = StatsUtils::INVALID_VALUE) override;
     void Reset() override;
 private:
-    std::map<int32_t, double> userPowerMap_;
+    // Sorted by user id, a device has a handful of users
+    std::vector<std::pair<int32_t, double>> userPowers_;
+    std::vector<std::pair<int32_t, double>>::iterator FindUser(int32_t userId);
 };
 } // namespace PowerMgr
 } // namespace OHOS
@@ -16,8 +16,13 @@
 #ifndef WAKELOCK_ENTITY_H
 #define WAKELOCK_ENTITY_H
 
-#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
+#include "battery_stats_name_table.h"
 #include "entities/battery_stats_entity.h"
 #include "stats_helper.h"
 
@@ -25,7 +30,23 @@ namespace OHOS {
 namespace PowerMgr {
 class WakelockEntity : public BatteryStatsEntity {
 public:
+    struct Config {
+        // Distinct lock names kept, the other names are counted in the overflow timer of the uid, shown as "other"
+        size_t maxNames = 256;
+        // (uid, name) timers kept, a uid over the cap counts its new locks in its overflow timer
+        size_t maxLocks = 1024;
+        size_t dumpTopCount = 10;
+    };
+
+    struct LockInfo {
+        int32_t uid = StatsUtils::INVALID_VALUE;
+        std::string name;
+        int64_t holdTimeMs = StatsUtils::DEFAULT_VALUE;
+        bool isHeld = false;
+    };
+
     WakelockEntity();
+    explicit WakelockEntity(const Config& config);
     ~WakelockEntity() = default;
     void Calculate(int32_t uid = StatsUtils::INVALID_VALUE) override;
     int64_t GetActiveTimeMs(int32_t uid, StatsUtils::StatsType statsType,
@@ -34,11 +55,33 @@ public:
     double GetStatsPowerMah(StatsUtils::StatsType statsType, int32_t uid = StatsUtils::INVALID_VALUE) override;
     std::shared_ptr<StatsHelper::ActiveTimer> GetOrCreateTimer(int32_t uid, StatsUtils::StatsType statsType,
         int16_t level = StatsUtils::INVALID_VALUE) override;
+    // Zeroes the times, the locks held keep their holds and their timers run on from now
     void Reset() override;
+    void DumpInfo(std::string& result, int32_t uid = StatsUtils::INVALID_VALUE) override;
+    // Holding the same lock again nests, the lock timer runs until every hold is released. True when the uid took
+    // its first hold or released its last, the wakelock timer of the uid follows these changes
+    bool UpdateLockState(int32_t uid, std::string_view name, StatsUtils::StatsState state);
+    // The uids holding any lock
+    std::vector<int32_t> GetHoldingUids();
+    int64_t GetLockTimeMs(int32_t uid, std::string_view name);
+    // The count locks held longest, of one uid or of every uid, longest first
+    std::vector<LockInfo> GetTopLocks(size_t count, int32_t uid = StatsUtils::INVALID_VALUE);
 private:
-    std::map<int32_t, std::shared_ptr<StatsHelper::ActiveTimer>> wakelockTimerMap_;
-    std::map<int32_t, double> wakelockPowerMap_;
+    struct LockStats {
+        StatsHelper::ActiveTimer timer;
+        uint32_t holdCount = 0;
+    };
+    Config config_;
+    std::mutex lockMutex_;
+    BatteryStatsNameTable names_;
+    std::unordered_map<uint64_t, LockStats> locks_;
+    // Holds of every lock of the uid
+    std::unordered_map<int32_t, uint32_t> uidHoldCounts_;
+    uint64_t droppedLockCount_ = 0;
+    LockStats* GetOrCreateLockLocked(int32_t uid, std::string_view name);
+    LockStats* FindLockLocked(int32_t uid, std::string_view name);
+    static uint64_t GetLockKey(int32_t uid, uint32_t nameId);
 };
 } // namespace PowerMgr
 } // namespace OHOS
-#endif // WAKELOCK_ENTITY_H
\ No newline at end of file
+#endif // WAKELOCK_ENTITY_H
\ No newline at end of file
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef POWER_PROFILE_H
+#define POWER_PROFILE_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "stats_utils.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * The average currents of power_average.json in mA, compiled once by BatteryStatsParser so that the power formulas
+ * index arrays instead of looking the currents up by name.
+ */
+struct PowerProfile {
+    enum Item : uint8_t {
+        ITEM_BLUETOOTH_BR_ON = 0,
+        ITEM_BLUETOOTH_BR_SCAN,
+        ITEM_BLUETOOTH_BLE_ON,
+        ITEM_BLUETOOTH_BLE_SCAN,
+        ITEM_WIFI_ON,
+        ITEM_WIFI_SCAN,
+        ITEM_CAMERA_ON,
+        ITEM_FLASHLIGHT_ON,
+        ITEM_GNSS_ON,
+        ITEM_SENSOR_GRAVITY,
+        ITEM_SENSOR_PROXIMITY,
+        ITEM_AUDIO_ON,
+        ITEM_SCREEN_ON,
+        ITEM_CPU_AWAKE,
+        ITEM_CPU_IDLE,
+        ITEM_CPU_ACTIVE,
+        ITEM_CPU_SUSPEND,
+        ITEM_ALARM_ON,
+        // The traffic items are charges in mAh per MB rather than currents
+        ITEM_WIFI_RX,
+        ITEM_WIFI_TX,
+        ITEM_RADIO_RX,
+        ITEM_RADIO_TX,
+        ITEM_BUTT,
+    };
+
+    std::array<double, ITEM_BUTT> averageMa {};
+    // Current of every brightness level, the level times screen_brightness
+    std::array<double, StatsUtils::SCREEN_BRIGHTNESS_BIN + 1> brightnessMa {};
+    std::array<double, StatsUtils::RADIO_SIGNAL_BIN> radioOnMa {};
+    std::array<double, StatsUtils::RADIO_SIGNAL_BIN> radioDataMa {};
+    std::vector<double> clusterMa;
+    // The speeds of every cluster one after another, cluster i takes [speedOffsets[i], speedOffsets[i + 1])
+    std::vector<double> speedMa;
+    std::vector<size_t> speedOffsets {0};
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // POWER_PROFILE_H
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PROC_FILE_READER_H
+#define PROC_FILE_READER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Reads a proc file into a buffer which is kept across reads, so refreshing the same files again and again only
+ * allocates when a file outgrows every earlier read. Lines and tokens are handed out as views into the buffer and
+ * stay valid until the next Read.
+ */
+class ProcFileReader {
+public:
+    ProcFileReader() = default;
+    ~ProcFileReader() = default;
+    bool Read(const std::string& path);
+    bool NextLine(std::string_view& line);
+    const char* GetData() const;
+    size_t GetSize() const;
+    size_t GetCapacity() const;
+    // Takes the next field of input, the empty fields between repeated delimiters are skipped like Split does
+    static bool NextToken(std::string_view& input, char delimiter, std::string_view& token);
+    // Same result as StatsUtils::ParseStrtollResult without copying the token into a string
+    static bool ParseInt64(std::string_view token, int64_t& value);
+private:
+    static constexpr size_t INITIAL_CAPACITY = 64 * 1024;
+    std::vector<char> buffer_;
+    size_t size_ = 0;
+    size_t pos_ = 0;
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // PROC_FILE_READER_H
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRAFFIC_SOURCE_H
+#define TRAFFIC_SOURCE_H
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "proc_file_reader.h"
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Where BatteryStatsTraffic gets the per uid network bytes from. Like CpuTimeSource, a source only reports the
+ * absolute bytes since the counters were created and the increments are left to the caller.
+ */
+class TrafficSource {
+public:
+    enum Network : uint8_t {
+        NETWORK_WIFI = 0,
+        NETWORK_CELLULAR,
+        NETWORK_BUTT,
+    };
+
+    // Gets the bytes of one uid on one interface, a uid may be reported more than once. Returning false stops the read
+    using Visitor = std::function<bool(int32_t uid, Network network, uint64_t rxBytes, uint64_t txBytes)>;
+
+    virtual ~TrafficSource() = default;
+    virtual const char* GetName() const = 0;
+    virtual bool Read(const Visitor& visitor) = 0;
+    static std::unique_ptr<TrafficSource> Create();
+    // Tells the network of an interface by its name, false for the interfaces which are not counted, like lo
+    static bool GetNetwork(std::string_view iface, Network& network);
+};
+
+/**
+ * Parses a netstats style table, one line per interface, tag, uid and counter set:
+ *   idx iface acct_tag_hex uid_tag_int cnt_set rx_bytes rx_packets tx_bytes tx_packets ...
+ * Only the untagged lines are counted, the tagged ones are a breakdown of them. Pointing it at a fixture file gives
+ * the tests a traffic source they control.
+ */
+class NetStatsTrafficSource : public TrafficSource {
+public:
+    explicit NetStatsTrafficSource(const std::string& path);
+    ~NetStatsTrafficSource() override = default;
+    const char* GetName() const override;
+    bool Read(const Visitor& visitor) override;
+private:
+    std::string path_;
+    ProcFileReader fileReader_;
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // TRAFFIC_SOURCE_H
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_stats_codec.h"
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr uint32_t CRC32_POLYNOMIAL = 0xEDB88320;
+constexpr uint32_t CRC32_INIT = 0xFFFFFFFF;
+constexpr size_t CRC32_TABLE_SIZE = 256;
+constexpr uint32_t BITS_PER_BYTE = 8;
+constexpr uint32_t BYTE_MASK = 0xFF;
+constexpr uint32_t VARINT_PAYLOAD_BITS = 7;
+constexpr uint8_t VARINT_PAYLOAD_MASK = 0x7F;
+constexpr uint8_t VARINT_CONTINUE_BIT = 0x80;
+constexpr uint32_t VARINT_MAX_SHIFT = 63;
+constexpr uint32_t SIGN_SHIFT = 63;
+
+constexpr std::array<uint32_t, CRC32_TABLE_SIZE> MakeCrc32Table()
+{
+    std::array<uint32_t, CRC32_TABLE_SIZE> table {};
+    for (uint32_t i = 0; i < CRC32_TABLE_SIZE; i++) {
+        uint32_t crc = i;
+        for (uint32_t bit = 0; bit < BITS_PER_BYTE; bit++) {
+            crc = (crc & 1) ? (crc >> 1) ^ CRC32_POLYNOMIAL : crc >> 1;
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr std::array<uint32_t, CRC32_TABLE_SIZE> CRC32_TABLE = MakeCrc32Table();
+
+void PutFixed(std::string& buffer, uint64_t value, size_t size)
+{
+    for (size_t i = 0; i < size; i++) {
+        buffer.push_back(static_cast<char>((value >> (i * BITS_PER_BYTE)) & BYTE_MASK));
+    }
+}
+} // namespace
+
+bool BatteryStatsCodec::Reader::Skip(size_t size)
+{
+    if (GetRemaining() < size) {
+        return false;
+    }
+    pos_ += size;
+    return true;
+}
+
+bool BatteryStatsCodec::Reader::GetFixed(uint64_t& value, size_t size)
+{
+    if (GetRemaining() < size) {
+        return false;
+    }
+    value = 0;
+    for (size_t i = 0; i < size; i++) {
+        value |= static_cast<uint64_t>(pos_[i]) << (i * BITS_PER_BYTE);
+    }
+    pos_ += size;
+    return true;
+}
+
+bool BatteryStatsCodec::Reader::GetFixed16(uint16_t& value)
+{
+    uint64_t bits = 0;
+    if (!GetFixed(bits, sizeof(value))) {
+        return false;
+    }
+    value = static_cast<uint16_t>(bits);
+    return true;
+}
+
+bool BatteryStatsCodec::Reader::GetFixed32(uint32_t& value)
+{
+    uint64_t bits = 0;
+    if (!GetFixed(bits, sizeof(value))) {
+        return false;
+    }
+    value = static_cast<uint32_t>(bits);
+    return true;
+}
+
+bool BatteryStatsCodec::Reader::GetFixed64(uint64_t& value)
+{
+    return GetFixed(value, sizeof(value));
+}
+
+bool BatteryStatsCodec::Reader::GetDouble(double& value)
+{
+    uint64_t bits = 0;
+    if (!GetFixed64(bits)) {
+        return false;
+    }
+    std::memcpy(&value, &bits, sizeof(value));
+    return true;
+}
+
+bool BatteryStatsCodec::Reader::GetVarint(uint64_t& value)
+{
+    value = 0;
+    for (uint32_t shift = 0; shift <= VARINT_MAX_SHIFT; shift += VARINT_PAYLOAD_BITS) {
+        if (pos_ == end_) {
+            return false;
+        }
+        uint8_t byte = *pos_++;
+        value |= static_cast<uint64_t>(byte & VARINT_PAYLOAD_MASK) << shift;
+        if ((byte & VARINT_CONTINUE_BIT) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool BatteryStatsCodec::Reader::GetSignedVarint(int64_t& value)
+{
+    uint64_t bits = 0;
+    if (!GetVarint(bits)) {
+        return false;
+    }
+    value = static_cast<int64_t>((bits >> 1) ^ (0 - (bits & 1)));
+    return true;
+}
+
+bool BatteryStatsCodec::Reader::GetCount(size_t& count)
+{
+    uint64_t value = 0;
+    if (!GetVarint(value) || value > GetRemaining()) {
+        return false;
+    }
+    count = static_cast<size_t>(value);
+    return true;
+}
+
+void BatteryStatsCodec::PutFixed16(std::string& buffer, uint16_t value)
+{
+    PutFixed(buffer, value, sizeof(value));
+}
+
+void BatteryStatsCodec::PutFixed32(std::string& buffer, uint32_t value)
+{
+    PutFixed(buffer, value, sizeof(value));
+}
+
+void BatteryStatsCodec::PutFixed64(std::string& buffer, uint64_t value)
+{
+    PutFixed(buffer, value, sizeof(value));
+}
+
+void BatteryStatsCodec::SetFixed32(std::string& buffer, size_t offset, uint32_t value)
+{
+    for (size_t i = 0; i < sizeof(value); i++) {
+        buffer[offset + i] = static_cast<char>((value >> (i * BITS_PER_BYTE)) & BYTE_MASK);
+    }
+}
+
+void BatteryStatsCodec::PutDouble(std::string& buffer, double value)
+{
+    uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+    PutFixed64(buffer, bits);
+}
+
+void BatteryStatsCodec::PutVarint(std::string& buffer, uint64_t value)
+{
+    while (value > VARINT_PAYLOAD_MASK) {
+        buffer.push_back(static_cast<char>((value & VARINT_PAYLOAD_MASK) | VARINT_CONTINUE_BIT));
+        value >>= VARINT_PAYLOAD_BITS;
+    }
+    buffer.push_back(static_cast<char>(value));
+}
+
+void BatteryStatsCodec::PutSignedVarint(std::string& buffer, int64_t value)
+{
+    uint64_t bits = static_cast<uint64_t>(value);
+    PutVarint(buffer, (bits << 1) ^ (0 - (bits >> SIGN_SHIFT)));
+}
+
+uint32_t BatteryStatsCodec::Crc32(const uint8_t* data, size_t size)
+{
+    uint32_t crc = CRC32_INIT;
+    for (size_t i = 0; i < size; i++) {
+        crc = CRC32_TABLE[(crc ^ data[i]) & BYTE_MASK] ^ (crc >> BITS_PER_BYTE);
+    }
+    return crc ^ CRC32_INIT;
+}
+
+bool BatteryStatsCodec::WriteAll(int32_t fd, const std::string& buffer)
+{
+    size_t written = 0;
+    while (written < buffer.size()) {
+        ssize_t ret = write(fd, buffer.data() + written, buffer.size() - written);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            return false;
+        }
+        written += static_cast<size_t>(ret);
+    }
+    return true;
+}
+
+bool BatteryStatsCodec::ReadFile(const std::string& path, size_t maxSize, std::string& buffer, size_t& fileSize)
+{
+    int32_t fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat fileStat {};
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size < 0) {
+        close(fd);
+        return false;
+    }
+    fileSize = static_cast<size_t>(fileStat.st_size);
+    size_t size = fileSize < maxSize ? fileSize : maxSize;
+    buffer.resize(size);
+    size_t readSize = 0;
+    while (readSize < size) {
+        ssize_t ret = read(fd, &buffer[readSize], size - readSize);
+        if (ret < 0 && errno == EINTR) {
+            continue;
+        }
+        if (ret <= 0) {
+            break;
+        }
+        readSize += static_cast<size_t>(ret);
+    }
+    close(fd);
+    buffer.resize(readSize);
+    return true;
+}
+} // namespace PowerMgr
+} // namespace OHOS
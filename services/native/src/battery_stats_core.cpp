@@ -14,6 +14,7 @@
  */
 #include "battery_stats_core.h"
 
+#include <chrono>
 #include <cinttypes>
 #include <cstdio>
 #include <fstream>
@@ -30,6 +31,8 @@
 
 #include "battery_info.h"
 #include "battery_srv_client.h"
+#include "battery_stats_journal.h"
+#include "battery_stats_snapshot.h"
 #include "entities/audio_entity.h"
 #include "entities/bluetooth_entity.h"
 #include "entities/camera_entity.h"
@@ -54,29 +57,76 @@
 namespace OHOS {
 namespace PowerMgr {
 namespace {
-static const std::string BATTERY_STATS_JSON = "/data/service/el0/stats/battery_stats.json";
+static const std::string BATTERY_STATS_JSON = "/battery_stats.json";
+static const std::string BATTERY_STATS_SNAPSHOT = "/battery_stats.bin";
+static const std::string BATTERY_STATS_JOURNAL = "/battery_stats.journal";
+static const std::string BATTERY_STATS_TRACE = "/battery_stats.trace";
+// Part timers kept in the snapshot, the level is ignored by the entity for the types without levels
+constexpr StatsUtils::StatsType SNAPSHOT_PART_TIMER_TYPES[] = {
+    StatsUtils::STATS_TYPE_BLUETOOTH_BR_ON,
+    StatsUtils::STATS_TYPE_BLUETOOTH_BLE_ON,
+    StatsUtils::STATS_TYPE_SCREEN_ON,
+    StatsUtils::STATS_TYPE_WIFI_ON,
+    StatsUtils::STATS_TYPE_PHONE_IDLE,
+    StatsUtils::STATS_TYPE_CPU_SUSPEND,
+};
+constexpr StatsUtils::StatsType SNAPSHOT_UID_TIMER_TYPES[] = {
+    StatsUtils::STATS_TYPE_BLUETOOTH_BR_SCAN,
+    StatsUtils::STATS_TYPE_BLUETOOTH_BLE_SCAN,
+    StatsUtils::STATS_TYPE_CAMERA_ON,
+    StatsUtils::STATS_TYPE_FLASHLIGHT_ON,
+    StatsUtils::STATS_TYPE_GNSS_ON,
+    StatsUtils::STATS_TYPE_SENSOR_GRAVITY_ON,
+    StatsUtils::STATS_TYPE_SENSOR_PROXIMITY_ON,
+    StatsUtils::STATS_TYPE_AUDIO_ON,
+    StatsUtils::STATS_TYPE_WAKELOCK_HOLD,
+};
+// Camera timers are kept per camera device, the restored time is added to this pseudo device
+constexpr const char* SNAPSHOT_CAMERA_DEVICE_ID = "";
+constexpr int64_t CPU_SAMPLE_WAIT_TIMEOUT_MS = 500;
+
+int64_t GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t GetWallTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
 } // namespace
+
+template<typename T>
+std::shared_ptr<T> BatteryStatsCore::CreateEntity()
+{
+    auto entity = std::make_shared<T>();
+    entity->SetContext({ weak_from_this(), uidTable_, traffic_, powerProfile_, sums_ });
+    return entity;
+}
+
 void BatteryStatsCore::CreatePartEntity()
 {
     if (bluetoothEntity_ == nullptr) {
         STATS_HILOGD(COMP_SVC, "Create bluetooth entity");
-        bluetoothEntity_ = std::make_shared<BluetoothEntity>();
+        bluetoothEntity_ = CreateEntity<BluetoothEntity>();
     }
     if (idleEntity_ == nullptr) {
         STATS_HILOGD(COMP_SVC, "Create idle entity");
-        idleEntity_ = std::make_shared<IdleEntity>();
+        idleEntity_ = CreateEntity<IdleEntity>();
     }
     if (phoneEntity_ == nullptr) {
         STATS_HILOGD(COMP_SVC, "Create phone entity");
-        phoneEntity_ = std::make_shared<PhoneEntity>();
+        phoneEntity_ = CreateEntity<PhoneEntity>();
     }
     if (screenEntity_ == nullptr) {
         STATS_HILOGD(COMP_SVC, "Create screen entity");
-        screenEntity_ = std::make_shared<ScreenEntity>();
+        screenEntity_ = CreateEntity<ScreenEntity>();
     }
     if (wifiEntity_ == nullptr) {
         STATS_HILOGD(COMP_SVC, "Create wifi entity");
-        wifiEntity_ = std::make_shared<WifiEntity>();
+        wifiEntity_ = CreateEntity<WifiEntity>();
     }
 }
 
@@ -84,74 +134,237 @@ void BatteryStatsCore::CreateAppEntity()
 {
     if (audioEntity_ == nullptr) {
         STATS_HILOGD(COMP_SVC, "Create audio entity");
-        audioEntity_ = std::make_shared<AudioEntity>();
+        audioEntity_ = CreateEntity<AudioEntity>();
     }
     if (cameraEntity_ == nullptr) {
         STATS_HILOGD(COMP_SVC, "Create camera entity");
-        cameraEntity_ = std::make_shared<CameraEntity>();
+        cameraEntity_ = CreateEntity<CameraEntity>();
     }
     if (flashlightEntity_ == nullptr) {
         STATS_HILOGD(COMP_SVC, "Create flashlight entity");
-        flashlightEntity_ = std::make_shared<FlashlightEntity>();
+        flashlightEntity_ = CreateEntity<FlashlightEntity>();
     }
     if (gnssEntity_ == nullptr) {
         STATS_HILOGD(COMP_SVC, "Create gnss entity");
-        gnssEntity_ = std::make_shared<GnssEntity>();
+        gnssEntity_ = CreateEntity<GnssEntity>();
     }
     if (sensorEntity_ == nullptr) {
         STATS_HILOGD(COMP_SVC, "Create sensor entity");
-        sensorEntity_ = std::make_shared<SensorEntity>();
+        sensorEntity_ = CreateEntity<SensorEntity>();
     }
     if (uidEntity_ == nullptr) {
         STATS_HILOGD(COMP_SVC, "Create uid entity");
-        uidEntity_ = std::make_shared<UidEntity>();
+        uidEntity_ = CreateEntity<UidEntity>();
     }
     if (userEntity_ == nullptr) {
         STATS_HILOGD(COMP_SVC, "Create user entity");
-        userEntity_ = std::make_shared<UserEntity>();
+        userEntity_ = CreateEntity<UserEntity>();
     }
     if (wakelockEntity_ == nullptr) {
         STATS_HILOGD(COMP_SVC, "Create wakelock entity");
-        wakelockEntity_ = std::make_shared<WakelockEntity>();
+        wakelockEntity_ = CreateEntity<WakelockEntity>();
     }
     if (cpuEntity_ == nullptr) {
         STATS_HILOGD(COMP_SVC, "Create cpu entity");
-        cpuEntity_ = std::make_shared<CpuEntity>();
+        cpuEntity_ = CreateEntity<CpuEntity>();
     }
     if (alarmEntity_ == nullptr) {
         STATS_HILOGD(COMP_SVC, "Create alarm entity");
-        alarmEntity_ = std::make_shared<AlarmEntity>();
+        alarmEntity_ = CreateEntity<AlarmEntity>();
     }
 }
 
-bool BatteryStatsCore::Init()
+bool BatteryStatsCore::InitEntities(std::shared_ptr<const PowerProfile> profile)
 {
-    STATS_HILOGI(COMP_SVC, "Battery stats core init");
+    CoreLock lock(*this);
+    if (profile != nullptr) {
+        powerProfile_ = profile;
+    }
     CreateAppEntity();
     CreatePartEntity();
+    return true;
+}
+
+bool BatteryStatsCore::Init(std::shared_ptr<const PowerProfile> profile, size_t eventLogCapacity)
+{
+    STATS_HILOGI(COMP_SVC, "Battery stats core init");
+    if (eventLogCapacity != eventLog_.GetCapacity()) {
+        eventLog_.SetCapacity(eventLogCapacity);
+    }
+    if (traffic_ == nullptr) {
+        traffic_ = std::make_shared<BatteryStatsTraffic>(TrafficSource::Create());
+    }
+    InitEntities(profile);
     auto& batterySrvClient = BatterySrvClient::GetInstance();
     BatteryPluggedType plugType = batterySrvClient.GetPluggedType();
-    if (plugType == BatteryPluggedType::PLUGGED_TYPE_NONE || plugType == BatteryPluggedType::PLUGGED_TYPE_BUTT) {
-        StatsHelper::SetOnBattery(true);
-    } else {
-        StatsHelper::SetOnBattery(false);
+    {
+        CoreLock lock(*this);
+        StatsHelper::SetOnBattery(plugType == BatteryPluggedType::PLUGGED_TYPE_NONE ||
+            plugType == BatteryPluggedType::PLUGGED_TYPE_BUTT);
+        // The first read of the cpu times is the base the samples count from
+        cpuEntity_->UpdateCpuTime();
     }
 
+    if (cpuSampler_ == nullptr) {
+        cpuSampler_ = std::make_shared<CpuTimeSampler>();
+    }
+    if (journal_ == nullptr) {
+        journal_ = std::make_shared<BatteryStatsJournal>(statsDir_ + BATTERY_STATS_JOURNAL);
+    }
+    if (trace_ == nullptr) {
+        trace_ = std::make_shared<BatteryStatsTrace>(statsDir_ + BATTERY_STATS_TRACE);
+    }
     if (!LoadBatteryStatsData()) {
         STATS_HILOGW(COMP_SVC, "Load battery stats data failed");
     }
     return true;
 }
 
+bool BatteryStatsCore::StartJournal()
+{
+    if (journal_ == nullptr) {
+        return false;
+    }
+    return journal_->Start([this](size_t& snapshotBytes) { return WriteSnapshot(snapshotBytes); });
+}
+
+void BatteryStatsCore::StopJournal()
+{
+    if (journal_ != nullptr) {
+        journal_->Stop();
+    }
+}
+
+bool BatteryStatsCore::StartTrace()
+{
+    return trace_ != nullptr && trace_->Start();
+}
+
+void BatteryStatsCore::StopTrace()
+{
+    if (trace_ != nullptr) {
+        trace_->Stop();
+    }
+}
+
+void BatteryStatsCore::RecordTraceEvent(const StatsUtils::StatsData& data)
+{
+    if (trace_ != nullptr) {
+        trace_->RecordEvent(data);
+    }
+}
+
+bool BatteryStatsCore::StartCpuSampler()
+{
+    if (cpuSampler_ == nullptr) {
+        return false;
+    }
+    // The traffic counters are read on the same thread and triggers as the cpu times, before the cpu sample may
+    // compute the power for the history
+    return cpuSampler_->Start([this] {
+        SampleTraffic();
+        SampleCpuTime();
+    });
+}
+
+void BatteryStatsCore::StopCpuSampler()
+{
+    if (cpuSampler_ != nullptr) {
+        cpuSampler_->Stop();
+    }
+}
+
+void BatteryStatsCore::RequestCpuSample(CpuTimeSampler::Trigger trigger)
+{
+    if (cpuSampler_ != nullptr) {
+        cpuSampler_->RequestSample(trigger);
+    }
+}
+
+void BatteryStatsCore::SetOnBattery(bool isOnBattery)
+{
+    // The cpu time is only counted while on battery, so the time since the last sample belongs to the old state
+    if (cpuSampler_ != nullptr && cpuSampler_->IsRunning() && isOnBattery != StatsHelper::IsOnBattery()) {
+        cpuSampler_->WaitForSample(CpuTimeSampler::TRIGGER_POWER_SUPPLY, CPU_SAMPLE_WAIT_TIMEOUT_MS);
+    }
+    // Not locked while waiting, the sample takes the lock
+    CoreLock lock(*this);
+    if (trace_ != nullptr && isOnBattery != StatsHelper::IsOnBattery()) {
+        trace_->RecordPowerSupply(isOnBattery);
+    }
+    StatsHelper::SetOnBattery(isOnBattery);
+    // The timers stop or resume counting, a result computed under the old state is out of date
+    statsVersion_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void BatteryStatsCore::InvalidateUserIds()
+{
+    if (uidEntity_ == nullptr) {
+        return;
+    }
+    CoreLock lock(*this);
+    uidEntity_->InvalidateUserIds();
+    statsVersion_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void BatteryStatsCore::SampleCpuTime()
+{
+    if (cpuEntity_ == nullptr || uidEntity_ == nullptr) {
+        return;
+    }
+    CoreLock lock(*this);
+    cpuEntity_->UpdateCpuTime();
+    uidEntity_->MarkUidDirty(StatsUtils::INVALID_VALUE, BatteryStatsInfo::CONSUMPTION_TYPE_CPU);
+    statsVersion_.fetch_add(1, std::memory_order_relaxed);
+    // Computing once per history bucket keeps the buckets filled when nobody queries the stats
+    if (history_.IsRecordDue(GetWallTimeMs())) {
+        ComputePowerLocked();
+    }
+}
+
+void BatteryStatsCore::SampleTraffic()
+{
+    if (traffic_ == nullptr) {
+        return;
+    }
+    CoreLock lock(*this);
+    if (!traffic_->Update()) {
+        return;
+    }
+    statsVersion_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void BatteryStatsCore::SetEventQueue(std::shared_ptr<BatteryStatsEventQueue> eventQueue)
+{
+    eventQueue_ = std::move(eventQueue);
+}
+
+void BatteryStatsCore::FlushStatsEvents()
+{
+    if (eventQueue_ != nullptr) {
+        eventQueue_->Flush();
+    }
+}
+
 void BatteryStatsCore::ComputePower()
 {
-    std::lock_guard lock(mutex_);
+    // Apply the stats events which are still pending in the queue before calculating
+    FlushStatsEvents();
+    CoreLock lock(*this);
+    ComputePowerLocked();
+}
+
+void BatteryStatsCore::ComputePowerLocked()
+{
     STATS_HILOGD(COMP_SVC, "Calculate battery stats");
+    // Every timer of the computation is read at the same now
+    StatsHelper::TimeSnapshot timeSnapshot;
+    uint64_t version = statsVersion_.load();
     const uint32_t DFX_DELAY_S = 60;
     int id = HiviewDFX::XCollie::GetInstance().SetTimer("BatteryStatsCoreComputePower", DFX_DELAY_S, nullptr, nullptr,
         HiviewDFX::XCOLLIE_FLAG_LOG);
 
-    BatteryStatsEntity::ResetStatsEntity();
+    ResetSums();
     uidEntity_->Calculate();
     bluetoothEntity_->Calculate();
     idleEntity_->Calculate();
@@ -159,14 +372,60 @@ void BatteryStatsCore::ComputePower()
     screenEntity_->Calculate();
     wifiEntity_->Calculate();
     userEntity_->Calculate();
+    auto result = std::make_shared<const BatteryStatsResult>(version, GetSteadyTimeMs(),
+        sums_->statsInfoList, sums_->totalPowerMah);
+    std::atomic_store(&result_, result);
+    resultComputeCount_.fetch_add(1, std::memory_order_relaxed);
+    history_.Record(GetWallTimeMs(), *result);
 
     HiviewDFX::XCollie::GetInstance().CancelTimer(id);
 }
 
+void BatteryStatsCore::ResetSums()
+{
+    STATS_HILOGI(COMP_SVC, "Reset total consumption power and battery stats list");
+    *sums_ = BatteryStatsEntity::Sums();
+}
+
+bool BatteryStatsCore::IsResultFresh(const std::shared_ptr<const BatteryStatsResult>& result) const
+{
+    return result != nullptr && result->GetVersion() == statsVersion_.load() &&
+        GetSteadyTimeMs() - result->GetComputeTimeMs() < BatteryStatsResult::MAX_AGE_MS;
+}
+
+std::shared_ptr<const BatteryStatsResult> BatteryStatsCore::GetStatsResult()
+{
+    if (cpuSampler_ != nullptr) {
+        cpuSampler_->SampleIfStale();
+    }
+    FlushStatsEvents();
+    auto result = std::atomic_load(&result_);
+    if (IsResultFresh(result)) {
+        resultHitCount_.fetch_add(1, std::memory_order_relaxed);
+        return result;
+    }
+    // The consumer of the events publishes a new result, the readers queued behind share it. Without a running
+    // queue the caller applies the events itself and publishes under the lock
+    if (eventQueue_ == nullptr || !eventQueue_->Sync([this] { PublishResult(); })) {
+        PublishResult();
+    }
+    return std::atomic_load(&result_);
+}
+
+void BatteryStatsCore::PublishResult()
+{
+    CoreLock lock(*this);
+    if (IsResultFresh(std::atomic_load(&result_))) {
+        resultHitCount_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    ComputePowerLocked();
+}
+
 BatteryStatsInfoList BatteryStatsCore::GetBatteryStats()
 {
-    std::lock_guard lock(mutex_);
-    return BatteryStatsEntity::GetStatsInfoList();
+    auto result = std::atomic_load(&result_);
+    return result != nullptr ? result->GetStatsInfoList() : BatteryStatsInfoList {};
 }
 
 std::shared_ptr<BatteryStatsEntity> BatteryStatsCore::GetEntity(const BatteryStatsInfo::ConsumptionType& type)
@@ -215,6 +474,8 @@ void BatteryStatsCore::UpdateStats(StatsUtils::StatsType statsType, int64_t time
         "Update for duration, statsType: %{public}s, uid: %{public}d, time: %{public}" PRId64 ", "  \
         "data: %{public}" PRId64 "",
         StatsUtils::ConvertStatsType(statsType).c_str(), uid, time, data);
+    CoreLock lock(*this);
+    statsVersion_.fetch_add(1, std::memory_order_relaxed);
     if (uid > StatsUtils::INVALID_VALUE) {
         uidEntity_->UpdateUidMap(uid);
     }
@@ -284,6 +545,8 @@ void BatteryStatsCore::UpdateStats(StatsUtils::StatsType statsType, StatsUtils::
         "Update for state, statsType: %{public}s, uid: %{public}d, state: %{public}d, level: %{public}d,"   \
         "deviceId: %{private}s",
         StatsUtils::ConvertStatsType(statsType).c_str(), uid, state, level, deviceId.c_str());
+    CoreLock lock(*this);
+    statsVersion_.fetch_add(1, std::memory_order_relaxed);
     if (uid > StatsUtils::INVALID_VALUE) {
         uidEntity_->UpdateUidMap(uid);
     }
@@ -321,6 +584,34 @@ void BatteryStatsCore::UpdateStats(StatsUtils::StatsType statsType, StatsUtils::
     }
 }
 
+void BatteryStatsCore::UpdateWakelockStats(StatsUtils::StatsState state, int32_t uid, const std::string& name)
+{
+    CoreLock lock(*this);
+    if (wakelockEntity_ == nullptr) {
+        return;
+    }
+    // The wakelock timer of the uid runs from its first hold to the release of its last, whatever the lock
+    if (wakelockEntity_->UpdateLockState(uid, name, state)) {
+        UpdateStats(StatsUtils::STATS_TYPE_WAKELOCK_HOLD, state, StatsUtils::INVALID_VALUE, uid);
+    }
+}
+
+bool BatteryStatsCore::GetStatsHistory(int64_t beginTimeMs, int64_t endTimeMs, BatteryStatsHistoryInfo& history)
+{
+    // A stale result is computed again, which records the consumption since the last record
+    GetStatsResult();
+    return history_.Query(beginTimeMs, endTimeMs, history);
+}
+
+std::vector<WakelockEntity::LockInfo> BatteryStatsCore::GetTopWakelocks(size_t count, int32_t uid)
+{
+    CoreLock lock(*this);
+    if (wakelockEntity_ == nullptr) {
+        return {};
+    }
+    return wakelockEntity_->GetTopLocks(count, uid);
+}
+
 void BatteryStatsCore::UpdateScreenStats(StatsUtils::StatsType statsType, StatsUtils::StatsState state, int16_t level)
 {
     STATS_HILOGD(COMP_SVC,
@@ -381,6 +672,7 @@ void BatteryStatsCore::UpdatePhoneStats(StatsUtils::StatsType statsType, StatsUt
             break;
         case StatsUtils::STATS_STATE_DEACTIVATED:
             timer->StopRunning();
+            JournalTimer(statsType, level);
             break;
         default:
             break;
@@ -408,16 +700,21 @@ void BatteryStatsCore::UpdateTimer(std::shared_ptr<BatteryStatsEntity> entity, S
         return;
     }
 
+    int32_t runningDelta = 0;
     switch (state) {
         case StatsUtils::STATS_STATE_ACTIVATED:
-            timer->StartRunning();
+            runningDelta = timer->StartRunning() ? 1 : 0;
             break;
         case StatsUtils::STATS_STATE_DEACTIVATED:
-            timer->StopRunning();
+            runningDelta = timer->StopRunning() ? -1 : 0;
+            JournalTimer(statsType, StatsUtils::INVALID_VALUE, uid);
             break;
         default:
             break;
     }
+    if (uid > StatsUtils::INVALID_VALUE) {
+        uidEntity_->MarkUidDirty(uid, entity->GetConsumptionType(), runningDelta);
+    }
 }
 
 void BatteryStatsCore::UpdateTimer(std::shared_ptr<BatteryStatsEntity> entity, StatsUtils::StatsType statsType,
@@ -441,6 +738,10 @@ void BatteryStatsCore::UpdateTimer(std::shared_ptr<BatteryStatsEntity> entity, S
         return;
     }
     timer->AddRunningTimeMs(time);
+    JournalTimer(statsType, StatsUtils::INVALID_VALUE, uid);
+    if (uid > StatsUtils::INVALID_VALUE) {
+        uidEntity_->MarkUidDirty(uid, entity->GetConsumptionType());
+    }
 }
 
 void BatteryStatsCore::UpdateCameraTimer(StatsUtils::StatsState state, int32_t uid, const std::string& deviceId)
@@ -459,9 +760,11 @@ void BatteryStatsCore::UpdateCameraTimer(StatsUtils::StatsState state, int32_t u
         return;
     }
 
+    int32_t runningDelta = 0;
     switch (state) {
         case StatsUtils::STATS_STATE_ACTIVATED: {
             if (timer->StartRunning()) {
+                runningDelta = 1;
                 isCameraOn_ = true;
                 lastCameraUid_ = uid;
             }
@@ -469,6 +772,10 @@ void BatteryStatsCore::UpdateCameraTimer(StatsUtils::StatsState state, int32_t u
         }
         case StatsUtils::STATS_STATE_DEACTIVATED: {
             if (timer->StopRunning()) {
+                runningDelta = -1;
+                if (uid > StatsUtils::INVALID_VALUE) {
+                    JournalTimer(StatsUtils::STATS_TYPE_CAMERA_ON, StatsUtils::INVALID_VALUE, uid);
+                }
                 UpdateTimer(flashlightEntity_,
                             StatsUtils::STATS_TYPE_FLASHLIGHT_ON,
                             StatsUtils::STATS_STATE_DEACTIVATED,
@@ -481,6 +788,9 @@ void BatteryStatsCore::UpdateCameraTimer(StatsUtils::StatsState state, int32_t u
         default:
             break;
     }
+    if (uid > StatsUtils::INVALID_VALUE && deviceId != "") {
+        uidEntity_->MarkUidDirty(uid, BatteryStatsInfo::CONSUMPTION_TYPE_CAMERA, runningDelta);
+    }
 }
 
 void BatteryStatsCore::UpdateScreenTimer(StatsUtils::StatsState state)
@@ -503,11 +813,14 @@ void BatteryStatsCore::UpdateScreenTimer(StatsUtils::StatsState state)
     } else if (state == StatsUtils::STATS_STATE_DEACTIVATED) {
         if (screenOnTimer != nullptr) {
             screenOnTimer->StopRunning();
+            JournalTimer(StatsUtils::STATS_TYPE_SCREEN_ON);
         }
         if (brightnessTimer != nullptr) {
             brightnessTimer->StopRunning();
+            JournalTimer(StatsUtils::STATS_TYPE_SCREEN_BRIGHTNESS, lastBrightnessLevel_);
         }
         isScreenOn_ = false;
+        RequestCpuSample(CpuTimeSampler::TRIGGER_SCREEN_OFF);
     }
 }
 
@@ -533,6 +846,7 @@ void BatteryStatsCore::UpdateBrightnessTimer(StatsUtils::StatsState state, int16
             STATS_HILOGI(COMP_SVC, "Stop screen brightness timer for last level: %{public}d",
                 lastBrightnessLevel_);
             oldBrightnessTimer->StopRunning();
+            JournalTimer(StatsUtils::STATS_TYPE_SCREEN_BRIGHTNESS, lastBrightnessLevel_);
         }
         if (newBrightnessTimer != nullptr) {
             STATS_HILOGI(COMP_SVC, "Start screen brightness timer for latest level: %{public}d", level);
@@ -563,10 +877,15 @@ void BatteryStatsCore::UpdateCounter(std::shared_ptr<BatteryStatsEntity> entity,
         return;
     }
     counter->AddCount(data);
+    JournalCounter(statsType, uid);
+    if (uid > StatsUtils::INVALID_VALUE) {
+        uidEntity_->MarkUidDirty(uid, entity->GetConsumptionType());
+    }
 }
 
 int64_t BatteryStatsCore::GetTotalTimeMs(StatsUtils::StatsType statsType, int16_t level)
 {
+    CoreLock lock(*this);
     STATS_HILOGD(COMP_SVC, "Handle statsType: %{public}s, level: %{public}d",
         StatsUtils::ConvertStatsType(statsType).c_str(), level);
     int64_t time = StatsUtils::DEFAULT_VALUE;
@@ -602,6 +921,7 @@ int64_t BatteryStatsCore::GetTotalTimeMs(StatsUtils::StatsType statsType, int16_
 
 void BatteryStatsCore::DumpInfo(std::string& result)
 {
+    CoreLock lock(*this);
     result.append("BATTERY STATS DUMP:\n");
     result.append("\n");
     if (bluetoothEntity_) {
@@ -628,26 +948,58 @@ void BatteryStatsCore::DumpInfo(std::string& result)
         uidEntity_->DumpInfo(result);
         result.append("\n");
     }
+    if (wakelockEntity_) {
+        wakelockEntity_->DumpInfo(result);
+        result.append("\n");
+    }
+    if (cpuSampler_) {
+        cpuSampler_->DumpInfo(result);
+        result.append("\n");
+    }
+    if (traffic_) {
+        traffic_->DumpInfo(result);
+        result.append("\n");
+    }
+    if (journal_) {
+        journal_->DumpInfo(result);
+        result.append("\n");
+    }
+    if (trace_) {
+        trace_->DumpInfo(result);
+        result.append("\n");
+    }
+    history_.DumpInfo(result);
+    result.append("\n");
+    result.append("Stats result: version = ")
+        .append(std::to_string(statsVersion_.load()))
+        .append(", hits = ")
+        .append(std::to_string(resultHitCount_.load()))
+        .append(", computes = ")
+        .append(std::to_string(resultComputeCount_.load()))
+        .append("\n\n");
     GetDebugInfo(result);
 }
 
 void BatteryStatsCore::UpdateDebugInfo(const std::string& info)
 {
-    std::lock_guard lock(mutex_);
-    debugInfo_.append(info);
+    StatsHelper::TimeBaseScope scope(timeBase_.get());
+    eventLog_.AppendText(info, StatsHelper::GetBootTimeMs());
+}
+
+void BatteryStatsCore::UpdateDebugInfo(const StatsUtils::StatsData& data)
+{
+    StatsHelper::TimeBaseScope scope(timeBase_.get());
+    eventLog_.Append(data, StatsHelper::GetBootTimeMs());
 }
 
 void BatteryStatsCore::GetDebugInfo(std::string& result)
 {
-    std::lock_guard lock(mutex_);
-    if (debugInfo_.size() > 0) {
-        result.append("Misc stats info dump:\n");
-        result.append(debugInfo_);
-    }
+    eventLog_.DumpInfo(result);
 }
 
 int64_t BatteryStatsCore::GetTotalTimeMs(int32_t uid, StatsUtils::StatsType statsType, int16_t level)
 {
+    CoreLock lock(*this);
     STATS_HILOGD(COMP_SVC, "Handle statsType: %{public}s, uid: %{public}d, level: %{public}d",
         StatsUtils::ConvertStatsType(statsType).c_str(), uid, level);
     int64_t time = StatsUtils::DEFAULT_VALUE;
@@ -692,13 +1044,28 @@ int64_t BatteryStatsCore::GetTotalTimeMs(int32_t uid, StatsUtils::StatsType stat
 
 int64_t BatteryStatsCore::GetTotalDataCount(StatsUtils::StatsType statsType, int32_t uid)
 {
-    STATS_HILOGD(COMP_SVC, "no traffic data bytes of %{public}s for uid: %{public}d",
-        StatsUtils::ConvertStatsType(statsType).c_str(), uid);
-    return StatsUtils::DEFAULT_VALUE;
+    CoreLock lock(*this);
+    int64_t data = StatsUtils::DEFAULT_VALUE;
+    switch (statsType) {
+        case StatsUtils::STATS_TYPE_WIFI_ON:
+        case StatsUtils::STATS_TYPE_WIFI_SCAN:
+            data = wifiEntity_->GetTrafficByte(statsType, uid);
+            break;
+        case StatsUtils::STATS_TYPE_PHONE_ACTIVE:
+        case StatsUtils::STATS_TYPE_PHONE_DATA:
+            data = phoneEntity_->GetTrafficByte(statsType, uid);
+            break;
+        default:
+            break;
+    }
+    STATS_HILOGD(COMP_SVC, "Get traffic data bytes: %{public}" PRId64 " of %{public}s for uid: %{public}d",
+        data, StatsUtils::ConvertStatsType(statsType).c_str(), uid);
+    return data;
 }
 
 int64_t BatteryStatsCore::GetTotalConsumptionCount(StatsUtils::StatsType statsType, int32_t uid)
 {
+    CoreLock lock(*this);
     int64_t data = StatsUtils::DEFAULT_VALUE;
     switch (statsType) {
         case StatsUtils::STATS_TYPE_WIFI_SCAN:
@@ -717,16 +1084,7 @@ int64_t BatteryStatsCore::GetTotalConsumptionCount(StatsUtils::StatsType statsTy
 
 double BatteryStatsCore::GetAppStatsMah(const int32_t& uid)
 {
-    double appStatsMah = StatsUtils::DEFAULT_VALUE;
-    auto statsInfoList = GetBatteryStats();
-    for (auto iter = statsInfoList.begin(); iter != statsInfoList.end(); iter++) {
-        if ((*iter)->GetConsumptionType() == BatteryStatsInfo::CONSUMPTION_TYPE_APP) {
-            if ((*iter)->GetUid() == uid) {
-                appStatsMah = (*iter)->GetPower();
-                break;
-            }
-        }
-    }
+    double appStatsMah = GetStatsResult()->GetAppPowerMah(uid);
     STATS_HILOGD(COMP_SVC, "Get stats mah: %{public}lf for uid: %{public}d", appStatsMah, uid);
     return appStatsMah;
 }
@@ -734,34 +1092,20 @@ double BatteryStatsCore::GetAppStatsMah(const int32_t& uid)
 double BatteryStatsCore::GetAppStatsPercent(const int32_t& uid)
 {
     double appStatsPercent = StatsUtils::DEFAULT_VALUE;
-    auto statsInfoList = GetBatteryStats();
-    auto totalConsumption = BatteryStatsEntity::GetTotalPowerMah();
+    auto result = GetStatsResult();
+    auto totalConsumption = result->GetTotalPowerMah();
     if (totalConsumption <= StatsUtils::DEFAULT_VALUE) {
         STATS_HILOGW(COMP_SVC, "No consumption got, return 0");
         return appStatsPercent;
     }
-    for (auto iter = statsInfoList.begin(); iter != statsInfoList.end(); iter++) {
-        if ((*iter)->GetConsumptionType() == BatteryStatsInfo::CONSUMPTION_TYPE_APP) {
-            if ((*iter)->GetUid() == uid && totalConsumption != StatsUtils::DEFAULT_VALUE) {
-                appStatsPercent = (*iter)->GetPower() / totalConsumption;
-                break;
-            }
-        }
-    }
+    appStatsPercent = result->GetAppPowerMah(uid) / totalConsumption;
     STATS_HILOGD(COMP_SVC, "Get stats percent: %{public}lf for uid: %{public}d", appStatsPercent, uid);
     return appStatsPercent;
 }
 
 double BatteryStatsCore::GetPartStatsMah(const BatteryStatsInfo::ConsumptionType& type)
 {
-    double partStatsMah = StatsUtils::DEFAULT_VALUE;
-    auto statsInfoList = GetBatteryStats();
-    for (auto iter = statsInfoList.begin(); iter != statsInfoList.end(); iter++) {
-        if ((*iter)->GetConsumptionType() == type) {
-            partStatsMah = (*iter)->GetPower();
-            break;
-        }
-    }
+    double partStatsMah = GetStatsResult()->GetPartPowerMah(type);
     STATS_HILOGD(COMP_SVC, "Get stats mah: %{public}lf for type: %{public}d", partStatsMah, type);
     return partStatsMah;
 }
@@ -769,13 +1113,10 @@ double BatteryStatsCore::GetPartStatsMah(const BatteryStatsInfo::ConsumptionType
 double BatteryStatsCore::GetPartStatsPercent(const BatteryStatsInfo::ConsumptionType& type)
 {
     double partStatsPercent = StatsUtils::DEFAULT_VALUE;
-    auto statsInfoList = GetBatteryStats();
-    auto totalConsumption = BatteryStatsEntity::GetTotalPowerMah();
-    for (auto iter = statsInfoList.begin(); iter != statsInfoList.end(); iter++) {
-        if ((*iter)->GetConsumptionType() == type && totalConsumption != StatsUtils::DEFAULT_VALUE) {
-            partStatsPercent = (*iter)->GetPower() / totalConsumption;
-            break;
-        }
+    auto result = GetStatsResult();
+    auto totalConsumption = result->GetTotalPowerMah();
+    if (totalConsumption != StatsUtils::DEFAULT_VALUE) {
+        partStatsPercent = result->GetPartPowerMah(type) / totalConsumption;
     }
     STATS_HILOGD(COMP_SVC, "Get stats percent: %{public}lf for type: %{public}d", partStatsPercent, type);
     return partStatsPercent;
@@ -1025,7 +1366,7 @@ void BatteryStatsCore::SaveForPower(cJSON* root)
         }
     }
 
-    auto statsInfoList = BatteryStatsEntity::GetStatsInfoList();
+    const auto& statsInfoList = sums_->statsInfoList;
     for (auto iter = statsInfoList.begin(); iter != statsInfoList.end(); iter++) {
         if ((*iter)->GetConsumptionType() == BatteryStatsInfo::CONSUMPTION_TYPE_APP) {
             std::string name = std::to_string((*iter)->GetUid());
@@ -1045,9 +1386,11 @@ void BatteryStatsCore::SaveForPower(cJSON* root)
     }
 }
 
-bool BatteryStatsCore::SaveBatteryStatsData()
+bool BatteryStatsCore::ExportBatteryStatsData(std::string& result)
 {
-    ComputePower();
+    FlushStatsEvents();
+    CoreLock lock(*this);
+    ComputePowerLocked();
     cJSON* root = cJSON_CreateObject();
     if (!root) {
         STATS_HILOGE(COMP_SVC, "Failed to create cJSON root object");
@@ -1070,34 +1413,97 @@ bool BatteryStatsCore::SaveBatteryStatsData()
         return false;
     }
     cJSON_Delete(root);
+    result.append(jsonStr).append("\n");
+    cJSON_free(jsonStr);
+    return true;
+}
 
-    FILE* fp = std::fopen(BATTERY_STATS_JSON.c_str(), "w");
-    if (!fp) {
-        STATS_HILOGE(COMP_SVC, "Opening json file failed");
-        cJSON_free(jsonStr);
-        return false;
+void BatteryStatsCore::SaveForSnapshot(BatteryStatsSnapshot& snapshot)
+{
+    StatsHelper::TimeSnapshot timeSnapshot;
+    const auto& statsInfoList = sums_->statsInfoList;
+    for (const auto& info : statsInfoList) {
+        if (info->GetConsumptionType() == BatteryStatsInfo::CONSUMPTION_TYPE_APP) {
+            snapshot.powers.emplace_back(info->GetUid(), info->GetPower());
+        } else if (info->GetConsumptionType() != BatteryStatsInfo::CONSUMPTION_TYPE_USER) {
+            snapshot.powers.emplace_back(info->GetConsumptionType(), info->GetPower());
+        }
+    }
+
+    // Only the part timers which have run are kept, most of the level bins stay empty
+    auto addPartValue = [&snapshot](StatsUtils::StatsType statsType, int16_t level, int64_t value) {
+        if (value > StatsUtils::DEFAULT_VALUE) {
+            snapshot.partValues.push_back({ statsType, level, value });
+        }
+    };
+    for (auto statsType : SNAPSHOT_PART_TIMER_TYPES) {
+        addPartValue(statsType, StatsUtils::INVALID_VALUE, GetTotalTimeMs(statsType));
+    }
+    for (uint16_t brightness = 0; brightness <= StatsUtils::SCREEN_BRIGHTNESS_BIN; brightness++) {
+        addPartValue(StatsUtils::STATS_TYPE_SCREEN_BRIGHTNESS, brightness,
+            GetTotalTimeMs(StatsUtils::STATS_TYPE_SCREEN_BRIGHTNESS, brightness));
+    }
+    for (uint16_t signal = 0; signal < StatsUtils::RADIO_SIGNAL_BIN; signal++) {
+        addPartValue(StatsUtils::STATS_TYPE_PHONE_ACTIVE, signal,
+            GetTotalTimeMs(StatsUtils::STATS_TYPE_PHONE_ACTIVE, signal));
+        addPartValue(StatsUtils::STATS_TYPE_PHONE_DATA, signal,
+            GetTotalTimeMs(StatsUtils::STATS_TYPE_PHONE_DATA, signal));
+    }
+    addPartValue(StatsUtils::STATS_TYPE_WIFI_SCAN, StatsUtils::INVALID_VALUE,
+        GetTotalConsumptionCount(StatsUtils::STATS_TYPE_WIFI_SCAN));
+
+    snapshot.uids = uidEntity_->GetUids();
+    for (auto statsType : SNAPSHOT_UID_TIMER_TYPES) {
+        BatteryStatsSnapshot::UidColumn column { statsType, {} };
+        column.values.reserve(snapshot.uids.size());
+        for (int32_t uid : snapshot.uids) {
+            column.values.push_back(GetTotalTimeMs(uid, statsType));
+        }
+        snapshot.uidColumns.push_back(std::move(column));
+    }
+    BatteryStatsSnapshot::UidColumn alarmColumn { StatsUtils::STATS_TYPE_ALARM, {} };
+    alarmColumn.values.reserve(snapshot.uids.size());
+    for (int32_t uid : snapshot.uids) {
+        alarmColumn.values.push_back(GetTotalConsumptionCount(StatsUtils::STATS_TYPE_ALARM, uid));
     }
+    snapshot.uidColumns.push_back(std::move(alarmColumn));
+}
 
-    auto len = fwrite(jsonStr, sizeof(char), strlen(jsonStr), fp);
-    std::fclose(fp);
-    if (len != strlen(jsonStr)) {
-        STATS_HILOGE(COMP_SVC, "Failed to write file");
-        cJSON_free(jsonStr);
+bool BatteryStatsCore::WriteSnapshot(size_t& snapshotBytes)
+{
+    FlushStatsEvents();
+    BatteryStatsSnapshot snapshot;
+    {
+        CoreLock lock(*this);
+        ComputePowerLocked();
+        SaveForSnapshot(snapshot);
+    }
+    if (!snapshot.SaveToFile(statsDir_ + BATTERY_STATS_SNAPSHOT, &snapshotBytes)) {
+        STATS_HILOGE(COMP_SVC, "Failed to save battery stats snapshot");
         return false;
     }
-    cJSON_free(jsonStr);
     return true;
 }
 
+bool BatteryStatsCore::SaveBatteryStatsData()
+{
+    // Compacting writes the snapshot and drops the journal records which it covers
+    if (journal_ != nullptr && journal_->IsRunning()) {
+        return journal_->Compact();
+    }
+    size_t snapshotBytes = 0;
+    return WriteSnapshot(snapshotBytes);
+}
+
 void BatteryStatsCore::UpdateStatsEntity(cJSON* root)
 {
-    BatteryStatsEntity::ResetStatsEntity();
     cJSON* powerObj = cJSON_GetObjectItemCaseSensitive(root, "Power");
     if (!StatsJsonUtils::IsValidJsonObjectOrJsonArray(powerObj)) {
         STATS_HILOGE(COMP_SVC, "Failed to get 'Power' object from json");
+        ResetSums();
         return;
     }
-    std::map<int32_t, double> tmpUserPowerMap;
+    std::vector<std::pair<int32_t, double>> powers;
     cJSON* currentElement = nullptr;
     cJSON_ArrayForEach(currentElement, powerObj) {
         const char* key = currentElement->string;
@@ -1109,14 +1515,24 @@ void BatteryStatsCore::UpdateStatsEntity(cJSON* root)
         if (!StatsUtils::ParseStrtollResult(keyStr, result)) {
             continue;
         }
-        auto id = static_cast<int32_t>(result);
+        powers.emplace_back(static_cast<int32_t>(result), currentElement->valuedouble);
+    }
+    RestorePower(powers);
+}
+
+void BatteryStatsCore::RestorePower(const std::vector<std::pair<int32_t, double>>& powers)
+{
+    ResetSums();
+    std::map<int32_t, double> tmpUserPowerMap;
+    for (const auto& [id, power] : powers) {
         int32_t usr = StatsUtils::INVALID_VALUE;
         std::shared_ptr<BatteryStatsInfo> info = std::make_shared<BatteryStatsInfo>();
         if (id > StatsUtils::INVALID_VALUE) {
             info->SetUid(id);
             info->SetConsumptioType(BatteryStatsInfo::CONSUMPTION_TYPE_APP);
-            info->SetPower(currentElement->valuedouble);
-            usr = AccountSA::OhosAccountKits::GetInstance().GetDeviceAccountIdByUID(id);
+            info->SetPower(power);
+            int32_t uid = id;
+            usr = AccountSA::OhosAccountKits::GetInstance().GetDeviceAccountIdByUID(uid);
             const auto& userPower = tmpUserPowerMap.find(usr);
             if (userPower != tmpUserPowerMap.end()) {
                 userPower->second += info->GetPower();
@@ -1126,23 +1542,195 @@ void BatteryStatsCore::UpdateStatsEntity(cJSON* root)
         } else if (id < StatsUtils::INVALID_VALUE && id > BatteryStatsInfo::CONSUMPTION_TYPE_INVALID) {
             info->SetUid(StatsUtils::INVALID_VALUE);
             info->SetConsumptioType(static_cast<BatteryStatsInfo::ConsumptionType>(id));
-            info->SetPower(currentElement->valuedouble);
+            info->SetPower(power);
         }
         STATS_HILOGD(COMP_SVC, "Load power:%{public}lfmAh,id:%{public}d,user:%{public}d", info->GetPower(), id, usr);
-        BatteryStatsEntity::UpdateStatsInfoList(info);
+        sums_->statsInfoList.push_back(info);
     }
     for (auto& iter : tmpUserPowerMap) {
         std::shared_ptr<BatteryStatsInfo> statsInfo = std::make_shared<BatteryStatsInfo>();
         statsInfo->SetConsumptioType(BatteryStatsInfo::CONSUMPTION_TYPE_USER);
         statsInfo->SetUserId(iter.first);
         statsInfo->SetPower(iter.second);
-        BatteryStatsEntity::UpdateStatsInfoList(statsInfo);
+        sums_->statsInfoList.push_back(statsInfo);
+    }
+}
+
+std::shared_ptr<BatteryStatsEntity> BatteryStatsCore::GetEntityForStatsType(StatsUtils::StatsType statsType)
+{
+    switch (statsType) {
+        case StatsUtils::STATS_TYPE_BLUETOOTH_BR_ON:
+        case StatsUtils::STATS_TYPE_BLUETOOTH_BLE_ON:
+        case StatsUtils::STATS_TYPE_BLUETOOTH_BR_SCAN:
+        case StatsUtils::STATS_TYPE_BLUETOOTH_BLE_SCAN:
+            return bluetoothEntity_;
+        case StatsUtils::STATS_TYPE_WIFI_ON:
+        case StatsUtils::STATS_TYPE_WIFI_SCAN:
+            return wifiEntity_;
+        case StatsUtils::STATS_TYPE_PHONE_ACTIVE:
+        case StatsUtils::STATS_TYPE_PHONE_DATA:
+            return phoneEntity_;
+        case StatsUtils::STATS_TYPE_PHONE_IDLE:
+        case StatsUtils::STATS_TYPE_CPU_SUSPEND:
+            return idleEntity_;
+        case StatsUtils::STATS_TYPE_SCREEN_ON:
+        case StatsUtils::STATS_TYPE_SCREEN_BRIGHTNESS:
+            return screenEntity_;
+        case StatsUtils::STATS_TYPE_CAMERA_ON:
+            return cameraEntity_;
+        case StatsUtils::STATS_TYPE_FLASHLIGHT_ON:
+            return flashlightEntity_;
+        case StatsUtils::STATS_TYPE_GNSS_ON:
+            return gnssEntity_;
+        case StatsUtils::STATS_TYPE_SENSOR_GRAVITY_ON:
+        case StatsUtils::STATS_TYPE_SENSOR_PROXIMITY_ON:
+            return sensorEntity_;
+        case StatsUtils::STATS_TYPE_AUDIO_ON:
+            return audioEntity_;
+        case StatsUtils::STATS_TYPE_WAKELOCK_HOLD:
+            return wakelockEntity_;
+        case StatsUtils::STATS_TYPE_ALARM:
+            return alarmEntity_;
+        default:
+            return nullptr;
+    }
+}
+
+void BatteryStatsCore::RestoreTimer(StatsUtils::StatsType statsType, int16_t level, int32_t uid, int64_t timeMs)
+{
+    auto entity = GetEntityForStatsType(statsType);
+    if (entity == nullptr || timeMs <= StatsUtils::DEFAULT_VALUE) {
+        return;
+    }
+    std::shared_ptr<StatsHelper::ActiveTimer> timer;
+    if (statsType == StatsUtils::STATS_TYPE_CAMERA_ON) {
+        timer = entity->GetOrCreateTimer(SNAPSHOT_CAMERA_DEVICE_ID, uid, statsType);
+    } else if (uid > StatsUtils::INVALID_VALUE) {
+        timer = entity->GetOrCreateTimer(uid, statsType);
+    } else {
+        timer = entity->GetOrCreateTimer(statsType, level);
+    }
+    if (timer != nullptr) {
+        timer->AddRunningTimeMs(timeMs);
+    }
+}
+
+void BatteryStatsCore::RestoreCounter(StatsUtils::StatsType statsType, int32_t uid, int64_t count)
+{
+    auto entity = GetEntityForStatsType(statsType);
+    if (entity == nullptr || count <= StatsUtils::DEFAULT_VALUE) {
+        return;
+    }
+    auto counter = entity->GetOrCreateCounter(statsType, uid);
+    if (counter != nullptr) {
+        counter->AddCount(count);
+    }
+}
+
+void BatteryStatsCore::RestoreFromSnapshot(const BatteryStatsSnapshot& snapshot)
+{
+    RestorePower(snapshot.powers);
+    for (const auto& partValue : snapshot.partValues) {
+        if (partValue.statsType == StatsUtils::STATS_TYPE_WIFI_SCAN) {
+            RestoreCounter(partValue.statsType, StatsUtils::INVALID_VALUE, partValue.value);
+        } else {
+            RestoreTimer(partValue.statsType, partValue.level, StatsUtils::INVALID_VALUE, partValue.value);
+        }
+    }
+    for (int32_t uid : snapshot.uids) {
+        uidEntity_->UpdateUidMap(uid);
+    }
+    for (const auto& column : snapshot.uidColumns) {
+        for (size_t i = 0; i < snapshot.uids.size(); i++) {
+            if (column.statsType == StatsUtils::STATS_TYPE_ALARM) {
+                RestoreCounter(column.statsType, snapshot.uids[i], column.values[i]);
+            } else {
+                RestoreTimer(column.statsType, StatsUtils::INVALID_VALUE, snapshot.uids[i], column.values[i]);
+            }
+        }
     }
+    STATS_HILOGI(COMP_SVC, "Restored battery stats snapshot, uids: %{public}zu", snapshot.uids.size());
+}
+
+int64_t BatteryStatsCore::GetTimerTotalMs(StatsUtils::StatsType statsType, int16_t level, int32_t uid)
+{
+    return uid > StatsUtils::INVALID_VALUE ? GetTotalTimeMs(uid, statsType) : GetTotalTimeMs(statsType, level);
+}
+
+void BatteryStatsCore::JournalTimer(StatsUtils::StatsType statsType, int16_t level, int32_t uid)
+{
+    if (journal_ == nullptr || !journal_->IsRunning()) {
+        return;
+    }
+    int64_t totalTimeMs = GetTimerTotalMs(statsType, level, uid);
+    if (totalTimeMs > StatsUtils::DEFAULT_VALUE) {
+        journal_->AppendTimer(statsType, level, uid, totalTimeMs);
+    }
+}
+
+void BatteryStatsCore::JournalCounter(StatsUtils::StatsType statsType, int32_t uid)
+{
+    if (journal_ == nullptr || !journal_->IsRunning()) {
+        return;
+    }
+    int64_t totalCount = GetTotalConsumptionCount(statsType, uid);
+    if (totalCount > StatsUtils::DEFAULT_VALUE) {
+        journal_->AppendCounter(statsType, uid, totalCount);
+    }
+}
+
+void BatteryStatsCore::ReplayJournal(const std::vector<BatteryStatsJournal::Record>& records)
+{
+    for (const auto& record : records) {
+        if (record.uid > StatsUtils::INVALID_VALUE) {
+            uidEntity_->UpdateUidMap(record.uid);
+        }
+        // Records hold absolute totals, only the part which is not restored yet is added
+        if (record.type == BatteryStatsJournal::RECORD_COUNTER) {
+            RestoreCounter(record.statsType, record.uid,
+                record.value - GetTotalConsumptionCount(record.statsType, record.uid));
+        } else {
+            RestoreTimer(record.statsType, record.level, record.uid,
+                record.value - GetTimerTotalMs(record.statsType, record.level, record.uid));
+        }
+    }
+    STATS_HILOGI(COMP_SVC, "Replayed battery stats journal, records: %{public}zu", records.size());
 }
 
 bool BatteryStatsCore::LoadBatteryStatsData()
 {
-    std::ifstream ifs(BATTERY_STATS_JSON, std::ios::binary);
+    auto beginTime = std::chrono::steady_clock::now();
+    CoreLock lock(*this);
+    std::vector<BatteryStatsJournal::Record> records;
+    bool hasReset = false;
+    bool hasJournal = BatteryStatsJournal::Replay(statsDir_ + BATTERY_STATS_JOURNAL, records, hasReset);
+    bool ret = false;
+    // The snapshot holds the stats before the reset, only the records behind the reset are valid
+    if (!hasReset) {
+        BatteryStatsSnapshot snapshot;
+        if (snapshot.LoadFromFile(statsDir_ + BATTERY_STATS_SNAPSHOT)) {
+            RestoreFromSnapshot(snapshot);
+            ret = true;
+        } else {
+            // The json file is only read to migrate the stats saved before the binary snapshot existed
+            ret = LoadBatteryStatsJson();
+        }
+    }
+    if (hasJournal) {
+        ReplayJournal(records);
+        ret = true;
+    }
+    statsVersion_.fetch_add(1, std::memory_order_relaxed);
+    if (journal_ != nullptr) {
+        journal_->SetReplayTimeUs(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - beginTime).count());
+    }
+    return ret;
+}
+
+bool BatteryStatsCore::LoadBatteryStatsJson()
+{
+    std::ifstream ifs(statsDir_ + BATTERY_STATS_JSON, std::ios::binary);
     if (!ifs.is_open()) {
         STATS_HILOGE(COMP_SVC, "Json file doesn't exist");
         return false;
@@ -1184,24 +1772,41 @@ bool BatteryStatsCore::LoadBatteryStatsData()
 
 void BatteryStatsCore::Reset()
 {
-    std::lock_guard lock(mutex_);
-    audioEntity_->Reset();
-    bluetoothEntity_->Reset();
-    cameraEntity_->Reset();
-    cpuEntity_->Reset();
-    flashlightEntity_->Reset();
-    gnssEntity_->Reset();
-    idleEntity_->Reset();
-    phoneEntity_->Reset();
-    screenEntity_->Reset();
-    sensorEntity_->Reset();
-    uidEntity_->Reset();
-    userEntity_->Reset();
-    wifiEntity_->Reset();
-    wakelockEntity_->Reset();
-    alarmEntity_->Reset();
-    BatteryStatsEntity::ResetStatsEntity();
-    debugInfo_.clear();
+    FlushStatsEvents();
+    bool isJournaled = false;
+    {
+        CoreLock lock(*this);
+        audioEntity_->Reset();
+        bluetoothEntity_->Reset();
+        cameraEntity_->Reset();
+        cpuEntity_->Reset();
+        flashlightEntity_->Reset();
+        gnssEntity_->Reset();
+        idleEntity_->Reset();
+        phoneEntity_->Reset();
+        screenEntity_->Reset();
+        sensorEntity_->Reset();
+        uidEntity_->Reset();
+        userEntity_->Reset();
+        wifiEntity_->Reset();
+        wakelockEntity_->Reset();
+        alarmEntity_->Reset();
+        // The wakelocks held go on counting from zero
+        for (int32_t uid : wakelockEntity_->GetHoldingUids()) {
+            uidEntity_->MarkUidDirty(uid, BatteryStatsInfo::CONSUMPTION_TYPE_WAKELOCK, 1);
+        }
+        ResetSums();
+        eventLog_.Clear();
+        history_.Rebase();
+        statsVersion_.fetch_add(1, std::memory_order_relaxed);
+        // Under the lock, so no record of the stats before the reset lands behind it and none after it before it
+        isJournaled = journal_ != nullptr && journal_->AppendReset();
+    }
+    // A reset drops every earlier record, it has to be durable before new stats arrive. Flushed outside of the
+    // lock, a running compaction holds the journal and takes the lock to compute the power
+    if (isJournaled) {
+        journal_->Flush();
+    }
 }
 } // namespace PowerMgr
 } // namespace OHOS
@@ -45,7 +45,20 @@ void BatteryStatsDetector::HandleStatsChangedEvent(StatsUtils::StatsData data)
         return;
     }
     auto core = bss->GetBatteryStatsCore();
-    if (IsDurationRelated(data.type)) {
+    if (core == nullptr) {
+        STATS_HILOGE(COMP_SVC, "Get battery stats core failed");
+        return;
+    }
+    core->RecordTraceEvent(data);
+    Dispatch(core, data);
+}
+
+void BatteryStatsDetector::Dispatch(const std::shared_ptr<BatteryStatsCore>& core, const StatsUtils::StatsData& data)
+{
+    if (data.type == StatsUtils::STATS_TYPE_WAKELOCK_HOLD) {
+        // The lock name is kept as well, so the time can be told apart per lock
+        core->UpdateWakelockStats(data.state, data.uid, data.eventDataName);
+    } else if (IsDurationRelated(data.type)) {
         // Update related timer with reported time
         // The traffic won't participate the power consumption calculation, just for dump info
         core->UpdateStats(data.type, data.time, data.traffic, data.uid);
@@ -53,7 +66,7 @@ void BatteryStatsDetector::HandleStatsChangedEvent(StatsUtils::StatsData data)
         // Update related timer based on state or level
         core->UpdateStats(data.type, data.state, data.level, data.uid, data.deviceId);
     }
-    HandleDebugInfo(data);
+    core->UpdateDebugInfo(data);
 }
 
 bool BatteryStatsDetector::IsDurationRelated(StatsUtils::StatsType type)
@@ -102,171 +115,5 @@ bool BatteryStatsDetector::IsStateRelated(StatsUtils::StatsType type)
     }
     return isMatch;
 }
-
-void BatteryStatsDetector::HandleThermalInfo(StatsUtils::StatsData data, int64_t bootTimeMs, std::string& debugInfo)
-{
-    debugInfo.append("Thermal event: Boot time after boot = ")
-        .append(ToString(bootTimeMs))
-        .append("ms\n");
-    if (!data.eventDebugInfo.empty()) {
-        debugInfo.append("Additional debug info: ")
-            .append(data.eventDebugInfo)
-            .append("\n");
-    }
-}
-
-void BatteryStatsDetector::HandleBatteryInfo(StatsUtils::StatsData data, int64_t bootTimeMs, std::string& debugInfo)
-{
-    debugInfo.append("Battery event: Battery level = ")
-        .append(ToString(data.level))
-        .append(", Charger type = ")
-        .append(ToString(data.eventDataExtra))
-        .append(", boot time after boot = ")
-        .append(ToString(bootTimeMs))
-        .append("ms\n");
-    if (!data.eventDebugInfo.empty()) {
-        debugInfo.append("Additional debug info: ")
-            .append(data.eventDebugInfo);
-    }
-}
-
-void BatteryStatsDetector::HandleDisplayInfo(StatsUtils::StatsData data, int64_t bootTimeMs, std::string& debugInfo)
-{
-    debugInfo.append("Dislpay event: Boot time after boot = ")
-        .append(ToString(bootTimeMs))
-        .append("ms\n");
-    if (!data.eventDebugInfo.empty()) {
-        debugInfo.append("Additional debug info: ")
-            .append(data.eventDebugInfo)
-            .append("\n");
-    }
-}
-
-void BatteryStatsDetector::HandleWakelockInfo(StatsUtils::StatsData data, int64_t bootTimeMs, std::string& debugInfo)
-{
-    debugInfo.append("\n")
-        .append("Wakelock event: UID = ")
-        .append(ToString(data.uid))
-        .append(", PID = ")
-        .append(ToString(data.pid))
-        .append(", wakelock type = ")
-        .append(ToString(data.eventDataType))
-        .append(", wakelock name = ")
-        .append(data.eventDataName)
-        .append(", boot time after boot = ")
-        .append(ToString(bootTimeMs))
-        .append("ms\n");
-    if (!data.eventDebugInfo.empty()) {
-        debugInfo.append("Additional debug info: ")
-            .append(data.eventDebugInfo);
-    }
-}
-
-void BatteryStatsDetector::HandleWorkschedulerInfo(StatsUtils::StatsData data, int64_t bootTimeMs,
-    std::string& debugInfo)
-{
-    debugInfo.append("WorkScheduler event: UID = ")
-        .append(ToString(data.uid))
-        .append(", PID = ")
-        .append(ToString(data.pid))
-        .append(", work type = ")
-        .append(ToString(data.eventDataType))
-        .append(", work interval = ")
-        .append(ToString(data.eventDataExtra))
-        .append(", work state = ")
-        .append(ToString(data.state))
-        .append(", boot time after boot = ")
-        .append(ToString(bootTimeMs))
-        .append("ms\n");
-    if (!data.eventDebugInfo.empty()) {
-        debugInfo.append("Additional debug info: ")
-            .append(data.eventDebugInfo);
-    }
-}
-
-void BatteryStatsDetector::HandlePhoneInfo(StatsUtils::StatsData data, int64_t bootTimeMs, std::string& debugInfo)
-{
-    debugInfo.append("Phone event: Boot time after boot = ")
-        .append(ToString(bootTimeMs))
-        .append("ms\n");
-    if (!data.eventDebugInfo.empty()) {
-        debugInfo.append("Additional debug info: ")
-            .append(data.eventDebugInfo)
-            .append("\n");
-    }
-}
-
-void BatteryStatsDetector::HandleFlashlightInfo(StatsUtils::StatsData data, int64_t bootTimeMs, std::string& debugInfo)
-{
-    std::string eventState;
-    if (data.state == StatsUtils::STATS_STATE_ACTIVATED) {
-        eventState = "ON";
-    } else {
-        eventState = "OFF";
-    }
-    debugInfo.append("Flashlight event: UID = ")
-        .append(ToString(data.uid))
-        .append(", PID = ")
-        .append(ToString(data.pid))
-        .append(", flashlight state = ")
-        .append(eventState)
-        .append(", boot time after boot = ")
-        .append(ToString(bootTimeMs))
-        .append("ms\n");
-}
-
-void BatteryStatsDetector::HandleDistributedSchedulerInfo(StatsUtils::StatsData data, int64_t bootTimeMs,
-    std::string& debugInfo)
-{
-    debugInfo.append("Distributed schedule event")
-        .append(", boot time after boot = ")
-        .append(ToString(bootTimeMs))
-        .append("ms\n");
-    if (!data.eventDebugInfo.empty()) {
-        debugInfo.append("Additional debug info: ")
-            .append(data.eventDebugInfo)
-            .append("\n");
-    }
-}
-
-void BatteryStatsDetector::HandleDebugInfo(StatsUtils::StatsData data)
-{
-    int64_t bootTimeMs = StatsHelper::GetBootTimeMs();
-    auto core = BatteryStatsService::GetInstance()->GetBatteryStatsCore();
-    std::string debugInfo;
-    switch (data.type) {
-        case StatsUtils::STATS_TYPE_THERMAL:
-            HandleThermalInfo(data, bootTimeMs, debugInfo);
-            break;
-        case StatsUtils::STATS_TYPE_BATTERY:
-            HandleBatteryInfo(data, bootTimeMs, debugInfo);
-            break;
-        case StatsUtils::STATS_TYPE_WORKSCHEDULER:
-            HandleWorkschedulerInfo(data, bootTimeMs, debugInfo);
-            break;
-        case StatsUtils::STATS_TYPE_WAKELOCK_HOLD:
-            HandleWakelockInfo(data, bootTimeMs, debugInfo);
-            break;
-        case StatsUtils::STATS_TYPE_DISPLAY:
-        case StatsUtils::STATS_TYPE_SCREEN_ON:
-        case StatsUtils::STATS_TYPE_SCREEN_BRIGHTNESS:
-            HandleDisplayInfo(data, bootTimeMs, debugInfo);
-            break;
-        case StatsUtils::STATS_TYPE_PHONE_ACTIVE:
-        case StatsUtils::STATS_TYPE_PHONE_DATA:
-            HandlePhoneInfo(data, bootTimeMs, debugInfo);
-            break;
-        case StatsUtils::STATS_TYPE_FLASHLIGHT_ON:
-            HandleFlashlightInfo(data, bootTimeMs, debugInfo);
-            break;
-        case StatsUtils::STATS_TYPE_DISTRIBUTEDSCHEDULER:
-            HandleDistributedSchedulerInfo(data, bootTimeMs, debugInfo);
-            break;
-        default:
-            STATS_HILOGD(COMP_SVC, "Invalid type");
-            break;
-    }
-    core->UpdateDebugInfo(debugInfo);
-}
 } // namespace PowerMgr
 } // namespace OHOS
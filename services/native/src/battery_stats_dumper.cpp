@@ -15,6 +15,8 @@
 
 #include "battery_stats_dumper.h"
 
+#include <iterator>
+
 #include "battery_stats_service.h"
 #include "stats_common.h"
 
@@ -24,6 +26,10 @@ namespace {
 constexpr const char* ARGS_HELP = "-h";
 constexpr const char* ARGS_STATS = "-batterystats";
 constexpr const char* ARGS_POWER_AVERAGE = "-poweraverage";
+constexpr const char* ARGS_EXPORT = "-export";
+constexpr const char* ARGS_TRACE = "-trace";
+constexpr const char* TRACE_START = "start";
+constexpr const char* TRACE_STOP = "stop";
 }
 
 bool BatteryStatsDumper::Dump(const std::vector<std::string>& args, std::string& result)
@@ -45,12 +51,34 @@ bool BatteryStatsDumper::Dump(const std::vector<std::string>& args, std::string&
                 continue;
             }
             core->DumpInfo(result);
+            auto eventQueue = bss->GetBatteryStatsEventQueue();
+            if (eventQueue != nullptr) {
+                eventQueue->DumpInfo(result);
+            }
         } else if (*it == ARGS_POWER_AVERAGE) {
             auto parser = bss->GetBatteryStatsParser();
             if (parser == nullptr) {
                 continue;
             }
             parser->DumpInfo(result);
+        } else if (*it == ARGS_EXPORT) {
+            auto core = bss->GetBatteryStatsCore();
+            if (core == nullptr) {
+                continue;
+            }
+            core->ExportBatteryStatsData(result);
+        } else if (*it == ARGS_TRACE) {
+            auto core = bss->GetBatteryStatsCore();
+            if (core == nullptr || std::next(it) == args.end()) {
+                continue;
+            }
+            it++;
+            if (*it == TRACE_START) {
+                result.append(core->StartTrace() ? "Trace recording started\n" : "Trace recording start failed\n");
+            } else if (*it == TRACE_STOP) {
+                core->StopTrace();
+                result.append("Trace recording stopped\n");
+            }
         }
     }
     return true;
@@ -63,7 +91,10 @@ void BatteryStatsDumper::ShowUsage(std::string& result)
         "command list:\n"
         "  -h              :    Show this help menu. \n"
         "  -batterystats   :    Show all the information of battery stats.\n"
-        "  -poweraverage   :    Show all the information of power average configuration.\n";
+        "  -poweraverage   :    Show all the information of power average configuration.\n"
+        "  -export         :    Export the battery stats in json format.\n"
+        "  -trace start    :    Start recording the stats events for a replay.\n"
+        "  -trace stop     :    Stop recording the stats events.\n";
     result.append(HELP_COMMAND_MSG);
 }
 } // namespace PowerMgr
@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_stats_event_log.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "stats_log.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+void AppendBootTime(const BatteryStatsEventLog::Record& record, std::string& result)
+{
+    result.append("boot time after boot = ")
+        .append(std::to_string(record.bootTimeMs))
+        .append("ms\n");
+}
+
+void AppendUidPid(const BatteryStatsEventLog::Record& record, std::string& result)
+{
+    result.append("UID = ")
+        .append(std::to_string(record.uid))
+        .append(", PID = ")
+        .append(std::to_string(record.pid));
+}
+
+void AppendInfo(const BatteryStatsEventLog::Record& record, std::string& result)
+{
+    if (record.infoSize > 0) {
+        result.append("Additional debug info: ")
+            .append(record.text + record.nameSize, record.infoSize)
+            .append("\n");
+    }
+}
+} // namespace
+
+BatteryStatsEventLog::BatteryStatsEventLog(size_t capacity) : records_(std::max<size_t>(capacity, 1)) {}
+
+bool BatteryStatsEventLog::IsLogged(StatsUtils::StatsType type)
+{
+    switch (type) {
+        case StatsUtils::STATS_TYPE_THERMAL:
+        case StatsUtils::STATS_TYPE_BATTERY:
+        case StatsUtils::STATS_TYPE_WORKSCHEDULER:
+        case StatsUtils::STATS_TYPE_WAKELOCK_HOLD:
+        case StatsUtils::STATS_TYPE_DISPLAY:
+        case StatsUtils::STATS_TYPE_SCREEN_ON:
+        case StatsUtils::STATS_TYPE_SCREEN_BRIGHTNESS:
+        case StatsUtils::STATS_TYPE_PHONE_ACTIVE:
+        case StatsUtils::STATS_TYPE_PHONE_DATA:
+        case StatsUtils::STATS_TYPE_FLASHLIGHT_ON:
+        case StatsUtils::STATS_TYPE_DISTRIBUTEDSCHEDULER:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool BatteryStatsEventLog::FillText(Record& record, std::string_view name, std::string_view info)
+{
+    size_t nameSize = std::min(name.size(), NAME_SIZE);
+    size_t infoSize = std::min(info.size(), TEXT_SIZE - nameSize);
+    std::memcpy(record.text, name.data(), nameSize);
+    std::memcpy(record.text + nameSize, info.data(), infoSize);
+    record.nameSize = static_cast<uint8_t>(nameSize);
+    record.infoSize = static_cast<uint8_t>(infoSize);
+    return nameSize < name.size() || infoSize < info.size();
+}
+
+bool BatteryStatsEventLog::Append(const StatsUtils::StatsData& data, int64_t bootTimeMs)
+{
+    if (!IsLogged(data.type)) {
+        STATS_HILOGD(COMP_SVC, "Invalid type");
+        return false;
+    }
+    Record record {};
+    record.bootTimeMs = bootTimeMs;
+    record.uid = data.uid;
+    record.pid = data.pid;
+    record.dataType = data.eventDataType;
+    record.dataExtra = data.eventDataExtra;
+    record.level = data.level;
+    record.type = static_cast<int8_t>(data.type);
+    record.state = static_cast<int8_t>(data.state);
+    // Only the wakelock event shows its name, the flashlight event shows no debug info
+    std::string_view name;
+    std::string_view info = data.eventDebugInfo;
+    if (data.type == StatsUtils::STATS_TYPE_WAKELOCK_HOLD) {
+        name = data.eventDataName;
+    } else if (data.type == StatsUtils::STATS_TYPE_FLASHLIGHT_ON) {
+        info = std::string_view();
+    }
+    bool truncated = FillText(record, name, info);
+    Push(record, truncated);
+    return true;
+}
+
+void BatteryStatsEventLog::AppendText(std::string_view text, int64_t bootTimeMs)
+{
+    if (text.empty()) {
+        return;
+    }
+    Record record {};
+    record.bootTimeMs = bootTimeMs;
+    record.type = static_cast<int8_t>(StatsUtils::STATS_TYPE_INVALID);
+    bool truncated = FillText(record, "", text);
+    Push(record, truncated);
+}
+
+void BatteryStatsEventLog::Push(const Record& record, bool truncated)
+{
+    std::lock_guard lock(mutex_);
+    records_[head_] = record;
+    head_ = (head_ + 1) % records_.size();
+    if (size_ < records_.size()) {
+        size_++;
+    } else {
+        droppedCount_++;
+    }
+    if (truncated) {
+        truncatedCount_++;
+    }
+}
+
+void BatteryStatsEventLog::Clear()
+{
+    std::lock_guard lock(mutex_);
+    head_ = 0;
+    size_ = 0;
+    droppedCount_ = 0;
+    truncatedCount_ = 0;
+}
+
+void BatteryStatsEventLog::SetCapacity(size_t capacity)
+{
+    std::lock_guard lock(mutex_);
+    records_.assign(std::max<size_t>(capacity, 1), Record {});
+    head_ = 0;
+    size_ = 0;
+    droppedCount_ = 0;
+    truncatedCount_ = 0;
+}
+
+size_t BatteryStatsEventLog::GetSize() const
+{
+    std::lock_guard lock(mutex_);
+    return size_;
+}
+
+size_t BatteryStatsEventLog::GetCapacity() const
+{
+    return records_.size();
+}
+
+uint64_t BatteryStatsEventLog::GetDroppedCount() const
+{
+    std::lock_guard lock(mutex_);
+    return droppedCount_;
+}
+
+uint64_t BatteryStatsEventLog::GetTruncatedCount() const
+{
+    std::lock_guard lock(mutex_);
+    return truncatedCount_;
+}
+
+void BatteryStatsEventLog::DumpInfo(std::string& result) const
+{
+    std::vector<Record> records;
+    uint64_t droppedCount = 0;
+    uint64_t truncatedCount = 0;
+    {
+        // Copy out under the lock, the text is formatted without holding it
+        std::lock_guard lock(mutex_);
+        records.reserve(size_);
+        size_t oldest = (head_ + records_.size() - size_) % records_.size();
+        for (size_t i = 0; i < size_; i++) {
+            records.push_back(records_[(oldest + i) % records_.size()]);
+        }
+        droppedCount = droppedCount_;
+        truncatedCount = truncatedCount_;
+    }
+    if (records.empty()) {
+        return;
+    }
+    result.append("Misc stats info dump: events = ")
+        .append(std::to_string(records.size()))
+        .append(", capacity = ")
+        .append(std::to_string(records_.size()))
+        .append(", dropped = ")
+        .append(std::to_string(droppedCount))
+        .append(", truncated = ")
+        .append(std::to_string(truncatedCount))
+        .append("\n");
+    for (const auto& record : records) {
+        FormatRecord(record, result);
+    }
+}
+
+void BatteryStatsEventLog::FormatRecord(const Record& record, std::string& result)
+{
+    switch (static_cast<StatsUtils::StatsType>(record.type)) {
+        case StatsUtils::STATS_TYPE_THERMAL:
+            result.append("Thermal event: ");
+            break;
+        case StatsUtils::STATS_TYPE_BATTERY:
+            result.append("Battery event: Battery level = ")
+                .append(std::to_string(record.level))
+                .append(", Charger type = ")
+                .append(std::to_string(record.dataExtra))
+                .append(", ");
+            break;
+        case StatsUtils::STATS_TYPE_WORKSCHEDULER:
+            result.append("WorkScheduler event: ");
+            AppendUidPid(record, result);
+            result.append(", work type = ")
+                .append(std::to_string(record.dataType))
+                .append(", work interval = ")
+                .append(std::to_string(record.dataExtra))
+                .append(", work state = ")
+                .append(std::to_string(record.state))
+                .append(", ");
+            break;
+        case StatsUtils::STATS_TYPE_WAKELOCK_HOLD:
+            result.append("Wakelock event: ");
+            AppendUidPid(record, result);
+            result.append(", wakelock type = ")
+                .append(std::to_string(record.dataType))
+                .append(", wakelock name = ")
+                .append(record.text, record.nameSize)
+                .append(", ");
+            break;
+        case StatsUtils::STATS_TYPE_DISPLAY:
+        case StatsUtils::STATS_TYPE_SCREEN_ON:
+        case StatsUtils::STATS_TYPE_SCREEN_BRIGHTNESS:
+            result.append("Display event: ");
+            break;
+        case StatsUtils::STATS_TYPE_PHONE_ACTIVE:
+        case StatsUtils::STATS_TYPE_PHONE_DATA:
+            result.append("Phone event: ");
+            break;
+        case StatsUtils::STATS_TYPE_FLASHLIGHT_ON:
+            result.append("Flashlight event: ");
+            AppendUidPid(record, result);
+            result.append(", flashlight state = ")
+                .append(record.state == StatsUtils::STATS_STATE_ACTIVATED ? "ON" : "OFF")
+                .append(", ");
+            break;
+        case StatsUtils::STATS_TYPE_DISTRIBUTEDSCHEDULER:
+            result.append("Distributed schedule event, ");
+            break;
+        default:
+            // Free text, shown as it was given
+            result.append(record.text + record.nameSize, record.infoSize);
+            return;
+    }
+    AppendBootTime(record, result);
+    AppendInfo(record, result);
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_stats_event_queue.h"
+
+#include <chrono>
+#include <algorithm>
+#include <cinttypes>
+#include <pthread.h>
+
+#include "string_ex.h"
+
+#include "stats_helper.h"
+#include "stats_log.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr uint32_t MIN_CAPACITY = 2;
+constexpr int64_t CONSUMER_WAIT_MS = 10;
+constexpr const char* CONSUMER_THREAD_NAME = "StatsEventQueue";
+}
+
+BatteryStatsEventQueue::BatteryStatsEventQueue(uint32_t capacity)
+{
+    // Round the capacity up to a power of two so that the slot index is a simple mask
+    capacity_ = MIN_CAPACITY;
+    while (capacity_ < capacity) {
+        capacity_ <<= 1;
+    }
+    mask_ = capacity_ - 1;
+    slots_ = std::make_unique<Slot[]>(capacity_);
+    for (uint32_t i = 0; i < capacity_; i++) {
+        slots_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    STATS_HILOGI(COMP_SVC, "BatteryStatsEventQueue instance is created, capacity: %{public}u", capacity_);
+}
+
+BatteryStatsEventQueue::~BatteryStatsEventQueue()
+{
+    Stop();
+}
+
+bool BatteryStatsEventQueue::Start(const EventHandler& handler)
+{
+    if (running_.load()) {
+        STATS_HILOGD(COMP_SVC, "Event queue is already running");
+        return true;
+    }
+    if (handler == nullptr) {
+        STATS_HILOGE(COMP_SVC, "Event handler is null, start event queue failed");
+        return false;
+    }
+    handler_ = handler;
+    running_.store(true);
+    consumer_ = std::thread([this] { ConsumerLoop(); });
+    pthread_setname_np(consumer_.native_handle(), CONSUMER_THREAD_NAME);
+    STATS_HILOGI(COMP_SVC, "Event queue is started");
+    return true;
+}
+
+void BatteryStatsEventQueue::Stop()
+{
+    if (!running_.exchange(false)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+        waitCond_.notify_one();
+    }
+    if (consumer_.joinable()) {
+        consumer_.join();
+    }
+    STATS_HILOGI(COMP_SVC, "Event queue is stopped, applied: %{public}" PRIu64 ", dropped: %{public}" PRIu64 "",
+        appliedCount_.load(), dropCount_.load());
+}
+
+bool BatteryStatsEventQueue::IsRunning() const
+{
+    return running_.load();
+}
+
+bool BatteryStatsEventQueue::Push(StatsUtils::StatsData data)
+{
+    uint64_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Slot* slot = nullptr;
+    while (true) {
+        slot = &slots_[pos & mask_];
+        uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            dropCount_.fetch_add(1, std::memory_order_relaxed);
+            STATS_HILOGW(COMP_SVC, "Event queue is full, drop %{public}s event",
+                StatsUtils::ConvertStatsType(data.type).c_str());
+            return false;
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+    slot->event.data = std::move(data);
+    slot->event.enqueueTimeUs = GetSteadyTimeUs();
+    slot->event.bootTimeMs = StatsHelper::GetBootTimeMs();
+    slot->event.upTimeMs = StatsHelper::GetUpTimeMs();
+    slot->sequence.store(pos + 1);
+
+    if (consumerWaiting_.load()) {
+        std::lock_guard<std::mutex> lock(waitMutex_);
+        waitCond_.notify_one();
+    }
+    return true;
+}
+
+bool BatteryStatsEventQueue::Pop(std::vector<Event>& batch)
+{
+    uint64_t pos = dequeuePos_.load(std::memory_order_relaxed);
+    while (batch.size() < MAX_BATCH_SIZE) {
+        Slot& slot = slots_[pos & mask_];
+        if (slot.sequence.load() != pos + 1) {
+            // Empty, or the producer which claimed this slot has not published it yet
+            break;
+        }
+        batch.push_back(std::move(slot.event));
+        slot.sequence.store(pos + capacity_, std::memory_order_release);
+        pos++;
+    }
+    dequeuePos_.store(pos, std::memory_order_release);
+    return !batch.empty();
+}
+
+void BatteryStatsEventQueue::ConsumerLoop()
+{
+    std::vector<Event> batch;
+    batch.reserve(MAX_BATCH_SIZE);
+    while (true) {
+        if (Pop(batch)) {
+            ApplyBatch(batch);
+            continue;
+        }
+        RunSyncTask();
+        if (!running_.load()) {
+            // Exit once every claimed slot is applied, a producer may have claimed one and not published it yet
+            if (dequeuePos_.load(std::memory_order_relaxed) == enqueuePos_.load()) {
+                break;
+            }
+            std::this_thread::yield();
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(waitMutex_);
+        consumerWaiting_.store(true);
+        waitCond_.wait_for(lock, std::chrono::milliseconds(CONSUMER_WAIT_MS), [this] {
+            uint64_t pos = dequeuePos_.load(std::memory_order_relaxed);
+            return !running_.load() || syncPending_.load() || slots_[pos & mask_].sequence.load() == pos + 1;
+        });
+        consumerWaiting_.store(false);
+    }
+}
+
+void BatteryStatsEventQueue::ApplyBatch(std::vector<Event>& batch)
+{
+    for (auto& event : batch) {
+        // Producers racing for slots may stamp them out of order, the time never goes back for the timers
+        lastBootTimeMs_ = std::max(lastBootTimeMs_, event.bootTimeMs);
+        lastUpTimeMs_ = std::max(lastUpTimeMs_, event.upTimeMs);
+        {
+            StatsHelper::TimeSnapshot eventTime(lastBootTimeMs_, lastUpTimeMs_);
+            handler_(event.data);
+        }
+        UpdateApplyLatency(GetSteadyTimeUs() - event.enqueueTimeUs);
+    }
+    appliedCount_.fetch_add(batch.size());
+    batch.clear();
+
+    std::lock_guard<std::mutex> lock(flushMutex_);
+    flushCond_.notify_all();
+}
+
+bool BatteryStatsEventQueue::Flush(int64_t timeoutMs)
+{
+    if (!running_.load() || std::this_thread::get_id() == consumer_.get_id()) {
+        return false;
+    }
+    uint64_t target = enqueuePos_.load();
+    // Readers mostly find the queue drained, let them pass without touching the flush lock
+    if (appliedCount_.load() >= target) {
+        return true;
+    }
+    std::unique_lock<std::mutex> lock(flushMutex_);
+    bool ret = flushCond_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this, target] {
+        return appliedCount_.load() >= target || !running_.load();
+    });
+    if (!ret) {
+        STATS_HILOGW(COMP_SVC, "Flush event queue timeout, depth: %{public}" PRIu64 "", GetDepth());
+    }
+    return ret;
+}
+
+bool BatteryStatsEventQueue::Sync(const SyncTask& task, int64_t timeoutMs)
+{
+    if (task == nullptr || !running_.load() || std::this_thread::get_id() == consumer_.get_id()) {
+        return false;
+    }
+    std::lock_guard<std::mutex> syncLock(syncMutex_);
+    std::unique_lock<std::mutex> lock(flushMutex_);
+    syncTask_ = task;
+    syncTarget_ = enqueuePos_.load();
+    syncState_ = SYNC_PENDING;
+    syncPending_.store(true);
+    {
+        std::lock_guard<std::mutex> waitLock(waitMutex_);
+        waitCond_.notify_one();
+    }
+    flushCond_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this] {
+        return syncState_ == SYNC_DONE || !running_.load();
+    });
+    // A task which already runs is waited for, the caller may rely on what it publishes
+    flushCond_.wait(lock, [this] { return syncState_ != SYNC_RUNNING; });
+    bool ret = syncState_ == SYNC_DONE;
+    if (!ret) {
+        STATS_HILOGW(COMP_SVC, "Sync event queue failed, depth: %{public}" PRIu64 "", GetDepth());
+    }
+    syncState_ = SYNC_IDLE;
+    syncTask_ = nullptr;
+    syncPending_.store(false);
+    return ret;
+}
+
+void BatteryStatsEventQueue::RunSyncTask()
+{
+    if (!syncPending_.load()) {
+        return;
+    }
+    SyncTask task;
+    {
+        std::lock_guard<std::mutex> lock(flushMutex_);
+        if (syncState_ != SYNC_PENDING || appliedCount_.load() < syncTarget_) {
+            return;
+        }
+        syncState_ = SYNC_RUNNING;
+        task = syncTask_;
+    }
+    task();
+    std::lock_guard<std::mutex> lock(flushMutex_);
+    syncState_ = SYNC_DONE;
+    syncPending_.store(false);
+    flushCond_.notify_all();
+}
+
+void BatteryStatsEventQueue::UpdateApplyLatency(int64_t latencyUs)
+{
+    lastApplyLatencyUs_.store(latencyUs, std::memory_order_relaxed);
+    totalApplyLatencyUs_.fetch_add(latencyUs, std::memory_order_relaxed);
+    if (latencyUs > maxApplyLatencyUs_.load(std::memory_order_relaxed)) {
+        // Only the consumer thread updates the latency, no need to compare and exchange
+        maxApplyLatencyUs_.store(latencyUs, std::memory_order_relaxed);
+    }
+}
+
+uint32_t BatteryStatsEventQueue::GetCapacity() const
+{
+    return capacity_;
+}
+
+uint64_t BatteryStatsEventQueue::GetDepth() const
+{
+    uint64_t enqueuePos = enqueuePos_.load();
+    uint64_t appliedCount = appliedCount_.load();
+    return enqueuePos > appliedCount ? enqueuePos - appliedCount : 0;
+}
+
+uint64_t BatteryStatsEventQueue::GetDropCount() const
+{
+    return dropCount_.load();
+}
+
+uint64_t BatteryStatsEventQueue::GetAppliedCount() const
+{
+    return appliedCount_.load();
+}
+
+int64_t BatteryStatsEventQueue::GetLastApplyLatencyUs() const
+{
+    return lastApplyLatencyUs_.load();
+}
+
+int64_t BatteryStatsEventQueue::GetMaxApplyLatencyUs() const
+{
+    return maxApplyLatencyUs_.load();
+}
+
+int64_t BatteryStatsEventQueue::GetAverageApplyLatencyUs() const
+{
+    uint64_t appliedCount = appliedCount_.load();
+    if (appliedCount == 0) {
+        return StatsUtils::DEFAULT_VALUE;
+    }
+    return totalApplyLatencyUs_.load() / static_cast<int64_t>(appliedCount);
+}
+
+
+void BatteryStatsEventQueue::DumpInfo(std::string& result)
+{
+    result.append("Stats event queue: capacity = ")
+        .append(ToString(capacity_))
+        .append(", depth = ")
+        .append(ToString(GetDepth()))
+        .append(", applied = ")
+        .append(ToString(GetAppliedCount()))
+        .append(", dropped = ")
+        .append(ToString(GetDropCount()))
+        .append("\n")
+        .append("Apply latency: last = ")
+        .append(ToString(GetLastApplyLatencyUs()))
+        .append("us, average = ")
+        .append(ToString(GetAverageApplyLatencyUs()))
+        .append("us, max = ")
+        .append(ToString(GetMaxApplyLatencyUs()))
+        .append("us\n");
+}
+
+int64_t BatteryStatsEventQueue::GetSteadyTimeUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_stats_history.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "stats_log.h"
+#include "stats_utils.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+int64_t GetBucket(int64_t timeMs, int64_t bucketSpanMs)
+{
+    return std::max<int64_t>(timeMs, 0) / bucketSpanMs;
+}
+} // namespace
+
+BatteryStatsHistory::BatteryStatsHistory() : BatteryStatsHistory(Config {}) {}
+
+BatteryStatsHistory::BatteryStatsHistory(const Config& config) : config_(config)
+{
+    rings_[0].tier = config_.fine;
+    rings_[1].tier = config_.coarse;
+    for (auto& ring : rings_) {
+        ring.tier.bucketSpanMs = std::max<int64_t>(ring.tier.bucketSpanMs, 1);
+        ring.tier.bucketCount = std::max<size_t>(ring.tier.bucketCount, 1);
+    }
+    ClearLocked();
+}
+
+size_t BatteryStatsHistory::Advance(Ring& ring, int64_t timeMs)
+{
+    const size_t count = ring.tier.bucketCount;
+    // A wall clock set back keeps adding to the latest bucket
+    int64_t bucket = std::max(GetBucket(timeMs, ring.tier.bucketSpanMs), ring.lastBucket);
+    if (bucket > ring.lastBucket) {
+        int64_t first = std::max(ring.lastBucket + 1, bucket - static_cast<int64_t>(count) + 1);
+        size_t columns = ring.uidMah.size() / count;
+        for (int64_t id = first; id <= bucket; id++) {
+            size_t slot = static_cast<size_t>(id) % count;
+            ring.bucketIds[slot] = id;
+            ring.totalMah[slot] = 0.0f;
+            for (size_t part = 0; part < PART_COUNT; part++) {
+                ring.partMah[part * count + slot] = 0.0f;
+            }
+            for (size_t column = 0; column < columns; column++) {
+                ring.uidMah[column * count + slot] = 0.0f;
+            }
+        }
+        ring.lastBucket = bucket;
+    }
+    return static_cast<size_t>(bucket) % count;
+}
+
+bool BatteryStatsHistory::IsColumnEmptyLocked(size_t column) const
+{
+    for (const auto& ring : rings_) {
+        auto begin = ring.uidMah.begin() + column * ring.tier.bucketCount;
+        if (std::any_of(begin, begin + ring.tier.bucketCount, [](float value) { return value != 0.0f; })) {
+            return false;
+        }
+    }
+    return true;
+}
+
+size_t BatteryStatsHistory::GetColumnLocked(int32_t uid)
+{
+    auto iter = uidColumns_.find(uid);
+    if (iter != uidColumns_.end()) {
+        return iter->second;
+    }
+    if (columnUids_.size() <= config_.maxUids) {
+        size_t column = columnUids_.size();
+        columnUids_.push_back(uid);
+        uidColumns_.emplace(uid, column);
+        for (auto& ring : rings_) {
+            ring.uidMah.resize(ring.uidMah.size() + ring.tier.bucketCount, 0.0f);
+        }
+        return column;
+    }
+    // Full, take over the column of a uid whose buckets have all aged out
+    for (size_t column = OTHER_COLUMN + 1; column < columnUids_.size(); column++) {
+        if (IsColumnEmptyLocked(column)) {
+            uidColumns_.erase(columnUids_[column]);
+            columnUids_[column] = uid;
+            uidColumns_.emplace(uid, column);
+            return column;
+        }
+    }
+    if (overflowCount_++ == 0) {
+        STATS_HILOGW(COMP_SVC, "History uid columns are full, max uids: %{public}zu", config_.maxUids);
+    }
+    return OTHER_COLUMN;
+}
+
+void BatteryStatsHistory::Record(int64_t timeMs, const BatteryStatsResult& result)
+{
+    std::array<double, PART_COUNT> partMah {};
+    std::unordered_map<int32_t, double> appMah;
+    for (const auto& info : result.GetStatsInfoList()) {
+        auto type = info->GetConsumptionType();
+        if (type == BatteryStatsInfo::CONSUMPTION_TYPE_APP) {
+            appMah.emplace(info->GetUid(), info->GetPower());
+        } else if (type > BatteryStatsInfo::CONSUMPTION_TYPE_APP && type <= BatteryStatsInfo::CONSUMPTION_TYPE_ALARM) {
+            partMah[type - BatteryStatsInfo::CONSUMPTION_TYPE_APP] += info->GetPower();
+        }
+    }
+    double totalMah = result.GetTotalPowerMah();
+
+    std::lock_guard lock(mutex_);
+    if (hasBaseline_) {
+        std::array<size_t, TIER_COUNT> slots {};
+        for (size_t i = 0; i < TIER_COUNT; i++) {
+            slots[i] = Advance(rings_[i], timeMs);
+        }
+        // The totals only grow between resets, a smaller value is a rounding difference
+        auto addDelta = [this, &slots](double current, double last, auto&& cell) {
+            double delta = current - last;
+            if (delta <= 0.0) {
+                return;
+            }
+            for (size_t i = 0; i < TIER_COUNT; i++) {
+                cell(rings_[i], slots[i]) += static_cast<float>(delta);
+            }
+        };
+        addDelta(totalMah, lastTotalMah_, [](Ring& ring, size_t slot) -> float& { return ring.totalMah[slot]; });
+        for (size_t part = 0; part < PART_COUNT; part++) {
+            addDelta(partMah[part], lastPartMah_[part], [part](Ring& ring, size_t slot) -> float& {
+                return ring.partMah[part * ring.tier.bucketCount + slot];
+            });
+        }
+        for (const auto& [uid, mah] : appMah) {
+            auto last = lastAppMah_.find(uid);
+            double lastMah = last != lastAppMah_.end() ? last->second : 0.0;
+            if (mah <= lastMah) {
+                continue;
+            }
+            size_t column = GetColumnLocked(uid);
+            addDelta(mah, lastMah, [column](Ring& ring, size_t slot) -> float& {
+                return ring.uidMah[column * ring.tier.bucketCount + slot];
+            });
+        }
+    }
+    hasBaseline_ = true;
+    lastRecordTimeMs_ = timeMs;
+    lastTotalMah_ = totalMah;
+    lastPartMah_ = partMah;
+    lastAppMah_ = std::move(appMah);
+    recordCount_++;
+}
+
+void BatteryStatsHistory::Rebase()
+{
+    std::lock_guard lock(mutex_);
+    hasBaseline_ = true;
+    lastTotalMah_ = 0.0;
+    lastPartMah_.fill(0.0);
+    lastAppMah_.clear();
+}
+
+bool BatteryStatsHistory::IsRecordDue(int64_t timeMs) const
+{
+    std::lock_guard lock(mutex_);
+    if (lastRecordTimeMs_ < 0 || timeMs < lastRecordTimeMs_) {
+        return true;
+    }
+    int64_t spanMs = rings_[0].tier.bucketSpanMs;
+    return GetBucket(timeMs, spanMs) != GetBucket(lastRecordTimeMs_, spanMs);
+}
+
+bool BatteryStatsHistory::Query(int64_t beginTimeMs, int64_t endTimeMs, BatteryStatsHistoryInfo& history) const
+{
+    history = BatteryStatsHistoryInfo {};
+    if (endTimeMs <= beginTimeMs) {
+        return false;
+    }
+    std::lock_guard lock(mutex_);
+    const Ring* ring = &rings_[TIER_COUNT - 1];
+    for (const auto& candidate : rings_) {
+        int64_t oldest = candidate.lastBucket - static_cast<int64_t>(candidate.tier.bucketCount) + 1;
+        if (GetBucket(beginTimeMs, candidate.tier.bucketSpanMs) >= oldest) {
+            ring = &candidate;
+            break;
+        }
+    }
+    const size_t count = ring->tier.bucketCount;
+    const int64_t spanMs = ring->tier.bucketSpanMs;
+    history.bucketSpanMs = spanMs;
+    if (ring->lastBucket < 0 || endTimeMs <= 0) {
+        return true;
+    }
+    int64_t first = std::max(GetBucket(beginTimeMs, spanMs), ring->lastBucket - static_cast<int64_t>(count) + 1);
+    int64_t last = std::min(GetBucket(endTimeMs - 1, spanMs), ring->lastBucket);
+    std::array<double, PART_COUNT> partMah {};
+    std::vector<double> columnMah(columnUids_.size(), 0.0);
+    for (int64_t id = first; id <= last; id++) {
+        size_t slot = static_cast<size_t>(id) % count;
+        if (ring->bucketIds[slot] != id) {
+            continue;
+        }
+        history.bucketStartMs.push_back(id * spanMs);
+        history.totalPowerMah.push_back(ring->totalMah[slot]);
+        for (size_t part = 0; part < PART_COUNT; part++) {
+            partMah[part] += ring->partMah[part * count + slot];
+        }
+        for (size_t column = 0; column < columnMah.size(); column++) {
+            columnMah[column] += ring->uidMah[column * count + slot];
+        }
+    }
+    for (size_t part = 0; part < PART_COUNT; part++) {
+        if (partMah[part] > 0.0) {
+            history.consumptionTypes.push_back(static_cast<BatteryStatsInfo::ConsumptionType>(
+                BatteryStatsInfo::CONSUMPTION_TYPE_APP + static_cast<int32_t>(part)));
+            history.partPowerMah.push_back(partMah[part]);
+        }
+    }
+    std::vector<std::pair<double, int32_t>> apps;
+    for (size_t column = 0; column < columnMah.size(); column++) {
+        if (columnMah[column] > 0.0) {
+            apps.emplace_back(columnMah[column], columnUids_[column]);
+        }
+    }
+    std::sort(apps.begin(), apps.end(), [](const auto& lhs, const auto& rhs) { return lhs.first > rhs.first; });
+    for (const auto& [mah, uid] : apps) {
+        history.uids.push_back(uid);
+        history.appPowerMah.push_back(mah);
+    }
+    return true;
+}
+
+void BatteryStatsHistory::Clear()
+{
+    std::lock_guard lock(mutex_);
+    ClearLocked();
+}
+
+void BatteryStatsHistory::ClearLocked()
+{
+    for (auto& ring : rings_) {
+        const size_t count = ring.tier.bucketCount;
+        ring.lastBucket = -1;
+        ring.bucketIds.assign(count, -1);
+        ring.totalMah.assign(count, 0.0f);
+        ring.partMah.assign(PART_COUNT * count, 0.0f);
+        ring.uidMah.assign(count, 0.0f);
+    }
+    columnUids_.assign(1, StatsUtils::INVALID_VALUE);
+    uidColumns_.clear();
+    hasBaseline_ = false;
+    lastRecordTimeMs_ = -1;
+    lastTotalMah_ = 0.0;
+    lastPartMah_.fill(0.0);
+    lastAppMah_.clear();
+    recordCount_ = 0;
+    overflowCount_ = 0;
+}
+
+void BatteryStatsHistory::DumpInfo(std::string& result) const
+{
+    std::lock_guard lock(mutex_);
+    result.append("Stats history: records = ")
+        .append(std::to_string(recordCount_))
+        .append(", uids = ")
+        .append(std::to_string(columnUids_.size() - 1))
+        .append("/")
+        .append(std::to_string(config_.maxUids))
+        .append(", overflow = ")
+        .append(std::to_string(overflowCount_));
+    for (const auto& ring : rings_) {
+        result.append(", ")
+            .append(std::to_string(ring.tier.bucketCount))
+            .append(" x ")
+            .append(std::to_string(ring.tier.bucketSpanMs))
+            .append("ms");
+    }
+    result.append("\n");
+}
+} // namespace PowerMgr
+} // namespace OHOS
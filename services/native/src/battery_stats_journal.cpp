@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_stats_journal.h"
+
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "string_ex.h"
+
+#include "battery_stats_codec.h"
+#include "stats_log.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr size_t FRAME_HEADER_SIZE = sizeof(uint32_t) * 2;
+constexpr size_t MAX_JOURNAL_SIZE = 16 * 1024 * 1024;
+constexpr mode_t JOURNAL_FILE_MODE = S_IRUSR | S_IWUSR | S_IRGRP;
+constexpr const char* WRITER_THREAD_NAME = "StatsJournal";
+
+bool DecodeRecord(BatteryStatsCodec::Reader& reader, BatteryStatsJournal::Record& record)
+{
+    uint64_t type = 0;
+    if (!reader.GetVarint(type)) {
+        return false;
+    }
+    record = BatteryStatsJournal::Record();
+    record.type = static_cast<BatteryStatsJournal::RecordType>(type);
+    if (record.type == BatteryStatsJournal::RECORD_RESET) {
+        return true;
+    }
+    if (record.type != BatteryStatsJournal::RECORD_TIMER && record.type != BatteryStatsJournal::RECORD_COUNTER) {
+        return false;
+    }
+    int64_t statsType = 0;
+    int64_t level = 0;
+    int64_t uid = 0;
+    if (!reader.GetSignedVarint(statsType) || !reader.GetSignedVarint(level) || !reader.GetSignedVarint(uid) ||
+        !reader.GetSignedVarint(record.value)) {
+        return false;
+    }
+    record.statsType = static_cast<StatsUtils::StatsType>(statsType);
+    record.level = static_cast<int16_t>(level);
+    record.uid = static_cast<int32_t>(uid);
+    return true;
+}
+
+bool ReadJournalFile(const std::string& path, std::string& buffer)
+{
+    size_t fileSize = 0;
+    if (!BatteryStatsCodec::ReadFile(path, MAX_JOURNAL_SIZE, buffer, fileSize)) {
+        return false;
+    }
+    if (fileSize > MAX_JOURNAL_SIZE) {
+        STATS_HILOGW(COMP_SVC, "Journal is too large: %{public}zu, only replay the head", fileSize);
+    }
+    return true;
+}
+
+// Returns the size of the intact frames, everything behind a torn or corrupted frame is ignored
+size_t ParseFrames(const std::string& buffer, std::vector<BatteryStatsJournal::Record>& records, bool& hasReset)
+{
+    records.clear();
+    hasReset = false;
+    std::vector<BatteryStatsJournal::Record> frameRecords;
+    BatteryStatsCodec::Reader reader(reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size());
+    while (reader.GetRemaining() >= FRAME_HEADER_SIZE) {
+        uint32_t payloadSize = 0;
+        uint32_t payloadCrc = 0;
+        reader.GetFixed32(payloadSize);
+        reader.GetFixed32(payloadCrc);
+        const uint8_t* payload = reader.GetPosition();
+        if (payloadSize > reader.GetRemaining() || BatteryStatsCodec::Crc32(payload, payloadSize) != payloadCrc) {
+            return buffer.size() - reader.GetRemaining() - FRAME_HEADER_SIZE;
+        }
+        BatteryStatsCodec::Reader frameReader(payload, payloadSize);
+        frameRecords.clear();
+        while (frameReader.GetRemaining() > 0) {
+            BatteryStatsJournal::Record record;
+            if (!DecodeRecord(frameReader, record)) {
+                return buffer.size() - reader.GetRemaining() - FRAME_HEADER_SIZE;
+            }
+            frameRecords.push_back(record);
+        }
+        reader.Skip(payloadSize);
+        for (const auto& record : frameRecords) {
+            if (record.type == BatteryStatsJournal::RECORD_RESET) {
+                records.clear();
+                hasReset = true;
+            } else {
+                records.push_back(record);
+            }
+        }
+    }
+    return buffer.size() - reader.GetRemaining();
+}
+} // namespace
+
+BatteryStatsJournal::BatteryStatsJournal(const std::string& path) : BatteryStatsJournal(path, Config()) {}
+
+BatteryStatsJournal::BatteryStatsJournal(const std::string& path, const Config& config)
+    : path_(path), config_(config)
+{
+    STATS_HILOGI(COMP_SVC, "BatteryStatsJournal instance is created, flush interval: %{public}" PRId64 "ms",
+        config_.flushIntervalMs);
+}
+
+BatteryStatsJournal::~BatteryStatsJournal()
+{
+    Stop();
+}
+
+bool BatteryStatsJournal::Start(const CompactHandler& handler)
+{
+    if (running_.load()) {
+        STATS_HILOGD(COMP_SVC, "Journal is already running");
+        return true;
+    }
+    if (handler == nullptr) {
+        STATS_HILOGE(COMP_SVC, "Compact handler is null, start journal failed");
+        return false;
+    }
+    fd_ = open(path_.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, JOURNAL_FILE_MODE);
+    if (fd_ < 0) {
+        STATS_HILOGE(COMP_SVC, "Opening journal file failed, errno: %{public}d", errno);
+        return false;
+    }
+    // Appending behind a torn frame would hide every new frame from the replay, cut the torn tail first
+    std::string buffer;
+    std::vector<Record> records;
+    bool hasReset = false;
+    size_t validSize = ReadJournalFile(path_, buffer) ? ParseFrames(buffer, records, hasReset) : 0;
+    if (validSize < buffer.size() && ftruncate(fd_, static_cast<off_t>(validSize)) != 0) {
+        STATS_HILOGE(COMP_SVC, "Truncating torn journal failed, errno: %{public}d", errno);
+        validSize = buffer.size();
+    }
+    fileSize_.store(validSize);
+    compactHandler_ = handler;
+    running_.store(true);
+    writer_ = std::thread([this] { WriterLoop(); });
+    pthread_setname_np(writer_.native_handle(), WRITER_THREAD_NAME);
+    STATS_HILOGI(COMP_SVC, "Journal is started, size: %{public}zu", fileSize_.load());
+    return true;
+}
+
+void BatteryStatsJournal::Stop()
+{
+    if (!running_.exchange(false)) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        pendingCond_.notify_one();
+    }
+    if (writer_.joinable()) {
+        writer_.join();
+    }
+    std::lock_guard<std::mutex> lock(ioMutex_);
+    FlushLocked();
+    close(fd_);
+    fd_ = -1;
+    STATS_HILOGI(COMP_SVC, "Journal is stopped, frames: %{public}" PRIu64 ", compactions: %{public}" PRIu64 "",
+        frameCount_.load(), compactCount_.load());
+}
+
+bool BatteryStatsJournal::IsRunning() const
+{
+    return running_.load();
+}
+
+void BatteryStatsJournal::AppendTimer(StatsUtils::StatsType statsType, int16_t level, int32_t uid,
+    int64_t totalTimeMs)
+{
+    AppendRecord({ RECORD_TIMER, statsType, level, uid, totalTimeMs });
+}
+
+void BatteryStatsJournal::AppendCounter(StatsUtils::StatsType statsType, int32_t uid, int64_t totalCount)
+{
+    AppendRecord({ RECORD_COUNTER, statsType, StatsUtils::INVALID_VALUE, uid, totalCount });
+}
+
+bool BatteryStatsJournal::AppendReset()
+{
+    if (!running_.load()) {
+        return false;
+    }
+    AppendRecord({ RECORD_RESET });
+    return true;
+}
+
+void BatteryStatsJournal::AppendRecord(const Record& record)
+{
+    if (!running_.load()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(pendingMutex_);
+    size_t oldSize = pending_.size();
+    BatteryStatsCodec::PutVarint(pending_, record.type);
+    if (record.type != RECORD_RESET) {
+        BatteryStatsCodec::PutSignedVarint(pending_, record.statsType);
+        BatteryStatsCodec::PutSignedVarint(pending_, record.level);
+        BatteryStatsCodec::PutSignedVarint(pending_, record.uid);
+        BatteryStatsCodec::PutSignedVarint(pending_, record.value);
+    }
+    recordBytes_.fetch_add(pending_.size() - oldSize, std::memory_order_relaxed);
+    if (pending_.size() >= config_.flushThresholdBytes) {
+        pendingCond_.notify_one();
+    }
+}
+
+void BatteryStatsJournal::WriterLoop()
+{
+    while (running_.load()) {
+        {
+            std::unique_lock<std::mutex> lock(pendingMutex_);
+            pendingCond_.wait_for(lock, std::chrono::milliseconds(config_.flushIntervalMs), [this] {
+                return !running_.load() || pending_.size() >= config_.flushThresholdBytes;
+            });
+        }
+        std::lock_guard<std::mutex> lock(ioMutex_);
+        FlushLocked();
+        if (fileSize_.load() >= config_.compactThresholdBytes) {
+            CompactLocked();
+        }
+    }
+}
+
+bool BatteryStatsJournal::Flush()
+{
+    std::lock_guard<std::mutex> lock(ioMutex_);
+    return FlushLocked();
+}
+
+bool BatteryStatsJournal::FlushLocked()
+{
+    if (fd_ < 0) {
+        return false;
+    }
+    frame_.assign(FRAME_HEADER_SIZE, '\0');
+    {
+        // Group commit: every record buffered since the last flush goes into one frame and one sync
+        std::lock_guard<std::mutex> lock(pendingMutex_);
+        if (pending_.empty()) {
+            return true;
+        }
+        frame_.append(pending_);
+        pending_.clear();
+    }
+    size_t payloadSize = frame_.size() - FRAME_HEADER_SIZE;
+    BatteryStatsCodec::SetFixed32(frame_, 0, static_cast<uint32_t>(payloadSize));
+    BatteryStatsCodec::SetFixed32(frame_, sizeof(uint32_t),
+        BatteryStatsCodec::Crc32(reinterpret_cast<const uint8_t*>(frame_.data()) + FRAME_HEADER_SIZE, payloadSize));
+    if (!BatteryStatsCodec::WriteAll(fd_, frame_) || fdatasync(fd_) != 0) {
+        STATS_HILOGE(COMP_SVC, "Writing journal frame failed, errno: %{public}d", errno);
+        failCount_.fetch_add(1);
+        // Cut a partially written frame, otherwise every frame behind it would be unreadable
+        if (ftruncate(fd_, static_cast<off_t>(fileSize_.load())) != 0) {
+            STATS_HILOGE(COMP_SVC, "Truncating journal failed, errno: %{public}d", errno);
+        }
+        return false;
+    }
+    fileSize_.fetch_add(frame_.size());
+    journalBytesWritten_.fetch_add(frame_.size());
+    frameCount_.fetch_add(1);
+    return true;
+}
+
+bool BatteryStatsJournal::Compact()
+{
+    std::lock_guard<std::mutex> lock(ioMutex_);
+    return CompactLocked();
+}
+
+bool BatteryStatsJournal::CompactLocked()
+{
+    if (fd_ < 0) {
+        return false;
+    }
+    // The records which arrive while the snapshot is written stay pending and land in the truncated journal
+    FlushLocked();
+    size_t snapshotBytes = 0;
+    if (!compactHandler_(snapshotBytes)) {
+        STATS_HILOGE(COMP_SVC, "Writing snapshot failed, keep the journal");
+        failCount_.fetch_add(1);
+        return false;
+    }
+    snapshotBytesWritten_.fetch_add(snapshotBytes);
+    compactCount_.fetch_add(1);
+    if (ftruncate(fd_, 0) != 0) {
+        // Still consistent, the records left in the journal are covered by the snapshot
+        STATS_HILOGE(COMP_SVC, "Truncating journal failed, errno: %{public}d", errno);
+        failCount_.fetch_add(1);
+        return false;
+    }
+    fileSize_.store(0);
+    STATS_HILOGD(COMP_SVC, "Compacted journal, snapshot size: %{public}zu", snapshotBytes);
+    return true;
+}
+
+bool BatteryStatsJournal::Replay(const std::string& path, std::vector<Record>& records, bool& hasReset)
+{
+    std::string buffer;
+    if (!ReadJournalFile(path, buffer)) {
+        records.clear();
+        hasReset = false;
+        STATS_HILOGW(COMP_SVC, "Journal file doesn't exist");
+        return false;
+    }
+    size_t validSize = ParseFrames(buffer, records, hasReset);
+    if (validSize < buffer.size()) {
+        STATS_HILOGW(COMP_SVC, "Journal frame is torn or corrupted, drop %{public}zu bytes",
+            buffer.size() - validSize);
+    }
+    return true;
+}
+
+void BatteryStatsJournal::SetReplayTimeUs(int64_t replayTimeUs)
+{
+    replayTimeUs_.store(replayTimeUs);
+}
+
+uint64_t BatteryStatsJournal::GetRecordBytes() const
+{
+    return recordBytes_.load();
+}
+
+uint64_t BatteryStatsJournal::GetJournalBytesWritten() const
+{
+    return journalBytesWritten_.load();
+}
+
+uint64_t BatteryStatsJournal::GetSnapshotBytesWritten() const
+{
+    return snapshotBytesWritten_.load();
+}
+
+uint64_t BatteryStatsJournal::GetCompactCount() const
+{
+    return compactCount_.load();
+}
+
+double BatteryStatsJournal::GetWriteAmplification() const
+{
+    uint64_t recordBytes = GetRecordBytes();
+    if (recordBytes == 0) {
+        return StatsUtils::DEFAULT_VALUE;
+    }
+    return static_cast<double>(GetJournalBytesWritten() + GetSnapshotBytesWritten()) / recordBytes;
+}
+
+void BatteryStatsJournal::DumpInfo(std::string& result)
+{
+    result.append("Stats journal: size = ")
+        .append(ToString(fileSize_.load()))
+        .append(", frames = ")
+        .append(ToString(frameCount_.load()))
+        .append(", compactions = ")
+        .append(ToString(GetCompactCount()))
+        .append(", failures = ")
+        .append(ToString(failCount_.load()))
+        .append("\n")
+        .append("Journal writes: record bytes = ")
+        .append(ToString(GetRecordBytes()))
+        .append(", journal bytes = ")
+        .append(ToString(GetJournalBytesWritten()))
+        .append(", snapshot bytes = ")
+        .append(ToString(GetSnapshotBytesWritten()))
+        .append(", write amplification = ")
+        .append(std::to_string(GetWriteAmplification()))
+        .append("\n")
+        .append("Journal replay time: ")
+        .append(ToString(replayTimeUs_.load()))
+        .append("us\n");
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -35,8 +35,8 @@
 #endif
 
 #include "battery_stats_service.h"
-#include "stats_cjson_utils.h"
 #include "stats_hisysevent.h"
+#include "stats_json_view.h"
 #include "stats_log.h"
 #include "stats_types.h"
 
@@ -54,109 +54,142 @@ void BatteryStatsListener::OnEvent(std::shared_ptr<HiviewDFX::HiSysEventRecord>
     std::string eventName = sysEvent->GetEventName();
     std::string eventDetail = sysEvent->AsJson();
     STATS_HILOGD(COMP_SVC, "EventDetail: %{public}s", eventDetail.c_str());
-    if (!StatsHiSysEvent::CheckHiSysEvent(eventName)) {
+    StatsHiSysEvent::HiSysEventType eventType = StatsHiSysEvent::GetHiSysEventType(eventName);
+    if (eventType == StatsHiSysEvent::HISYSEVENT_TYPE_INVALID) {
         return;
     }
 
-    cJSON* root = cJSON_Parse(eventDetail.c_str());
-    if (root != nullptr) {
-        if (!cJSON_IsObject(root)) {
-            STATS_HILOGD(COMP_SVC, "json root is not an object");
-            cJSON_Delete(root);
-            return;
-        }
-        ProcessHiSysEvent(eventName, root);
-        cJSON_Delete(root);
-    } else {
+    // Index the top-level fields in place instead of building a cJSON tree for every event
+    StatsJsonView root(eventDetail);
+    if (!root.IsValid()) {
         STATS_HILOGW(COMP_SVC, "Parse hisysevent data failed");
+        return;
     }
+    ProcessHiSysEvent(eventType, root);
 }
 
-void BatteryStatsListener::ProcessHiSysEvent(const std::string& eventName, const cJSON* root)
+const BatteryStatsListener::EventTable& BatteryStatsListener::GetEventTable()
+{
+    static const EventTable table = [] {
+        EventTable eventTable {};
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_POWER_RUNNINGLOCK] = {
+            StatsUtils::STATS_TYPE_WAKELOCK_HOLD, &BatteryStatsListener::ProcessWakelockEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_SCREEN_STATE] = {
+            StatsUtils::STATS_TYPE_SCREEN_ON, &BatteryStatsListener::ProcessDisplayEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_BRIGHTNESS_NIT] = {
+            StatsUtils::STATS_TYPE_SCREEN_BRIGHTNESS, &BatteryStatsListener::ProcessDisplayEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_BACKLIGHT_DISCOUNT] = {
+            StatsUtils::STATS_TYPE_DISPLAY, &BatteryStatsListener::ProcessDisplayEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_AMBIENT_LIGHT] = {
+            StatsUtils::STATS_TYPE_DISPLAY, &BatteryStatsListener::ProcessDisplayEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_BATTERY_CHANGED] = {
+            StatsUtils::STATS_TYPE_BATTERY, &BatteryStatsListener::ProcessBatteryEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_POWER_TEMPERATURE] = {
+            StatsUtils::STATS_TYPE_THERMAL, &BatteryStatsListener::ProcessThermalEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_THERMAL_LEVEL_CHANGED] = {
+            StatsUtils::STATS_TYPE_THERMAL, &BatteryStatsListener::ProcessThermalEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_THERMAL_ACTION_TRIGGERED] = {
+            StatsUtils::STATS_TYPE_THERMAL, &BatteryStatsListener::ProcessThermalEvent };
+        for (auto eventType : { StatsHiSysEvent::HISYSEVENT_TYPE_POWER_WORKSCHEDULER,
+            StatsHiSysEvent::HISYSEVENT_TYPE_WORK_ADD, StatsHiSysEvent::HISYSEVENT_TYPE_WORK_REMOVE,
+            StatsHiSysEvent::HISYSEVENT_TYPE_WORK_START, StatsHiSysEvent::HISYSEVENT_TYPE_WORK_STOP }) {
+            eventTable[eventType] = {
+                StatsUtils::STATS_TYPE_WORKSCHEDULER, &BatteryStatsListener::ProcessWorkschedulerEvent };
+        }
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_CALL_STATE] = {
+            StatsUtils::STATS_TYPE_PHONE_ACTIVE, &BatteryStatsListener::ProcessPhoneEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_DATA_CONNECTION_STATE] = {
+            StatsUtils::STATS_TYPE_PHONE_DATA, &BatteryStatsListener::ProcessPhoneEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_TORCH_STATE] = {
+            StatsUtils::STATS_TYPE_FLASHLIGHT_ON, &BatteryStatsListener::ProcessFlashlightEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_CAMERA_CONNECT] = {
+            StatsUtils::STATS_TYPE_CAMERA_ON, &BatteryStatsListener::ProcessCameraEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_CAMERA_DISCONNECT] = {
+            StatsUtils::STATS_TYPE_CAMERA_ON, &BatteryStatsListener::ProcessCameraEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_FLASHLIGHT_ON] = {
+            StatsUtils::STATS_TYPE_CAMERA_FLASHLIGHT_ON, &BatteryStatsListener::ProcessCameraEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_FLASHLIGHT_OFF] = {
+            StatsUtils::STATS_TYPE_CAMERA_FLASHLIGHT_ON, &BatteryStatsListener::ProcessCameraEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_STREAM_CHANGE] = {
+            StatsUtils::STATS_TYPE_AUDIO_ON, &BatteryStatsListener::ProcessAudioEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_POWER_SENSOR_GRAVITY] = {
+            StatsUtils::STATS_TYPE_SENSOR_GRAVITY_ON, &BatteryStatsListener::ProcessSensorEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_POWER_SENSOR_PROXIMITY] = {
+            StatsUtils::STATS_TYPE_SENSOR_PROXIMITY_ON, &BatteryStatsListener::ProcessSensorEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_GNSS_STATE] = {
+            StatsUtils::STATS_TYPE_GNSS_ON, &BatteryStatsListener::ProcessGnssEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_BR_SWITCH_STATE] = {
+            StatsUtils::STATS_TYPE_BLUETOOTH_BR_ON, &BatteryStatsListener::ProcessBluetoothBrEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_DISCOVERY_STATE] = {
+            StatsUtils::STATS_TYPE_BLUETOOTH_BR_SCAN, &BatteryStatsListener::ProcessBluetoothBrEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_BLE_SWITCH_STATE] = {
+            StatsUtils::STATS_TYPE_BLUETOOTH_BLE_ON, &BatteryStatsListener::ProcessBluetoothBleEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_BLE_SCAN_START] = {
+            StatsUtils::STATS_TYPE_BLUETOOTH_BLE_SCAN, &BatteryStatsListener::ProcessBluetoothBleEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_BLE_SCAN_STOP] = {
+            StatsUtils::STATS_TYPE_BLUETOOTH_BLE_SCAN, &BatteryStatsListener::ProcessBluetoothBleEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_WIFI_CONNECTION] = {
+            StatsUtils::STATS_TYPE_WIFI_ON, &BatteryStatsListener::ProcessWifiEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_WIFI_SCAN] = {
+            StatsUtils::STATS_TYPE_WIFI_SCAN, &BatteryStatsListener::ProcessWifiEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_START_REMOTE_ABILITY] = {
+            StatsUtils::STATS_TYPE_DISTRIBUTEDSCHEDULER, &BatteryStatsListener::ProcessDistributedSchedulerEvent };
+        eventTable[StatsHiSysEvent::HISYSEVENT_TYPE_MISC_TIME_STATISTIC_REPORT] = {
+            StatsUtils::STATS_TYPE_ALARM, &BatteryStatsListener::ProcessAlarmEvent };
+        return eventTable;
+    }();
+    return table;
+}
+
+void BatteryStatsListener::ProcessHiSysEvent(StatsHiSysEvent::HiSysEventType eventType, const StatsJsonView& root)
 {
     auto statsService = BatteryStatsService::GetInstance();
     auto detector = statsService->GetBatteryStatsDetector();
     StatsUtils::StatsData data;
     data.eventDebugInfo.clear();
-    if (eventName == StatsHiSysEvent::POWER_RUNNINGLOCK) {
-        ProcessWakelockEvent(data, root);
-    } else if (eventName == StatsHiSysEvent::SCREEN_STATE || eventName == StatsHiSysEvent::BRIGHTNESS_NIT ||
-        eventName == StatsHiSysEvent::BACKLIGHT_DISCOUNT || eventName == StatsHiSysEvent::AMBIENT_LIGHT) {
-        ProcessDisplayEvent(data, root, eventName);
-    } else if (eventName == StatsHiSysEvent::BATTERY_CHANGED) {
-        ProcessBatteryEvent(data, root);
-    } else if (eventName == StatsHiSysEvent::POWER_TEMPERATURE ||
-        eventName == StatsHiSysEvent::THERMAL_LEVEL_CHANGED ||
-        eventName == StatsHiSysEvent::THERMAL_ACTION_TRIGGERED) {
-        ProcessThermalEvent(data, root);
-    } else if (eventName == StatsHiSysEvent::POWER_WORKSCHEDULER || eventName == StatsHiSysEvent::WORK_ADD ||
-        eventName == StatsHiSysEvent::WORK_REMOVE || eventName == StatsHiSysEvent::WORK_START ||
-        eventName == StatsHiSysEvent::WORK_STOP) {
-        ProcessWorkschedulerEvent(data, root);
-    } else if (eventName == StatsHiSysEvent::CALL_STATE || eventName == StatsHiSysEvent::DATA_CONNECTION_STATE) {
-        ProcessPhoneEvent(data, root, eventName);
-    } else {
-        ProcessHiSysEventInternal(data, eventName, root);
+    // One indexed lookup replaces the chain of event name comparisons
+    const EventEntry& entry = GetEventTable()[eventType];
+    data.type = entry.statsType;
+    if (entry.handler != nullptr) {
+        (this->*entry.handler)(data, root, eventType);
+    }
+    // Hand the event over to the consumer thread, so that the callback never waits for the stats readers
+    auto eventQueue = statsService->GetBatteryStatsEventQueue();
+    if (eventQueue != nullptr && eventQueue->IsRunning()) {
+        eventQueue->Push(std::move(data));
+        return;
     }
     detector->HandleStatsChangedEvent(data);
 }
 
-void BatteryStatsListener::ProcessHiSysEventInternal(StatsUtils::StatsData& data,
-    const std::string& eventName, const cJSON* root)
-{
-    if (eventName == StatsHiSysEvent::TORCH_STATE) {
-        ProcessFlashlightEvent(data, root);
-    } else if (eventName == StatsHiSysEvent::CAMERA_CONNECT || eventName == StatsHiSysEvent::CAMERA_DISCONNECT ||
-        eventName == StatsHiSysEvent::FLASHLIGHT_ON || eventName == StatsHiSysEvent::FLASHLIGHT_OFF) {
-        ProcessCameraEvent(data, root, eventName);
-    } else if (eventName == StatsHiSysEvent::STREAM_CHANGE) {
-        ProcessAudioEvent(data, root);
-    } else if (eventName == StatsHiSysEvent::POWER_SENSOR_GRAVITY ||
-        eventName == StatsHiSysEvent::POWER_SENSOR_PROXIMITY) {
-        ProcessSensorEvent(data, root, eventName);
-    } else if (eventName == StatsHiSysEvent::GNSS_STATE) {
-        ProcessGnssEvent(data, root);
-    } else if (eventName == StatsHiSysEvent::BR_SWITCH_STATE || eventName == StatsHiSysEvent::DISCOVERY_STATE ||
-        eventName == StatsHiSysEvent::BLE_SWITCH_STATE || eventName == StatsHiSysEvent::BLE_SCAN_START ||
-        eventName == StatsHiSysEvent::BLE_SCAN_STOP) {
-        ProcessBluetoothEvent(data, root, eventName);
-    } else if (eventName == StatsHiSysEvent::WIFI_CONNECTION || eventName == StatsHiSysEvent::WIFI_SCAN) {
-        ProcessWifiEvent(data, root, eventName);
-    } else if (eventName == StatsHiSysEvent::START_REMOTE_ABILITY) {
-        ProcessDistributedSchedulerEvent(data, root);
-    } else if (eventName == StatsHiSysEvent::MISC_TIME_STATISTIC_REPORT) {
-        ProcessAlarmEvent(data, root);
-    }
-}
-
-void BatteryStatsListener::ProcessCameraEvent(StatsUtils::StatsData& data, const cJSON* root,
-    const std::string& eventName)
+void BatteryStatsListener::ProcessCameraEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+    StatsHiSysEvent::HiSysEventType eventType)
 {
-    if (eventName == StatsHiSysEvent::CAMERA_CONNECT || eventName == StatsHiSysEvent::CAMERA_DISCONNECT) {
-        data.type = StatsUtils::STATS_TYPE_CAMERA_ON;
-        cJSON* uidItem = cJSON_GetObjectItemCaseSensitive(root, "UID");
-        if (StatsJsonUtils::IsValidJsonNumber(uidItem)) {
-            data.uid = static_cast<int32_t>(uidItem->valueint);
+    if (eventType == StatsHiSysEvent::HISYSEVENT_TYPE_CAMERA_CONNECT ||
+        eventType == StatsHiSysEvent::HISYSEVENT_TYPE_CAMERA_DISCONNECT) {
+        int32_t uid = StatsUtils::INVALID_VALUE;
+        if (root.GetInt("UID", uid)) {
+            data.uid = uid;
         }
 
-        cJSON* pidItem = cJSON_GetObjectItemCaseSensitive(root, "PID");
-        if (StatsJsonUtils::IsValidJsonNumber(pidItem)) {
-            data.pid = static_cast<int32_t>(pidItem->valueint);
+        int32_t pid = StatsUtils::INVALID_VALUE;
+        if (root.GetInt("PID", pid)) {
+            data.pid = pid;
         }
 
-        cJSON* idItem = cJSON_GetObjectItemCaseSensitive(root, "ID");
-        if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(idItem)) {
-            data.deviceId = idItem->valuestring;
+        std::string_view id;
+        if (root.GetString("ID", id)) {
+            data.deviceId = id;
         }
 
-        if (eventName == StatsHiSysEvent::CAMERA_CONNECT) {
+        if (eventType == StatsHiSysEvent::HISYSEVENT_TYPE_CAMERA_CONNECT) {
             data.state = StatsUtils::STATS_STATE_ACTIVATED;
         } else {
             data.state = StatsUtils::STATS_STATE_DEACTIVATED;
         }
-    } else if (eventName == StatsHiSysEvent::FLASHLIGHT_ON || eventName == StatsHiSysEvent::FLASHLIGHT_OFF) {
-        data.type = StatsUtils::STATS_TYPE_CAMERA_FLASHLIGHT_ON;
-        if (eventName == StatsHiSysEvent::FLASHLIGHT_ON) {
+    } else if (eventType == StatsHiSysEvent::HISYSEVENT_TYPE_FLASHLIGHT_ON ||
+        eventType == StatsHiSysEvent::HISYSEVENT_TYPE_FLASHLIGHT_OFF) {
+        if (eventType == StatsHiSysEvent::HISYSEVENT_TYPE_FLASHLIGHT_ON) {
             data.state = StatsUtils::STATS_STATE_ACTIVATED;
         } else {
             data.state = StatsUtils::STATS_STATE_DEACTIVATED;
@@ -164,23 +197,22 @@ void BatteryStatsListener::ProcessCameraEvent(StatsUtils::StatsData& data, const
     }
 }
 
-void BatteryStatsListener::ProcessAudioEvent(StatsUtils::StatsData& data, const cJSON* root)
+void BatteryStatsListener::ProcessAudioEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+    [[maybe_unused]] StatsHiSysEvent::HiSysEventType eventType)
 {
-    data.type = StatsUtils::STATS_TYPE_AUDIO_ON;
-    cJSON* uidItem = cJSON_GetObjectItemCaseSensitive(root, "UID");
-    if (StatsJsonUtils::IsValidJsonNumber(uidItem)) {
-        data.uid = static_cast<int32_t>(uidItem->valueint);
+    int32_t uid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("UID", uid)) {
+        data.uid = uid;
     }
 
-    cJSON* pidItem = cJSON_GetObjectItemCaseSensitive(root, "PID");
-    if (StatsJsonUtils::IsValidJsonNumber(pidItem)) {
-        data.pid = static_cast<int32_t>(pidItem->valueint);
+    int32_t pid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("PID", pid)) {
+        data.pid = pid;
     }
 
-    cJSON* stateItem = cJSON_GetObjectItemCaseSensitive(root, "STATE");
-    if (StatsJsonUtils::IsValidJsonNumber(stateItem)) {
-        AudioState state = static_cast<AudioState>(stateItem->valueint);
-        switch (state) {
+    int32_t state = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("STATE", state)) {
+        switch (static_cast<AudioState>(state)) {
             case AudioState::AUDIO_STATE_RUNNING:
                 data.state = StatsUtils::STATS_STATE_ACTIVATED;
                 break;
@@ -196,152 +228,130 @@ void BatteryStatsListener::ProcessAudioEvent(StatsUtils::StatsData& data, const
     }
 }
 
-void BatteryStatsListener::ProcessSensorEvent(StatsUtils::StatsData& data, const cJSON* root,
-    const std::string& eventName)
+void BatteryStatsListener::ProcessSensorEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+    [[maybe_unused]] StatsHiSysEvent::HiSysEventType eventType)
 {
-    if (eventName == StatsHiSysEvent::POWER_SENSOR_GRAVITY) {
-        data.type = StatsUtils::STATS_TYPE_SENSOR_GRAVITY_ON;
-    } else if (eventName == StatsHiSysEvent::POWER_SENSOR_PROXIMITY) {
-        data.type = StatsUtils::STATS_TYPE_SENSOR_PROXIMITY_ON;
-    }
-
-    cJSON* uidItem = cJSON_GetObjectItemCaseSensitive(root, "UID");
-    if (StatsJsonUtils::IsValidJsonNumber(uidItem)) {
-        data.uid = static_cast<int32_t>(uidItem->valueint);
+    int32_t uid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("UID", uid)) {
+        data.uid = uid;
     }
 
-    cJSON* pidItem = cJSON_GetObjectItemCaseSensitive(root, "PID");
-    if (StatsJsonUtils::IsValidJsonNumber(pidItem)) {
-        data.pid = static_cast<int32_t>(pidItem->valueint);
+    int32_t pid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("PID", pid)) {
+        data.pid = pid;
     }
 
-    cJSON* stateItem = cJSON_GetObjectItemCaseSensitive(root, "STATE");
-    if (StatsJsonUtils::IsValidJsonNumber(stateItem)) {
-        if (stateItem->valueint == 1) {
+    int32_t state = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("STATE", state)) {
+        if (state == 1) {
             data.state = StatsUtils::STATS_STATE_ACTIVATED;
-        } else if (stateItem->valueint == 0) {
+        } else if (state == 0) {
             data.state = StatsUtils::STATS_STATE_DEACTIVATED;
         }
     }
 }
 
-void BatteryStatsListener::ProcessGnssEvent(StatsUtils::StatsData& data, const cJSON* root)
+void BatteryStatsListener::ProcessGnssEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+    [[maybe_unused]] StatsHiSysEvent::HiSysEventType eventType)
 {
-    data.type = StatsUtils::STATS_TYPE_GNSS_ON;
-    cJSON* uidItem = cJSON_GetObjectItemCaseSensitive(root, "UID");
-    if (StatsJsonUtils::IsValidJsonNumber(uidItem)) {
-        data.uid = static_cast<int32_t>(uidItem->valueint);
+    int32_t uid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("UID", uid)) {
+        data.uid = uid;
     }
 
-    cJSON* pidItem = cJSON_GetObjectItemCaseSensitive(root, "PID");
-    if (StatsJsonUtils::IsValidJsonNumber(pidItem)) {
-        data.pid = static_cast<int32_t>(pidItem->valueint);
+    int32_t pid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("PID", pid)) {
+        data.pid = pid;
     }
 
-    cJSON* stateItem = cJSON_GetObjectItemCaseSensitive(root, "STATE");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(stateItem)) {
-        const char* stateStr = stateItem->valuestring;
-        if (strcmp(stateStr, "start") == 0) {
+    std::string_view state;
+    if (root.GetString("STATE", state)) {
+        if (state == "start") {
             data.state = StatsUtils::STATS_STATE_ACTIVATED;
-        } else if (strcmp(stateStr, "stop") == 0) {
+        } else if (state == "stop") {
             data.state = StatsUtils::STATS_STATE_DEACTIVATED;
         }
     }
 }
 
-void BatteryStatsListener::ProcessBluetoothBrEvent(StatsUtils::StatsData& data, const cJSON* root,
-    const std::string& eventName)
+void BatteryStatsListener::ProcessBluetoothBrEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+    StatsHiSysEvent::HiSysEventType eventType)
 {
-    cJSON* stateItem = cJSON_GetObjectItemCaseSensitive(root, "STATE");
-    if (eventName == StatsHiSysEvent::BR_SWITCH_STATE) {
-        data.type = StatsUtils::STATS_TYPE_BLUETOOTH_BR_ON;
-        if (StatsJsonUtils::IsValidJsonNumber(stateItem)) {
+    int32_t state = StatsUtils::INVALID_VALUE;
+    bool hasState = root.GetInt("STATE", state);
+    if (eventType == StatsHiSysEvent::HISYSEVENT_TYPE_BR_SWITCH_STATE) {
+        if (hasState) {
 #ifdef HAS_BATTERYSTATS_BLUETOOTH_PART
-            if (stateItem->valueint == Bluetooth::BTStateID::STATE_TURN_ON) {
+            if (state == Bluetooth::BTStateID::STATE_TURN_ON) {
                 data.state = StatsUtils::STATS_STATE_ACTIVATED;
-            } else if (stateItem->valueint == Bluetooth::BTStateID::STATE_TURN_OFF) {
+            } else if (state == Bluetooth::BTStateID::STATE_TURN_OFF) {
                 data.state = StatsUtils::STATS_STATE_DEACTIVATED;
             }
 #endif
         }
-    } else if (eventName == StatsHiSysEvent::DISCOVERY_STATE) {
-        data.type = StatsUtils::STATS_TYPE_BLUETOOTH_BR_SCAN;
-        if (StatsJsonUtils::IsValidJsonNumber(stateItem)) {
+    } else if (eventType == StatsHiSysEvent::HISYSEVENT_TYPE_DISCOVERY_STATE) {
+        if (hasState) {
 #ifdef HAS_BATTERYSTATS_BLUETOOTH_PART
-            if (stateItem->valueint == Bluetooth::DISCOVERY_STARTED) {
+            if (state == Bluetooth::DISCOVERY_STARTED) {
                 data.state = StatsUtils::STATS_STATE_ACTIVATED;
-            } else if (stateItem->valueint == Bluetooth::DISCOVERY_STOPED) {
+            } else if (state == Bluetooth::DISCOVERY_STOPED) {
                 data.state = StatsUtils::STATS_STATE_DEACTIVATED;
             }
 #endif
         }
-        cJSON* uidItem = cJSON_GetObjectItemCaseSensitive(root, "UID");
-        if (StatsJsonUtils::IsValidJsonNumber(uidItem)) {
-            data.uid = static_cast<int32_t>(uidItem->valueint);
+        int32_t uid = StatsUtils::INVALID_VALUE;
+        if (root.GetInt("UID", uid)) {
+            data.uid = uid;
         }
 
-        cJSON* pidItem = cJSON_GetObjectItemCaseSensitive(root, "PID");
-        if (StatsJsonUtils::IsValidJsonNumber(pidItem)) {
-            data.pid = static_cast<int32_t>(pidItem->valueint);
+        int32_t pid = StatsUtils::INVALID_VALUE;
+        if (root.GetInt("PID", pid)) {
+            data.pid = pid;
         }
     }
 }
 
-void BatteryStatsListener::ProcessBluetoothBleEvent(StatsUtils::StatsData& data, const cJSON* root,
-    const std::string& eventName)
+void BatteryStatsListener::ProcessBluetoothBleEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+    StatsHiSysEvent::HiSysEventType eventType)
 {
-    if (eventName == StatsHiSysEvent::BLE_SWITCH_STATE) {
-        data.type = StatsUtils::STATS_TYPE_BLUETOOTH_BLE_ON;
-        cJSON* stateItem = cJSON_GetObjectItemCaseSensitive(root, "STATE");
-        if (StatsJsonUtils::IsValidJsonNumber(stateItem)) {
+    if (eventType == StatsHiSysEvent::HISYSEVENT_TYPE_BLE_SWITCH_STATE) {
+        int32_t state = StatsUtils::INVALID_VALUE;
+        if (root.GetInt("STATE", state)) {
 #ifdef HAS_BATTERYSTATS_BLUETOOTH_PART
-            if (stateItem->valueint == Bluetooth::BTStateID::STATE_TURN_ON) {
+            if (state == Bluetooth::BTStateID::STATE_TURN_ON) {
                 data.state = StatsUtils::STATS_STATE_ACTIVATED;
-            } else if (stateItem->valueint == Bluetooth::BTStateID::STATE_TURN_OFF) {
+            } else if (state == Bluetooth::BTStateID::STATE_TURN_OFF) {
                 data.state = StatsUtils::STATS_STATE_DEACTIVATED;
             }
 #endif
         }
-    } else if (eventName == StatsHiSysEvent::BLE_SCAN_START || eventName == StatsHiSysEvent::BLE_SCAN_STOP) {
-        data.type = StatsUtils::STATS_TYPE_BLUETOOTH_BLE_SCAN;
-        if (eventName == StatsHiSysEvent::BLE_SCAN_START) {
+    } else if (eventType == StatsHiSysEvent::HISYSEVENT_TYPE_BLE_SCAN_START ||
+        eventType == StatsHiSysEvent::HISYSEVENT_TYPE_BLE_SCAN_STOP) {
+        if (eventType == StatsHiSysEvent::HISYSEVENT_TYPE_BLE_SCAN_START) {
             data.state = StatsUtils::STATS_STATE_ACTIVATED;
-        } else if (eventName == StatsHiSysEvent::BLE_SCAN_STOP) {
+        } else if (eventType == StatsHiSysEvent::HISYSEVENT_TYPE_BLE_SCAN_STOP) {
             data.state = StatsUtils::STATS_STATE_DEACTIVATED;
         }
-        cJSON* uidItem = cJSON_GetObjectItemCaseSensitive(root, "UID");
-        if (StatsJsonUtils::IsValidJsonNumber(uidItem)) {
-            data.uid = static_cast<int32_t>(uidItem->valueint);
+        int32_t uid = StatsUtils::INVALID_VALUE;
+        if (root.GetInt("UID", uid)) {
+            data.uid = uid;
         }
 
-        cJSON* pidItem = cJSON_GetObjectItemCaseSensitive(root, "PID");
-        if (StatsJsonUtils::IsValidJsonNumber(pidItem)) {
-            data.pid = static_cast<int32_t>(pidItem->valueint);
+        int32_t pid = StatsUtils::INVALID_VALUE;
+        if (root.GetInt("PID", pid)) {
+            data.pid = pid;
         }
     }
 }
 
-void BatteryStatsListener::ProcessBluetoothEvent(StatsUtils::StatsData& data, const cJSON* root,
-    const std::string& eventName)
+void BatteryStatsListener::ProcessWifiEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+    StatsHiSysEvent::HiSysEventType eventType)
 {
-    if (eventName == StatsHiSysEvent::BR_SWITCH_STATE || eventName == StatsHiSysEvent::DISCOVERY_STATE) {
-        ProcessBluetoothBrEvent(data, root, eventName);
-    } else if (eventName == StatsHiSysEvent::BLE_SWITCH_STATE ||eventName == StatsHiSysEvent::BLE_SCAN_START ||
-        eventName == StatsHiSysEvent::BLE_SCAN_STOP) {
-        ProcessBluetoothBleEvent(data, root, eventName);
-    }
-}
-
-void BatteryStatsListener::ProcessWifiEvent(StatsUtils::StatsData& data, const cJSON* root,
-    const std::string& eventName)
-{
-    if (eventName == StatsHiSysEvent::WIFI_CONNECTION) {
-        data.type = StatsUtils::STATS_TYPE_WIFI_ON;
-        cJSON* typeItem = cJSON_GetObjectItemCaseSensitive(root, "TYPE");
-        if (StatsJsonUtils::IsValidJsonNumber(typeItem)) {
+    if (eventType == StatsHiSysEvent::HISYSEVENT_TYPE_WIFI_CONNECTION) {
+        int32_t type = StatsUtils::INVALID_VALUE;
+        if (root.GetInt("TYPE", type)) {
 #ifdef HAS_BATTERYSTATS_WIFI_PART
-            int connectionTypeInt = typeItem->valueint;
-            switch (static_cast<Wifi::ConnState>(connectionTypeInt)) {
+            switch (static_cast<Wifi::ConnState>(type)) {
                 case Wifi::ConnState::CONNECTED:
                     data.state = StatsUtils::STATS_STATE_ACTIVATED;
                     break;
@@ -353,47 +363,41 @@ void BatteryStatsListener::ProcessWifiEvent(StatsUtils::StatsData& data, const c
             }
 #endif
         }
-    } else if (eventName == StatsHiSysEvent::WIFI_SCAN) {
-        data.type = StatsUtils::STATS_TYPE_WIFI_SCAN;
+    } else if (eventType == StatsHiSysEvent::HISYSEVENT_TYPE_WIFI_SCAN) {
         data.traffic = 1;
     }
 }
 
-void BatteryStatsListener::ProcessPhoneDebugInfo(StatsUtils::StatsData& data, const cJSON* root)
+void BatteryStatsListener::ProcessPhoneDebugInfo(StatsUtils::StatsData& data, const StatsJsonView& root)
 {
-    cJSON* item = nullptr;
-
-    item = cJSON_GetObjectItemCaseSensitive(root, "name_");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(item)) {
-        data.eventDebugInfo.append("Event name = ").append(item->valuestring);
+    std::string_view name;
+    if (root.GetString("name_", name)) {
+        data.eventDebugInfo.append("Event name = ").append(name);
     }
 
-    item = cJSON_GetObjectItemCaseSensitive(root, "STATE");
-    if (StatsJsonUtils::IsValidJsonNumber(item)) {
-        data.eventDebugInfo.append(" State = ").append(std::to_string(item->valueint));
+    int32_t value = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("STATE", value)) {
+        data.eventDebugInfo.append(" State = ").append(std::to_string(value));
     }
 
-    item = cJSON_GetObjectItemCaseSensitive(root, "SLOT_ID");
-    if (StatsJsonUtils::IsValidJsonNumber(item)) {
-        data.eventDebugInfo.append(" Slot ID = ").append(std::to_string(item->valueint));
+    if (root.GetInt("SLOT_ID", value)) {
+        data.eventDebugInfo.append(" Slot ID = ").append(std::to_string(value));
     }
 
-    item = cJSON_GetObjectItemCaseSensitive(root, "INDEX_ID");
-    if (StatsJsonUtils::IsValidJsonNumber(item)) {
-        data.eventDebugInfo.append(" Index ID = ").append(std::to_string(item->valueint));
+    if (root.GetInt("INDEX_ID", value)) {
+        data.eventDebugInfo.append(" Index ID = ").append(std::to_string(value));
     }
 }
 
-void BatteryStatsListener::ProcessPhoneEvent(StatsUtils::StatsData& data, const cJSON* root,
-    const std::string& eventName)
+void BatteryStatsListener::ProcessPhoneEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+    StatsHiSysEvent::HiSysEventType eventType)
 {
-    cJSON* stateItem = cJSON_GetObjectItemCaseSensitive(root, "STATE");
-    if (eventName == StatsHiSysEvent::CALL_STATE) {
-        data.type = StatsUtils::STATS_TYPE_PHONE_ACTIVE;
-        if (StatsJsonUtils::IsValidJsonNumber(stateItem)) {
+    int32_t state = StatsUtils::INVALID_VALUE;
+    bool hasState = root.GetInt("STATE", state);
+    if (eventType == StatsHiSysEvent::HISYSEVENT_TYPE_CALL_STATE) {
+        if (hasState) {
 #ifdef HAS_BATTERYSTATS_CALL_MANAGER_PART
-            int callStateInt = stateItem->valueint;
-            switch (static_cast<Telephony::TelCallState>(callStateInt)) {
+            switch (static_cast<Telephony::TelCallState>(state)) {
                 case Telephony::TelCallState::CALL_STATUS_ACTIVE:
                     data.state = StatsUtils::STATS_STATE_ACTIVATED;
                     break;
@@ -405,12 +409,11 @@ void BatteryStatsListener::ProcessPhoneEvent(StatsUtils::StatsData& data, const
             }
 #endif
         }
-    } else if (eventName == StatsHiSysEvent::DATA_CONNECTION_STATE) {
-        data.type = StatsUtils::STATS_TYPE_PHONE_DATA;
-        if (StatsJsonUtils::IsValidJsonNumber(stateItem)) {
-            if (stateItem->valueint == 1) {
+    } else if (eventType == StatsHiSysEvent::HISYSEVENT_TYPE_DATA_CONNECTION_STATE) {
+        if (hasState) {
+            if (state == 1) {
                 data.state = StatsUtils::STATS_STATE_ACTIVATED;
-            } else if (stateItem->valueint == 0) {
+            } else if (state == 0) {
                 data.state = StatsUtils::STATS_STATE_DEACTIVATED;
             }
         }
@@ -424,46 +427,45 @@ void BatteryStatsListener::ProcessPhoneEvent(StatsUtils::StatsData& data, const
     ProcessPhoneDebugInfo(data, root);
 }
 
-void BatteryStatsListener::ProcessFlashlightEvent(StatsUtils::StatsData& data, const cJSON* root)
+void BatteryStatsListener::ProcessFlashlightEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+    [[maybe_unused]] StatsHiSysEvent::HiSysEventType eventType)
 {
-    data.type = StatsUtils::STATS_TYPE_FLASHLIGHT_ON;
-    cJSON* uidItem = cJSON_GetObjectItemCaseSensitive(root, "UID");
-    if (StatsJsonUtils::IsValidJsonNumber(uidItem)) {
-        data.uid = static_cast<int32_t>(uidItem->valueint);
+    int32_t uid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("UID", uid)) {
+        data.uid = uid;
     }
 
-    cJSON* pidItem = cJSON_GetObjectItemCaseSensitive(root, "PID");
-    if (StatsJsonUtils::IsValidJsonNumber(pidItem)) {
-        data.pid = static_cast<int32_t>(pidItem->valueint);
+    int32_t pid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("PID", pid)) {
+        data.pid = pid;
     }
 
-    cJSON* stateItem = cJSON_GetObjectItemCaseSensitive(root, "STATE");
-    if (StatsJsonUtils::IsValidJsonNumber(stateItem)) {
-        if (stateItem->valueint == 1) {
+    int32_t state = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("STATE", state)) {
+        if (state == 1) {
             data.state = StatsUtils::STATS_STATE_ACTIVATED;
-        } else if (stateItem->valueint == 0) {
+        } else if (state == 0) {
             data.state = StatsUtils::STATS_STATE_DEACTIVATED;
         }
     }
 }
 
-void BatteryStatsListener::ProcessWakelockEvent(StatsUtils::StatsData& data, const cJSON* root)
+void BatteryStatsListener::ProcessWakelockEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+    [[maybe_unused]] StatsHiSysEvent::HiSysEventType eventType)
 {
-    data.type = StatsUtils::STATS_TYPE_WAKELOCK_HOLD;
-    cJSON* uidItem = cJSON_GetObjectItemCaseSensitive(root, "UID");
-    if (StatsJsonUtils::IsValidJsonNumber(uidItem)) {
-        data.uid = static_cast<int32_t>(uidItem->valueint);
+    int32_t uid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("UID", uid)) {
+        data.uid = uid;
     }
 
-    cJSON* pidItem = cJSON_GetObjectItemCaseSensitive(root, "PID");
-    if (StatsJsonUtils::IsValidJsonNumber(pidItem)) {
-        data.pid = static_cast<int32_t>(pidItem->valueint);
+    int32_t pid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("PID", pid)) {
+        data.pid = pid;
     }
-    cJSON* stateItem = cJSON_GetObjectItemCaseSensitive(root, "STATE");
-    if (StatsJsonUtils::IsValidJsonNumber(stateItem)) {
-        int lockStateInt = stateItem->valueint;
+    int32_t state = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("STATE", state)) {
         std::string stateLabel = "";
-        switch (static_cast<RunningLockState>(lockStateInt)) {
+        switch (static_cast<RunningLockState>(state)) {
             case RunningLockState::RUNNINGLOCK_STATE_DISABLE: {
                 data.state = StatsUtils::STATS_STATE_DEACTIVATED;
                 stateLabel = "Disable";
@@ -489,92 +491,89 @@ void BatteryStatsListener::ProcessWakelockEvent(StatsUtils::StatsData& data, con
     ProcessWakelockEventInternal(data, root);
 }
 
-void BatteryStatsListener::ProcessWakelockEventInternal(StatsUtils::StatsData& data, const cJSON* root)
+void BatteryStatsListener::ProcessWakelockEventInternal(StatsUtils::StatsData& data, const StatsJsonView& root)
 {
-    cJSON* typeItem = cJSON_GetObjectItemCaseSensitive(root, "TYPE");
-    if (StatsJsonUtils::IsValidJsonNumber(typeItem)) {
-        data.eventDataType = static_cast<int32_t>(typeItem->valueint);
+    int32_t type = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("TYPE", type)) {
+        data.eventDataType = type;
     }
 
-    cJSON* nameItem = cJSON_GetObjectItemCaseSensitive(root, "NAME");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(nameItem)) {
-        data.eventDataName = nameItem->valuestring;
+    std::string_view name;
+    if (root.GetString("NAME", name)) {
+        data.eventDataName = name;
     }
 
-    cJSON* logLevelItem = cJSON_GetObjectItemCaseSensitive(root, "LOG_LEVEL");
-    if (StatsJsonUtils::IsValidJsonNumber(logLevelItem)) {
-        data.eventDebugInfo.append(" LOG_LEVEL = ").append(std::to_string(logLevelItem->valueint));
+    int32_t logLevel = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("LOG_LEVEL", logLevel)) {
+        data.eventDebugInfo.append(" LOG_LEVEL = ").append(std::to_string(logLevel));
     }
 
-    cJSON* tagItem = cJSON_GetObjectItemCaseSensitive(root, "TAG");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(tagItem)) {
-        data.eventDebugInfo.append(" TAG = ").append(tagItem->valuestring);
+    std::string_view tag;
+    if (root.GetString("TAG", tag)) {
+        data.eventDebugInfo.append(" TAG = ").append(tag);
     }
 
-    cJSON* messageItem = cJSON_GetObjectItemCaseSensitive(root, "MESSAGE");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(messageItem)) {
-        data.eventDebugInfo.append(" MESSAGE = ").append(messageItem->valuestring);
+    std::string_view message;
+    if (root.GetString("MESSAGE", message)) {
+        data.eventDebugInfo.append(" MESSAGE = ").append(message);
     }
 }
 
-void BatteryStatsListener::ProcessDisplayDebugInfo(StatsUtils::StatsData& data, const cJSON* root)
+void BatteryStatsListener::ProcessDisplayDebugInfo(StatsUtils::StatsData& data, const StatsJsonView& root)
 {
-    cJSON* nameItem = cJSON_GetObjectItemCaseSensitive(root, "name_");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(nameItem)) {
-        data.eventDebugInfo.append("Event name = ").append(nameItem->valuestring);
+    std::string_view name;
+    if (root.GetString("name_", name)) {
+        data.eventDebugInfo.append("Event name = ").append(name);
     }
 
-    cJSON* stateItem = cJSON_GetObjectItemCaseSensitive(root, "STATE");
-    if (StatsJsonUtils::IsValidJsonNumber(stateItem)) {
-        data.eventDebugInfo.append(" Screen state = ").append(std::to_string(stateItem->valueint));
+    int32_t state = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("STATE", state)) {
+        data.eventDebugInfo.append(" Screen state = ").append(std::to_string(state));
     }
 
-    cJSON* brightnessItem = cJSON_GetObjectItemCaseSensitive(root, "BRIGHTNESS");
-    if (StatsJsonUtils::IsValidJsonNumber(brightnessItem)) {
-        data.eventDebugInfo.append(" Screen brightness = ").append(std::to_string(brightnessItem->valueint));
+    int32_t brightness = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("BRIGHTNESS", brightness)) {
+        data.eventDebugInfo.append(" Screen brightness = ").append(std::to_string(brightness));
     }
 
-    cJSON* reasonItem = cJSON_GetObjectItemCaseSensitive(root, "REASON");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(reasonItem)) {
-        data.eventDebugInfo.append(" Brightness reason = ").append(reasonItem->valuestring);
+    std::string_view reason;
+    if (root.GetString("REASON", reason)) {
+        data.eventDebugInfo.append(" Brightness reason = ").append(reason);
     }
     ProcessDisplayDebugInfoInternal(data, root);
 }
 
-void BatteryStatsListener::ProcessDisplayDebugInfoInternal(StatsUtils::StatsData& data, const cJSON* root)
+void BatteryStatsListener::ProcessDisplayDebugInfoInternal(StatsUtils::StatsData& data, const StatsJsonView& root)
 {
-    cJSON* nitItem = cJSON_GetObjectItemCaseSensitive(root, "NIT");
-    if (StatsJsonUtils::IsValidJsonNumber(nitItem)) {
-        data.eventDebugInfo.append(" Brightness nit = ").append(std::to_string(nitItem->valueint));
+    int32_t nit = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("NIT", nit)) {
+        data.eventDebugInfo.append(" Brightness nit = ").append(std::to_string(nit));
     }
 
-    cJSON* ratioItem = cJSON_GetObjectItemCaseSensitive(root, "RATIO");
-    if (StatsJsonUtils::IsValidJsonNumber(ratioItem)) {
-        data.eventDebugInfo.append(" Ratio = ").append(std::to_string(ratioItem->valueint));
+    int32_t ratio = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("RATIO", ratio)) {
+        data.eventDebugInfo.append(" Ratio = ").append(std::to_string(ratio));
     }
 
-    cJSON* typeItem = cJSON_GetObjectItemCaseSensitive(root, "TYPE");
-    if (StatsJsonUtils::IsValidJsonNumber(typeItem)) {
-        data.eventDebugInfo.append(" Ambient type = ").append(std::to_string(typeItem->valueint));
+    int32_t type = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("TYPE", type)) {
+        data.eventDebugInfo.append(" Ambient type = ").append(std::to_string(type));
     }
 
-    cJSON* levelItem = cJSON_GetObjectItemCaseSensitive(root, "LEVEL");
-    if (StatsJsonUtils::IsValidJsonNumber(levelItem)) {
-        data.eventDebugInfo.append(" Ambient brightness = ").append(std::to_string(levelItem->valueint));
+    int32_t level = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("LEVEL", level)) {
+        data.eventDebugInfo.append(" Ambient brightness = ").append(std::to_string(level));
     }
 }
 
-void BatteryStatsListener::ProcessDisplayEvent(StatsUtils::StatsData& data, const cJSON* root,
-    const std::string& eventName)
+void BatteryStatsListener::ProcessDisplayEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+    StatsHiSysEvent::HiSysEventType eventType)
 {
-    data.type = StatsUtils::STATS_TYPE_DISPLAY;
-    if (eventName == StatsHiSysEvent::SCREEN_STATE) {
-        data.type = StatsUtils::STATS_TYPE_SCREEN_ON;
+    if (eventType == StatsHiSysEvent::HISYSEVENT_TYPE_SCREEN_STATE) {
 #ifdef HAS_BATTERYSTATS_DISPLAY_MANAGER_PART
-        cJSON* stateItem = cJSON_GetObjectItemCaseSensitive(root, "STATE");
-        if (StatsJsonUtils::IsValidJsonNumber(stateItem)) {
-            int displayStateInt = stateItem->valueint;
-            switch (static_cast<DisplayPowerMgr::DisplayState>(displayStateInt)) {
+        int32_t state = StatsUtils::INVALID_VALUE;
+        if (root.GetInt("STATE", state)) {
+            switch (static_cast<DisplayPowerMgr::DisplayState>(state)) {
                 case DisplayPowerMgr::DisplayState::DISPLAY_OFF:
                     data.state = StatsUtils::STATS_STATE_DEACTIVATED;
                     break;
@@ -586,246 +585,245 @@ void BatteryStatsListener::ProcessDisplayEvent(StatsUtils::StatsData& data, cons
             }
         }
 #endif
-    } else if (eventName == StatsHiSysEvent::BRIGHTNESS_NIT) {
-        data.type = StatsUtils::STATS_TYPE_SCREEN_BRIGHTNESS;
-        cJSON* brightnessItem = cJSON_GetObjectItemCaseSensitive(root, "BRIGHTNESS");
-        if (StatsJsonUtils::IsValidJsonNumber(brightnessItem)) {
-            data.level = static_cast<int16_t>(brightnessItem->valueint);
+    } else if (eventType == StatsHiSysEvent::HISYSEVENT_TYPE_BRIGHTNESS_NIT) {
+        int32_t brightness = StatsUtils::INVALID_VALUE;
+        if (root.GetInt("BRIGHTNESS", brightness)) {
+            data.level = static_cast<int16_t>(brightness);
         }
     }
     ProcessDisplayDebugInfo(data, root);
 }
 
-void BatteryStatsListener::ProcessBatteryEvent(StatsUtils::StatsData& data, const cJSON* root)
+void BatteryStatsListener::ProcessBatteryEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+    [[maybe_unused]] StatsHiSysEvent::HiSysEventType eventType)
 {
-    data.type = StatsUtils::STATS_TYPE_BATTERY;
-
-    cJSON* levelItem = cJSON_GetObjectItemCaseSensitive(root, "LEVEL");
-    if (StatsJsonUtils::IsValidJsonNumber(levelItem)) {
-        data.level = static_cast<int16_t>(levelItem->valueint);
+    int32_t level = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("LEVEL", level)) {
+        data.level = static_cast<int16_t>(level);
     }
 
-    cJSON* chargerItem = cJSON_GetObjectItemCaseSensitive(root, "CHARGER");
-    if (StatsJsonUtils::IsValidJsonNumber(chargerItem)) {
-        data.eventDataExtra = static_cast<int32_t>(chargerItem->valueint);
+    int32_t charger = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("CHARGER", charger)) {
+        data.eventDataExtra = charger;
     }
 
-    cJSON* voltageItem = cJSON_GetObjectItemCaseSensitive(root, "VOLTAGE");
-    if (StatsJsonUtils::IsValidJsonNumber(voltageItem)) {
-        data.eventDebugInfo.append(" Voltage = ").append(std::to_string(voltageItem->valueint));
+    int32_t voltage = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("VOLTAGE", voltage)) {
+        data.eventDebugInfo.append(" Voltage = ").append(std::to_string(voltage));
     }
 
-    cJSON* healthItem = cJSON_GetObjectItemCaseSensitive(root, "HEALTH");
-    if (StatsJsonUtils::IsValidJsonNumber(healthItem)) {
-        data.eventDebugInfo.append(" Health = ").append(std::to_string(healthItem->valueint));
+    int32_t health = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("HEALTH", health)) {
+        data.eventDebugInfo.append(" Health = ").append(std::to_string(health));
     }
 
-    cJSON* temperatureItem = cJSON_GetObjectItemCaseSensitive(root, "TEMPERATURE");
-    if (StatsJsonUtils::IsValidJsonNumber(temperatureItem)) {
-        data.eventDebugInfo.append(" Temperature = ").append(std::to_string(temperatureItem->valueint));
+    int32_t temperature = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("TEMPERATURE", temperature)) {
+        data.eventDebugInfo.append(" Temperature = ").append(std::to_string(temperature));
     }
 }
 
-void BatteryStatsListener::ProcessThermalEvent(StatsUtils::StatsData& data, const cJSON* root)
+void BatteryStatsListener::ProcessThermalEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+    [[maybe_unused]] StatsHiSysEvent::HiSysEventType eventType)
 {
-    data.type = StatsUtils::STATS_TYPE_THERMAL;
-
-    cJSON* nameItem = cJSON_GetObjectItemCaseSensitive(root, "name_");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(nameItem)) {
-        data.eventDebugInfo.append("Event name = ").append(nameItem->valuestring);
+    std::string_view name;
+    if (root.GetString("name_", name)) {
+        data.eventDebugInfo.append("Event name = ").append(name);
     }
 
-    cJSON* bundleNameItem = cJSON_GetObjectItemCaseSensitive(root, "NAME");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(bundleNameItem)) {
-        data.eventDebugInfo.append(" Name = ").append(bundleNameItem->valuestring);
+    std::string_view bundleName;
+    if (root.GetString("NAME", bundleName)) {
+        data.eventDebugInfo.append(" Name = ").append(bundleName);
     }
 
-    cJSON* temperatureItem = cJSON_GetObjectItemCaseSensitive(root, "TEMPERATURE");
-    if (StatsJsonUtils::IsValidJsonNumber(temperatureItem)) {
-        data.eventDebugInfo.append(" Temperature = ").append(std::to_string(temperatureItem->valueint));
+    int32_t temperature = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("TEMPERATURE", temperature)) {
+        data.eventDebugInfo.append(" Temperature = ").append(std::to_string(temperature));
     }
 
-    cJSON* levelItem = cJSON_GetObjectItemCaseSensitive(root, "LEVEL");
-    if (StatsJsonUtils::IsValidJsonNumber(levelItem)) {
-        data.eventDebugInfo.append(" Temperature level = ").append(std::to_string(levelItem->valueint));
+    int32_t level = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("LEVEL", level)) {
+        data.eventDebugInfo.append(" Temperature level = ").append(std::to_string(level));
     }
 
     ProcessThermalEventInternal(data, root);
 }
 
-void BatteryStatsListener::ProcessThermalEventInternal(StatsUtils::StatsData& data, const cJSON* root)
+void BatteryStatsListener::ProcessThermalEventInternal(StatsUtils::StatsData& data, const StatsJsonView& root)
 {
-    cJSON* actionItem = cJSON_GetObjectItemCaseSensitive(root, "ACTION");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(actionItem)) {
-        data.eventDebugInfo.append(" Action name = ").append(actionItem->valuestring);
+    std::string_view action;
+    if (root.GetString("ACTION", action)) {
+        data.eventDebugInfo.append(" Action name = ").append(action);
     }
 
-    cJSON* valueItem = cJSON_GetObjectItemCaseSensitive(root, "VALUE");
-    if (StatsJsonUtils::IsValidJsonNumber(valueItem)) {
-        data.eventDebugInfo.append(" Value = ").append(std::to_string(valueItem->valueint));
+    int32_t value = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("VALUE", value)) {
+        data.eventDebugInfo.append(" Value = ").append(std::to_string(value));
     }
 
-    cJSON* ratioItem = cJSON_GetObjectItemCaseSensitive(root, "RATIO");
-    if (StatsJsonUtils::IsValidJsonNumber(ratioItem)) {
-        std::string ratio = std::to_string(static_cast<float>(ratioItem->valuedouble)).substr(THERMAL_RATIO_BEGIN,
+    double ratioValue = 0;
+    if (root.GetDouble("RATIO", ratioValue)) {
+        std::string ratio = std::to_string(static_cast<float>(ratioValue)).substr(THERMAL_RATIO_BEGIN,
             THERMAL_RATIO_LENGTH);
         data.eventDebugInfo.append(" Ratio = ").append(ratio);
     }
 }
 
-void BatteryStatsListener::ProcessPowerWorkschedulerEvent(StatsUtils::StatsData& data, const cJSON* root)
+void BatteryStatsListener::ProcessPowerWorkschedulerEvent(StatsUtils::StatsData& data, const StatsJsonView& root)
 {
-    data.type = StatsUtils::STATS_TYPE_WORKSCHEDULER;
-    cJSON* uidItem = cJSON_GetObjectItemCaseSensitive(root, "UID");
-    if (StatsJsonUtils::IsValidJsonNumber(uidItem)) {
-        data.uid = static_cast<int32_t>(uidItem->valueint);
+    int32_t uid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("UID", uid)) {
+        data.uid = uid;
     }
 
-    cJSON* pidItem = cJSON_GetObjectItemCaseSensitive(root, "PID");
-    if (StatsJsonUtils::IsValidJsonNumber(pidItem)) {
-        data.pid = static_cast<int32_t>(pidItem->valueint);
+    int32_t pid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("PID", pid)) {
+        data.pid = pid;
     }
 
-    cJSON* stateItem = cJSON_GetObjectItemCaseSensitive(root, "STATE");
-    if (StatsJsonUtils::IsValidJsonNumber(stateItem)) {
-        data.state = static_cast<StatsUtils::StatsState>(stateItem->valueint);
+    int32_t state = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("STATE", state)) {
+        data.state = static_cast<StatsUtils::StatsState>(state);
     }
 
-    cJSON* typeItem = cJSON_GetObjectItemCaseSensitive(root, "TYPE");
-    if (StatsJsonUtils::IsValidJsonNumber(typeItem)) {
-        data.eventDataType = static_cast<int32_t>(typeItem->valueint);
+    int32_t type = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("TYPE", type)) {
+        data.eventDataType = type;
     }
 
-    cJSON* intervalItem = cJSON_GetObjectItemCaseSensitive(root, "INTERVAL");
-    if (StatsJsonUtils::IsValidJsonNumber(intervalItem)) {
-        data.eventDataExtra = static_cast<int32_t>(intervalItem->valueint);
+    int32_t interval = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("INTERVAL", interval)) {
+        data.eventDataExtra = interval;
     }
 }
 
-void BatteryStatsListener::ProcessOthersWorkschedulerEvent(StatsUtils::StatsData& data, const cJSON* root)
+void BatteryStatsListener::ProcessOthersWorkschedulerEvent(StatsUtils::StatsData& data, const StatsJsonView& root)
 {
-    data.type = StatsUtils::STATS_TYPE_WORKSCHEDULER;
-    cJSON* nameItem = cJSON_GetObjectItemCaseSensitive(root, "name_");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(nameItem)) {
-        data.eventDebugInfo.append(nameItem->valuestring).append(":");
+    std::string_view name;
+    if (root.GetString("name_", name)) {
+        data.eventDebugInfo.append(name).append(":");
     }
 
-    cJSON* uidItem = cJSON_GetObjectItemCaseSensitive(root, "UID");
-    if (StatsJsonUtils::IsValidJsonNumber(uidItem)) {
-        data.uid = static_cast<int32_t>(uidItem->valueint);
+    int32_t uid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("UID", uid)) {
+        data.uid = uid;
     }
 
-    cJSON* pidItem = cJSON_GetObjectItemCaseSensitive(root, "PID");
-    if (StatsJsonUtils::IsValidJsonNumber(pidItem)) {
-        data.pid = static_cast<int32_t>(pidItem->valueint);
+    int32_t pid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("PID", pid)) {
+        data.pid = pid;
     }
 
-    cJSON* bundleNameItem = cJSON_GetObjectItemCaseSensitive(root, "NAME");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(bundleNameItem)) {
-        data.eventDebugInfo.append(" Bundle name = ").append(bundleNameItem->valuestring);
+    std::string_view bundleName;
+    if (root.GetString("NAME", bundleName)) {
+        data.eventDebugInfo.append(" Bundle name = ").append(bundleName);
     }
     ProcessOthersWorkschedulerEventInternal(data, root);
 }
 
-void BatteryStatsListener::ProcessOthersWorkschedulerEventInternal(StatsUtils::StatsData& data, const cJSON* root)
+void BatteryStatsListener::ProcessOthersWorkschedulerEventInternal(StatsUtils::StatsData& data,
+    const StatsJsonView& root)
 {
-    cJSON* workIdItem = cJSON_GetObjectItemCaseSensitive(root, "WORKID");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(workIdItem)) {
-        data.eventDebugInfo.append(" Work ID = ").append(workIdItem->valuestring);
+    std::string_view workId;
+    if (root.GetString("WORKID", workId)) {
+        data.eventDebugInfo.append(" Work ID = ").append(workId);
     }
 
-    cJSON* triggerItem = cJSON_GetObjectItemCaseSensitive(root, "TRIGGER");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(triggerItem)) {
-        data.eventDebugInfo.append(" Trigger conditions = ").append(triggerItem->valuestring);
+    std::string_view trigger;
+    if (root.GetString("TRIGGER", trigger)) {
+        data.eventDebugInfo.append(" Trigger conditions = ").append(trigger);
     }
 
-    cJSON* typeItem = cJSON_GetObjectItemCaseSensitive(root, "TYPE");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(typeItem)) {
-        data.eventDebugInfo.append(" Work type = ").append(typeItem->valuestring);
+    std::string_view type;
+    if (root.GetString("TYPE", type)) {
+        data.eventDebugInfo.append(" Work type = ").append(type);
     }
 
-    cJSON* intervalItem = cJSON_GetObjectItemCaseSensitive(root, "INTERVAL");
-    if (StatsJsonUtils::IsValidJsonNumber(intervalItem)) {
-        data.eventDebugInfo.append(" Interval = ").append(std::to_string(intervalItem->valueint));
+    int32_t interval = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("INTERVAL", interval)) {
+        data.eventDebugInfo.append(" Interval = ").append(std::to_string(interval));
     }
 }
 
-void BatteryStatsListener::ProcessWorkschedulerEvent(StatsUtils::StatsData& data, const cJSON* root)
+void BatteryStatsListener::ProcessWorkschedulerEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+    StatsHiSysEvent::HiSysEventType eventType)
 {
-    cJSON* nameItem = cJSON_GetObjectItemCaseSensitive(root, "name_");
-    if (!StatsJsonUtils::IsValidJsonStringAndNoEmpty(nameItem)) {
+    std::string_view eventName;
+    if (!root.GetString("name_", eventName)) {
+        // Records without an event name are not attributed to the work scheduler
+        data.type = StatsUtils::STATS_TYPE_INVALID;
         return;
     }
-    std::string eventName(nameItem->valuestring);
-    if (eventName == StatsHiSysEvent::POWER_WORKSCHEDULER) {
+    if (eventType == StatsHiSysEvent::HISYSEVENT_TYPE_POWER_WORKSCHEDULER) {
         ProcessPowerWorkschedulerEvent(data, root);
     } else {
         ProcessOthersWorkschedulerEvent(data, root);
     }
 }
 
-void BatteryStatsListener::ProcessDistributedSchedulerEvent(StatsUtils::StatsData& data, const cJSON* root)
+void BatteryStatsListener::ProcessDistributedSchedulerEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+    [[maybe_unused]] StatsHiSysEvent::HiSysEventType eventType)
 {
-    data.type = StatsUtils::STATS_TYPE_DISTRIBUTEDSCHEDULER;
-    cJSON* nameItem = cJSON_GetObjectItemCaseSensitive(root, "name_");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(nameItem)) {
-        data.eventDebugInfo.append("Event name = ").append(nameItem->valuestring);
+    std::string_view name;
+    if (root.GetString("name_", name)) {
+        data.eventDebugInfo.append("Event name = ").append(name);
     }
 
-    cJSON* callingTypeItem = cJSON_GetObjectItemCaseSensitive(root, "CALLING_TYPE");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(callingTypeItem)) {
-        data.eventDebugInfo.append(" Calling Type = ").append(callingTypeItem->valuestring);
+    std::string_view callingType;
+    if (root.GetString("CALLING_TYPE", callingType)) {
+        data.eventDebugInfo.append(" Calling Type = ").append(callingType);
     }
 
-    cJSON* callingUidItem = cJSON_GetObjectItemCaseSensitive(root, "CALLING_UID");
-    if (StatsJsonUtils::IsValidJsonNumber(callingUidItem)) {
-        data.eventDebugInfo.append(" Calling Uid = ").append(std::to_string(callingUidItem->valueint));
+    int32_t callingUid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("CALLING_UID", callingUid)) {
+        data.eventDebugInfo.append(" Calling Uid = ").append(std::to_string(callingUid));
     }
 
-    cJSON* callingPidItem = cJSON_GetObjectItemCaseSensitive(root, "CALLING_PID");
-    if (StatsJsonUtils::IsValidJsonNumber(callingPidItem)) {
-        data.eventDebugInfo.append(" Calling Pid = ").append(std::to_string(callingPidItem->valueint));
+    int32_t callingPid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("CALLING_PID", callingPid)) {
+        data.eventDebugInfo.append(" Calling Pid = ").append(std::to_string(callingPid));
     }
 
     ProcessDistributedSchedulerEventInternal(data, root);
 }
 
-void BatteryStatsListener::ProcessDistributedSchedulerEventInternal(StatsUtils::StatsData& data, const cJSON* root)
+void BatteryStatsListener::ProcessDistributedSchedulerEventInternal(StatsUtils::StatsData& data,
+    const StatsJsonView& root)
 {
-    cJSON* targetBundleItem = cJSON_GetObjectItemCaseSensitive(root, "TARGET_BUNDLE");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(targetBundleItem)) {
-        data.eventDebugInfo.append(" Target Bundle Name = ").append(targetBundleItem->valuestring);
+    std::string_view targetBundle;
+    if (root.GetString("TARGET_BUNDLE", targetBundle)) {
+        data.eventDebugInfo.append(" Target Bundle Name = ").append(targetBundle);
     }
 
-    cJSON* targetAbilityItem = cJSON_GetObjectItemCaseSensitive(root, "TARGET_ABILITY");
-    if (StatsJsonUtils::IsValidJsonStringAndNoEmpty(targetAbilityItem)) {
-        data.eventDebugInfo.append(" Target Ability Name = ").append(targetAbilityItem->valuestring);
+    std::string_view targetAbility;
+    if (root.GetString("TARGET_ABILITY", targetAbility)) {
+        data.eventDebugInfo.append(" Target Ability Name = ").append(targetAbility);
     }
 
-    cJSON* callingAppUidItem = cJSON_GetObjectItemCaseSensitive(root, "CALLING_APP_UID");
-    if (StatsJsonUtils::IsValidJsonNumber(callingAppUidItem)) {
-        data.eventDebugInfo.append(" Calling App Uid = ").append(std::to_string(callingAppUidItem->valueint));
+    int32_t callingAppUid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("CALLING_APP_UID", callingAppUid)) {
+        data.eventDebugInfo.append(" Calling App Uid = ").append(std::to_string(callingAppUid));
     }
 
-    cJSON* resultItem = cJSON_GetObjectItemCaseSensitive(root, "RESULT");
-    if (StatsJsonUtils::IsValidJsonNumber(resultItem)) {
-        data.eventDebugInfo.append(" RESULT = ").append(std::to_string(resultItem->valueint));
+    int32_t result = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("RESULT", result)) {
+        data.eventDebugInfo.append(" RESULT = ").append(std::to_string(result));
     }
 }
 
-void BatteryStatsListener::ProcessAlarmEvent(StatsUtils::StatsData& data, const cJSON* root)
+void BatteryStatsListener::ProcessAlarmEvent(StatsUtils::StatsData& data, const StatsJsonView& root,
+    [[maybe_unused]] StatsHiSysEvent::HiSysEventType eventType)
 {
-    data.type = StatsUtils::STATS_TYPE_ALARM;
     data.traffic = 1;
 
-    cJSON* uidItem = cJSON_GetObjectItemCaseSensitive(root, "CALLER_UID");
-    if (StatsJsonUtils::IsValidJsonNumber(uidItem)) {
-        data.uid = static_cast<int32_t>(uidItem->valueint);
+    int32_t uid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("CALLER_UID", uid)) {
+        data.uid = uid;
     }
 
-    cJSON* pidItem = cJSON_GetObjectItemCaseSensitive(root, "CALLER_PID");
-    if (StatsJsonUtils::IsValidJsonNumber(pidItem)) {
-        data.pid = static_cast<int32_t>(pidItem->valueint);
+    int32_t pid = StatsUtils::INVALID_VALUE;
+    if (root.GetInt("CALLER_PID", pid)) {
+        data.pid = pid;
     }
 }
 
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_stats_name_table.h"
+
+#include "stats_log.h"
+
+namespace OHOS {
+namespace PowerMgr {
+BatteryStatsNameTable::BatteryStatsNameTable(size_t capacity) : capacity_(capacity)
+{
+    Clear();
+}
+
+uint32_t BatteryStatsNameTable::Intern(std::string_view name)
+{
+    uint32_t id = OTHER_ID;
+    if (Find(name, id)) {
+        return id;
+    }
+    if (names_.size() > capacity_) {
+        if (overflowCount_++ == 0) {
+            STATS_HILOGW(COMP_SVC, "Name table is full, capacity: %{public}zu", capacity_);
+        }
+        return OTHER_ID;
+    }
+    id = static_cast<uint32_t>(names_.size());
+    const std::string& stored = names_.emplace_back(name);
+    ids_.emplace(stored, id);
+    return id;
+}
+
+bool BatteryStatsNameTable::Find(std::string_view name, uint32_t& id) const
+{
+    auto iter = ids_.find(name);
+    if (iter == ids_.end()) {
+        return false;
+    }
+    id = iter->second;
+    return true;
+}
+
+const std::string& BatteryStatsNameTable::GetName(uint32_t id) const
+{
+    return id < names_.size() ? names_[id] : names_[OTHER_ID];
+}
+
+size_t BatteryStatsNameTable::GetSize() const
+{
+    return names_.size() - 1;
+}
+
+size_t BatteryStatsNameTable::GetCapacity() const
+{
+    return capacity_;
+}
+
+uint64_t BatteryStatsNameTable::GetOverflowCount() const
+{
+    return overflowCount_;
+}
+
+void BatteryStatsNameTable::Clear()
+{
+    ids_.clear();
+    names_.clear();
+    overflowCount_ = 0;
+    // Only shown, never looked up
+    names_.emplace_back(OTHER_NAME);
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_stats_notifier.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cmath>
+#include <limits>
+#include <pthread.h>
+
+#include "stats_log.h"
+#include "stats_utils.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr const char* NOTIFIER_THREAD_NAME = "StatsNotifier";
+
+int64_t GetSteadyTimeMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+bool IsChanged(double current, double last, double thresholdMah)
+{
+    double delta = std::fabs(current - last);
+    return delta > 0.0 && delta >= thresholdMah;
+}
+} // namespace
+
+void BatteryStatsNotifier::CallbackDeathRecipient::OnRemoteDied(const wptr<IRemoteObject>& remote)
+{
+    sptr<IRemoteObject> object = remote.promote();
+    if (object == nullptr) {
+        return;
+    }
+    notifier_.Remove(object.GetRefPtr(), true);
+}
+
+BatteryStatsNotifier::BatteryStatsNotifier() : BatteryStatsNotifier(Config()) {}
+
+BatteryStatsNotifier::BatteryStatsNotifier(const Config& config) : config_(config)
+{
+    deathRecipient_ = new (std::nothrow) CallbackDeathRecipient(*this);
+}
+
+BatteryStatsNotifier::~BatteryStatsNotifier()
+{
+    Stop();
+    std::lock_guard lock(mutex_);
+    for (auto& [remote, subscriber] : subscribers_) {
+        if (deathRecipient_ != nullptr && remote->IsProxyObject()) {
+            remote->RemoveDeathRecipient(deathRecipient_);
+        }
+    }
+    subscribers_.clear();
+}
+
+bool BatteryStatsNotifier::Start(const ResultProvider& provider)
+{
+    if (provider == nullptr) {
+        return false;
+    }
+    if (running_.exchange(true)) {
+        return true;
+    }
+    provider_ = provider;
+    worker_ = std::thread([this] { NotifierLoop(); });
+    pthread_setname_np(worker_.native_handle(), NOTIFIER_THREAD_NAME);
+    STATS_HILOGI(COMP_SVC, "Stats notifier is started");
+    return true;
+}
+
+void BatteryStatsNotifier::Stop()
+{
+    {
+        std::lock_guard lock(mutex_);
+        if (!running_.exchange(false)) {
+            return;
+        }
+        cond_.notify_all();
+    }
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    STATS_HILOGI(COMP_SVC, "Stats notifier is stopped, pushes: %{public}" PRIu64 "", GetPushCount());
+}
+
+bool BatteryStatsNotifier::Subscribe(const sptr<IBatteryStatsCallback>& callback, int64_t intervalMs,
+    double thresholdMah)
+{
+    if (callback == nullptr || intervalMs < 0 || !(thresholdMah >= 0.0)) {
+        return false;
+    }
+    sptr<IRemoteObject> remote = callback->AsObject();
+    if (remote == nullptr) {
+        return false;
+    }
+    std::lock_guard lock(mutex_);
+    auto iter = subscribers_.find(remote.GetRefPtr());
+    int64_t interval = std::max(intervalMs, config_.minIntervalMs);
+    if (iter != subscribers_.end()) {
+        iter->second.intervalMs = interval;
+        iter->second.thresholdMah = thresholdMah;
+        return true;
+    }
+    if (subscribers_.size() >= config_.maxSubscribers) {
+        STATS_HILOGW(COMP_SVC, "Too many stats callbacks, max: %{public}zu", config_.maxSubscribers);
+        return false;
+    }
+    // A callback in the same process has no death notification, which is fine
+    if (deathRecipient_ != nullptr && remote->IsProxyObject() && !remote->AddDeathRecipient(deathRecipient_)) {
+        STATS_HILOGW(COMP_SVC, "Add death recipient of stats callback failed");
+    }
+    Subscriber subscriber;
+    subscriber.callback = callback;
+    subscriber.intervalMs = interval;
+    subscriber.thresholdMah = thresholdMah;
+    // Due at once, the first push carries every app
+    subscriber.nextDueMs = GetSteadyTimeMs();
+    subscribers_.emplace(remote.GetRefPtr(), std::move(subscriber));
+    wakeRequested_ = true;
+    cond_.notify_all();
+    STATS_HILOGI(COMP_SVC, "Stats callback is registered, interval: %{public}" PRId64 "ms, callbacks: %{public}zu",
+        interval, subscribers_.size());
+    return true;
+}
+
+bool BatteryStatsNotifier::Unsubscribe(const sptr<IBatteryStatsCallback>& callback)
+{
+    if (callback == nullptr || callback->AsObject() == nullptr) {
+        return false;
+    }
+    return Remove(callback->AsObject().GetRefPtr(), false);
+}
+
+bool BatteryStatsNotifier::Remove(IRemoteObject* remote, bool isDead)
+{
+    std::lock_guard lock(mutex_);
+    auto iter = subscribers_.find(remote);
+    if (iter == subscribers_.end()) {
+        return false;
+    }
+    if (!isDead && deathRecipient_ != nullptr && remote->IsProxyObject()) {
+        remote->RemoveDeathRecipient(deathRecipient_);
+    }
+    subscribers_.erase(iter);
+    STATS_HILOGI(COMP_SVC, "Stats callback is removed, dead: %{public}d, callbacks: %{public}zu", isDead,
+        subscribers_.size());
+    return true;
+}
+
+size_t BatteryStatsNotifier::GetSubscriberCount() const
+{
+    std::lock_guard lock(mutex_);
+    return subscribers_.size();
+}
+
+uint64_t BatteryStatsNotifier::GetPushCount() const
+{
+    std::lock_guard lock(mutex_);
+    return pushCount_;
+}
+
+int64_t BatteryStatsNotifier::GetWaitMsLocked(int64_t nowMs) const
+{
+    if (subscribers_.empty()) {
+        return -1;
+    }
+    int64_t nextDueMs = std::numeric_limits<int64_t>::max();
+    for (const auto& [remote, subscriber] : subscribers_) {
+        nextDueMs = std::min(nextDueMs, subscriber.nextDueMs);
+    }
+    return std::max<int64_t>(nextDueMs - nowMs, 0);
+}
+
+void BatteryStatsNotifier::NotifierLoop()
+{
+    while (running_.load()) {
+        {
+            std::unique_lock lock(mutex_);
+            auto isWoken = [this] { return !running_.load() || wakeRequested_; };
+            int64_t waitMs = GetWaitMsLocked(GetSteadyTimeMs());
+            if (waitMs < 0) {
+                cond_.wait(lock, isWoken);
+            } else if (waitMs > 0) {
+                cond_.wait_for(lock, std::chrono::milliseconds(waitMs), isWoken);
+            }
+            wakeRequested_ = false;
+            if (!running_.load() || GetWaitMsLocked(GetSteadyTimeMs()) != 0) {
+                continue;
+            }
+        }
+        // One result for all the due subscribers, computed outside the lock
+        auto result = provider_();
+        if (result != nullptr) {
+            NotifyDue(GetSteadyTimeMs(), *result);
+        }
+    }
+}
+
+bool BatteryStatsNotifier::CollectChanges(Subscriber& subscriber, const std::unordered_map<int32_t, double>& appMah,
+    double totalMah, Push& push)
+{
+    bool isFirst = subscriber.lastTotalMah < 0.0;
+    for (const auto& [uid, mah] : appMah) {
+        auto last = subscriber.lastAppMah.find(uid);
+        double lastMah = last != subscriber.lastAppMah.end() ? last->second : 0.0;
+        if (isFirst || IsChanged(mah, lastMah, subscriber.thresholdMah)) {
+            push.uids.push_back(uid);
+            push.appStatsMah.push_back(mah);
+            subscriber.lastAppMah[uid] = mah;
+        }
+    }
+    // The apps which are gone after a reset are reported as zero
+    for (auto iter = subscriber.lastAppMah.begin(); iter != subscriber.lastAppMah.end();) {
+        if (appMah.find(iter->first) != appMah.end()) {
+            ++iter;
+            continue;
+        }
+        push.uids.push_back(iter->first);
+        push.appStatsMah.push_back(StatsUtils::DEFAULT_VALUE);
+        iter = subscriber.lastAppMah.erase(iter);
+    }
+    if (!isFirst && push.uids.empty() && !IsChanged(totalMah, subscriber.lastTotalMah, subscriber.thresholdMah)) {
+        return false;
+    }
+    push.callback = subscriber.callback;
+    push.totalPowerMah = totalMah;
+    subscriber.lastTotalMah = totalMah;
+    return true;
+}
+
+size_t BatteryStatsNotifier::NotifyDue(int64_t nowMs, const BatteryStatsResult& result)
+{
+    std::unordered_map<int32_t, double> appMah;
+    for (const auto& info : result.GetStatsInfoList()) {
+        if (info->GetConsumptionType() == BatteryStatsInfo::CONSUMPTION_TYPE_APP) {
+            appMah.emplace(info->GetUid(), info->GetPower());
+        }
+    }
+    std::vector<Push> pushes;
+    {
+        std::lock_guard lock(mutex_);
+        for (auto& [remote, subscriber] : subscribers_) {
+            if (subscriber.nextDueMs > nowMs) {
+                continue;
+            }
+            subscriber.nextDueMs = nowMs + subscriber.intervalMs;
+            Push push;
+            if (CollectChanges(subscriber, appMah, result.GetTotalPowerMah(), push)) {
+                pushes.push_back(std::move(push));
+            }
+        }
+        pushCount_ += pushes.size();
+    }
+    // Oneway calls, a slow client does not hold up the others
+    for (const auto& push : pushes) {
+        ErrCode errCode = push.callback->OnStatsChanged(push.uids, push.appStatsMah, push.totalPowerMah);
+        if (errCode != ERR_OK) {
+            STATS_HILOGW(COMP_SVC, "Push stats change failed, error: %{public}d", errCode);
+        }
+    }
+    return pushes.size();
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -36,8 +36,44 @@ namespace {
 static const std::string POWER_AVERAGE_FILE = "etc/power_config/power_average.json";
 static const std::string VENDOR_POWER_AVERAGE_FILE = "/vendor/etc/power_config/power_average.json";
 static const std::string SYSTEM_POWER_AVERAGE_FILE = "/system/etc/power_config/power_average.json";
+// Not a current, sizes the debug event log of the core
+constexpr const char* EVENT_LOG_CAPACITY = "stats_event_log_capacity";
+// Indexed by PowerProfile::Item
+constexpr const char* PROFILE_ITEM_NAMES[PowerProfile::ITEM_BUTT] = {
+    StatsUtils::CURRENT_BLUETOOTH_BR_ON,
+    StatsUtils::CURRENT_BLUETOOTH_BR_SCAN,
+    StatsUtils::CURRENT_BLUETOOTH_BLE_ON,
+    StatsUtils::CURRENT_BLUETOOTH_BLE_SCAN,
+    StatsUtils::CURRENT_WIFI_ON,
+    StatsUtils::CURRENT_WIFI_SCAN,
+    StatsUtils::CURRENT_CAMERA_ON,
+    StatsUtils::CURRENT_FLASHLIGHT_ON,
+    StatsUtils::CURRENT_GNSS_ON,
+    StatsUtils::CURRENT_SENSOR_GRAVITY,
+    StatsUtils::CURRENT_SENSOR_PROXIMITY,
+    StatsUtils::CURRENT_AUDIO_ON,
+    StatsUtils::CURRENT_SCREEN_ON,
+    StatsUtils::CURRENT_CPU_AWAKE,
+    StatsUtils::CURRENT_CPU_IDLE,
+    StatsUtils::CURRENT_CPU_ACTIVE,
+    StatsUtils::CURRENT_CPU_SUSPEND,
+    StatsUtils::CURRENT_ALARM_ON,
+    StatsUtils::CURRENT_WIFI_RX,
+    StatsUtils::CURRENT_WIFI_TX,
+    StatsUtils::CURRENT_RADIO_RX,
+    StatsUtils::CURRENT_RADIO_TX,
+};
 } // namespace
 bool BatteryStatsParser::Init()
+{
+    if (!LoadAveragePower()) {
+        return false;
+    }
+    CompilePowerProfile();
+    return true;
+}
+
+bool BatteryStatsParser::LoadAveragePower()
 {
 #ifdef HAS_BATTERYSTATS_CONFIG_POLICY_PART
     char buf[MAX_PATH_LEN];
@@ -59,6 +95,44 @@ bool BatteryStatsParser::Init()
     return true;
 }
 
+void BatteryStatsParser::CompilePowerProfile()
+{
+    auto profile = std::make_shared<PowerProfile>();
+    for (uint8_t i = 0; i < PowerProfile::ITEM_BUTT; i++) {
+        profile->averageMa[i] = GetAveragePowerMa(PROFILE_ITEM_NAMES[i]);
+    }
+    double brightnessMa = GetAveragePowerMa(StatsUtils::CURRENT_SCREEN_BRIGHTNESS);
+    for (size_t level = 0; level < profile->brightnessMa.size(); level++) {
+        profile->brightnessMa[level] = brightnessMa * level;
+    }
+    for (uint16_t i = 0; i < StatsUtils::RADIO_SIGNAL_BIN; i++) {
+        profile->radioOnMa[i] = GetAveragePowerMa(StatsUtils::CURRENT_RADIO_ON, i);
+        profile->radioDataMa[i] = GetAveragePowerMa(StatsUtils::CURRENT_RADIO_DATA, i);
+    }
+    for (uint16_t i = 0; i < clusterNum_; i++) {
+        profile->clusterMa.push_back(GetAveragePowerMa(StatsUtils::CURRENT_CPU_CLUSTER, i));
+        std::string speedType = StatsUtils::CURRENT_CPU_SPEED + std::to_string(i);
+        uint16_t speedNum = GetSpeedNum(i);
+        for (uint16_t j = 0; j < speedNum; j++) {
+            profile->speedMa.push_back(GetAveragePowerMa(speedType, j));
+        }
+        profile->speedOffsets.push_back(profile->speedMa.size());
+    }
+    profile_ = profile;
+    STATS_HILOGI(COMP_SVC, "Power profile is compiled, clusters: %{public}d, speeds: %{public}d", clusterNum_,
+        static_cast<int32_t>(profile->speedMa.size()));
+}
+
+std::shared_ptr<const PowerProfile> BatteryStatsParser::GetPowerProfile() const
+{
+    return profile_;
+}
+
+size_t BatteryStatsParser::GetEventLogCapacity() const
+{
+    return eventLogCapacity_;
+}
+
 uint16_t BatteryStatsParser::GetSpeedNum(uint16_t cluster)
 {
     for (uint16_t i = 0; i < speedNum_.size(); i++) {
@@ -102,6 +176,10 @@ bool BatteryStatsParser::LoadAveragePowerFromFile(const std::string& path)
             continue;
         }
         std::string keyStr(type);
+        if (keyStr == EVENT_LOG_CAPACITY) {
+            ParseEventLogCapacity(currentElement);
+            continue;
+        }
         if (keyStr == StatsUtils::CURRENT_CPU_CLUSTER && StatsJsonUtils::IsValidJsonArray(currentElement)) {
             clusterNum_ = static_cast<uint16_t>(cJSON_GetArraySize(currentElement));
             STATS_HILOGD(COMP_SVC, "Read cluster num: %{public}d", clusterNum_);
@@ -137,6 +215,16 @@ void BatteryStatsParser::ParsingArray(const std::string& type, const cJSON* arra
     averageVecMap_.insert(std::pair<std::string, std::vector<double>>(type, listValues));
 }
 
+void BatteryStatsParser::ParseEventLogCapacity(const cJSON* item)
+{
+    if (!StatsJsonUtils::IsValidJsonNumber(item) || item->valuedouble < 1 ||
+        item->valuedouble > BatteryStatsEventLog::MAX_CAPACITY) {
+        STATS_HILOGW(COMP_SVC, "Invalid %{public}s, keep %{public}zu", EVENT_LOG_CAPACITY, eventLogCapacity_);
+        return;
+    }
+    eventLogCapacity_ = static_cast<size_t>(item->valuedouble);
+}
+
 double BatteryStatsParser::GetAveragePowerMa(std::string type)
 {
     double average = 0.0;
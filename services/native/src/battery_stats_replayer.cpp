@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_stats_replayer.h"
+
+#include <chrono>
+#include <cinttypes>
+
+#include "battery_stats_detector.h"
+#include "stats_clock.h"
+#include "stats_helper.h"
+#include "stats_log.h"
+
+namespace OHOS {
+namespace PowerMgr {
+BatteryStatsReplayer::BatteryStatsReplayer(std::shared_ptr<const PowerProfile> profile)
+    : profile_(std::move(profile)) {}
+
+bool BatteryStatsReplayer::Replay(const std::vector<BatteryStatsTrace::Record>& records, Result& result)
+{
+    result = Result();
+    if (records.empty()) {
+        STATS_HILOGE(COMP_SVC, "Nothing to replay");
+        return false;
+    }
+    auto begin = std::chrono::steady_clock::now();
+    auto clock = std::make_shared<FakeStatsClock>(records.front().bootTimeMs, records.front().upTimeMs);
+    // Starts on the charger, the trace begins with the power supply state
+    auto core = std::make_shared<BatteryStatsCore>(std::make_shared<StatsHelper::TimeBase>(clock));
+    core->InitEntities(profile_);
+    for (const auto& record : records) {
+        clock->SetTimeMs(record.bootTimeMs, record.upTimeMs);
+        if (record.type == BatteryStatsTrace::RECORD_POWER_SUPPLY) {
+            core->SetOnBattery(record.isOnBattery);
+            result.powerSupplyCount++;
+        } else {
+            BatteryStatsDetector::Dispatch(core, record.data);
+            result.eventCount++;
+        }
+    }
+    core_ = core;
+    result.traceSpanMs = records.back().bootTimeMs - records.front().bootTimeMs;
+    result.replayCostUs = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - begin).count();
+    STATS_HILOGI(COMP_SVC, "Replayed %{public}zu events over %{public}" PRId64 "ms in %{public}" PRId64 "us",
+        result.eventCount, result.traceSpanMs, result.replayCostUs);
+    return true;
+}
+
+bool BatteryStatsReplayer::Replay(const std::string& path, Result& result)
+{
+    std::vector<BatteryStatsTrace::Record> records;
+    if (!BatteryStatsTrace::Read(path, records)) {
+        result = Result();
+        return false;
+    }
+    return Replay(records, result);
+}
+
+std::shared_ptr<BatteryStatsCore> BatteryStatsReplayer::GetCore() const
+{
+    return core_;
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_stats_result.h"
+
+#include "stats_utils.h"
+
+namespace OHOS {
+namespace PowerMgr {
+BatteryStatsResult::BatteryStatsResult(uint64_t version, int64_t computeTimeMs,
+    const BatteryStatsInfoList& statsInfoList, double totalPowerMah)
+    : version_(version), computeTimeMs_(computeTimeMs), statsInfoList_(statsInfoList), totalPowerMah_(totalPowerMah)
+{
+    appPowerMap_.reserve(statsInfoList_.size());
+    for (const auto& info : statsInfoList_) {
+        // emplace keeps the first entry, the same one the linear scans used to return
+        if (info->GetConsumptionType() == BatteryStatsInfo::CONSUMPTION_TYPE_APP) {
+            appPowerMap_.emplace(info->GetUid(), info->GetPower());
+        }
+        partPowerMap_.emplace(info->GetConsumptionType(), info->GetPower());
+    }
+}
+
+uint64_t BatteryStatsResult::GetVersion() const
+{
+    return version_;
+}
+
+int64_t BatteryStatsResult::GetComputeTimeMs() const
+{
+    return computeTimeMs_;
+}
+
+const BatteryStatsInfoList& BatteryStatsResult::GetStatsInfoList() const
+{
+    return statsInfoList_;
+}
+
+double BatteryStatsResult::GetTotalPowerMah() const
+{
+    return totalPowerMah_;
+}
+
+double BatteryStatsResult::GetAppPowerMah(int32_t uid) const
+{
+    auto iter = appPowerMap_.find(uid);
+    return iter != appPowerMap_.end() ? iter->second : StatsUtils::DEFAULT_VALUE;
+}
+
+double BatteryStatsResult::GetPartPowerMah(BatteryStatsInfo::ConsumptionType type) const
+{
+    auto iter = partPowerMap_.find(type);
+    return iter != partPowerMap_.end() ? iter->second : StatsUtils::DEFAULT_VALUE;
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -16,6 +16,7 @@
 #include "battery_stats_service.h"
 
 #include <file_ex.h>
+#include <cinttypes>
 #include <cmath>
 #include <ipc_skeleton.h>
 
@@ -96,6 +97,17 @@ void BatteryStatsService::OnStop()
     RemoveSystemAbilityListener(DFX_SYS_EVENT_SERVICE_ABILITY_ID);
     RemoveSystemAbilityListener(COMMON_EVENT_SERVICE_ID);
     HiviewDFX::HiSysEventManager::RemoveListener(listenerPtr_);
+    if (eventQueue_ != nullptr) {
+        eventQueue_->Stop();
+    }
+    if (notifier_ != nullptr) {
+        notifier_->Stop();
+    }
+    if (core_ != nullptr) {
+        core_->StopCpuSampler();
+        core_->StopJournal();
+        core_->StopTrace();
+    }
     if (!OHOS::EventFwk::CommonEventManager::UnSubscribeCommonEvent(subscriberPtr_)) {
         STATS_HILOGE(COMP_SVC, "OnStart unregister to commonevent manager failed");
     }
@@ -132,8 +144,8 @@ bool BatteryStatsService::Init()
     }
 
     if (core_ == nullptr) {
-        core_ = std::make_shared<BatteryStatsCore>();
-        if (!core_->Init()) {
+        core_ = std::make_shared<BatteryStatsCore>(nullptr, statsDir_);
+        if (!core_->Init(parser_->GetPowerProfile(), parser_->GetEventLogCapacity())) {
             STATS_HILOGE(COMP_SVC, "Battery stats core initialization failed");
             return false;
         }
@@ -143,6 +155,31 @@ bool BatteryStatsService::Init()
         detector_ = std::make_shared<BatteryStatsDetector>();
     }
 
+    if (eventQueue_ == nullptr) {
+        eventQueue_ = std::make_shared<BatteryStatsEventQueue>();
+    }
+    core_->SetEventQueue(eventQueue_);
+    auto detector = detector_;
+    if (!eventQueue_->Start([detector](const StatsUtils::StatsData& data) {
+        detector->HandleStatsChangedEvent(data);
+    })) {
+        STATS_HILOGE(COMP_SVC, "Battery stats event queue start failed");
+        return false;
+    }
+    if (!core_->StartJournal()) {
+        STATS_HILOGW(COMP_SVC, "Battery stats journal start failed, stats are only saved at shutdown");
+    }
+    if (!core_->StartCpuSampler()) {
+        STATS_HILOGW(COMP_SVC, "Cpu time sampler start failed");
+    }
+    if (notifier_ == nullptr) {
+        notifier_ = std::make_shared<BatteryStatsNotifier>();
+    }
+    auto core = core_;
+    if (!notifier_->Start([core] { return core->GetStatsResult(); })) {
+        STATS_HILOGW(COMP_SVC, "Stats notifier start failed");
+    }
+
     return true;
 }
 
@@ -153,6 +190,8 @@ bool BatteryStatsService::SubscribeCommonEvent()
     MatchingSkills matchingSkills;
     matchingSkills.AddEvent(CommonEventSupport::COMMON_EVENT_SHUTDOWN);
     matchingSkills.AddEvent(CommonEventSupport::COMMON_EVENT_BATTERY_CHANGED);
+    matchingSkills.AddEvent(CommonEventSupport::COMMON_EVENT_USER_ADDED);
+    matchingSkills.AddEvent(CommonEventSupport::COMMON_EVENT_USER_REMOVED);
     CommonEventSubscribeInfo subscribeInfo(matchingSkills);
     subscribeInfo.SetThreadMode(CommonEventSubscribeInfo::ThreadMode::COMMON);
     if (!subscriberPtr_) {
@@ -183,6 +222,13 @@ bool BatteryStatsService::AddHiSysEventListener()
     return res;
 }
 
+void BatteryStatsService::FlushStatsEvents()
+{
+    if (eventQueue_ != nullptr) {
+        eventQueue_->Flush();
+    }
+}
+
 bool BatteryStatsService::IsServiceReady() const
 {
     return ready_;
@@ -190,17 +236,36 @@ bool BatteryStatsService::IsServiceReady() const
 
 BatteryStatsInfoList BatteryStatsService::GetBatteryStats()
 {
-    std::lock_guard lock(mutex_);
     BatteryStatsInfoList statsInfoList = {};
     if (!Permission::IsSystem()) {
         lastError_ = static_cast<int32_t>(StatsError::ERR_SYSTEM_API_DENIED);
         return statsInfoList;
     }
-    core_->ComputePower();
-    statsInfoList = core_->GetBatteryStats();
+    statsInfoList = core_->GetStatsResult()->GetStatsInfoList();
     return statsInfoList;
 }
 
+void BatteryStatsService::GetBatteryStatsTable(BatteryStatsTable& table)
+{
+    table = BatteryStatsTable {};
+    if (!Permission::IsSystem()) {
+        lastError_ = static_cast<int32_t>(StatsError::ERR_SYSTEM_API_DENIED);
+        return;
+    }
+    auto result = core_->GetStatsResult();
+    const auto& statsInfoList = result->GetStatsInfoList();
+    table.uids.reserve(statsInfoList.size());
+    table.userIds.reserve(statsInfoList.size());
+    table.consumptionTypes.reserve(statsInfoList.size());
+    table.powerMah.reserve(statsInfoList.size());
+    for (const auto& info : statsInfoList) {
+        table.uids.push_back(info->GetUid());
+        table.userIds.push_back(info->GetUserId());
+        table.consumptionTypes.push_back(info->GetConsumptionType());
+        table.powerMah.push_back(info->GetPower());
+    }
+}
+
 int32_t BatteryStatsService::Dump(int32_t fd, const std::vector<std::u16string>& args)
 {
     if (!isBootCompleted_) {
@@ -210,6 +275,7 @@ int32_t BatteryStatsService::Dump(int32_t fd, const std::vector<std::u16string>&
         return ERR_PERMISSION_DENIED;
     }
     std::lock_guard lock(mutex_);
+    FlushStatsEvents();
     std::vector<std::string> argsInStr;
     std::transform(args.begin(), args.end(), std::back_inserter(argsInStr),
         [](const std::u16string &arg) {
@@ -228,45 +294,37 @@ int32_t BatteryStatsService::Dump(int32_t fd, const std::vector<std::u16string>&
 
 double BatteryStatsService::GetAppStatsMah(const int32_t& uid)
 {
-    std::lock_guard lock(mutex_);
     if (!Permission::IsSystem()) {
         lastError_ = static_cast<int32_t>(StatsError::ERR_SYSTEM_API_DENIED);
         return StatsUtils::DEFAULT_VALUE;
     }
-    core_->ComputePower();
     return core_->GetAppStatsMah(uid);
 }
 
 double BatteryStatsService::GetAppStatsPercent(const int32_t& uid)
 {
-    std::lock_guard lock(mutex_);
     if (!Permission::IsSystem()) {
         lastError_ = static_cast<int32_t>(StatsError::ERR_SYSTEM_API_DENIED);
         return StatsUtils::DEFAULT_VALUE;
     }
-    core_->ComputePower();
     return core_->GetAppStatsPercent(uid);
 }
 
 double BatteryStatsService::GetPartStatsMah(const BatteryStatsInfo::ConsumptionType& type)
 {
-    std::lock_guard lock(mutex_);
     if (!Permission::IsSystem()) {
         lastError_ = static_cast<int32_t>(StatsError::ERR_SYSTEM_API_DENIED);
         return StatsUtils::DEFAULT_VALUE;
     }
-    core_->ComputePower();
     return core_->GetPartStatsMah(type);
 }
 
 double BatteryStatsService::GetPartStatsPercent(const BatteryStatsInfo::ConsumptionType& type)
 {
-    std::lock_guard lock(mutex_);
     if (!Permission::IsSystem()) {
         lastError_ = static_cast<int32_t>(StatsError::ERR_SYSTEM_API_DENIED);
         return StatsUtils::DEFAULT_VALUE;
     }
-    core_->ComputePower();
     return core_->GetPartStatsPercent(type);
 }
 
@@ -277,6 +335,7 @@ uint64_t BatteryStatsService::GetTotalTimeSecond(const StatsUtils::StatsType& st
         return ERR_OK;
     }
     STATS_HILOGD(COMP_SVC, "statsType: %{public}d, uid: %{public}d", statsType, uid);
+    FlushStatsEvents();
     uint64_t timeSecond;
     if (uid > StatsUtils::INVALID_VALUE) {
         double timeMs = static_cast<double>(core_->GetTotalTimeMs(uid, statsType));
@@ -294,6 +353,7 @@ uint64_t BatteryStatsService::GetTotalDataBytes(const StatsUtils::StatsType& sta
         lastError_ = static_cast<int32_t>(StatsError::ERR_SYSTEM_API_DENIED);
         return ERR_OK;
     }
+    FlushStatsEvents();
     return core_->GetTotalDataCount(statsType, uid);
 }
 
@@ -305,6 +365,11 @@ void BatteryStatsService::Reset()
     core_->Reset();
 }
 
+void BatteryStatsService::SetStatsDir(const std::string& statsDir)
+{
+    statsDir_ = statsDir;
+}
+
 std::shared_ptr<BatteryStatsCore> BatteryStatsService::GetBatteryStatsCore() const
 {
     return core_;
@@ -320,12 +385,17 @@ std::shared_ptr<BatteryStatsDetector> BatteryStatsService::GetBatteryStatsDetect
     return detector_;
 }
 
+std::shared_ptr<BatteryStatsEventQueue> BatteryStatsService::GetBatteryStatsEventQueue() const
+{
+    return eventQueue_;
+}
+
 void BatteryStatsService::SetOnBattery(bool isOnBattery)
 {
     if (!Permission::IsSystem()) {
         return;
     }
-    StatsHelper::SetOnBattery(isOnBattery);
+    core_->SetOnBattery(isOnBattery);
 }
 
 std::string BatteryStatsService::ShellDump(const std::vector<std::string>& args, uint32_t argc)
@@ -334,6 +404,7 @@ std::string BatteryStatsService::ShellDump(const std::vector<std::string>& args,
         return "";
     }
     std::lock_guard lock(mutex_);
+    FlushStatsEvents();
     pid_t pid = IPCSkeleton::GetCallingPid();
     std::string result;
     bool ret = BatteryStatsDumper::Dump(args, result);
@@ -341,6 +412,112 @@ std::string BatteryStatsService::ShellDump(const std::vector<std::string>& args,
     return result;
 }
 
+void BatteryStatsService::GetAppStatsBatch(const std::vector<int32_t>& uids,
+    const std::vector<StatsUtils::StatsType>& statsTypes, std::vector<double>& appStatsMah,
+    std::vector<double>& appStatsPercent, std::vector<uint64_t>& totalTimeSecond)
+{
+    appStatsMah.clear();
+    appStatsPercent.clear();
+    totalTimeSecond.clear();
+    if (!Permission::IsSystem()) {
+        lastError_ = static_cast<int32_t>(StatsError::ERR_SYSTEM_API_DENIED);
+        return;
+    }
+    if (uids.size() > BATCH_MAX_UID_COUNT ||
+        (!statsTypes.empty() && uids.size() > BATCH_MAX_CELL_COUNT / statsTypes.size())) {
+        STATS_HILOGW(COMP_SVC, "Batch too large, uids: %{public}zu, types: %{public}zu", uids.size(),
+            statsTypes.size());
+        lastError_ = static_cast<int32_t>(StatsError::ERR_PARAM_INVALID);
+        return;
+    }
+    auto result = core_->GetStatsResult();
+    double totalPowerMah = result->GetTotalPowerMah();
+    appStatsMah.reserve(uids.size());
+    appStatsPercent.reserve(uids.size());
+    totalTimeSecond.reserve(uids.size() * statsTypes.size());
+    for (auto uid : uids) {
+        double powerMah = result->GetAppPowerMah(uid);
+        appStatsMah.push_back(powerMah);
+        appStatsPercent.push_back(totalPowerMah > StatsUtils::DEFAULT_VALUE ?
+            powerMah / totalPowerMah : StatsUtils::DEFAULT_VALUE);
+        for (auto statsType : statsTypes) {
+            int64_t timeMs = uid > StatsUtils::INVALID_VALUE ? core_->GetTotalTimeMs(uid, statsType) :
+                core_->GetTotalTimeMs(statsType);
+            totalTimeSecond.push_back(round(static_cast<double>(timeMs) / StatsUtils::MS_IN_SECOND));
+        }
+    }
+    STATS_HILOGD(COMP_SVC, "Batch stats got, uids: %{public}zu, types: %{public}zu", uids.size(),
+        statsTypes.size());
+}
+
+void BatteryStatsService::GetStatsHistory(int64_t beginTimeMs, int64_t endTimeMs, BatteryStatsHistoryInfo& history)
+{
+    history = BatteryStatsHistoryInfo {};
+    if (!Permission::IsSystem()) {
+        lastError_ = static_cast<int32_t>(StatsError::ERR_SYSTEM_API_DENIED);
+        return;
+    }
+    if (!core_->GetStatsHistory(beginTimeMs, endTimeMs, history)) {
+        STATS_HILOGW(COMP_SVC, "Invalid history range, begin: %{public}" PRId64 ", end: %{public}" PRId64,
+            beginTimeMs, endTimeMs);
+        lastError_ = static_cast<int32_t>(StatsError::ERR_PARAM_INVALID);
+        return;
+    }
+    STATS_HILOGD(COMP_SVC, "History got, buckets: %{public}zu, uids: %{public}zu", history.bucketStartMs.size(),
+        history.uids.size());
+}
+
+bool BatteryStatsService::RegisterStatsCallback(const sptr<IBatteryStatsCallback>& callback, int64_t minIntervalMs,
+    double thresholdMah)
+{
+    if (!Permission::IsSystem()) {
+        lastError_ = static_cast<int32_t>(StatsError::ERR_SYSTEM_API_DENIED);
+        return false;
+    }
+    if (notifier_ == nullptr || !notifier_->Subscribe(callback, minIntervalMs, thresholdMah)) {
+        lastError_ = static_cast<int32_t>(StatsError::ERR_PARAM_INVALID);
+        return false;
+    }
+    return true;
+}
+
+bool BatteryStatsService::UnregisterStatsCallback(const sptr<IBatteryStatsCallback>& callback)
+{
+    if (!Permission::IsSystem()) {
+        lastError_ = static_cast<int32_t>(StatsError::ERR_SYSTEM_API_DENIED);
+        return false;
+    }
+    if (notifier_ == nullptr || !notifier_->Unsubscribe(callback)) {
+        lastError_ = static_cast<int32_t>(StatsError::ERR_PARAM_INVALID);
+        return false;
+    }
+    return true;
+}
+
+void BatteryStatsService::GetTopWakelocks(uint32_t count, int32_t uid, std::vector<BatteryStatsWakelockInfo>& wakelocks)
+{
+    wakelocks.clear();
+    if (!Permission::IsSystem()) {
+        lastError_ = static_cast<int32_t>(StatsError::ERR_SYSTEM_API_DENIED);
+        return;
+    }
+    if (count == 0 || count > TOP_WAKELOCK_MAX_COUNT) {
+        STATS_HILOGW(COMP_SVC, "Invalid top wakelock count: %{public}u", count);
+        lastError_ = static_cast<int32_t>(StatsError::ERR_PARAM_INVALID);
+        return;
+    }
+    // Applies the wakelock events which are still queued
+    if (eventQueue_ != nullptr) {
+        eventQueue_->Flush();
+    }
+    auto topLocks = core_->GetTopWakelocks(count, uid);
+    wakelocks.reserve(topLocks.size());
+    for (auto& lock : topLocks) {
+        wakelocks.push_back({ lock.uid, std::move(lock.name), lock.holdTimeMs, lock.isHeld });
+    }
+    STATS_HILOGD(COMP_SVC, "Top wakelocks got: %{public}zu", wakelocks.size());
+}
+
 int32_t BatteryStatsService::GetBatteryStatsIpc(ParcelableBatteryStatsList& batteryStats, int32_t& tempError)
 {
     StatsXCollie statsXCollie("BatteryStatsService::GetBatteryStatsIpc", false);
@@ -350,6 +527,15 @@ int32_t BatteryStatsService::GetBatteryStatsIpc(ParcelableBatteryStatsList& batt
     return ERR_OK;
 }
 
+int32_t BatteryStatsService::GetBatteryStatsTableIpc(ParcelableBatteryStatsTable& batteryStats, int32_t& tempError)
+{
+    StatsXCollie statsXCollie("BatteryStatsService::GetBatteryStatsTableIpc", false);
+    GetBatteryStatsTable(batteryStats.table_);
+    tempError = lastError_.load();
+    lastError_ = static_cast<int32_t>(StatsError::ERR_OK);
+    return ERR_OK;
+}
+
 int32_t BatteryStatsService::GetAppStatsMahIpc(int32_t uid, double& appStatsMah, int32_t& tempError)
 {
     StatsXCollie statsXCollie("BatteryStatsService::GetAppStatsMahIpc", false);
@@ -421,6 +607,85 @@ int32_t BatteryStatsService::ShellDumpIpc(const std::vector<std::string>& args,
     return ERR_OK;
 }
 
+int32_t BatteryStatsService::GetAppStatsBatchIpc(const std::vector<int32_t>& uids,
+    const std::vector<int32_t>& statsTypes, std::vector<double>& appStatsMah, std::vector<double>& appStatsPercent,
+    std::vector<int64_t>& totalTimeSecond, int32_t& tempError)
+{
+    StatsXCollie statsXCollie("BatteryStatsService::GetAppStatsBatchIpc", false);
+    std::vector<StatsUtils::StatsType> types;
+    types.reserve(statsTypes.size());
+    for (auto statsType : statsTypes) {
+        types.push_back(static_cast<StatsUtils::StatsType>(statsType));
+    }
+    std::vector<uint64_t> timeSecond;
+    GetAppStatsBatch(uids, types, appStatsMah, appStatsPercent, timeSecond);
+    totalTimeSecond.assign(timeSecond.begin(), timeSecond.end());
+    tempError = lastError_.load();
+    lastError_ = static_cast<int32_t>(StatsError::ERR_OK);
+    return ERR_OK;
+}
+
+int32_t BatteryStatsService::GetStatsHistoryIpc(int64_t beginTimeMs, int64_t endTimeMs, int64_t& bucketSpanMs,
+    std::vector<int64_t>& bucketStartMs, std::vector<double>& totalPowerMah, std::vector<int32_t>& uids,
+    std::vector<double>& appPowerMah, std::vector<int32_t>& consumptionTypes, std::vector<double>& partPowerMah,
+    int32_t& tempError)
+{
+    StatsXCollie statsXCollie("BatteryStatsService::GetStatsHistoryIpc", false);
+    BatteryStatsHistoryInfo history;
+    GetStatsHistory(beginTimeMs, endTimeMs, history);
+    bucketSpanMs = history.bucketSpanMs;
+    bucketStartMs = std::move(history.bucketStartMs);
+    totalPowerMah = std::move(history.totalPowerMah);
+    uids = std::move(history.uids);
+    appPowerMah = std::move(history.appPowerMah);
+    consumptionTypes.assign(history.consumptionTypes.begin(), history.consumptionTypes.end());
+    partPowerMah = std::move(history.partPowerMah);
+    tempError = lastError_.load();
+    lastError_ = static_cast<int32_t>(StatsError::ERR_OK);
+    return ERR_OK;
+}
+
+int32_t BatteryStatsService::RegisterStatsCallbackIpc(const sptr<IBatteryStatsCallback>& callback,
+    int64_t minIntervalMs, double thresholdMah, int32_t& tempError)
+{
+    StatsXCollie statsXCollie("BatteryStatsService::RegisterStatsCallbackIpc", false);
+    RegisterStatsCallback(callback, minIntervalMs, thresholdMah);
+    tempError = lastError_.load();
+    lastError_ = static_cast<int32_t>(StatsError::ERR_OK);
+    return ERR_OK;
+}
+
+int32_t BatteryStatsService::UnregisterStatsCallbackIpc(const sptr<IBatteryStatsCallback>& callback,
+    int32_t& tempError)
+{
+    StatsXCollie statsXCollie("BatteryStatsService::UnregisterStatsCallbackIpc", false);
+    UnregisterStatsCallback(callback);
+    tempError = lastError_.load();
+    lastError_ = static_cast<int32_t>(StatsError::ERR_OK);
+    return ERR_OK;
+}
+
+int32_t BatteryStatsService::GetTopWakelocksIpc(uint32_t count, int32_t uid, std::vector<int32_t>& uids,
+    std::vector<std::string>& names, std::vector<int64_t>& holdTimeMs, std::vector<bool>& isHeld, int32_t& tempError)
+{
+    StatsXCollie statsXCollie("BatteryStatsService::GetTopWakelocksIpc", false);
+    std::vector<BatteryStatsWakelockInfo> wakelocks;
+    GetTopWakelocks(count, uid, wakelocks);
+    uids.clear();
+    names.clear();
+    holdTimeMs.clear();
+    isHeld.clear();
+    for (auto& wakelock : wakelocks) {
+        uids.push_back(wakelock.uid);
+        names.push_back(std::move(wakelock.name));
+        holdTimeMs.push_back(wakelock.holdTimeMs);
+        isHeld.push_back(wakelock.isHeld);
+    }
+    tempError = lastError_.load();
+    lastError_ = static_cast<int32_t>(StatsError::ERR_OK);
+    return ERR_OK;
+}
+
 void BatteryStatsService::DestroyInstance()
 {
     std::lock_guard<std::mutex> lock(singletonMutex_);
@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_stats_snapshot.h"
+
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "battery_stats_codec.h"
+#include "stats_log.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr size_t MAX_SNAPSHOT_SIZE = 16 * 1024 * 1024;
+constexpr mode_t SNAPSHOT_FILE_MODE = S_IRUSR | S_IWUSR | S_IRGRP;
+using SnapshotReader = BatteryStatsCodec::Reader;
+
+// The rename only survives a power loss once the directory entry is on disk too
+bool SyncParentDir(const std::string& path)
+{
+    size_t pos = path.find_last_of('/');
+    std::string dir = pos == std::string::npos ? "." : (pos == 0 ? "/" : path.substr(0, pos));
+    int32_t fd = open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        STATS_HILOGE(COMP_SVC, "Opening snapshot dir failed, errno: %{public}d", errno);
+        return false;
+    }
+    bool ret = fsync(fd) == 0;
+    if (!ret) {
+        STATS_HILOGE(COMP_SVC, "Syncing snapshot dir failed, errno: %{public}d", errno);
+    }
+    close(fd);
+    return ret;
+}
+
+bool DecodePowers(SnapshotReader& reader, std::vector<std::pair<int32_t, double>>& powers)
+{
+    size_t count = 0;
+    if (!reader.GetCount(count)) {
+        return false;
+    }
+    powers.resize(count);
+    for (auto& power : powers) {
+        int64_t id = 0;
+        if (!reader.GetSignedVarint(id) || !reader.GetDouble(power.second)) {
+            return false;
+        }
+        power.first = static_cast<int32_t>(id);
+    }
+    return true;
+}
+
+bool DecodePartValues(SnapshotReader& reader, std::vector<BatteryStatsSnapshot::PartValue>& partValues)
+{
+    size_t count = 0;
+    if (!reader.GetCount(count)) {
+        return false;
+    }
+    partValues.resize(count);
+    for (auto& partValue : partValues) {
+        int64_t statsType = 0;
+        int64_t level = 0;
+        if (!reader.GetSignedVarint(statsType) || !reader.GetSignedVarint(level) ||
+            !reader.GetSignedVarint(partValue.value)) {
+            return false;
+        }
+        partValue.statsType = static_cast<StatsUtils::StatsType>(statsType);
+        partValue.level = static_cast<int16_t>(level);
+    }
+    return true;
+}
+
+bool DecodeUids(SnapshotReader& reader, size_t uidCount, std::vector<int32_t>& uids,
+    std::vector<BatteryStatsSnapshot::UidColumn>& uidColumns)
+{
+    size_t count = 0;
+    if (!reader.GetCount(count) || count != uidCount) {
+        return false;
+    }
+    uids.resize(count);
+    uint64_t uid = 0;
+    for (auto& item : uids) {
+        uint64_t delta = 0;
+        if (!reader.GetVarint(delta)) {
+            return false;
+        }
+        uid += delta;
+        if (uid > INT32_MAX) {
+            return false;
+        }
+        item = static_cast<int32_t>(uid);
+    }
+    size_t columnCount = 0;
+    if (!reader.GetCount(columnCount)) {
+        return false;
+    }
+    uidColumns.resize(columnCount);
+    for (auto& column : uidColumns) {
+        int64_t statsType = 0;
+        if (!reader.GetSignedVarint(statsType) || reader.GetRemaining() < count) {
+            return false;
+        }
+        column.statsType = static_cast<StatsUtils::StatsType>(statsType);
+        column.values.resize(count);
+        for (auto& value : column.values) {
+            if (!reader.GetSignedVarint(value)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+} // namespace
+
+bool BatteryStatsSnapshot::Encode(std::string& buffer) const
+{
+    buffer.clear();
+    buffer.reserve(HEADER_SIZE + powers.size() * sizeof(double) * 2 + uids.size() * (uidColumns.size() + 1) * 2);
+    BatteryStatsCodec::PutFixed32(buffer, MAGIC);
+    BatteryStatsCodec::PutFixed16(buffer, VERSION);
+    BatteryStatsCodec::PutFixed16(buffer, HEADER_SIZE);
+    BatteryStatsCodec::PutFixed32(buffer, static_cast<uint32_t>(0));
+    BatteryStatsCodec::PutFixed32(buffer, static_cast<uint32_t>(0));
+    BatteryStatsCodec::PutFixed32(buffer, static_cast<uint32_t>(uids.size()));
+    BatteryStatsCodec::PutFixed32(buffer, static_cast<uint32_t>(0));
+
+    BatteryStatsCodec::PutVarint(buffer, powers.size());
+    for (const auto& power : powers) {
+        BatteryStatsCodec::PutSignedVarint(buffer, power.first);
+        BatteryStatsCodec::PutDouble(buffer, power.second);
+    }
+    BatteryStatsCodec::PutVarint(buffer, partValues.size());
+    for (const auto& partValue : partValues) {
+        BatteryStatsCodec::PutSignedVarint(buffer, partValue.statsType);
+        BatteryStatsCodec::PutSignedVarint(buffer, partValue.level);
+        BatteryStatsCodec::PutSignedVarint(buffer, partValue.value);
+    }
+    BatteryStatsCodec::PutVarint(buffer, uids.size());
+    int32_t lastUid = 0;
+    for (int32_t uid : uids) {
+        if (uid < lastUid) {
+            STATS_HILOGE(COMP_SVC, "Snapshot uids are not sorted, uid: %{public}d", uid);
+            return false;
+        }
+        BatteryStatsCodec::PutVarint(buffer, static_cast<uint64_t>(uid - lastUid));
+        lastUid = uid;
+    }
+    BatteryStatsCodec::PutVarint(buffer, uidColumns.size());
+    for (const auto& column : uidColumns) {
+        if (column.values.size() != uids.size()) {
+            STATS_HILOGE(COMP_SVC, "Snapshot column size mismatch, type: %{public}d", column.statsType);
+            return false;
+        }
+        BatteryStatsCodec::PutSignedVarint(buffer, column.statsType);
+        for (int64_t value : column.values) {
+            BatteryStatsCodec::PutSignedVarint(buffer, value);
+        }
+    }
+
+    size_t payloadSize = buffer.size() - HEADER_SIZE;
+    if (payloadSize > MAX_SNAPSHOT_SIZE) {
+        STATS_HILOGE(COMP_SVC, "Snapshot is too large: %{public}zu", payloadSize);
+        return false;
+    }
+    const size_t payloadSizeOffset = sizeof(MAGIC) + sizeof(VERSION) + sizeof(HEADER_SIZE);
+    BatteryStatsCodec::SetFixed32(buffer, payloadSizeOffset, static_cast<uint32_t>(payloadSize));
+    BatteryStatsCodec::SetFixed32(buffer, payloadSizeOffset + sizeof(uint32_t),
+        BatteryStatsCodec::Crc32(reinterpret_cast<const uint8_t*>(buffer.data()) + HEADER_SIZE, payloadSize));
+    return true;
+}
+
+bool BatteryStatsSnapshot::Decode(const uint8_t* data, size_t size)
+{
+    Clear();
+    if (data == nullptr || size < HEADER_SIZE) {
+        STATS_HILOGE(COMP_SVC, "Snapshot is too small: %{public}zu", size);
+        return false;
+    }
+    SnapshotReader header(data, HEADER_SIZE);
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    uint16_t headerSize = 0;
+    uint32_t payloadSize = 0;
+    uint32_t payloadCrc = 0;
+    uint32_t uidCount = 0;
+    header.GetFixed32(magic);
+    header.GetFixed16(version);
+    header.GetFixed16(headerSize);
+    header.GetFixed32(payloadSize);
+    header.GetFixed32(payloadCrc);
+    header.GetFixed32(uidCount);
+    if (magic != MAGIC || version != VERSION || headerSize != HEADER_SIZE) {
+        STATS_HILOGE(COMP_SVC, "Unsupported snapshot, magic: %{public}x, version: %{public}u", magic, version);
+        return false;
+    }
+    if (payloadSize != size - HEADER_SIZE || BatteryStatsCodec::Crc32(data + HEADER_SIZE, payloadSize) != payloadCrc) {
+        STATS_HILOGE(COMP_SVC, "Snapshot payload is corrupted, size: %{public}zu", size);
+        return false;
+    }
+
+    SnapshotReader reader(data + HEADER_SIZE, payloadSize);
+    if (!DecodePowers(reader, powers) || !DecodePartValues(reader, partValues) ||
+        !DecodeUids(reader, uidCount, uids, uidColumns) || reader.GetRemaining() != 0) {
+        STATS_HILOGE(COMP_SVC, "Failed to decode snapshot payload");
+        Clear();
+        return false;
+    }
+    return true;
+}
+
+bool BatteryStatsSnapshot::SaveToFile(const std::string& path, size_t* fileSize) const
+{
+    std::string buffer;
+    if (!Encode(buffer)) {
+        return false;
+    }
+    // Write a temporary file and rename it, a crash in between leaves the previous snapshot untouched
+    std::string tmpPath = path + ".tmp";
+    int32_t fd = open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, SNAPSHOT_FILE_MODE);
+    if (fd < 0) {
+        STATS_HILOGE(COMP_SVC, "Opening snapshot file failed, errno: %{public}d", errno);
+        return false;
+    }
+    bool ret = BatteryStatsCodec::WriteAll(fd, buffer) && fsync(fd) == 0;
+    if (!ret) {
+        STATS_HILOGE(COMP_SVC, "Writing snapshot file failed, errno: %{public}d", errno);
+    }
+    close(fd);
+    if (!ret || rename(tmpPath.c_str(), path.c_str()) != 0) {
+        STATS_HILOGE(COMP_SVC, "Saving snapshot file failed, errno: %{public}d", errno);
+        unlink(tmpPath.c_str());
+        return false;
+    }
+    if (!SyncParentDir(path)) {
+        return false;
+    }
+    STATS_HILOGD(COMP_SVC, "Saved snapshot, size: %{public}zu, uids: %{public}zu", buffer.size(), uids.size());
+    if (fileSize != nullptr) {
+        *fileSize = buffer.size();
+    }
+    return true;
+}
+
+bool BatteryStatsSnapshot::LoadFromFile(const std::string& path)
+{
+    Clear();
+    int32_t fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        STATS_HILOGW(COMP_SVC, "Snapshot file doesn't exist");
+        return false;
+    }
+    struct stat fileStat {};
+    if (fstat(fd, &fileStat) != 0 || fileStat.st_size < HEADER_SIZE ||
+        static_cast<size_t>(fileStat.st_size) > HEADER_SIZE + MAX_SNAPSHOT_SIZE) {
+        STATS_HILOGE(COMP_SVC, "Snapshot file has an invalid size");
+        close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(fileStat.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        STATS_HILOGE(COMP_SVC, "Mapping snapshot file failed, errno: %{public}d", errno);
+        return false;
+    }
+    bool ret = Decode(static_cast<const uint8_t*>(data), size);
+    munmap(data, size);
+    return ret;
+}
+
+void BatteryStatsSnapshot::Clear()
+{
+    powers.clear();
+    partValues.clear();
+    uids.clear();
+    uidColumns.clear();
+}
+} // namespace PowerMgr
+} // namespace OHOS
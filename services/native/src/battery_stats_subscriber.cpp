@@ -55,10 +55,14 @@ void BatteryStatsSubscriber::OnReceiveEvent(const OHOS::EventFwk::CommonEventDat
         }
         if (pluggedType == static_cast<int32_t>(BatteryPluggedType::PLUGGED_TYPE_NONE) ||
             pluggedType == static_cast<int32_t>(BatteryPluggedType::PLUGGED_TYPE_BUTT)) {
-            StatsHelper::SetOnBattery(true);
+            statsService->GetBatteryStatsCore()->SetOnBattery(true);
         } else {
-            StatsHelper::SetOnBattery(false);
+            statsService->GetBatteryStatsCore()->SetOnBattery(false);
         }
+    } else if (action == OHOS::EventFwk::CommonEventSupport::COMMON_EVENT_USER_ADDED ||
+        action == OHOS::EventFwk::CommonEventSupport::COMMON_EVENT_USER_REMOVED) {
+        STATS_HILOGI(COMP_SVC, "Received %{public}s event, userId=%{public}d", action.c_str(), data.GetCode());
+        statsService->GetBatteryStatsCore()->InvalidateUserIds();
     }
 }
 } // namespace PowerMgr
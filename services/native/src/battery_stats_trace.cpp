@@ -0,0 +1,320 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_stats_trace.h"
+
+#include <cerrno>
+#include <cinttypes>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "battery_stats_codec.h"
+#include "stats_helper.h"
+#include "stats_log.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr size_t FILE_HEADER_SIZE = sizeof(uint32_t) * 2;
+constexpr size_t FRAME_HEADER_SIZE = sizeof(uint32_t) * 2;
+constexpr size_t MAX_TRACE_READ_SIZE = 64 * 1024 * 1024;
+constexpr mode_t TRACE_FILE_MODE = S_IRUSR | S_IWUSR | S_IRGRP;
+
+void PutString(std::string& buffer, const std::string& value)
+{
+    BatteryStatsCodec::PutVarint(buffer, value.size());
+    buffer.append(value);
+}
+
+bool GetString(BatteryStatsCodec::Reader& reader, std::string& value)
+{
+    size_t size = 0;
+    if (!reader.GetCount(size)) {
+        return false;
+    }
+    value.assign(reinterpret_cast<const char*>(reader.GetPosition()), size);
+    return reader.Skip(size);
+}
+
+template<typename T>
+bool GetSigned(BatteryStatsCodec::Reader& reader, T& value)
+{
+    int64_t raw = 0;
+    if (!reader.GetSignedVarint(raw)) {
+        return false;
+    }
+    value = static_cast<T>(raw);
+    return true;
+}
+
+bool DecodeEvent(BatteryStatsCodec::Reader& reader, StatsUtils::StatsData& data)
+{
+    return GetSigned(reader, data.type) && GetSigned(reader, data.state) && GetSigned(reader, data.uid) &&
+        GetSigned(reader, data.pid) && GetSigned(reader, data.level) && GetSigned(reader, data.eventDataType) &&
+        GetSigned(reader, data.eventDataExtra) && GetSigned(reader, data.time) && GetSigned(reader, data.traffic) &&
+        GetString(reader, data.eventDataName) && GetString(reader, data.deviceId);
+}
+
+bool DecodeRecord(BatteryStatsCodec::Reader& reader, BatteryStatsTrace::Record& record)
+{
+    uint64_t type = 0;
+    int64_t bootDeltaMs = 0;
+    int64_t upDeltaMs = 0;
+    if (!reader.GetVarint(type) || !reader.GetSignedVarint(bootDeltaMs) || !reader.GetSignedVarint(upDeltaMs)) {
+        return false;
+    }
+    // The times of the previous record are carried in
+    record.type = static_cast<BatteryStatsTrace::RecordType>(type);
+    record.bootTimeMs += bootDeltaMs;
+    record.upTimeMs += upDeltaMs;
+    record.data = StatsUtils::StatsData();
+    record.isOnBattery = false;
+    if (record.type == BatteryStatsTrace::RECORD_EVENT) {
+        return DecodeEvent(reader, record.data);
+    }
+    if (record.type == BatteryStatsTrace::RECORD_POWER_SUPPLY) {
+        uint64_t isOnBattery = 0;
+        if (!reader.GetVarint(isOnBattery)) {
+            return false;
+        }
+        record.isOnBattery = isOnBattery != 0;
+        return true;
+    }
+    return false;
+}
+} // namespace
+
+BatteryStatsTrace::BatteryStatsTrace(const std::string& path) : BatteryStatsTrace(path, Config()) {}
+
+BatteryStatsTrace::BatteryStatsTrace(const std::string& path, const Config& config) : path_(path), config_(config) {}
+
+BatteryStatsTrace::~BatteryStatsTrace()
+{
+    Stop();
+}
+
+bool BatteryStatsTrace::Start()
+{
+    std::lock_guard lock(mutex_);
+    if (recording_.load()) {
+        STATS_HILOGD(COMP_SVC, "Trace is already recording");
+        return true;
+    }
+    fd_ = open(path_.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, TRACE_FILE_MODE);
+    if (fd_ < 0) {
+        STATS_HILOGE(COMP_SVC, "Open trace failed, errno: %{public}d", errno);
+        return false;
+    }
+    std::string header;
+    BatteryStatsCodec::PutFixed32(header, MAGIC);
+    BatteryStatsCodec::PutFixed16(header, VERSION);
+    BatteryStatsCodec::PutFixed16(header, 0);
+    if (!BatteryStatsCodec::WriteAll(fd_, header)) {
+        STATS_HILOGE(COMP_SVC, "Write trace header failed, errno: %{public}d", errno);
+        close(fd_);
+        fd_ = -1;
+        return false;
+    }
+    fileSize_ = header.size();
+    pending_.clear();
+    lastBootTimeMs_ = StatsUtils::DEFAULT_VALUE;
+    lastUpTimeMs_ = StatsUtils::DEFAULT_VALUE;
+    recordCount_ = 0;
+    recording_.store(true);
+
+    // The replay starts from the power supply state the device had
+    Record record;
+    record.type = RECORD_POWER_SUPPLY;
+    record.isOnBattery = StatsHelper::IsOnBattery();
+    AppendLocked(record);
+    STATS_HILOGI(COMP_SVC, "Trace recording is started");
+    return true;
+}
+
+void BatteryStatsTrace::Stop()
+{
+    std::lock_guard lock(mutex_);
+    if (recording_.load()) {
+        FlushLocked();
+    }
+    StopLocked();
+}
+
+void BatteryStatsTrace::StopLocked()
+{
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+        STATS_HILOGI(COMP_SVC, "Trace recording is stopped, records: %{public}" PRIu64 "", recordCount_);
+    }
+    pending_.clear();
+    recording_.store(false);
+}
+
+bool BatteryStatsTrace::IsRecording() const
+{
+    return recording_.load(std::memory_order_relaxed);
+}
+
+void BatteryStatsTrace::RecordEvent(const StatsUtils::StatsData& data)
+{
+    if (!IsRecording()) {
+        return;
+    }
+    Record record;
+    record.type = RECORD_EVENT;
+    record.data = data;
+    std::lock_guard lock(mutex_);
+    if (recording_.load()) {
+        AppendLocked(record);
+    }
+}
+
+void BatteryStatsTrace::RecordPowerSupply(bool isOnBattery)
+{
+    if (!IsRecording()) {
+        return;
+    }
+    Record record;
+    record.type = RECORD_POWER_SUPPLY;
+    record.isOnBattery = isOnBattery;
+    std::lock_guard lock(mutex_);
+    if (recording_.load()) {
+        AppendLocked(record);
+    }
+}
+
+void BatteryStatsTrace::AppendLocked(const Record& record)
+{
+    // Stamped under the lock, so the times in the trace never go back
+    int64_t bootTimeMs = StatsHelper::GetBootTimeMs();
+    int64_t upTimeMs = StatsHelper::GetUpTimeMs();
+    BatteryStatsCodec::PutVarint(pending_, record.type);
+    BatteryStatsCodec::PutSignedVarint(pending_, bootTimeMs - lastBootTimeMs_);
+    BatteryStatsCodec::PutSignedVarint(pending_, upTimeMs - lastUpTimeMs_);
+    lastBootTimeMs_ = bootTimeMs;
+    lastUpTimeMs_ = upTimeMs;
+    if (record.type == RECORD_EVENT) {
+        const StatsUtils::StatsData& data = record.data;
+        BatteryStatsCodec::PutSignedVarint(pending_, data.type);
+        BatteryStatsCodec::PutSignedVarint(pending_, data.state);
+        BatteryStatsCodec::PutSignedVarint(pending_, data.uid);
+        BatteryStatsCodec::PutSignedVarint(pending_, data.pid);
+        BatteryStatsCodec::PutSignedVarint(pending_, data.level);
+        BatteryStatsCodec::PutSignedVarint(pending_, data.eventDataType);
+        BatteryStatsCodec::PutSignedVarint(pending_, data.eventDataExtra);
+        BatteryStatsCodec::PutSignedVarint(pending_, data.time);
+        BatteryStatsCodec::PutSignedVarint(pending_, data.traffic);
+        PutString(pending_, data.eventDataName);
+        PutString(pending_, data.deviceId);
+    } else {
+        BatteryStatsCodec::PutVarint(pending_, record.isOnBattery ? 1 : 0);
+    }
+    recordCount_++;
+    if (pending_.size() >= config_.flushThresholdBytes) {
+        FlushLocked();
+    }
+}
+
+bool BatteryStatsTrace::FlushLocked()
+{
+    if (pending_.empty() || fd_ < 0) {
+        return true;
+    }
+    if (fileSize_ + FRAME_HEADER_SIZE + pending_.size() > config_.maxBytes) {
+        STATS_HILOGW(COMP_SVC, "Trace reached its size limit: %{public}zu, stop recording", config_.maxBytes);
+        StopLocked();
+        return false;
+    }
+    frame_.clear();
+    BatteryStatsCodec::PutFixed32(frame_, static_cast<uint32_t>(pending_.size()));
+    BatteryStatsCodec::PutFixed32(frame_,
+        BatteryStatsCodec::Crc32(reinterpret_cast<const uint8_t*>(pending_.data()), pending_.size()));
+    frame_.append(pending_);
+    pending_.clear();
+    if (!BatteryStatsCodec::WriteAll(fd_, frame_)) {
+        STATS_HILOGE(COMP_SVC, "Write trace failed, errno: %{public}d, stop recording", errno);
+        failCount_++;
+        StopLocked();
+        return false;
+    }
+    fileSize_ += frame_.size();
+    return true;
+}
+
+bool BatteryStatsTrace::Read(const std::string& path, std::vector<Record>& records)
+{
+    records.clear();
+    std::string buffer;
+    size_t fileSize = 0;
+    if (!BatteryStatsCodec::ReadFile(path, MAX_TRACE_READ_SIZE, buffer, fileSize)) {
+        STATS_HILOGW(COMP_SVC, "Trace file doesn't exist");
+        return false;
+    }
+    BatteryStatsCodec::Reader reader(reinterpret_cast<const uint8_t*>(buffer.data()), buffer.size());
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    uint16_t reserved = 0;
+    if (buffer.size() < FILE_HEADER_SIZE || !reader.GetFixed32(magic) || !reader.GetFixed16(version) ||
+        !reader.GetFixed16(reserved) || magic != MAGIC || version != VERSION) {
+        STATS_HILOGE(COMP_SVC, "Unknown trace format");
+        return false;
+    }
+    Record record;
+    std::vector<Record> frameRecords;
+    while (reader.GetRemaining() >= FRAME_HEADER_SIZE) {
+        uint32_t payloadSize = 0;
+        uint32_t payloadCrc = 0;
+        reader.GetFixed32(payloadSize);
+        reader.GetFixed32(payloadCrc);
+        const uint8_t* payload = reader.GetPosition();
+        if (payloadSize > reader.GetRemaining() || BatteryStatsCodec::Crc32(payload, payloadSize) != payloadCrc) {
+            STATS_HILOGW(COMP_SVC, "Trace frame is torn or corrupted, drop the rest");
+            return true;
+        }
+        BatteryStatsCodec::Reader frameReader(payload, payloadSize);
+        frameRecords.clear();
+        while (frameReader.GetRemaining() > 0) {
+            if (!DecodeRecord(frameReader, record)) {
+                STATS_HILOGW(COMP_SVC, "Undecodable trace record, drop the rest");
+                return true;
+            }
+            frameRecords.push_back(record);
+        }
+        records.insert(records.end(), frameRecords.begin(), frameRecords.end());
+        reader.Skip(payloadSize);
+    }
+    if (fileSize > buffer.size()) {
+        STATS_HILOGW(COMP_SVC, "Trace is too large: %{public}zu, only read the head", fileSize);
+    }
+    return true;
+}
+
+void BatteryStatsTrace::DumpInfo(std::string& result)
+{
+    std::lock_guard lock(mutex_);
+    result.append("Trace: recording = ")
+        .append(recording_.load() ? "true" : "false")
+        .append(", records = ")
+        .append(std::to_string(recordCount_))
+        .append(", bytes = ")
+        .append(std::to_string(fileSize_ + pending_.size()))
+        .append(", failures = ")
+        .append(std::to_string(failCount_))
+        .append("\n");
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_stats_traffic.h"
+
+#include <algorithm>
+
+#include "stats_helper.h"
+#include "stats_log.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr uint32_t NETWORK_KEY_BITS = 8;
+constexpr uint32_t UID_HASH_MULTIPLIER = 2654435761u;
+constexpr double BYTES_IN_MB = 1024.0 * 1024.0;
+constexpr const char* NETWORK_NAMES[TrafficSource::NETWORK_BUTT] = { "wifi", "cellular" };
+
+uint64_t MakeKey(int32_t uid, TrafficSource::Network network)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(uid)) << NETWORK_KEY_BITS) | network;
+}
+
+int32_t GetKeyUid(uint64_t key)
+{
+    return static_cast<int32_t>(static_cast<uint32_t>(key >> NETWORK_KEY_BITS));
+}
+
+TrafficSource::Network GetKeyNetwork(uint64_t key)
+{
+    return static_cast<TrafficSource::Network>(key & ((1u << NETWORK_KEY_BITS) - 1));
+}
+
+size_t GetUidHash(int32_t uid)
+{
+    return static_cast<size_t>(static_cast<uint32_t>(uid) * UID_HASH_MULTIPLIER);
+}
+} // namespace
+
+BatteryStatsTraffic::BatteryStatsTraffic(std::unique_ptr<TrafficSource> source, size_t maxUids)
+    : source_(std::move(source)), maxUids_(std::max<size_t>(maxUids, 1))
+{
+    // At most half full, so a probe always ends at an empty slot
+    capacity_ = 1;
+    while (capacity_ < maxUids_ * 2) {
+        capacity_ <<= 1;
+    }
+    slots_ = std::make_unique<Slot[]>(capacity_);
+}
+
+size_t BatteryStatsTraffic::GetCounter(TrafficSource::Network network, Direction direction)
+{
+    return static_cast<size_t>(network) * DIRECTION_BUTT + direction;
+}
+
+const BatteryStatsTraffic::Slot* BatteryStatsTraffic::FindSlot(int32_t uid) const
+{
+    if (uid <= StatsUtils::INVALID_VALUE) {
+        return nullptr;
+    }
+    const size_t mask = capacity_ - 1;
+    size_t index = GetUidHash(uid) & mask;
+    for (size_t i = 0; i < capacity_; i++) {
+        const Slot& slot = slots_[(index + i) & mask];
+        int32_t slotUid = slot.uid.load(std::memory_order_acquire);
+        if (slotUid == uid) {
+            return &slot;
+        }
+        if (slotUid == EMPTY_UID) {
+            break;
+        }
+    }
+    return nullptr;
+}
+
+BatteryStatsTraffic::Slot* BatteryStatsTraffic::GetOrCreateSlotLocked(int32_t uid)
+{
+    const size_t mask = capacity_ - 1;
+    size_t index = GetUidHash(uid) & mask;
+    for (size_t i = 0; i < capacity_; i++) {
+        Slot& slot = slots_[(index + i) & mask];
+        int32_t slotUid = slot.uid.load(std::memory_order_relaxed);
+        if (slotUid == uid) {
+            return &slot;
+        }
+        if (slotUid != EMPTY_UID) {
+            continue;
+        }
+        if (uidCount_.load(std::memory_order_relaxed) >= maxUids_) {
+            break;
+        }
+        // The counters of an empty slot are zero, so a reader finding the uid sees no stale bytes
+        slot.uid.store(uid, std::memory_order_release);
+        uidCount_.fetch_add(1, std::memory_order_relaxed);
+        return &slot;
+    }
+    if (overflowCount_.fetch_add(1, std::memory_order_relaxed) == 0) {
+        STATS_HILOGW(COMP_SVC, "Traffic uid slots are full, max uids: %{public}zu", maxUids_);
+    }
+    return nullptr;
+}
+
+void BatteryStatsTraffic::AddLocked(int32_t uid, TrafficSource::Network network,
+    const std::array<uint64_t, DIRECTION_BUTT>& bytes)
+{
+    if (std::all_of(bytes.begin(), bytes.end(), [](uint64_t value) { return value == 0; })) {
+        return;
+    }
+    Slot* slot = GetOrCreateSlotLocked(uid);
+    for (uint8_t direction = 0; direction < DIRECTION_BUTT; direction++) {
+        size_t counter = GetCounter(network, static_cast<Direction>(direction));
+        if (slot != nullptr) {
+            slot->bytes[counter].fetch_add(bytes[direction], std::memory_order_relaxed);
+        }
+        totalBytes_[counter].fetch_add(bytes[direction], std::memory_order_relaxed);
+    }
+}
+
+bool BatteryStatsTraffic::Update()
+{
+    std::lock_guard lock(updateMutex_);
+    currentBytes_.clear();
+    bool result = source_->Read([this](int32_t uid, TrafficSource::Network network, uint64_t rxBytes,
+        uint64_t txBytes) {
+        auto& bytes = currentBytes_[MakeKey(uid, network)];
+        bytes[DIRECTION_RX] += rxBytes;
+        bytes[DIRECTION_TX] += txBytes;
+        return true;
+    });
+    if (!result) {
+        if (readFailCount_++ == 0) {
+            STATS_HILOGW(COMP_SVC, "Read %{public}s traffic source failed", source_->GetName());
+        }
+        return false;
+    }
+    // The increments only count while on battery, otherwise the bytes are just remembered
+    if (hasBaseline_ && StatsHelper::IsOnBattery()) {
+        for (const auto& [key, bytes] : currentBytes_) {
+            auto last = lastBytes_.find(key);
+            std::array<uint64_t, DIRECTION_BUTT> delta {};
+            for (uint8_t direction = 0; direction < DIRECTION_BUTT; direction++) {
+                uint64_t lastValue = last != lastBytes_.end() ? last->second[direction] : 0;
+                // The counters of an interface start again from zero when it is recreated
+                delta[direction] = bytes[direction] >= lastValue ? bytes[direction] - lastValue : bytes[direction];
+            }
+            AddLocked(GetKeyUid(key), GetKeyNetwork(key), delta);
+        }
+    }
+    lastBytes_.swap(currentBytes_);
+    hasBaseline_ = true;
+    updateCount_.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+uint64_t BatteryStatsTraffic::GetBytes(TrafficSource::Network network, Direction direction, int32_t uid) const
+{
+    if (network >= TrafficSource::NETWORK_BUTT || direction >= DIRECTION_BUTT) {
+        return StatsUtils::DEFAULT_VALUE;
+    }
+    size_t counter = GetCounter(network, direction);
+    if (uid == StatsUtils::INVALID_VALUE) {
+        return totalBytes_[counter].load(std::memory_order_relaxed);
+    }
+    const Slot* slot = FindSlot(uid);
+    return slot != nullptr ? slot->bytes[counter].load(std::memory_order_relaxed) : StatsUtils::DEFAULT_VALUE;
+}
+
+uint64_t BatteryStatsTraffic::GetBytes(TrafficSource::Network network, int32_t uid) const
+{
+    return GetBytes(network, DIRECTION_RX, uid) + GetBytes(network, DIRECTION_TX, uid);
+}
+
+double BatteryStatsTraffic::GetPowerMah(TrafficSource::Network network, double rxMahPerMb, double txMahPerMb,
+    int32_t uid) const
+{
+    double rxMb = static_cast<double>(GetBytes(network, DIRECTION_RX, uid)) / BYTES_IN_MB;
+    double txMb = static_cast<double>(GetBytes(network, DIRECTION_TX, uid)) / BYTES_IN_MB;
+    return rxMb * rxMahPerMb + txMb * txMahPerMb;
+}
+
+void BatteryStatsTraffic::Reset(TrafficSource::Network network)
+{
+    if (network >= TrafficSource::NETWORK_BUTT) {
+        return;
+    }
+    std::lock_guard lock(updateMutex_);
+    for (uint8_t direction = 0; direction < DIRECTION_BUTT; direction++) {
+        size_t counter = GetCounter(network, static_cast<Direction>(direction));
+        for (size_t i = 0; i < capacity_; i++) {
+            slots_[i].bytes[counter].store(0, std::memory_order_relaxed);
+        }
+        totalBytes_[counter].store(0, std::memory_order_relaxed);
+    }
+}
+
+void BatteryStatsTraffic::DumpInfo(std::string& result) const
+{
+    result.append("Traffic: source = ")
+        .append(source_->GetName())
+        .append(", updates = ")
+        .append(std::to_string(updateCount_.load()))
+        .append(", uids = ")
+        .append(std::to_string(uidCount_.load()))
+        .append("/")
+        .append(std::to_string(maxUids_))
+        .append(", overflow = ")
+        .append(std::to_string(overflowCount_.load()))
+        .append("\n");
+    for (uint8_t network = 0; network < TrafficSource::NETWORK_BUTT; network++) {
+        auto type = static_cast<TrafficSource::Network>(network);
+        result.append(NETWORK_NAMES[network])
+            .append(" traffic: rx = ")
+            .append(std::to_string(GetBytes(type, DIRECTION_RX)))
+            .append("B, tx = ")
+            .append(std::to_string(GetBytes(type, DIRECTION_TX)))
+            .append("B\n");
+    }
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "battery_stats_uid_table.h"
+
+#include "stats_log.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr size_t MIN_BUCKET_COUNT = 64;
+constexpr uint32_t HASH_MULTIPLIER = 0x9E3779B1;
+constexpr uint32_t HASH_SHIFT = 16;
+}
+
+size_t BatteryStatsUidTable::GetBucketIndex(int32_t uid) const
+{
+    uint32_t hash = static_cast<uint32_t>(uid) * HASH_MULTIPLIER;
+    return (hash ^ (hash >> HASH_SHIFT)) & (buckets_.size() - 1);
+}
+
+uint32_t BatteryStatsUidTable::FindSlotInBuckets(int32_t uid) const
+{
+    if (uid <= StatsUtils::INVALID_VALUE || buckets_.empty()) {
+        return INVALID_SLOT;
+    }
+    // Linear probing, the table is kept at most half full so an empty bucket always ends the probe
+    for (size_t index = GetBucketIndex(uid);; index = (index + 1) & (buckets_.size() - 1)) {
+        const Bucket& bucket = buckets_[index];
+        if (bucket.uid == uid) {
+            lastFound_ = bucket;
+            return bucket.slot;
+        }
+        if (bucket.slot == INVALID_SLOT) {
+            return INVALID_SLOT;
+        }
+    }
+}
+
+void BatteryStatsUidTable::InsertBucket(int32_t uid, uint32_t slot)
+{
+    size_t index = GetBucketIndex(uid);
+    while (buckets_[index].slot != INVALID_SLOT) {
+        index = (index + 1) & (buckets_.size() - 1);
+    }
+    buckets_[index].uid = uid;
+    buckets_[index].slot = slot;
+}
+
+void BatteryStatsUidTable::Rehash(size_t bucketCount)
+{
+    buckets_.assign(bucketCount, Bucket());
+    for (uint32_t slot = 0; slot < uids_.size(); slot++) {
+        InsertBucket(uids_[slot], slot);
+    }
+}
+
+uint32_t BatteryStatsUidTable::GetOrCreateSlot(int32_t uid)
+{
+    uint32_t slot = FindSlot(uid);
+    if (slot != INVALID_SLOT || uid <= StatsUtils::INVALID_VALUE) {
+        return slot;
+    }
+    if ((uids_.size() + 1) * 2 > buckets_.size()) {
+        Rehash(buckets_.empty() ? MIN_BUCKET_COUNT : buckets_.size() * 2);
+    }
+    slot = static_cast<uint32_t>(uids_.size());
+    if (slot % SLOTS_PER_BLOCK == 0) {
+        blocks_.push_back(std::make_shared<Block>());
+    }
+    uids_.push_back(uid);
+    InsertBucket(uid, slot);
+    STATS_HILOGD(COMP_SVC, "Create slot: %{public}u for uid: %{public}d", slot, uid);
+    return slot;
+}
+
+uint32_t BatteryStatsUidTable::GetSlotCount() const
+{
+    return static_cast<uint32_t>(uids_.size());
+}
+
+int32_t BatteryStatsUidTable::GetUid(uint32_t slot) const
+{
+    return slot < uids_.size() ? uids_[slot] : StatsUtils::INVALID_VALUE;
+}
+
+template<typename T, size_t N>
+T* BatteryStatsUidTable::GetOrCreateCell(LazyColumn<T, N>& columns, size_t column, uint32_t slot)
+{
+    auto& cells = columns[column];
+    // Allocated the first time a uid of the block uses the column
+    if (cells == nullptr) {
+        cells = std::make_unique<std::array<T, SLOTS_PER_BLOCK>>();
+    }
+    return &(*cells)[slot % SLOTS_PER_BLOCK];
+}
+
+template<typename T, size_t N>
+T* BatteryStatsUidTable::FindCell(const LazyColumn<T, N>& columns, size_t column, uint32_t slot)
+{
+    const auto& cells = columns[column];
+    return cells == nullptr ? nullptr : &(*cells)[slot % SLOTS_PER_BLOCK];
+}
+
+std::shared_ptr<StatsHelper::ActiveTimer> BatteryStatsUidTable::GetOrCreateTimer(int32_t uid, TimerColumn column)
+{
+    uint32_t slot = GetOrCreateSlot(uid);
+    if (slot == INVALID_SLOT || column >= TIMER_COLUMN_END) {
+        return nullptr;
+    }
+    const auto& block = blocks_[slot / SLOTS_PER_BLOCK];
+    return std::shared_ptr<StatsHelper::ActiveTimer>(block, GetOrCreateCell(block->timers, column, slot));
+}
+
+int64_t BatteryStatsUidTable::GetRunningTimeMs(int32_t uid, TimerColumn column)
+{
+    uint32_t slot = FindSlot(uid);
+    if (slot == INVALID_SLOT || column >= TIMER_COLUMN_END) {
+        return StatsUtils::DEFAULT_VALUE;
+    }
+    const StatsHelper::ActiveTimer* timer = FindCell(blocks_[slot / SLOTS_PER_BLOCK]->timers, column, slot);
+    return timer == nullptr ? StatsUtils::DEFAULT_VALUE : timer->GetRunningTimeMs();
+}
+
+std::shared_ptr<StatsHelper::Counter> BatteryStatsUidTable::GetOrCreateCounter(int32_t uid, CounterColumn column)
+{
+    uint32_t slot = GetOrCreateSlot(uid);
+    if (slot == INVALID_SLOT || column >= COUNTER_COLUMN_END) {
+        return nullptr;
+    }
+    const auto& block = blocks_[slot / SLOTS_PER_BLOCK];
+    return std::shared_ptr<StatsHelper::Counter>(block, GetOrCreateCell(block->counters, column, slot));
+}
+
+int64_t BatteryStatsUidTable::GetCount(int32_t uid, CounterColumn column)
+{
+    uint32_t slot = FindSlot(uid);
+    if (slot == INVALID_SLOT || column >= COUNTER_COLUMN_END) {
+        return StatsUtils::DEFAULT_VALUE;
+    }
+    StatsHelper::Counter* counter = FindCell(blocks_[slot / SLOTS_PER_BLOCK]->counters, column, slot);
+    return counter == nullptr ? StatsUtils::DEFAULT_VALUE : counter->GetCount();
+}
+
+double BatteryStatsUidTable::GetPower(int32_t uid, PowerColumn column) const
+{
+    uint32_t slot = FindSlot(uid);
+    if (slot == INVALID_SLOT || column >= POWER_COLUMN_END) {
+        return StatsUtils::DEFAULT_VALUE;
+    }
+    return blocks_[slot / SLOTS_PER_BLOCK]->powers[column][slot % SLOTS_PER_BLOCK];
+}
+
+void BatteryStatsUidTable::SetPower(int32_t uid, PowerColumn column, double power)
+{
+    uint32_t slot = GetOrCreateSlot(uid);
+    if (slot == INVALID_SLOT || column >= POWER_COLUMN_END) {
+        return;
+    }
+    blocks_[slot / SLOTS_PER_BLOCK]->powers[column][slot % SLOTS_PER_BLOCK] = power;
+}
+
+int64_t BatteryStatsUidTable::GetData(int32_t uid, DataColumn column) const
+{
+    uint32_t slot = FindSlot(uid);
+    if (slot == INVALID_SLOT || column >= DATA_COLUMN_END) {
+        return StatsUtils::DEFAULT_VALUE;
+    }
+    return blocks_[slot / SLOTS_PER_BLOCK]->data[column][slot % SLOTS_PER_BLOCK];
+}
+
+void BatteryStatsUidTable::SetData(int32_t uid, DataColumn column, int64_t data)
+{
+    uint32_t slot = GetOrCreateSlot(uid);
+    if (slot == INVALID_SLOT || column >= DATA_COLUMN_END) {
+        return;
+    }
+    blocks_[slot / SLOTS_PER_BLOCK]->data[column][slot % SLOTS_PER_BLOCK] = data;
+}
+
+void BatteryStatsUidTable::ResetColumn(TimerColumn column)
+{
+    if (column >= TIMER_COLUMN_END) {
+        return;
+    }
+    for (const auto& block : blocks_) {
+        if (block->timers[column] == nullptr) {
+            continue;
+        }
+        for (auto& timer : *block->timers[column]) {
+            timer.Reset();
+        }
+    }
+}
+
+void BatteryStatsUidTable::ResetColumn(CounterColumn column)
+{
+    if (column >= COUNTER_COLUMN_END) {
+        return;
+    }
+    for (const auto& block : blocks_) {
+        if (block->counters[column] == nullptr) {
+            continue;
+        }
+        for (auto& counter : *block->counters[column]) {
+            counter.Reset();
+        }
+    }
+}
+
+void BatteryStatsUidTable::ResetColumn(PowerColumn column)
+{
+    if (column >= POWER_COLUMN_END) {
+        return;
+    }
+    for (const auto& block : blocks_) {
+        block->powers[column].fill(StatsUtils::DEFAULT_VALUE);
+    }
+}
+
+void BatteryStatsUidTable::ResetColumn(DataColumn column)
+{
+    if (column >= DATA_COLUMN_END) {
+        return;
+    }
+    for (const auto& block : blocks_) {
+        block->data[column].fill(StatsUtils::DEFAULT_VALUE);
+    }
+}
+
+size_t BatteryStatsUidTable::GetMemoryUsage() const
+{
+    size_t usage = sizeof(*this) + buckets_.capacity() * sizeof(Bucket) + uids_.capacity() * sizeof(int32_t) +
+        blocks_.capacity() * sizeof(std::shared_ptr<Block>) + blocks_.size() * sizeof(Block);
+    for (const auto& block : blocks_) {
+        for (const auto& timers : block->timers) {
+            usage += timers == nullptr ? 0 : sizeof(*timers);
+        }
+        for (const auto& counters : block->counters) {
+            usage += counters == nullptr ? 0 : sizeof(*counters);
+        }
+    }
+    return usage;
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cpu_time_kernel.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+#if defined(__AVX2__)
+constexpr size_t LANES = 4;
+
+// Exact int64 to double conversion, AVX2 has no instruction for it
+__m256d ConvertToDouble(__m256i value)
+{
+    const double highMagic = 442721857769029238784.0;           // 3 * 2^67
+    const double allMagic = 442726361368656609280.0;            // 3 * 2^67 + 2^52
+    const int64_t lowMagic = 0x4330000000000000;                // 2^52 as double bits
+    __m256i high = _mm256_srai_epi32(value, 16);                // 16: keep the upper 48 bits with their sign
+    high = _mm256_blend_epi16(high, _mm256_setzero_si256(), 0x33);
+    high = _mm256_add_epi64(high, _mm256_castpd_si256(_mm256_set1_pd(highMagic)));
+    __m256i low = _mm256_blend_epi16(value, _mm256_set1_epi64x(lowMagic), 0x88);
+    __m256d highDouble = _mm256_sub_pd(_mm256_castsi256_pd(high), _mm256_set1_pd(allMagic));
+    return _mm256_add_pd(highDouble, _mm256_castsi256_pd(low));
+}
+#elif defined(__SSE2__)
+constexpr size_t LANES = 2;
+
+// SSE2 has no 64-bit compare, the sign of the upper half is spread over the whole lane instead
+__m128i NegativeMask(__m128i value)
+{
+    const int32_t signShift = 31;
+    __m128i sign = _mm_srai_epi32(value, signShift);
+    return _mm_shuffle_epi32(sign, _MM_SHUFFLE(3, 3, 1, 1));
+}
+#elif defined(__aarch64__)
+constexpr size_t LANES = 2;
+#endif
+} // namespace
+
+bool CpuTimeKernel::AccumulateScalar(const int64_t* current, int64_t* last, int64_t* total, size_t count,
+    bool replace)
+{
+    bool clamped = false;
+    for (size_t i = 0; i < count; i++) {
+        // Wraps around like the vector subtraction does
+        int64_t increment = static_cast<int64_t>(static_cast<uint64_t>(current[i]) - static_cast<uint64_t>(last[i]));
+        if (increment < 0) {
+            increment = 0;
+            clamped = true;
+        }
+        last[i] = current[i];
+        if (total == nullptr) {
+            continue;
+        }
+        total[i] = replace ? increment : total[i] + increment;
+    }
+    return clamped;
+}
+
+bool CpuTimeKernel::Accumulate(const int64_t* current, int64_t* last, int64_t* total, size_t count, bool replace)
+{
+    size_t i = 0;
+#if defined(__AVX2__)
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i negative = zero;
+    for (; i + LANES <= count; i += LANES) {
+        __m256i now = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(current + i));
+        __m256i before = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(last + i));
+        __m256i increment = _mm256_sub_epi64(now, before);
+        __m256i mask = _mm256_cmpgt_epi64(zero, increment);
+        negative = _mm256_or_si256(negative, mask);
+        increment = _mm256_andnot_si256(mask, increment);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(last + i), now);
+        if (total != nullptr) {
+            __m256i* out = reinterpret_cast<__m256i*>(total + i);
+            _mm256_storeu_si256(out, replace ? increment : _mm256_add_epi64(_mm256_loadu_si256(out), increment));
+        }
+    }
+    bool clamped = !_mm256_testz_si256(negative, negative);
+#elif defined(__SSE2__)
+    __m128i negative = _mm_setzero_si128();
+    for (; i + LANES <= count; i += LANES) {
+        __m128i now = _mm_loadu_si128(reinterpret_cast<const __m128i*>(current + i));
+        __m128i before = _mm_loadu_si128(reinterpret_cast<const __m128i*>(last + i));
+        __m128i increment = _mm_sub_epi64(now, before);
+        __m128i mask = NegativeMask(increment);
+        negative = _mm_or_si128(negative, mask);
+        increment = _mm_andnot_si128(mask, increment);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(last + i), now);
+        if (total != nullptr) {
+            __m128i* out = reinterpret_cast<__m128i*>(total + i);
+            _mm_storeu_si128(out, replace ? increment : _mm_add_epi64(_mm_loadu_si128(out), increment));
+        }
+    }
+    bool clamped = _mm_movemask_epi8(negative) != 0;
+#elif defined(__aarch64__)
+    uint64x2_t negative = vdupq_n_u64(0);
+    for (; i + LANES <= count; i += LANES) {
+        int64x2_t now = vld1q_s64(current + i);
+        int64x2_t increment = vsubq_s64(now, vld1q_s64(last + i));
+        uint64x2_t mask = vcltzq_s64(increment);
+        negative = vorrq_u64(negative, mask);
+        increment = vbicq_s64(increment, vreinterpretq_s64_u64(mask));
+        vst1q_s64(last + i, now);
+        if (total != nullptr) {
+            vst1q_s64(total + i, replace ? increment : vaddq_s64(vld1q_s64(total + i), increment));
+        }
+    }
+    bool clamped = vmaxvq_u32(vreinterpretq_u32_u64(negative)) != 0;
+#else
+    bool clamped = false;
+#endif
+    if (i < count) {
+        bool tailClamped = AccumulateScalar(current + i, last + i, total == nullptr ? nullptr : total + i,
+            count - i, replace);
+        clamped = clamped || tailClamped;
+    }
+    return clamped;
+}
+
+double CpuTimeKernel::DotScalar(const double* weights, const int64_t* values, size_t count)
+{
+    double sum = 0.0;
+    for (size_t i = 0; i < count; i++) {
+        sum += weights[i] * static_cast<double>(values[i]);
+    }
+    return sum;
+}
+
+double CpuTimeKernel::Dot(const double* weights, const int64_t* values, size_t count)
+{
+    size_t i = 0;
+    double sum = 0.0;
+#if defined(__AVX2__)
+    __m256d sums = _mm256_setzero_pd();
+    for (; i + LANES <= count; i += LANES) {
+        __m256d value = ConvertToDouble(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + i)));
+        sums = _mm256_add_pd(sums, _mm256_mul_pd(_mm256_loadu_pd(weights + i), value));
+    }
+    double lanes[LANES];
+    _mm256_storeu_pd(lanes, sums);
+    sum = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]); // 2, 3: the upper lanes
+#elif defined(__aarch64__)
+    float64x2_t sums = vdupq_n_f64(0.0);
+    for (; i + LANES <= count; i += LANES) {
+        sums = vaddq_f64(sums, vmulq_f64(vld1q_f64(weights + i), vcvtq_f64_s64(vld1q_s64(values + i))));
+    }
+    sum = vaddvq_f64(sums);
+#endif
+    return sum + DotScalar(weights + i, values + i, count - i);
+}
+
+const char* CpuTimeKernel::GetIsaName()
+{
+#if defined(__AVX2__)
+    return "avx2";
+#elif defined(__SSE2__)
+    return "sse2";
+#elif defined(__aarch64__)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cpu_time_matrix.h"
+
+#include <algorithm>
+
+#include "cpu_time_kernel.h"
+
+namespace OHOS {
+namespace PowerMgr {
+bool CpuTimeMatrix::Update(int32_t uid, const std::vector<int64_t>& times, UpdateMode mode)
+{
+    if (times.size() > width_) {
+        Widen(times.size());
+    }
+    if (width_ == 0) {
+        return true;
+    }
+    size_t offset = GetOrAddRow(uid) * width_;
+    const int64_t* current = times.data();
+    if (times.size() < width_) {
+        padded_.assign(last_.begin() + offset, last_.begin() + offset + width_);
+        std::copy(times.begin(), times.end(), padded_.begin());
+        current = padded_.data();
+    }
+    // A new row starts from zero, so the first read counts everything since boot
+    int64_t* totals = mode == UPDATE_LAST ? nullptr : totals_.data() + offset;
+    return !CpuTimeKernel::Accumulate(current, last_.data() + offset, totals, width_, mode == UPDATE_REPLACE);
+}
+
+const int64_t* CpuTimeMatrix::GetTotals(int32_t uid) const
+{
+    auto iter = rows_.find(uid);
+    return iter == rows_.end() ? nullptr : totals_.data() + iter->second * width_;
+}
+
+const int64_t* CpuTimeMatrix::GetLast(int32_t uid) const
+{
+    auto iter = rows_.find(uid);
+    return iter == rows_.end() ? nullptr : last_.data() + iter->second * width_;
+}
+
+size_t CpuTimeMatrix::GetWidth() const
+{
+    return width_;
+}
+
+size_t CpuTimeMatrix::GetRowCount() const
+{
+    return rows_.size();
+}
+
+size_t CpuTimeMatrix::GetOrAddRow(int32_t uid)
+{
+    auto iter = rows_.find(uid);
+    if (iter != rows_.end()) {
+        return iter->second;
+    }
+    size_t row = rows_.size();
+    rows_.emplace(uid, row);
+    last_.resize(last_.size() + width_, 0);
+    totals_.resize(totals_.size() + width_, 0);
+    return row;
+}
+
+void CpuTimeMatrix::Widen(size_t width)
+{
+    size_t rowCount = rows_.size();
+    std::vector<int64_t> last(rowCount * width, 0);
+    std::vector<int64_t> totals(rowCount * width, 0);
+    for (size_t row = 0; row < rowCount; row++) {
+        std::copy_n(last_.begin() + row * width_, width_, last.begin() + row * width);
+        std::copy_n(totals_.begin() + row * width_, width_, totals.begin() + row * width);
+    }
+    last_.swap(last);
+    totals_.swap(totals);
+    width_ = width;
+}
+} // namespace PowerMgr
+} // namespace OHOS
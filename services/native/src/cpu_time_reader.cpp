@@ -15,22 +15,21 @@
 
 #include "cpu_time_reader.h"
 
-#include <fstream>
+#include <algorithm>
+
 #include "string_ex.h"
 
-#include "battery_stats_service.h"
+#include "cpu_time_kernel.h"
 #include "stats_helper.h"
 #include "stats_log.h"
 #include "stats_utils.h"
 
 namespace OHOS {
 namespace PowerMgr {
-namespace {
-static const std::string UID_CPU_ACTIVE_TIME_FILE = "/proc/uid_concurrent_active_time";
-static const std::string UID_CPU_CLUSTER_TIME_FILE = "/proc/uid_concurrent_policy_time";
-static const std::string UID_CPU_FREQ_TIME_FILE = "/proc/uid_time_in_state";
-static const std::string UID_CPU_TIME_FILE = "/proc/uid_cputime/show_uid_stat";
-} // namespace
+CpuTimeReader::CpuTimeReader() : CpuTimeReader(CpuTimeSource::Create()) {}
+
+CpuTimeReader::CpuTimeReader(std::unique_ptr<CpuTimeSource> source) : source_(std::move(source)) {}
+
 bool CpuTimeReader::Init()
 {
     if (!UpdateCpuTime()) {
@@ -41,10 +40,11 @@ bool CpuTimeReader::Init()
 
 int64_t CpuTimeReader::GetUidCpuActiveTimeMs(int32_t uid)
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     int64_t cpuActiveTime = 0;
-    auto iter = activeTimeMap_.find(uid);
-    if (iter != activeTimeMap_.end()) {
-        cpuActiveTime = iter->second;
+    const int64_t* totals = activeTime_.GetTotals(uid);
+    if (totals != nullptr) {
+        cpuActiveTime = totals[0];
         STATS_HILOGD(COMP_SVC, "Get cpu active time: %{public}s for uid: %{public}d",
             std::to_string(cpuActiveTime).c_str(), uid);
     } else {
@@ -55,25 +55,24 @@ int64_t CpuTimeReader::GetUidCpuActiveTimeMs(int32_t uid)
 
 void CpuTimeReader::DumpInfo(std::string& result, int32_t uid)
 {
-    auto uidIter = lastUidTimeMap_.find(uid);
-    if (uidIter == lastUidTimeMap_.end()) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const int64_t* uidTime = uidTime_.GetLast(uid);
+    if (uidTime == nullptr || uidTime_.GetWidth() < 2) { // 2: user and system time
         STATS_HILOGE(COMP_SVC, "No related CPU info for uid: %{public}d", uid);
         return;
     }
     std::string freqTime = "";
-    auto freqIter = lastFreqTimeMap_.find(uid);
-    if (freqIter != lastFreqTimeMap_.end()) {
-        for (auto timeIter = freqIter->second.begin(); timeIter != freqIter->second.end(); timeIter++) {
-            for (uint32_t i = 0; i < timeIter->second.size(); i++) {
-                freqTime.append(ToString(timeIter->second[i]))
-                    .append(" ");
-            }
+    const int64_t* lastFreqTime = freqTime_.GetLast(uid);
+    if (lastFreqTime != nullptr) {
+        for (size_t i = 0; i < freqTime_.GetWidth(); i++) {
+            freqTime.append(ToString(lastFreqTime[i]))
+                .append(" ");
         }
     }
     result.append("Total cpu time: userSpaceTime=")
-        .append(ToString(uidIter->second[0]))
+        .append(ToString(uidTime[0]))
         .append("ms, systemSpaceTime=")
-        .append(ToString(uidIter->second[1]))
+        .append(ToString(uidTime[1]))
         .append("ms\n")
         .append("Total cpu time per freq: ")
         .append(freqTime)
@@ -82,12 +81,12 @@ void CpuTimeReader::DumpInfo(std::string& result, int32_t uid)
 
 int64_t CpuTimeReader::GetUidCpuClusterTimeMs(int32_t uid, uint32_t cluster)
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     int64_t cpuClusterTime = 0;
-    auto iter = clusterTimeMap_.find(uid);
-    if (iter != clusterTimeMap_.end()) {
-        auto cpuClusterTimeVector = iter->second;
-        if (cluster < cpuClusterTimeVector.size()) {
-            cpuClusterTime = cpuClusterTimeVector[cluster];
+    const int64_t* totals = clusterTime_.GetTotals(uid);
+    if (totals != nullptr) {
+        if (cluster < clusterTime_.GetWidth()) {
+            cpuClusterTime = totals[cluster];
             STATS_HILOGD(COMP_SVC, "Get cpu cluster time: %{public}s of cluster: %{public}d",
                 std::to_string(cpuClusterTime).c_str(), cluster);
         } else {
@@ -99,38 +98,55 @@ int64_t CpuTimeReader::GetUidCpuClusterTimeMs(int32_t uid, uint32_t cluster)
     return cpuClusterTime;
 }
 
+const int64_t* CpuTimeReader::GetFreqTimes(int32_t uid, uint32_t cluster, size_t& speedNum) const
+{
+    speedNum = 0;
+    const int64_t* totals = freqTime_.GetTotals(uid);
+    if (totals == nullptr || cluster + 1 >= freqClusterOffsets_.size()) {
+        return nullptr;
+    }
+    size_t begin = std::min(freqClusterOffsets_[cluster], freqTime_.GetWidth());
+    size_t end = std::min(freqClusterOffsets_[cluster + 1], freqTime_.GetWidth());
+    speedNum = end - begin;
+    return totals + begin;
+}
+
 int64_t CpuTimeReader::GetUidCpuFreqTimeMs(int32_t uid, uint32_t cluster, uint32_t speed)
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     int64_t cpuFreqTime = 0;
-    auto uidIter = freqTimeMap_.find(uid);
-    if (uidIter != freqTimeMap_.end()) {
-        auto cpuFreqTimeMap = uidIter->second;
-        auto clusterIter = cpuFreqTimeMap.find(cluster);
-        if (clusterIter != cpuFreqTimeMap.end()) {
-            auto cpuFreqTimeVector = clusterIter->second;
-            if (speed < cpuFreqTimeVector.size()) {
-                cpuFreqTime = cpuFreqTimeVector[speed];
-                STATS_HILOGD(COMP_SVC, "Get cpu freq time: %{public}s of speed: %{public}d",
-                    std::to_string(cpuFreqTime).c_str(), speed);
-            } else {
-                STATS_HILOGD(COMP_SVC, "No cpu freq time of speed: %{public}d found, return 0", speed);
-            }
-        } else {
-            STATS_HILOGD(COMP_SVC, "No cluster cpu freq time vector of cluster: %{public}d found, return 0",
-                cluster);
-        }
+    size_t speedNum = 0;
+    const int64_t* speedTimes = GetFreqTimes(uid, cluster, speedNum);
+    if (speed < speedNum) {
+        cpuFreqTime = speedTimes[speed];
+        STATS_HILOGD(COMP_SVC, "Get cpu freq time: %{public}s of speed: %{public}d",
+            std::to_string(cpuFreqTime).c_str(), speed);
     } else {
-        STATS_HILOGD(COMP_SVC, "No uid cpu freq time map found for uid: %{public}d, return 0", uid);
+        STATS_HILOGD(COMP_SVC, "No cpu freq time of uid: %{public}d, cluster: %{public}d, speed: %{public}d found",
+            uid, cluster, speed);
     }
     return cpuFreqTime;
 }
 
+double CpuTimeReader::GetUidCpuFreqPowerMaMs(int32_t uid, uint32_t cluster, const double* averageMa,
+    size_t speedNum)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    size_t timeNum = 0;
+    const int64_t* speedTimes = GetFreqTimes(uid, cluster, timeNum);
+    if (speedTimes == nullptr) {
+        return StatsUtils::DEFAULT_VALUE;
+    }
+    return CpuTimeKernel::Dot(averageMa, speedTimes, std::min(speedNum, timeNum));
+}
+
 std::vector<int64_t> CpuTimeReader::GetUidCpuTimeMs(int32_t uid)
 {
+    std::lock_guard<std::mutex> lock(mutex_);
     std::vector<int64_t> cpuTimeVec;
-    auto iter = uidTimeMap_.find(uid);
-    if (iter != uidTimeMap_.end()) {
-        cpuTimeVec = iter->second;
+    const int64_t* totals = uidTime_.GetTotals(uid);
+    if (totals != nullptr) {
+        cpuTimeVec.assign(totals, totals + uidTime_.GetWidth());
         STATS_HILOGD(COMP_SVC, "Get uid cpu time vector for uid: %{public}d, size: %{public}d", uid,
             static_cast<int32_t>(cpuTimeVec.size()));
     } else {
@@ -141,485 +157,86 @@ std::vector<int64_t> CpuTimeReader::GetUidCpuTimeMs(int32_t uid)
 
 bool CpuTimeReader::UpdateCpuTime()
 {
+    std::lock_guard<std::mutex> updateLock(updateMutex_);
+    bool result = true;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        result = UpdateCpuTimeLocked();
+    }
+    return result;
+}
+
+bool CpuTimeReader::UpdateCpuTimeLocked()
+{
+    if (!source_->Prepare()) {
+        STATS_HILOGW(COMP_SVC, "Prepare %{public}s cpu time source failed", source_->GetName());
+        return false;
+    }
+    // The increments only count while on battery, otherwise the times are just remembered
+    bool isOnBattery = StatsHelper::IsOnBattery();
     bool result = true;
-    if (!ReadUidCpuClusterTime()) {
+    if (!ReadUidCpuTimes(CpuTimeSource::TIME_TYPE_CLUSTER, clusterTime_,
+        isOnBattery ? CpuTimeMatrix::UPDATE_ACCUMULATE : CpuTimeMatrix::UPDATE_LAST)) {
         STATS_HILOGW(COMP_SVC, "Read uid cpu cluster time failed");
         result = false;
     }
 
-    if (!ReadUidCpuTime()) {
+    if (!ReadUidCpuTimes(CpuTimeSource::TIME_TYPE_UID, uidTime_,
+        isOnBattery ? CpuTimeMatrix::UPDATE_REPLACE : CpuTimeMatrix::UPDATE_LAST)) {
         STATS_HILOGW(COMP_SVC, "Read uid cpu time failed");
         result = false;
     }
 
-    if (!ReadUidCpuActiveTime()) {
+    if (!ReadUidCpuTimes(CpuTimeSource::TIME_TYPE_ACTIVE, activeTime_,
+        isOnBattery ? CpuTimeMatrix::UPDATE_ACCUMULATE : CpuTimeMatrix::UPDATE_LAST)) {
         STATS_HILOGW(COMP_SVC, "Read uid cpu active time failed");
         result = false;
     }
 
-    if (!ReadUidCpuFreqTime()) {
+    if (!ReadUidCpuTimes(CpuTimeSource::TIME_TYPE_FREQ, freqTime_,
+        isOnBattery ? CpuTimeMatrix::UPDATE_ACCUMULATE : CpuTimeMatrix::UPDATE_LAST)) {
         STATS_HILOGW(COMP_SVC, "Read uid cpu freq time failed");
         result = false;
     }
     return result;
 }
 
-bool CpuTimeReader::ReadUidCpuActiveTimeImpl(std::string& line, int32_t uid)
-{
-    int64_t timeMs = 0;
-    std::vector<std::string> splitedTime;
-    Split(line, ' ', splitedTime);
-    for (uint16_t i = 0; i < splitedTime.size(); i++) {
-        int64_t result = 0;
-        if (!StatsUtils::ParseStrtollResult(splitedTime[i], result)) {
-            continue;
-        }
-        timeMs += result * 10; // Unit is 10ms
-    }
-
-    int64_t increment = 0;
-    if (timeMs > 0) {
-        auto iterLast = lastActiveTimeMap_.find(uid);
-        if (iterLast != lastActiveTimeMap_.end()) {
-            increment = timeMs - iterLast->second;
-            if (increment >= 0) {
-                iterLast->second = timeMs;
-            } else {
-                STATS_HILOGI(COMP_SVC, "Negative cpu active time increment");
-                return false;
-            }
-        } else {
-            lastActiveTimeMap_.insert(std::pair<int32_t, int64_t>(uid, timeMs));
-            increment = timeMs;
-        }
-    }
-
-    if (StatsHelper::IsOnBattery()) {
-        STATS_HILOGD(COMP_SVC, "Power supply is not connected. Add the increment");
-        auto iter = activeTimeMap_.find(uid);
-        if (iter != activeTimeMap_.end()) {
-            iter->second += increment;
-        } else {
-            activeTimeMap_.insert(std::pair<int32_t, int64_t>(uid, increment));
-            STATS_HILOGI(COMP_SVC, "Add active time: %{public}sms, uid: %{public}d",
-                std::to_string(increment).c_str(), uid);
-        }
-    }
-    return true;
-}
-
-bool CpuTimeReader::ReadUidCpuActiveTime()
-{
-    std::ifstream input(UID_CPU_ACTIVE_TIME_FILE);
-    if (!input) {
-        STATS_HILOGW(COMP_SVC, "Open file failed");
-        return false;
-    }
-
-    std::string line;
-    const int32_t INDEX_0 = 0;
-    const int32_t INDEX_1 = 1;
-    while (getline(input, line)) {
-        int32_t uid = StatsUtils::INVALID_VALUE;
-        std::vector<std::string> splitedLine;
-        Split(line, ':', splitedLine);
-        if (splitedLine[INDEX_0] == "cpus") {
-            continue;
-        } else {
-            int64_t result = 0;
-            if (!StatsUtils::ParseStrtollResult(splitedLine[INDEX_0], result)) {
-                continue;
-            }
-            uid = static_cast<int32_t>(result);
-        }
-
-        if (uid > StatsUtils::INVALID_VALUE) {
-            auto bss = BatteryStatsService::GetInstance();
-            auto uidEntity =
-                bss->GetBatteryStatsCore()->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_APP);
-            if (uidEntity) {
-                uidEntity->UpdateUidMap(uid);
-            }
-        }
-
-        if (ReadUidCpuActiveTimeImpl(splitedLine[INDEX_1], uid)) {
-            continue;
-        } else {
-            return false;
-        }
-    }
-    return true;
-}
-
-void CpuTimeReader::ReadPolicy(std::vector<uint16_t>& clusters, std::string& line)
-{
-    std::vector<std::string> splitedPolicy;
-    Split(line, ' ', splitedPolicy);
-    uint32_t step = 2;
-    for (uint32_t i = 0; i < splitedPolicy.size(); i += step) {
-        int64_t result = 0;
-        if (!StatsUtils::ParseStrtollResult(splitedPolicy[i + 1], result)) {
-            continue;
-        }
-        uint16_t coreNum = static_cast<uint16_t>(result);
-        clusters.push_back(coreNum);
-        clustersMap_.insert(std::pair<uint16_t, uint16_t>(i, coreNum));
-    }
-}
-
-bool CpuTimeReader::ReadClusterTimeIncrement(std::vector<int64_t>& clusterTime, std::vector<int64_t>& increments,
-    int32_t uid, std::vector<uint16_t>& clusters, std::string& timeLine)
-{
-    std::vector<std::string> splitedTime;
-    Split(timeLine, ' ', splitedTime);
-    uint16_t count = 0;
-    for (uint16_t i = 0; i < clusters.size(); i++) {
-        int64_t tempTimeMs = 0;
-        for (uint16_t j = 0; j < clusters[i]; j++) {
-            int64_t result = 0;
-            if (!StatsUtils::ParseStrtollResult(splitedTime[count++], result)) {
-                continue;
-            }
-            tempTimeMs += result * 10; // Unit is 10ms
-        }
-        clusterTime.push_back(tempTimeMs);
-    }
-
-    auto iterLast = lastClusterTimeMap_.find(uid);
-    if (iterLast != lastClusterTimeMap_.end()) {
-        for (uint16_t i = 0; i < clusters.size(); i++) {
-            int64_t increment = clusterTime[i] - iterLast->second[i];
-            if (increment >= 0) {
-                iterLast->second[i] = clusterTime[i];
-                increments.push_back(increment);
-            } else {
-                STATS_HILOGD(COMP_SVC, "Negative cpu cluster time increment");
-                return false;
-            }
-        }
-    } else {
-        lastClusterTimeMap_.insert(std::pair<int32_t, std::vector<int64_t>>(uid, clusterTime));
-        increments = clusterTime;
-        STATS_HILOGI(COMP_SVC, "Add last cpu cluster time for uid: %{public}d", uid);
-    }
-    return true;
-}
-
-bool CpuTimeReader::ReadUidCpuClusterTime()
-{
-    std::ifstream input(UID_CPU_CLUSTER_TIME_FILE);
-    if (!input) {
-        STATS_HILOGW(COMP_SVC, "Open file failed");
-        return false;
-    }
-    std::string line;
-    int32_t uid = -1;
-    std::vector<uint16_t> clusters;
-    std::vector<int64_t> clusterTime;
-    while (getline(input, line)) {
-        clusterTime.clear();
-        if (line.find("policy") != line.npos) {
-            ReadPolicy(clusters, line);
-            continue;
-        }
-
-        std::vector<std::string> splitedLine;
-        Split(line, ':', splitedLine);
-        int64_t result = 0;
-        if (!StatsUtils::ParseStrtollResult(splitedLine[0], result)) {
-            continue;
-        }
-        uid = static_cast<int32_t>(result);
-        if (uid > StatsUtils::INVALID_VALUE) {
-            auto bss = BatteryStatsService::GetInstance();
-            auto uidEntity = bss->GetBatteryStatsCore()->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_APP);
-            if (uidEntity) {
-                uidEntity->UpdateUidMap(uid);
-            }
-        }
-
-        std::vector<int64_t> increments;
-        if (!ReadClusterTimeIncrement(clusterTime, increments, uid, clusters, splitedLine[1])) {
-            return false;
-        }
-
-        if (StatsHelper::IsOnBattery()) {
-            STATS_HILOGD(COMP_SVC, "Power supply is not connected. Add the increment");
-            auto iter = clusterTimeMap_.find(uid);
-            if (iter != clusterTimeMap_.end()) {
-                AddIncrementsToClusterTime(iter->second, increments, clusters);
-            } else {
-                clusterTimeMap_.insert(std::pair<int32_t, std::vector<int64_t>>(uid, increments));
-                STATS_HILOGI(COMP_SVC, "Add cpu cluster time for uid: %{public}d", uid);
-            }
-        }
-    }
-    return true;
-}
-
-void CpuTimeReader::AddIncrementsToClusterTime(std::vector<int64_t>& clusterTime,
-    const std::vector<int64_t>& increments, const std::vector<uint16_t>& clusters)
+bool CpuTimeReader::ReadUidCpuTimes(CpuTimeSource::TimeType type, CpuTimeMatrix& matrix,
+    CpuTimeMatrix::UpdateMode mode)
 {
-    for (uint16_t i = 0; i < clusters.size(); i++) {
-        clusterTime[i] += increments[i];
-    }
-}
-
-bool CpuTimeReader::ProcessFreqTime(std::map<uint32_t, std::vector<int64_t>>& map, std::map<uint32_t,
-    std::vector<int64_t>>& increments, std::map<uint32_t, std::vector<int64_t>>& speedTime, int32_t index, int32_t uid)
-{
-    auto iterLastTemp = map.find(index);
-    if (iterLastTemp != map.end()) {
-        std::vector<int64_t> lastSpeedTimes = iterLastTemp->second;
-        std::vector<int64_t> newIncrementTimes;
-        newIncrementTimes.clear();
-        for (uint16_t j = 0; j < lastSpeedTimes.size(); j++) {
-            int64_t increment = speedTime.at(index)[j] - lastSpeedTimes[j];
-            if (increment >= 0) {
-                newIncrementTimes.push_back(increment);
-                increments.insert(std::pair<uint32_t, std::vector<int64_t>>(index, newIncrementTimes));
-            } else {
-                STATS_HILOGI(COMP_SVC, "Negative cpu freq time increment");
-                return false;
-            }
+    return source_->Read(type, [this, &matrix, mode](int32_t uid, const std::vector<int64_t>& times) {
+        UpdateUidMap(uid);
+        if (!matrix.Update(uid, times, mode)) {
+            // The kernel dropped the uid and counts again from zero, nothing is known about the time in between
+            STATS_HILOGD(COMP_SVC, "Negative cpu time increment for uid: %{public}d", uid);
         }
-        iterLastTemp->second = speedTime.at(index);
-    }
-    return true;
-}
-
-bool CpuTimeReader::ReadFreqTimeIncrement(std::map<uint32_t, std::vector<int64_t>>& speedTime,
-    std::map<uint32_t, std::vector<int64_t>>& increments, int32_t uid, std::vector<std::string>& splitedTime)
-{
-    auto bss = BatteryStatsService::GetInstance();
-    auto parser = bss->GetBatteryStatsParser();
-    uint16_t clusterNum = parser->GetClusterNum();
-    uint16_t count = 0;
-    for (uint16_t i = 0; i < clusterNum; i++) {
-        std::vector<int64_t> tempSpeedTimes;
-        tempSpeedTimes.clear();
-        for (uint16_t j = 0; j < parser->GetSpeedNum(i); j++) {
-            int64_t result = 0;
-            if (!StatsUtils::ParseStrtollResult(splitedTime[count++], result)) {
-                continue;
-            }
-            int64_t tempTimeMs = result * 10; // Unit is 10ms
-            tempSpeedTimes.push_back(tempTimeMs);
-        }
-        speedTime.insert(std::pair<uint32_t, std::vector<int64_t>>(i, tempSpeedTimes));
-    }
-
-    auto iterLast = lastFreqTimeMap_.find(uid);
-    if (iterLast == lastFreqTimeMap_.end()) {
-        lastFreqTimeMap_.insert(std::pair<int32_t, std::map<uint32_t, std::vector<int64_t>>>(uid, speedTime));
-        increments = speedTime;
-        STATS_HILOGI(COMP_SVC, "Add last cpu freq time for uid: %{public}d", uid);
         return true;
-    }
-    for (uint16_t i = 0; i < lastFreqTimeMap_.size(); i++) {
-        if (!ProcessFreqTime(iterLast->second, increments, speedTime, i, uid)) {
-            return false;
-        }
-    }
-    return true;
-}
-
-void CpuTimeReader::DistributeFreqTime(std::map<uint32_t, std::vector<int64_t>>& uidIncrements,
-    std::map<uint32_t, std::vector<int64_t>>& increments)
-{
-    auto bss = BatteryStatsService::GetInstance();
-    auto parser = bss->GetBatteryStatsParser();
-    uint16_t clusterNum = parser->GetClusterNum();
-    if (wakelockCounts_ > 0) {
-        for (uint16_t i = 0; i < clusterNum; i++) {
-            uint16_t speedNum = parser->GetSpeedNum(i);
-            for (uint16_t j = 0; j < speedNum; j++) {
-                int32_t step = 2;
-                uidIncrements.at(i)[j] = increments.at(i)[j] / step;
-            }
-        }
-        // TO-DO, distribute half of cpu freq time to wakelock holders
-    }
+    });
 }
 
-void CpuTimeReader::AddFreqTimeToUid(std::map<uint32_t, std::vector<int64_t>>& uidIncrements, int32_t uid)
+void CpuTimeReader::SetSpeedOffsets(const std::vector<size_t>& offsets)
 {
-    auto bss = BatteryStatsService::GetInstance();
-    auto parser = bss->GetBatteryStatsParser();
-    uint16_t clusterNum = parser->GetClusterNum();
-    auto iter = freqTimeMap_.find(uid);
-    if (iter != freqTimeMap_.end()) {
-        for (uint16_t i = 0; i < clusterNum; i++) {
-            uint16_t speedNum = parser->GetSpeedNum(i);
-            for (uint16_t j = 0; j < speedNum; j++) {
-                iter->second.at(i)[j] += uidIncrements.at(i)[j];
-            }
-        }
-    } else {
-        freqTimeMap_.insert(std::pair<int32_t, std::map<uint32_t, std::vector<int64_t>>>(uid, uidIncrements));
-        STATS_HILOGI(COMP_SVC, "Add cpu freq time for uid: %{public}d", uid);
-    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    freqClusterOffsets_ = offsets;
 }
 
-bool CpuTimeReader::ReadUidCpuFreqTime()
+void CpuTimeReader::UpdateUidMap(int32_t uid)
 {
-    std::ifstream input(UID_CPU_FREQ_TIME_FILE);
-    if (!input) {
-        STATS_HILOGW(COMP_SVC, "Open file failed");
-        return false;
-    }
-    std::string line;
-    int32_t uid = -1;
-    std::map<uint32_t, std::vector<int64_t>> speedTime;
-    while (getline(input, line)) {
-        speedTime.clear();
-        std::vector<std::string> splitedLine;
-        Split(line, ':', splitedLine);
-        if (splitedLine[0] == "uid") {
-            continue;
-        } else {
-            int64_t result = 0;
-            if (!StatsUtils::ParseStrtollResult(splitedLine[0], result)) {
-                continue;
-            }
-            uid = static_cast<int32_t>(result);
-        }
-        if (uid > StatsUtils::INVALID_VALUE) {
-            auto bss = BatteryStatsService::GetInstance();
-            auto uidEntity =
-                bss->GetBatteryStatsCore()->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_APP);
-            if (uidEntity) {
-                uidEntity->UpdateUidMap(uid);
-            }
-        }
-        std::vector<std::string> splitedTime;
-        Split(splitedLine[1], ' ', splitedTime);
-
-        std::map<uint32_t, std::vector<int64_t>> increments;
-        if (!ReadFreqTimeIncrement(speedTime, increments, uid, splitedTime)) {
-            return false;
-        }
-
-        std::map<uint32_t, std::vector<int64_t>> uidIncrements = increments;
-        DistributeFreqTime(uidIncrements, increments);
-
-        if (!StatsHelper::IsOnBattery()) {
-            STATS_HILOGD(COMP_SVC, "Power supply is connected, don't add the increment");
-            continue;
-        }
-        AddFreqTimeToUid(uidIncrements, uid);
-    }
-    return true;
-}
-
-bool CpuTimeReader::ReadUidTimeIncrement(std::vector<int64_t>& cpuTime, std::vector<int64_t>& uidIncrements,
-    int32_t uid, std::string& timeLine)
-{
-    std::vector<std::string> splitedTime;
-    Split(timeLine, ' ', splitedTime);
-    for (uint16_t i = 0; i < splitedTime.size(); i++) {
-        int64_t tempTime = 0;
-        int64_t result = 0;
-        if (!StatsUtils::ParseStrtollResult(splitedTime[i], result)) {
-            continue;
-        }
-        tempTime = result;
-        cpuTime.push_back(tempTime);
-    }
-
-    std::vector<int64_t> increments;
-    auto iterLast = lastUidTimeMap_.find(uid);
-    if (iterLast != lastUidTimeMap_.end()) {
-        for (uint16_t i = 0; i < splitedTime.size(); i++) {
-            int64_t increment = 0;
-            increment = cpuTime[i] - iterLast->second[i];
-            if (increment >= 0) {
-                iterLast->second[i] = cpuTime[i];
-                increments.push_back(increment);
-            } else {
-                STATS_HILOGI(COMP_SVC, "Negative cpu time increment");
-                return false;
-            }
-        }
-    } else {
-        lastUidTimeMap_.insert(std::pair<int32_t, std::vector<int64_t>>(uid, cpuTime));
-        increments = cpuTime;
-        STATS_HILOGI(COMP_SVC, "Add last cpu time for uid: %{public}d", uid);
-    }
-
-    uidIncrements = increments;
-
-    if (wakelockCounts_ > 0) {
-        double weight = 0.5;
-        uidIncrements[0] = increments[0] / (StatsUtils::US_IN_MS * 1.0) * weight;
-        uidIncrements[1] = increments[1] / (StatsUtils::US_IN_MS * 1.0) * weight;
-        // TO-DO, distribute half of cpu time to wakelock holders
-    }
-    return true;
-}
-
-bool CpuTimeReader::ReadUidCpuTime()
-{
-    std::ifstream input(UID_CPU_TIME_FILE);
-    if (!input) {
-        STATS_HILOGW(COMP_SVC, "Open file failed");
-        return false;
-    }
-    std::string line;
-    std::vector<int64_t> cpuTime;
-    while (getline(input, line)) {
-        cpuTime.clear();
-        std::vector<std::string> splitedLine;
-        Split(line, ':', splitedLine);
-        int64_t result = 0;
-        if (!StatsUtils::ParseStrtollResult(splitedLine[0], result)) {
-            continue;
-        }
-        int32_t uid = static_cast<int32_t>(result);
-        if (uid > StatsUtils::INVALID_VALUE) {
-            auto bss = BatteryStatsService::GetInstance();
-            auto uidEntity =
-                bss->GetBatteryStatsCore()->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_APP);
-            if (uidEntity) {
-                uidEntity->UpdateUidMap(uid);
-            }
-        }
-
-        std::vector<int64_t> uidIncrements;
-        if (!ReadUidTimeIncrement(cpuTime, uidIncrements, uid, splitedLine[1])) {
-            return false;
-        }
-
-        if (StatsHelper::IsOnBattery()) {
-            STATS_HILOGD(COMP_SVC, "Power supply is not connected. Add the increment");
-            UpdateUidTimeMap(uid, uidIncrements);
-        }
-    }
-    return true;
-}
-
-void CpuTimeReader::UpdateUidTimeMap(int32_t uid, const std::vector<int64_t>& uidIncrements)
-{
-    auto iter = uidTimeMap_.find(uid);
-    if (iter != uidTimeMap_.end()) {
-        for (uint16_t i = 0; i < uidIncrements.size(); i++) {
-            iter->second[i] = uidIncrements[i];
-        }
-    } else {
-        uidTimeMap_.insert(std::pair<int32_t, std::vector<int64_t>>(uid, uidIncrements));
-        STATS_HILOGI(COMP_SVC, "Add cpu time for uid: %{public}d", uid);
+    if (uid <= StatsUtils::INVALID_VALUE) {
+        return;
     }
+    sampledUids_.push_back(uid);
 }
 
-void CpuTimeReader::Split(std::string &origin, char delimiter, std::vector<std::string> &splited)
+std::vector<int32_t> CpuTimeReader::TakeSampledUids()
 {
-    size_t start;
-    size_t end = 0;
-
-    while ((start = origin.find_first_not_of(delimiter, end)) != std::string::npos) {
-        end = origin.find(delimiter, start);
-        splited.push_back(origin.substr(start, end - start));
-    }
+    std::lock_guard<std::mutex> updateLock(updateMutex_);
+    // Every proc file lists the same uids, hand each of them over once
+    std::sort(sampledUids_.begin(), sampledUids_.end());
+    sampledUids_.erase(std::unique(sampledUids_.begin(), sampledUids_.end()), sampledUids_.end());
+    std::vector<int32_t> uids;
+    uids.swap(sampledUids_);
+    return uids;
 }
 } // namespace PowerMgr
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cpu_time_sampler.h"
+
+#include <chrono>
+#include <cinttypes>
+#include <pthread.h>
+
+#include "string_ex.h"
+
+#include "stats_log.h"
+#include "stats_utils.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr const char* SAMPLER_THREAD_NAME = "StatsCpuSampler";
+constexpr const char* TRIGGER_NAMES[CpuTimeSampler::TRIGGER_BUTT] = {
+    "periodic", "screen off", "power supply", "query",
+};
+
+int64_t GetSteadyTimeUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t GetSteadyTimeMs()
+{
+    return GetSteadyTimeUs() / 1000; // 1000: us per ms
+}
+} // namespace
+
+CpuTimeSampler::CpuTimeSampler() : CpuTimeSampler(Config()) {}
+
+CpuTimeSampler::CpuTimeSampler(const Config& config) : config_(config) {}
+
+CpuTimeSampler::~CpuTimeSampler()
+{
+    Stop();
+}
+
+bool CpuTimeSampler::Start(const SampleHandler& handler)
+{
+    if (handler == nullptr) {
+        return false;
+    }
+    if (running_.exchange(true)) {
+        return true;
+    }
+    handler_ = handler;
+    worker_ = std::thread([this] { SamplerLoop(); });
+    pthread_setname_np(worker_.native_handle(), SAMPLER_THREAD_NAME);
+    STATS_HILOGI(COMP_SVC, "Cpu time sampler is started, interval: %{public}" PRId64 "ms", config_.intervalMs);
+    return true;
+}
+
+void CpuTimeSampler::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!running_.exchange(false)) {
+            return;
+        }
+        requestCond_.notify_one();
+        sampleCond_.notify_all();
+    }
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    STATS_HILOGI(COMP_SVC, "Cpu time sampler is stopped, samples: %{public}" PRIu64 "", sampleCount_.load());
+}
+
+bool CpuTimeSampler::IsRunning() const
+{
+    return running_.load();
+}
+
+void CpuTimeSampler::RequestLocked(Trigger trigger, bool urgent)
+{
+    if (requested_) {
+        coalescedCount_.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        requested_ = true;
+        pendingTrigger_ = trigger;
+    }
+    urgent_ = urgent_ || urgent;
+    requestCond_.notify_one();
+}
+
+void CpuTimeSampler::RequestSample(Trigger trigger)
+{
+    if (!running_.load()) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    RequestLocked(trigger, false);
+}
+
+bool CpuTimeSampler::WaitForSample(Trigger trigger, int64_t timeoutMs)
+{
+    // The sample handler must not wait for itself
+    if (!running_.load() || std::this_thread::get_id() == worker_.get_id()) {
+        return false;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    // A sample which is running already may have read the files before the caller asked, so wait for the next one.
+    // Every caller waiting at the same time waits for that same sample.
+    uint64_t target = startedCount_ + 1;
+    RequestLocked(trigger, true);
+    bool sampled = sampleCond_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this, target] {
+        return !running_.load() || finishedCount_ >= target;
+    });
+    if (!sampled || finishedCount_ < target) {
+        waitTimeoutCount_.fetch_add(1, std::memory_order_relaxed);
+        STATS_HILOGW(COMP_SVC, "Waiting for cpu time sample timed out");
+        return false;
+    }
+    return true;
+}
+
+bool CpuTimeSampler::SampleIfStale()
+{
+    int64_t staleness = GetStalenessMs();
+    if (staleness >= 0 && staleness <= config_.queryMaxAgeMs) {
+        return true;
+    }
+    return WaitForSample(TRIGGER_QUERY, config_.waitTimeoutMs);
+}
+
+void CpuTimeSampler::SamplerLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (running_.load()) {
+        int64_t nowMs = GetSteadyTimeMs();
+        int64_t lastMs = lastSampleTimeMs_.load();
+        if (!requested_ && lastMs >= 0 && nowMs - lastMs < config_.intervalMs) {
+            requestCond_.wait_for(lock, std::chrono::milliseconds(lastMs + config_.intervalMs - nowMs), [this] {
+                return !running_.load() || requested_;
+            });
+            continue;
+        }
+        if (requested_ && !urgent_ && lastMs >= 0 && nowMs - lastMs < config_.minIntervalMs) {
+            // The requests arriving while the sampler holds back are served by the same sample
+            requestCond_.wait_for(lock, std::chrono::milliseconds(lastMs + config_.minIntervalMs - nowMs), [this] {
+                return !running_.load() || urgent_;
+            });
+            continue;
+        }
+        Trigger trigger = requested_ ? pendingTrigger_ : TRIGGER_PERIODIC;
+        requested_ = false;
+        urgent_ = false;
+        startedCount_++;
+        lock.unlock();
+        Sample(trigger);
+        lock.lock();
+        finishedCount_ = startedCount_;
+        sampleCond_.notify_all();
+    }
+}
+
+void CpuTimeSampler::Sample(Trigger trigger)
+{
+    int64_t startUs = GetSteadyTimeUs();
+    lastSampleTimeMs_.store(startUs / 1000); // 1000: us per ms
+    handler_();
+    int64_t costUs = GetSteadyTimeUs() - startUs;
+    lastCostUs_.store(costUs);
+    if (costUs > maxCostUs_.load()) {
+        maxCostUs_.store(costUs);
+    }
+    totalCostUs_.fetch_add(costUs, std::memory_order_relaxed);
+    sampleCount_.fetch_add(1, std::memory_order_relaxed);
+    triggerCounts_[trigger].fetch_add(1, std::memory_order_relaxed);
+    STATS_HILOGD(COMP_SVC, "Sampled cpu time for %{public}s, cost: %{public}" PRId64 "us", TRIGGER_NAMES[trigger],
+        costUs);
+}
+
+int64_t CpuTimeSampler::GetStalenessMs() const
+{
+    int64_t lastMs = lastSampleTimeMs_.load();
+    return lastMs < 0 ? StatsUtils::INVALID_VALUE : GetSteadyTimeMs() - lastMs;
+}
+
+uint64_t CpuTimeSampler::GetSampleCount() const
+{
+    return sampleCount_.load();
+}
+
+uint64_t CpuTimeSampler::GetCoalescedCount() const
+{
+    return coalescedCount_.load();
+}
+
+void CpuTimeSampler::DumpInfo(std::string& result)
+{
+    uint64_t sampleCount = GetSampleCount();
+    int64_t averageCostUs = sampleCount > 0 ? totalCostUs_.load() / static_cast<int64_t>(sampleCount) : 0;
+    result.append("Cpu time sampler: samples = ")
+        .append(ToString(sampleCount))
+        .append(", coalesced requests = ")
+        .append(ToString(GetCoalescedCount()))
+        .append(", wait timeouts = ")
+        .append(ToString(waitTimeoutCount_.load()))
+        .append(", staleness = ")
+        .append(ToString(GetStalenessMs()))
+        .append("ms\n")
+        .append("Cpu sample cost: last = ")
+        .append(ToString(lastCostUs_.load()))
+        .append("us, max = ")
+        .append(ToString(maxCostUs_.load()))
+        .append("us, average = ")
+        .append(ToString(averageCostUs))
+        .append("us\n")
+        .append("Cpu samples per trigger:");
+    for (uint8_t i = 0; i < TRIGGER_BUTT; i++) {
+        result.append(" ")
+            .append(TRIGGER_NAMES[i])
+            .append(" = ")
+            .append(ToString(triggerCounts_[i].load()));
+    }
+    result.append("\n");
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,295 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "cpu_time_source.h"
+
+#include <unistd.h>
+
+#include "battery_stats_codec.h"
+#include "stats_log.h"
+#include "stats_utils.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+static const std::string UID_CPU_ACTIVE_TIME_FILE = "/proc/uid_concurrent_active_time";
+static const std::string UID_CPU_CLUSTER_TIME_FILE = "/proc/uid_concurrent_policy_time";
+static const std::string UID_CPU_FREQ_TIME_FILE = "/proc/uid_time_in_state";
+static const std::string UID_CPU_TIME_FILE = "/proc/uid_cputime/show_uid_stat";
+static const std::string UID_CPU_TIME_BINARY_FILE = "/proc/uid_cputime/packed_stat";
+constexpr int64_t TEXT_TIME_UNIT_MS = 10;
+// uid and reserved, active time, user and system time
+constexpr size_t RECORD_FIXED_SIZE = sizeof(uint32_t) * 2 + sizeof(uint64_t) * 3;
+
+// Takes the uid field and the time field of a "uid: time time ..." line
+bool SplitUidLine(std::string_view line, std::string_view& uidField, std::string_view& timeField)
+{
+    if (!ProcFileReader::NextToken(line, ':', uidField)) {
+        return false;
+    }
+    timeField = {};
+    ProcFileReader::NextToken(line, ':', timeField);
+    return true;
+}
+
+bool GetInt64(BatteryStatsCodec::Reader& reader, int64_t& value)
+{
+    uint64_t bits = 0;
+    if (!reader.GetFixed64(bits)) {
+        return false;
+    }
+    value = static_cast<int64_t>(bits);
+    return true;
+}
+
+bool GetInt64s(BatteryStatsCodec::Reader& reader, size_t count, std::vector<int64_t>& values)
+{
+    for (size_t i = 0; i < count; i++) {
+        int64_t value = 0;
+        if (!GetInt64(reader, value)) {
+            return false;
+        }
+        values.push_back(value);
+    }
+    return true;
+}
+} // namespace
+
+std::unique_ptr<CpuTimeSource> CpuTimeSource::Create()
+{
+    if (access(UID_CPU_TIME_BINARY_FILE.c_str(), R_OK) == 0) {
+        auto source = std::make_unique<BinaryCpuTimeSource>(UID_CPU_TIME_BINARY_FILE);
+        if (source->Prepare()) {
+            STATS_HILOGI(COMP_SVC, "Read cpu time from %{public}s", UID_CPU_TIME_BINARY_FILE.c_str());
+            return source;
+        }
+    }
+    return std::make_unique<ProcCpuTimeSource>();
+}
+
+const char* ProcCpuTimeSource::GetName() const
+{
+    return "proc";
+}
+
+bool ProcCpuTimeSource::Read(TimeType type, const Visitor& visitor)
+{
+    static const std::string* const files[TIME_TYPE_BUTT] = {
+        &UID_CPU_ACTIVE_TIME_FILE, &UID_CPU_CLUSTER_TIME_FILE, &UID_CPU_FREQ_TIME_FILE, &UID_CPU_TIME_FILE,
+    };
+    if (type >= TIME_TYPE_BUTT || !procReader_.Read(*files[type])) {
+        STATS_HILOGW(COMP_SVC, "Open file failed");
+        return false;
+    }
+    if (type == TIME_TYPE_CLUSTER) {
+        clusterCores_.clear();
+    }
+    std::string_view line;
+    while (procReader_.NextLine(line)) {
+        if (type == TIME_TYPE_CLUSTER && line.find("policy") != line.npos) {
+            ParsePolicy(line);
+            continue;
+        }
+        // The header lines, "cpus: 8" and "uid: freq freq ...", have no numeric uid
+        std::string_view uidField;
+        std::string_view timeField;
+        int64_t uid = 0;
+        if (!SplitUidLine(line, uidField, timeField) || !ProcFileReader::ParseInt64(uidField, uid)) {
+            continue;
+        }
+        if (!ParseTimes(type, timeField)) {
+            continue;
+        }
+        if (!visitor(static_cast<int32_t>(uid), times_)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ProcCpuTimeSource::ParseTimes(TimeType type, std::string_view timeField)
+{
+    times_.clear();
+    std::string_view token;
+    int64_t value = 0;
+    if (type == TIME_TYPE_CLUSTER) {
+        // The times are listed per core, the cores of a cluster add up to the cluster time
+        for (uint16_t cores : clusterCores_) {
+            int64_t clusterTime = 0;
+            for (uint16_t i = 0; i < cores; i++) {
+                if (ProcFileReader::NextToken(timeField, ' ', token) && ProcFileReader::ParseInt64(token, value)) {
+                    clusterTime += value * TEXT_TIME_UNIT_MS;
+                }
+            }
+            times_.push_back(clusterTime);
+        }
+        return true;
+    }
+    int64_t totalTime = 0;
+    while (ProcFileReader::NextToken(timeField, ' ', token)) {
+        if (!ProcFileReader::ParseInt64(token, value)) {
+            continue;
+        }
+        if (type == TIME_TYPE_ACTIVE) {
+            totalTime += value * TEXT_TIME_UNIT_MS;
+        } else if (type == TIME_TYPE_FREQ) {
+            times_.push_back(value * TEXT_TIME_UNIT_MS);
+        } else {
+            times_.push_back(value);
+        }
+    }
+    if (type == TIME_TYPE_ACTIVE) {
+        times_.push_back(totalTime);
+    }
+    return true;
+}
+
+void ProcCpuTimeSource::ParsePolicy(std::string_view line)
+{
+    // The line holds "policyN: cores" pairs
+    std::string_view policy;
+    std::string_view cores;
+    while (ProcFileReader::NextToken(line, ' ', policy)) {
+        if (!ProcFileReader::NextToken(line, ' ', cores)) {
+            break;
+        }
+        int64_t result = 0;
+        if (!ProcFileReader::ParseInt64(cores, result)) {
+            continue;
+        }
+        clusterCores_.push_back(static_cast<uint16_t>(result));
+    }
+}
+
+BinaryCpuTimeSource::BinaryCpuTimeSource(const std::string& path) : path_(path) {}
+
+const char* BinaryCpuTimeSource::GetName() const
+{
+    return "binary";
+}
+
+size_t BinaryCpuTimeSource::GetRecordSize(uint16_t clusterCount, uint16_t freqCount)
+{
+    return RECORD_FIXED_SIZE + sizeof(uint64_t) * (static_cast<size_t>(clusterCount) + freqCount);
+}
+
+bool BinaryCpuTimeSource::Prepare()
+{
+    ready_ = false;
+    if (!fileReader_.Read(path_)) {
+        return false;
+    }
+    size_t frameSize = 0;
+    return SelectFrame(0, frameSize);
+}
+
+bool BinaryCpuTimeSource::SelectFrame(size_t offset, size_t& frameSize)
+{
+    ready_ = false;
+    if (offset >= fileReader_.GetSize()) {
+        return false;
+    }
+    BatteryStatsCodec::Reader reader(reinterpret_cast<const uint8_t*>(fileReader_.GetData()) + offset,
+        fileReader_.GetSize() - offset);
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    uint16_t reserved = 0;
+    if (!reader.GetFixed32(magic) || !reader.GetFixed16(version) || !reader.GetFixed16(clusterCount_) ||
+        !reader.GetFixed16(freqCount_) || !reader.GetFixed16(reserved) || !reader.GetFixed32(recordCount_)) {
+        STATS_HILOGW(COMP_SVC, "Cpu time dump header is truncated");
+        return false;
+    }
+    if (magic != MAGIC || version != VERSION) {
+        STATS_HILOGW(COMP_SVC, "Unknown cpu time dump, magic: %{public}x, version: %{public}u", magic, version);
+        return false;
+    }
+    size_t recordsSize = GetRecordSize(clusterCount_, freqCount_) * recordCount_;
+    if (reader.GetRemaining() < recordsSize) {
+        STATS_HILOGW(COMP_SVC, "Cpu time dump is truncated, records: %{public}u", recordCount_);
+        return false;
+    }
+    frameOffset_ = offset;
+    frameSize = HEADER_SIZE + recordsSize;
+    ready_ = true;
+    return true;
+}
+
+bool BinaryCpuTimeSource::Read(TimeType type, const Visitor& visitor)
+{
+    if (!ready_ || type >= TIME_TYPE_BUTT) {
+        return false;
+    }
+    size_t recordSize = GetRecordSize(clusterCount_, freqCount_);
+    const uint8_t* records = reinterpret_cast<const uint8_t*>(fileReader_.GetData()) + frameOffset_ + HEADER_SIZE;
+    for (uint32_t i = 0; i < recordCount_; i++) {
+        BatteryStatsCodec::Reader reader(records + recordSize * i, recordSize);
+        uint32_t uid = 0;
+        uint32_t reserved = 0;
+        reader.GetFixed32(uid);
+        reader.GetFixed32(reserved);
+        times_.clear();
+        bool ret = true;
+        // Skip over the fields in front of the wanted ones, the record size was checked when the frame was selected
+        switch (type) {
+            case TIME_TYPE_ACTIVE:
+                ret = GetInt64s(reader, 1, times_);
+                break;
+            case TIME_TYPE_CLUSTER:
+                ret = reader.Skip(sizeof(uint64_t)) && GetInt64s(reader, clusterCount_, times_);
+                break;
+            case TIME_TYPE_FREQ:
+                ret = reader.Skip(sizeof(uint64_t) * (1 + static_cast<size_t>(clusterCount_))) &&
+                    GetInt64s(reader, freqCount_, times_);
+                break;
+            default:
+                ret = reader.Skip(sizeof(uint64_t) * (1 + static_cast<size_t>(clusterCount_) + freqCount_)) &&
+                    GetInt64s(reader, 2, times_); // 2: user and system time
+                break;
+        }
+        if (!ret) {
+            return false;
+        }
+        if (!visitor(static_cast<int32_t>(uid), times_)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+ReplayCpuTimeSource::ReplayCpuTimeSource(const std::string& path) : BinaryCpuTimeSource(path) {}
+
+const char* ReplayCpuTimeSource::GetName() const
+{
+    return "replay";
+}
+
+bool ReplayCpuTimeSource::Prepare()
+{
+    if (!loaded_) {
+        if (!fileReader_.Read(path_)) {
+            return false;
+        }
+        loaded_ = true;
+    }
+    size_t frameSize = 0;
+    if (!SelectFrame(nextOffset_, frameSize)) {
+        STATS_HILOGI(COMP_SVC, "No more cpu time dumps to replay");
+        return false;
+    }
+    nextOffset_ += frameSize;
+    return true;
+}
+} // namespace PowerMgr
+} // namespace OHOS
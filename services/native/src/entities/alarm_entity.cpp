@@ -34,46 +34,27 @@ int64_t AlarmEntity::GetConsumptionCount(StatsUtils::StatsType statsType, int32_
 {
     int64_t count = StatsUtils::DEFAULT_VALUE;
     if (statsType == StatsUtils::STATS_TYPE_ALARM) {
-        auto almIter = alarmCounterMap_.find(uid);
-        if (almIter != alarmCounterMap_.end()) {
-            count = almIter->second->GetCount();
-            STATS_HILOGD(COMP_SVC, "Get alarm count: %{public}" PRId64 " for uid: %{public}d", count, uid);
-        }
-        STATS_HILOGD(COMP_SVC, "No alarm count related to uid: %{public}d was found, return 0", uid);
+        count = uidTable_->GetCount(uid, BatteryStatsUidTable::COUNTER_ALARM);
+        STATS_HILOGD(COMP_SVC, "Get alarm count: %{public}" PRId64 " for uid: %{public}d", count, uid);
     }
     return count;
 }
 
 void AlarmEntity::Calculate(int32_t uid)
 {
-    auto bss = BatteryStatsService::GetInstance();
-    auto alarmOnAverageMa = bss->GetBatteryStatsParser()->GetAveragePowerMa(StatsUtils::CURRENT_ALARM_ON);
+    auto alarmOnAverageMa = powerProfile_->averageMa[PowerProfile::ITEM_ALARM_ON];
     auto alarmOnCount = GetConsumptionCount(StatsUtils::STATS_TYPE_ALARM, uid);
     auto alarmOnPowerMah = alarmOnAverageMa * alarmOnCount;
-    auto iter = alarmPowerMap_.find(uid);
-    if (iter != alarmPowerMap_.end()) {
-        STATS_HILOGD(COMP_SVC, "Update alarm on power consumption: %{public}lfmAh for uid: %{public}d",
-            alarmOnAverageMa, uid);
-        iter->second = alarmOnPowerMah;
-    } else {
-        STATS_HILOGD(COMP_SVC, "Create alarm on power consumption: %{public}lfmAh for uid: %{public}d",
-            alarmOnAverageMa, uid);
-        alarmPowerMap_.insert(std::pair<int32_t, double>(uid, alarmOnPowerMah));
-    }
+    STATS_HILOGD(COMP_SVC, "Update alarm on power consumption: %{public}lfmAh for uid: %{public}d",
+        alarmOnPowerMah, uid);
+    uidTable_->SetPower(uid, BatteryStatsUidTable::POWER_ALARM, alarmOnPowerMah);
 }
 
 double AlarmEntity::GetEntityPowerMah(int32_t uidOrUserId)
 {
-    double power = StatsUtils::DEFAULT_VALUE;
-    auto iter = alarmPowerMap_.find(uidOrUserId);
-    if (iter != alarmPowerMap_.end()) {
-        power = iter->second;
-        STATS_HILOGD(COMP_SVC, "Get app alarm power consumption: %{public}lfmAh for uid: %{public}d",
-            power, uidOrUserId);
-    } else {
-        STATS_HILOGD(COMP_SVC,
-            "No app alarm power consumption related to uid: %{public}d was found, return 0", uidOrUserId);
-    }
+    double power = uidTable_->GetPower(uidOrUserId, BatteryStatsUidTable::POWER_ALARM);
+    STATS_HILOGD(COMP_SVC, "Get app alarm power consumption: %{public}lfmAh for uid: %{public}d",
+        power, uidOrUserId);
     return power;
 }
 
@@ -81,15 +62,9 @@ double AlarmEntity::GetStatsPowerMah(StatsUtils::StatsType statsType, int32_t ui
 {
     double power = StatsUtils::DEFAULT_VALUE;
     if (statsType == StatsUtils::STATS_TYPE_ALARM) {
-        auto alarmOnIter = alarmPowerMap_.find(uid);
-        if (alarmOnIter != alarmPowerMap_.end()) {
-            power = alarmOnIter->second;
-            STATS_HILOGD(COMP_SVC, "Get alarm on power consumption: %{public}lfmAh for uid: %{public}d",
-                power, uid);
-        } else {
-            STATS_HILOGD(COMP_SVC,
-                "No alarm on power alarm related to uid: %{public}d was found, return 0", uid);
-        }
+        power = uidTable_->GetPower(uid, BatteryStatsUidTable::POWER_ALARM);
+        STATS_HILOGD(COMP_SVC, "Get alarm on power consumption: %{public}lfmAh for uid: %{public}d",
+            power, uid);
     }
     return power;
 }
@@ -100,30 +75,17 @@ std::shared_ptr<StatsHelper::Counter> AlarmEntity::GetOrCreateCounter(StatsUtils
         return nullptr;
     }
 
-    auto alarmOnIter = alarmCounterMap_.find(uid);
-    if (alarmOnIter != alarmCounterMap_.end()) {
-        STATS_HILOGD(COMP_SVC, "Get alarm on counter for uid: %{public}d", uid);
-        return alarmOnIter->second;
-    }
-    STATS_HILOGD(COMP_SVC, "Create alarm on counter for uid: %{public}d", uid);
-    std::shared_ptr<StatsHelper::Counter> alarmCounter = std::make_shared<StatsHelper::Counter>();
-    alarmCounterMap_.insert(std::pair<int32_t, std::shared_ptr<StatsHelper::Counter>>(uid, alarmCounter));
-    return alarmCounter;
+    STATS_HILOGD(COMP_SVC, "Get alarm on counter for uid: %{public}d", uid);
+    return uidTable_->GetOrCreateCounter(uid, BatteryStatsUidTable::COUNTER_ALARM);
 }
 
 void AlarmEntity::Reset()
 {
     // Reset app Alarm on total power consumption
-    for (auto& iter : alarmPowerMap_) {
-        iter.second = StatsUtils::DEFAULT_VALUE;
-    }
+    uidTable_->ResetColumn(BatteryStatsUidTable::POWER_ALARM);
 
     // Reset Alarm on counter
-    for (auto& iter : alarmCounterMap_) {
-        if (iter.second) {
-            iter.second->Reset();
-        }
-    }
+    uidTable_->ResetColumn(BatteryStatsUidTable::COUNTER_ALARM);
 }
 } // namespace PowerMgr
 } // namespace OHOS
\ No newline at end of file
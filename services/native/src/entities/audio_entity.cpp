@@ -35,14 +35,9 @@ int64_t AudioEntity::GetActiveTimeMs(int32_t uid, StatsUtils::StatsType statsTyp
     int64_t activeTimeMs = StatsUtils::DEFAULT_VALUE;
     switch (statsType) {
         case StatsUtils::STATS_TYPE_AUDIO_ON: {
-            auto iter = audioTimerMap_.find(uid);
-            if (iter != audioTimerMap_.end()) {
-                activeTimeMs = iter->second->GetRunningTimeMs();
-                STATS_HILOGD(COMP_SVC, "Get audio on time: %{public}" PRId64 "ms for uid: %{public}d",
-                    activeTimeMs, uid);
-                break;
-            }
-            STATS_HILOGD(COMP_SVC, "Didn't find related timer for uid: %{public}d, return 0", uid);
+            activeTimeMs = uidTable_->GetRunningTimeMs(uid, BatteryStatsUidTable::TIMER_AUDIO_ON);
+            STATS_HILOGD(COMP_SVC, "Get audio on time: %{public}" PRId64 "ms for uid: %{public}d",
+                activeTimeMs, uid);
             break;
         }
         default:
@@ -53,34 +48,19 @@ int64_t AudioEntity::GetActiveTimeMs(int32_t uid, StatsUtils::StatsType statsTyp
 
 void AudioEntity::Calculate(int32_t uid)
 {
-    auto bss = BatteryStatsService::GetInstance();
-    auto audioOnAverageMa = bss->GetBatteryStatsParser()->GetAveragePowerMa(StatsUtils::CURRENT_AUDIO_ON);
+    auto audioOnAverageMa = powerProfile_->averageMa[PowerProfile::ITEM_AUDIO_ON];
     auto audioOnTimeMs = GetActiveTimeMs(uid, StatsUtils::STATS_TYPE_AUDIO_ON);
     auto audioOnPowerMah = audioOnAverageMa * audioOnTimeMs / StatsUtils::MS_IN_HOUR;
-    auto iter = audioPowerMap_.find(uid);
-    if (iter != audioPowerMap_.end()) {
-        STATS_HILOGD(COMP_SVC, "Update audio on power consumption: %{public}lfmAh for uid: %{public}d",
-            audioOnAverageMa, uid);
-        iter->second = audioOnPowerMah;
-    } else {
-        STATS_HILOGD(COMP_SVC, "Create audio on power consumption: %{public}lfmAh for uid: %{public}d",
-            audioOnPowerMah, uid);
-        audioPowerMap_.insert(std::pair<int32_t, double>(uid, audioOnPowerMah));
-    }
+    STATS_HILOGD(COMP_SVC, "Update audio on power consumption: %{public}lfmAh for uid: %{public}d",
+        audioOnPowerMah, uid);
+    uidTable_->SetPower(uid, BatteryStatsUidTable::POWER_AUDIO, audioOnPowerMah);
 }
 
 double AudioEntity::GetEntityPowerMah(int32_t uidOrUserId)
 {
-    double power = StatsUtils::DEFAULT_VALUE;
-    auto iter = audioPowerMap_.find(uidOrUserId);
-    if (iter != audioPowerMap_.end()) {
-        power = iter->second;
-        STATS_HILOGD(COMP_SVC, "Get app audio power consumption: %{public}lfmAh for uid: %{public}d",
-            power, uidOrUserId);
-    } else {
-        STATS_HILOGD(COMP_SVC,
-            "No app audio power consumption related to uid: %{public}d was found, return 0", uidOrUserId);
-    }
+    double power = uidTable_->GetPower(uidOrUserId, BatteryStatsUidTable::POWER_AUDIO);
+    STATS_HILOGD(COMP_SVC, "Get app audio power consumption: %{public}lfmAh for uid: %{public}d",
+        power, uidOrUserId);
     return power;
 }
 
@@ -88,15 +68,9 @@ double AudioEntity::GetStatsPowerMah(StatsUtils::StatsType statsType, int32_t ui
 {
     double power = StatsUtils::DEFAULT_VALUE;
     if (statsType == StatsUtils::STATS_TYPE_AUDIO_ON) {
-        auto audioOnIter = audioPowerMap_.find(uid);
-        if (audioOnIter != audioPowerMap_.end()) {
-            power = audioOnIter->second;
-            STATS_HILOGD(COMP_SVC, "Get audio on power consumption: %{public}lfmAh for uid: %{public}d",
-                power, uid);
-        } else {
-            STATS_HILOGD(COMP_SVC,
-                "No audio on power consumption related to uid: %{public}d was found, return 0", uid);
-        }
+        power = uidTable_->GetPower(uid, BatteryStatsUidTable::POWER_AUDIO);
+        STATS_HILOGD(COMP_SVC, "Get audio on power consumption: %{public}lfmAh for uid: %{public}d",
+            power, uid);
     }
     return power;
 }
@@ -107,16 +81,8 @@ std::shared_ptr<StatsHelper::ActiveTimer> AudioEntity::GetOrCreateTimer(int32_t
     std::shared_ptr<StatsHelper::ActiveTimer> timer = nullptr;
     switch (statsType) {
         case StatsUtils::STATS_TYPE_AUDIO_ON: {
-            auto audioOnIter = audioTimerMap_.find(uid);
-            if (audioOnIter != audioTimerMap_.end()) {
-                STATS_HILOGD(COMP_SVC, "Get audio on timer for uid: %{public}d", uid);
-                timer = audioOnIter->second;
-                break;
-            }
-            STATS_HILOGD(COMP_SVC, "Create audio on timer for uid: %{public}d", uid);
-            std::shared_ptr<StatsHelper::ActiveTimer> audioTimer = std::make_shared<StatsHelper::ActiveTimer>();
-            audioTimerMap_.insert(std::pair<int32_t, std::shared_ptr<StatsHelper::ActiveTimer>>(uid, audioTimer));
-            timer = audioTimer;
+            STATS_HILOGD(COMP_SVC, "Get audio on timer for uid: %{public}d", uid);
+            timer = uidTable_->GetOrCreateTimer(uid, BatteryStatsUidTable::TIMER_AUDIO_ON);
             break;
         }
         default:
@@ -129,16 +95,10 @@ std::shared_ptr<StatsHelper::ActiveTimer> AudioEntity::GetOrCreateTimer(int32_t
 void AudioEntity::Reset()
 {
     // Reset app Audio on total power consumption
-    for (auto& iter : audioPowerMap_) {
-        iter.second = StatsUtils::DEFAULT_VALUE;
-    }
+    uidTable_->ResetColumn(BatteryStatsUidTable::POWER_AUDIO);
 
     // Reset Audio on timer
-    for (auto& iter : audioTimerMap_) {
-        if (iter.second) {
-            iter.second->Reset();
-        }
-    }
+    uidTable_->ResetColumn(BatteryStatsUidTable::TIMER_AUDIO_ON);
 }
 } // namespace PowerMgr
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
\ No newline at end of file
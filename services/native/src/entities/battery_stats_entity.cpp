@@ -18,9 +18,6 @@
 
 namespace OHOS {
 namespace PowerMgr {
-double BatteryStatsEntity::totalPowerMah_ = StatsUtils::DEFAULT_VALUE;
-BatteryStatsInfoList BatteryStatsEntity::statsInfoList_;
-
 void BatteryStatsEntity::AggregateUserPowerMah(int32_t userId, double power)
 {
     STATS_HILOGE(COMP_SVC, "No need to add app power to related user");
@@ -43,14 +40,21 @@ int64_t BatteryStatsEntity::GetConsumptionCount(StatsUtils::StatsType statsType,
     return StatsUtils::DEFAULT_VALUE;
 }
 
-BatteryStatsInfoList BatteryStatsEntity::GetStatsInfoList()
-{
-    return statsInfoList_;
-}
-
-void BatteryStatsEntity::UpdateStatsInfoList(std::shared_ptr<BatteryStatsInfo> info)
+void BatteryStatsEntity::SetContext(const Context& context)
 {
-    statsInfoList_.push_back(info);
+    core_ = context.core;
+    if (context.uidTable != nullptr) {
+        uidTable_ = context.uidTable;
+    }
+    if (context.traffic != nullptr) {
+        traffic_ = context.traffic;
+    }
+    if (context.powerProfile != nullptr) {
+        powerProfile_ = context.powerProfile;
+    }
+    if (context.sums != nullptr) {
+        sums_ = context.sums;
+    }
 }
 
 int64_t BatteryStatsEntity::GetActiveTimeMs(int32_t uid, StatsUtils::StatsType statsType, int16_t level)
@@ -75,6 +79,16 @@ void BatteryStatsEntity::UpdateUidMap(int32_t uid)
     STATS_HILOGE(COMP_SVC, "No need to update uid");
 }
 
+void BatteryStatsEntity::MarkUidDirty(int32_t uid, BatteryStatsInfo::ConsumptionType type, int32_t runningDelta)
+{
+    STATS_HILOGE(COMP_SVC, "No need to mark uid dirty");
+}
+
+void BatteryStatsEntity::InvalidateUserIds()
+{
+    STATS_HILOGE(COMP_SVC, "No need to invalidate user ids");
+}
+
 std::vector<int32_t> BatteryStatsEntity::GetUids()
 {
     STATS_HILOGE(COMP_SVC, "No need to get uids");
@@ -131,17 +145,5 @@ BatteryStatsInfo::ConsumptionType BatteryStatsEntity::GetConsumptionType()
 {
     return consumptionType_;
 }
-
-double BatteryStatsEntity::GetTotalPowerMah()
-{
-    return totalPowerMah_;
-}
-
-void BatteryStatsEntity::ResetStatsEntity()
-{
-    STATS_HILOGI(COMP_SVC, "Reset total consumption power and battery stats list");
-    totalPowerMah_ = StatsUtils::DEFAULT_VALUE;
-    statsInfoList_.clear();
-}
 } // namespace PowerMgr
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
\ No newline at end of file
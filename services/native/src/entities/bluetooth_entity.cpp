@@ -24,8 +24,9 @@
 #include "sys_mgr_client.h"
 #endif
 
-#include "battery_stats_service.h"
+#include "battery_stats_core.h"
 #include "stats_log.h"
+#include "string_ex.h"
 
 namespace OHOS {
 namespace PowerMgr {
@@ -50,17 +51,14 @@ void BluetoothEntity::Calculate(int32_t uid)
 
 void BluetoothEntity::CalculateBtPower()
 {
-    auto bss = BatteryStatsService::GetInstance();
     // Calculate Bluetooth BR on power
-    auto bluetoothBrOnAverageMa =
-        bss->GetBatteryStatsParser()->GetAveragePowerMa(StatsUtils::CURRENT_BLUETOOTH_BR_ON);
+    auto bluetoothBrOnAverageMa = powerProfile_->averageMa[PowerProfile::ITEM_BLUETOOTH_BR_ON];
     auto bluetoothBrOnTimeMs = GetActiveTimeMs(StatsUtils::STATS_TYPE_BLUETOOTH_BR_ON);
     auto bluetoothBrOnPowerMah = bluetoothBrOnAverageMa * bluetoothBrOnTimeMs / StatsUtils::MS_IN_HOUR;
     bluetoothBrPowerMah_ += bluetoothBrOnPowerMah;
 
     // Calculate Bluetooth BLE on power
-    auto bluetoothBleOnAverageMa =
-        bss->GetBatteryStatsParser()->GetAveragePowerMa(StatsUtils::CURRENT_BLUETOOTH_BLE_ON);
+    auto bluetoothBleOnAverageMa = powerProfile_->averageMa[PowerProfile::ITEM_BLUETOOTH_BLE_ON];
     auto bluetoothBleOnTimeMs = GetActiveTimeMs(StatsUtils::STATS_TYPE_BLUETOOTH_BLE_ON);
     auto bluetoothBleOnPowerMah = bluetoothBleOnAverageMa * bluetoothBleOnTimeMs / StatsUtils::MS_IN_HOUR;
     bluetoothBlePowerMah_ += bluetoothBleOnPowerMah;
@@ -68,12 +66,12 @@ void BluetoothEntity::CalculateBtPower()
     auto bluetoothUidPowerMah = GetBluetoothUidPower();
 
     bluetoothPowerMah_ = bluetoothBrOnPowerMah + bluetoothBleOnPowerMah + bluetoothUidPowerMah;
-    totalPowerMah_ += bluetoothPowerMah_;
+    sums_->totalPowerMah += bluetoothPowerMah_;
 
     std::shared_ptr<BatteryStatsInfo> statsInfo = std::make_shared<BatteryStatsInfo>();
     statsInfo->SetConsumptioType(BatteryStatsInfo::CONSUMPTION_TYPE_BLUETOOTH);
     statsInfo->SetPower(bluetoothPowerMah_);
-    statsInfoList_.push_back(statsInfo);
+    sums_->statsInfoList.push_back(statsInfo);
 
     STATS_HILOGD(COMP_SVC, "Calculate bluetooth Br time: %{public}" PRId64 "ms, Br power average: %{public}lfma,"    \
         "Br power consumption: %{public}lfmAh, bluetooth Ble time: %{public}" PRId64 "ms, "                          \
@@ -91,17 +89,14 @@ void BluetoothEntity::CalculateBtPower()
 
 void BluetoothEntity::CalculateBtPowerForApp(int32_t uid)
 {
-    auto bss = BatteryStatsService::GetInstance();
     // Calculate Bluetooth Br scan power consumption
-    auto bluetoothBrScanAverageMa =
-        bss->GetBatteryStatsParser()->GetAveragePowerMa(StatsUtils::CURRENT_BLUETOOTH_BR_SCAN);
+    auto bluetoothBrScanAverageMa = powerProfile_->averageMa[PowerProfile::ITEM_BLUETOOTH_BR_SCAN];
     auto bluetoothBrScanTimeMs = GetActiveTimeMs(uid, StatsUtils::STATS_TYPE_BLUETOOTH_BR_SCAN);
     auto bluetoothBrScanPowerMah = bluetoothBrScanTimeMs * bluetoothBrScanAverageMa / StatsUtils::MS_IN_HOUR;
     UpdateAppBluetoothBlePower(POWER_TYPE_BR, uid, bluetoothBrScanPowerMah);
 
     // Calculate Bluetooth Ble scan power consumption
-    auto bluetoothBleScanAverageMa =
-        bss->GetBatteryStatsParser()->GetAveragePowerMa(StatsUtils::CURRENT_BLUETOOTH_BLE_SCAN);
+    auto bluetoothBleScanAverageMa = powerProfile_->averageMa[PowerProfile::ITEM_BLUETOOTH_BLE_SCAN];
     auto bluetoothBleScanTimeMs = GetActiveTimeMs(uid, StatsUtils::STATS_TYPE_BLUETOOTH_BLE_SCAN);
     auto bluetoothBleScanPowerMah = bluetoothBleScanTimeMs * bluetoothBleScanAverageMa / StatsUtils::MS_IN_HOUR;
     UpdateAppBluetoothBlePower(POWER_TYPE_BLE, uid, bluetoothBleScanPowerMah);
@@ -127,41 +122,20 @@ void BluetoothEntity::UpdateAppBluetoothBlePower(PowerType type, int32_t uid, do
 {
     switch (type) {
         case POWER_TYPE_BR: {
-            auto iter = appBluetoothBrPowerMap_.find(uid);
-            if (iter != appBluetoothBrPowerMap_.end()) {
-                iter->second = powerMah;
-                STATS_HILOGD(COMP_SVC, "Update app bluetooth Br power consumption: %{public}lfmAh for uid: %{public}d",
-                    powerMah, uid);
-                break;
-            }
-            appBluetoothBrPowerMap_.insert(std::pair<int32_t, double>(uid, powerMah));
-            STATS_HILOGD(COMP_SVC, "Create app bluetooth Br power consumption: %{public}lfmAh for uid: %{public}d",
+            uidTable_->SetPower(uid, BatteryStatsUidTable::POWER_BLUETOOTH_BR_SCAN, powerMah);
+            STATS_HILOGD(COMP_SVC, "Update app bluetooth Br power consumption: %{public}lfmAh for uid: %{public}d",
                 powerMah, uid);
             break;
         }
         case POWER_TYPE_BLE: {
-            auto iter = appBluetoothBlePowerMap_.find(uid);
-            if (iter != appBluetoothBlePowerMap_.end()) {
-                iter->second = powerMah;
-                STATS_HILOGD(COMP_SVC, "Update app bluetooth Ble power consumption: %{public}lfmAh for uid: %{public}d",
-                    powerMah, uid);
-                break;
-            }
-            appBluetoothBlePowerMap_.insert(std::pair<int32_t, double>(uid, powerMah));
-            STATS_HILOGD(COMP_SVC, "Create app bluetooth Ble power consumption: %{public}lfmAh for uid: %{public}d",
+            uidTable_->SetPower(uid, BatteryStatsUidTable::POWER_BLUETOOTH_BLE_SCAN, powerMah);
+            STATS_HILOGD(COMP_SVC, "Update app bluetooth Ble power consumption: %{public}lfmAh for uid: %{public}d",
                 powerMah, uid);
             break;
         }
         case POWER_TYPE_ALL: {
-            auto iter = appBluetoothPowerMap_.find(uid);
-            if (iter != appBluetoothPowerMap_.end()) {
-                iter->second = powerMah;
-                STATS_HILOGD(COMP_SVC, "Update app bluetooth power consumption: %{public}lfmAh for uid: %{public}d",
-                    powerMah, uid);
-                break;
-            }
-            appBluetoothPowerMap_.insert(std::pair<int32_t, double>(uid, powerMah));
-            STATS_HILOGD(COMP_SVC, "Create app bluetooth power consumption: %{public}lfmAh for uid: %{public}d",
+            uidTable_->SetPower(uid, BatteryStatsUidTable::POWER_BLUETOOTH, powerMah);
+            STATS_HILOGD(COMP_SVC, "Update app bluetooth power consumption: %{public}lfmAh for uid: %{public}d",
                 powerMah, uid);
             break;
         }
@@ -175,25 +149,15 @@ int64_t BluetoothEntity::GetActiveTimeMs(int32_t uid, StatsUtils::StatsType stat
     int64_t time = StatsUtils::DEFAULT_VALUE;
     switch (statsType) {
         case StatsUtils::STATS_TYPE_BLUETOOTH_BR_SCAN: {
-            auto brScanIter = appBluetoothBrScanTimerMap_.find(uid);
-            if (brScanIter != appBluetoothBrScanTimerMap_.end()) {
-                time = brScanIter->second->GetRunningTimeMs();
-                STATS_HILOGD(COMP_SVC, "Get blueooth Br scan time: %{public}" PRId64 "ms for uid: %{public}d",
-                    time, uid);
-                break;
-            }
-            STATS_HILOGD(COMP_SVC, "No bluetooth Br scan timer related to uid: %{public}d was found, return 0", uid);
+            time = uidTable_->GetRunningTimeMs(uid, BatteryStatsUidTable::TIMER_BLUETOOTH_BR_SCAN);
+            STATS_HILOGD(COMP_SVC, "Get blueooth Br scan time: %{public}" PRId64 "ms for uid: %{public}d",
+                time, uid);
             break;
         }
         case StatsUtils::STATS_TYPE_BLUETOOTH_BLE_SCAN: {
-            auto bleScanIter = appBluetoothBleScanTimerMap_.find(uid);
-            if (bleScanIter != appBluetoothBleScanTimerMap_.end()) {
-                time = bleScanIter->second->GetRunningTimeMs();
-                STATS_HILOGD(COMP_SVC, "Get blueooth Ble scan time: %{public}" PRId64 "ms for uid: %{public}d",
-                    time, uid);
-                break;
-            }
-            STATS_HILOGD(COMP_SVC, "No bluetooth Ble scan timer related to uid: %{public}d was found, return 0", uid);
+            time = uidTable_->GetRunningTimeMs(uid, BatteryStatsUidTable::TIMER_BLUETOOTH_BLE_SCAN);
+            STATS_HILOGD(COMP_SVC, "Get blueooth Ble scan time: %{public}" PRId64 "ms for uid: %{public}d",
+                time, uid);
             break;
         }
         default:
@@ -234,15 +198,9 @@ double BluetoothEntity::GetEntityPowerMah(int32_t uidOrUserId)
 {
     double power = StatsUtils::DEFAULT_VALUE;
     if (uidOrUserId > StatsUtils::INVALID_VALUE) {
-        auto iter = appBluetoothPowerMap_.find(uidOrUserId);
-        if (iter != appBluetoothPowerMap_.end()) {
-            power = iter->second;
-            STATS_HILOGD(COMP_SVC, "Get app blueooth power consumption: %{public}lfmAh for uid: %{public}d",
-                power, uidOrUserId);
-        } else {
-            STATS_HILOGD(COMP_SVC,
-                "No app blueooth power consumption related to uid: %{public}d was found, return 0", uidOrUserId);
-        }
+        power = uidTable_->GetPower(uidOrUserId, BatteryStatsUidTable::POWER_BLUETOOTH);
+        STATS_HILOGD(COMP_SVC, "Get app blueooth power consumption: %{public}lfmAh for uid: %{public}d",
+            power, uidOrUserId);
     } else {
         power = bluetoothPowerMah_;
         STATS_HILOGD(COMP_SVC, "Get blueooth power consumption: %{public}lfmAh", power);
@@ -265,27 +223,15 @@ double BluetoothEntity::GetStatsPowerMah(StatsUtils::StatsType statsType, int32_
             break;
         }
         case StatsUtils::STATS_TYPE_BLUETOOTH_BR_SCAN: {
-            auto brIter = appBluetoothBrPowerMap_.find(uid);
-            if (brIter != appBluetoothBrPowerMap_.end()) {
-                power = brIter->second;
-                STATS_HILOGD(COMP_SVC, "Get blueooth Br scan power consumption: %{public}lfmAh for uid: %{public}d",
-                    power, uid);
-                break;
-            }
-            STATS_HILOGD(COMP_SVC,
-                "No bluetooth Br scan power consumption related to uid: %{public}d was found, return 0", uid);
+            power = uidTable_->GetPower(uid, BatteryStatsUidTable::POWER_BLUETOOTH_BR_SCAN);
+            STATS_HILOGD(COMP_SVC, "Get blueooth Br scan power consumption: %{public}lfmAh for uid: %{public}d",
+                power, uid);
             break;
         }
         case StatsUtils::STATS_TYPE_BLUETOOTH_BLE_SCAN: {
-            auto bleIter = appBluetoothBlePowerMap_.find(uid);
-            if (bleIter != appBluetoothBlePowerMap_.end()) {
-                power = bleIter->second;
-                STATS_HILOGD(COMP_SVC, "Get blueooth Ble scan power consumption: %{public}lfmAh for uid: %{public}d",
-                    power, uid);
-                break;
-            }
-            STATS_HILOGD(COMP_SVC,
-                "No bluetooth Ble scan power consumption related to uid: %{public}d was found, return 0", uid);
+            power = uidTable_->GetPower(uid, BatteryStatsUidTable::POWER_BLUETOOTH_BLE_SCAN);
+            STATS_HILOGD(COMP_SVC, "Get blueooth Ble scan power consumption: %{public}lfmAh for uid: %{public}d",
+                power, uid);
             break;
         }
         default:
@@ -309,30 +255,13 @@ void BluetoothEntity::Reset()
     }
 
     // Reset app Bluetooth scan power consumption
-    for (auto& iter : appBluetoothBrPowerMap_) {
-        iter.second = StatsUtils::DEFAULT_VALUE;
-    }
-
-    for (auto& iter : appBluetoothBlePowerMap_) {
-        iter.second = StatsUtils::DEFAULT_VALUE;
-    }
-
-    for (auto& iter : appBluetoothPowerMap_) {
-        iter.second = StatsUtils::DEFAULT_VALUE;
-    }
+    uidTable_->ResetColumn(BatteryStatsUidTable::POWER_BLUETOOTH_BR_SCAN);
+    uidTable_->ResetColumn(BatteryStatsUidTable::POWER_BLUETOOTH_BLE_SCAN);
+    uidTable_->ResetColumn(BatteryStatsUidTable::POWER_BLUETOOTH);
 
     // Reset Bluetooth scan timer
-    for (auto& iter : appBluetoothBrScanTimerMap_) {
-        if (iter.second) {
-            iter.second->Reset();
-        }
-    }
-
-    for (auto& iter : appBluetoothBleScanTimerMap_) {
-        if (iter.second) {
-            iter.second->Reset();
-        }
-    }
+    uidTable_->ResetColumn(BatteryStatsUidTable::TIMER_BLUETOOTH_BR_SCAN);
+    uidTable_->ResetColumn(BatteryStatsUidTable::TIMER_BLUETOOTH_BLE_SCAN);
 }
 
 std::shared_ptr<StatsHelper::ActiveTimer> BluetoothEntity::GetOrCreateTimer(int32_t uid,
@@ -341,31 +270,13 @@ std::shared_ptr<StatsHelper::ActiveTimer> BluetoothEntity::GetOrCreateTimer(int3
     std::shared_ptr<StatsHelper::ActiveTimer> timer = nullptr;
     switch (statsType) {
         case StatsUtils::STATS_TYPE_BLUETOOTH_BR_SCAN: {
-            auto brScanIter = appBluetoothBrScanTimerMap_.find(uid);
-            if (brScanIter != appBluetoothBrScanTimerMap_.end()) {
-                STATS_HILOGD(COMP_SVC, "Get blueooth Br scan timer for uid: %{public}d", uid);
-                timer = brScanIter->second;
-                break;
-            }
-            STATS_HILOGD(COMP_SVC, "Create bluetooth Br scan timer for uid: %{public}d", uid);
-            std::shared_ptr<StatsHelper::ActiveTimer> brScanTimer = std::make_shared<StatsHelper::ActiveTimer>();
-            appBluetoothBrScanTimerMap_.insert(
-                std::pair<int32_t, std::shared_ptr<StatsHelper::ActiveTimer>>(uid, brScanTimer));
-            timer = brScanTimer;
+            STATS_HILOGD(COMP_SVC, "Get blueooth Br scan timer for uid: %{public}d", uid);
+            timer = uidTable_->GetOrCreateTimer(uid, BatteryStatsUidTable::TIMER_BLUETOOTH_BR_SCAN);
             break;
         }
         case StatsUtils::STATS_TYPE_BLUETOOTH_BLE_SCAN: {
-            auto bleScanIter = appBluetoothBleScanTimerMap_.find(uid);
-            if (bleScanIter != appBluetoothBleScanTimerMap_.end()) {
-                STATS_HILOGD(COMP_SVC, "Get blueooth Ble scan timer for uid: %{public}d", uid);
-                timer = bleScanIter->second;
-                break;
-            }
-            STATS_HILOGD(COMP_SVC, "Create bluetooth Ble scan timer for uid: %{public}d", uid);
-            std::shared_ptr<StatsHelper::ActiveTimer> bleScanTimer = std::make_shared<StatsHelper::ActiveTimer>();
-            appBluetoothBleScanTimerMap_.insert(
-                std::pair<int32_t, std::shared_ptr<StatsHelper::ActiveTimer>>(uid, bleScanTimer));
-            timer = bleScanTimer;
+            STATS_HILOGD(COMP_SVC, "Get blueooth Ble scan timer for uid: %{public}d", uid);
+            timer = uidTable_->GetOrCreateTimer(uid, BatteryStatsUidTable::TIMER_BLUETOOTH_BLE_SCAN);
             break;
         }
         default:
@@ -431,9 +342,8 @@ double BluetoothEntity::GetBluetoothUidPower()
     int32_t bluetoothUid = bmgr->GetUidByBundleName(bundleName, AppExecFwk::Constants::DEFAULT_USERID);
     IPCSkeleton::SetCallingIdentity(identity);
 
-    auto bss = BatteryStatsService::GetInstance();
-    auto core = bss->GetBatteryStatsCore();
-    auto uidEntity = core->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_APP);
+    auto core = core_.lock();
+    auto uidEntity = core != nullptr ? core->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_APP) : nullptr;
     if (uidEntity != nullptr) {
         bluetoothUidPower = uidEntity->GetEntityPowerMah(bluetoothUid);
     }
@@ -47,34 +47,19 @@ int64_t CameraEntity::GetActiveTimeMs(int32_t uid, StatsUtils::StatsType statsTy
 
 void CameraEntity::Calculate(int32_t uid)
 {
-    auto bss = BatteryStatsService::GetInstance();
-    auto cameraOnAverageMa = bss->GetBatteryStatsParser()->GetAveragePowerMa(StatsUtils::CURRENT_CAMERA_ON);
+    auto cameraOnAverageMa = powerProfile_->averageMa[PowerProfile::ITEM_CAMERA_ON];
     auto cameraOnTimeMs = GetActiveTimeMs(uid, StatsUtils::STATS_TYPE_CAMERA_ON);
     auto cameraOnPowerMah = cameraOnAverageMa * cameraOnTimeMs / StatsUtils::MS_IN_HOUR;
-    auto iter = cameraPowerMap_.find(uid);
-    if (iter != cameraPowerMap_.end()) {
-        STATS_HILOGD(COMP_SVC, "Update camera on power consumption: %{public}lfmAh for uid: %{public}d",
-            cameraOnAverageMa, uid);
-        iter->second = cameraOnPowerMah;
-    } else {
-        STATS_HILOGD(COMP_SVC, "Create camera on power consumption: %{public}lfmAh for uid: %{public}d",
-            cameraOnAverageMa, uid);
-        cameraPowerMap_.insert(std::pair<int32_t, double>(uid, cameraOnPowerMah));
-    }
+    STATS_HILOGD(COMP_SVC, "Update camera on power consumption: %{public}lfmAh for uid: %{public}d",
+        cameraOnPowerMah, uid);
+    uidTable_->SetPower(uid, BatteryStatsUidTable::POWER_CAMERA, cameraOnPowerMah);
 }
 
 double CameraEntity::GetEntityPowerMah(int32_t uidOrUserId)
 {
-    double power = StatsUtils::DEFAULT_VALUE;
-    auto iter = cameraPowerMap_.find(uidOrUserId);
-    if (iter != cameraPowerMap_.end()) {
-        power = iter->second;
-        STATS_HILOGD(COMP_SVC, "Get app camera power consumption: %{public}lfmAh for uid: %{public}d",
-            power, uidOrUserId);
-    } else {
-        STATS_HILOGD(COMP_SVC,
-            "No app camera power consumption related to uid: %{public}d was found, return 0", uidOrUserId);
-    }
+    double power = uidTable_->GetPower(uidOrUserId, BatteryStatsUidTable::POWER_CAMERA);
+    STATS_HILOGD(COMP_SVC, "Get app camera power consumption: %{public}lfmAh for uid: %{public}d",
+        power, uidOrUserId);
     return power;
 }
 
@@ -82,15 +67,9 @@ double CameraEntity::GetStatsPowerMah(StatsUtils::StatsType statsType, int32_t u
 {
     double power = StatsUtils::DEFAULT_VALUE;
     if (statsType == StatsUtils::STATS_TYPE_CAMERA_ON) {
-        auto cameraOnIter = cameraPowerMap_.find(uid);
-        if (cameraOnIter != cameraPowerMap_.end()) {
-            power = cameraOnIter->second;
-            STATS_HILOGD(COMP_SVC, "Get camera on power consumption: %{public}lfmAh for uid: %{public}d",
-                power, uid);
-        } else {
-            STATS_HILOGD(COMP_SVC,
-                "No camera on power consumption related to uid: %{public}d was found, return 0", uid);
-        }
+        power = uidTable_->GetPower(uid, BatteryStatsUidTable::POWER_CAMERA);
+        STATS_HILOGD(COMP_SVC, "Get camera on power consumption: %{public}lfmAh for uid: %{public}d",
+            power, uid);
     }
     return power;
 }
@@ -124,9 +103,7 @@ std::shared_ptr<StatsHelper::ActiveTimer> CameraEntity::GetOrCreateTimer(const s
 void CameraEntity::Reset()
 {
     // Reset app Camera on total power consumption
-    for (auto& iter : cameraPowerMap_) {
-        iter.second = StatsUtils::DEFAULT_VALUE;
-    }
+    uidTable_->ResetColumn(BatteryStatsUidTable::POWER_CAMERA);
 
     // Reset Camera on timer
     for (auto& cameraIter : cameraTimerMap_) {
@@ -138,4 +115,4 @@ void CameraEntity::Reset()
     }
 }
 } // namespace PowerMgr
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
\ No newline at end of file
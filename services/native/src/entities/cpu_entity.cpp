@@ -15,7 +15,7 @@
 
 #include "entities/cpu_entity.h"
 
-#include "battery_stats_service.h"
+#include "battery_stats_core.h"
 #include "stats_log.h"
 
 namespace OHOS {
@@ -27,39 +27,41 @@ CpuEntity::CpuEntity()
 {
     STATS_HILOGD(COMP_SVC, "Created cpu entity");
     consumptionType_ = BatteryStatsInfo::CONSUMPTION_TYPE_CPU;
-    if (!cpuReader_) {
-        cpuReader_ = std::make_shared<CpuTimeReader>();
-        cpuReader_->Init();
-    }
 }
 
 int64_t CpuEntity::GetCpuTimeMs(int32_t uid)
 {
-    int64_t cpuTimeMs = StatsUtils::DEFAULT_VALUE;
-    auto iter = cpuTimeMap_.find(uid);
-    if (iter != cpuTimeMap_.end()) {
-        STATS_HILOGD(COMP_SVC, "Get cpu time: %{public}sms for uid: %{public}d",
-            std::to_string(cpuTimeMs).c_str(), uid);
-        cpuTimeMs = iter->second;
-    } else {
-        STATS_HILOGD(COMP_SVC, "No cpu time realted to uid: %{public}d was found, return 0", uid);
-    }
+    int64_t cpuTimeMs = uidTable_->GetData(uid, BatteryStatsUidTable::DATA_CPU_TIME);
+    STATS_HILOGD(COMP_SVC, "Get cpu time: %{public}sms for uid: %{public}d",
+        std::to_string(cpuTimeMs).c_str(), uid);
     return cpuTimeMs;
 }
 
 void CpuEntity::UpdateCpuTime()
 {
-    if (cpuReader_) {
-        if (!cpuReader_->UpdateCpuTime()) {
-            STATS_HILOGE(COMP_SVC, "Update CPU time failed");
+    // Created by the first update, the kernel is not read for a core which never samples the cpu time
+    if (cpuReader_ == nullptr) {
+        cpuReader_ = std::make_shared<CpuTimeReader>();
+        cpuReader_->SetSpeedOffsets(powerProfile_->speedOffsets);
+    }
+    if (!cpuReader_->UpdateCpuTime()) {
+        STATS_HILOGE(COMP_SVC, "Update CPU time failed");
+    }
+    // The uid entity calls back into the getters of the reader, so it is told about the uids after the update
+    auto core = core_.lock();
+    auto uidEntity = core != nullptr ? core->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_APP) : nullptr;
+    for (int32_t uid : cpuReader_->TakeSampledUids()) {
+        if (uidEntity != nullptr) {
+            uidEntity->UpdateUidMap(uid);
         }
-    } else {
-        STATS_HILOGW(COMP_SVC, "CPU reader is nullptr");
     }
 }
 
 void CpuEntity::Calculate(int32_t uid)
 {
+    if (cpuReader_ == nullptr) {
+        return;
+    }
     double cpuTotalPowerMah = StatsUtils::DEFAULT_VALUE;
     // Get cpu time related with uid
     std::vector<int64_t> cpuTimeVec = cpuReader_->GetUidCpuTimeMs(uid);
@@ -67,16 +69,9 @@ void CpuEntity::Calculate(int32_t uid)
     for (uint32_t i = 0; i < cpuTimeVec.size(); i++) {
         cpuTimeMs += cpuTimeVec[i];
     }
-    auto cpuTimeIter = cpuTimeMap_.find(uid);
-    if (cpuTimeIter != cpuTimeMap_.end()) {
-        STATS_HILOGD(COMP_SVC, "Update cpu time: %{public}sms for uid: %{public}d",
-            std::to_string(cpuTimeMs).c_str(), uid);
-        cpuTimeIter->second = cpuTimeMs;
-    } else {
-        STATS_HILOGD(COMP_SVC, "Create cpu time: %{public}sms for uid: %{public}d",
-            std::to_string(cpuTimeMs).c_str(), uid);
-        cpuTimeMap_.insert(std::pair<int32_t, int64_t>(uid, cpuTimeMs));
-    }
+    STATS_HILOGD(COMP_SVC, "Update cpu time: %{public}sms for uid: %{public}d",
+        std::to_string(cpuTimeMs).c_str(), uid);
+    uidTable_->SetData(uid, BatteryStatsUidTable::DATA_CPU_TIME, cpuTimeMs);
 
     // Calculate cpu active power
     cpuTotalPowerMah += CalculateCpuActivePower(uid);
@@ -87,100 +82,58 @@ void CpuEntity::Calculate(int32_t uid)
     // Calculate cpu speed power
     cpuTotalPowerMah += CalculateCpuSpeedPower(uid);
 
-    auto cpuTotalIter = cpuTotalPowerMap_.find(uid);
-    if (cpuTotalIter != cpuTotalPowerMap_.end()) {
-        STATS_HILOGD(COMP_SVC, "Update cpu speed power consumption: %{public}lfmAh for uid: %{public}d",
-            cpuTotalPowerMah, uid);
-        cpuTotalIter->second = cpuTotalPowerMah;
-    } else {
-        STATS_HILOGD(COMP_SVC, "Create cpu speed power consumption: %{public}lfmAh for uid: %{public}d",
-            cpuTotalPowerMah, uid);
-        cpuTotalPowerMap_.insert(std::pair<int32_t, double>(uid, cpuTotalPowerMah));
-    }
+    STATS_HILOGD(COMP_SVC, "Update cpu total power consumption: %{public}lfmAh for uid: %{public}d",
+        cpuTotalPowerMah, uid);
+    uidTable_->SetPower(uid, BatteryStatsUidTable::POWER_CPU, cpuTotalPowerMah);
 }
 
 double CpuEntity::CalculateCpuActivePower(int32_t uid)
 {
-    auto bss = BatteryStatsService::GetInstance();
-    double cpuActiveAverageMa =
-        bss->GetBatteryStatsParser()->GetAveragePowerMa(StatsUtils::CURRENT_CPU_ACTIVE);
+    double cpuActiveAverageMa = powerProfile_->averageMa[PowerProfile::ITEM_CPU_ACTIVE];
     int64_t cpuActiveTimeMs = cpuReader_->GetUidCpuActiveTimeMs(uid);
     double cpuActivePower = cpuActiveAverageMa * cpuActiveTimeMs / StatsUtils::MS_IN_HOUR;
 
-    auto cpuActiveIter = cpuActivePowerMap_.find(uid);
-    if (cpuActiveIter != cpuActivePowerMap_.end()) {
-        STATS_HILOGD(COMP_SVC, "Update cpu active power consumption: %{public}lfmAh for uid: %{public}d",
-            cpuActivePower, uid);
-        cpuActiveIter->second = cpuActivePower;
-    } else {
-        STATS_HILOGD(COMP_SVC, "Create cpu active power consumption: %{public}lfmAh for uid: %{public}d",
-            cpuActivePower, uid);
-        cpuActivePowerMap_.insert(std::pair<int32_t, double>(uid, cpuActivePower));
-    }
+    STATS_HILOGD(COMP_SVC, "Update cpu active power consumption: %{public}lfmAh for uid: %{public}d",
+        cpuActivePower, uid);
+    uidTable_->SetPower(uid, BatteryStatsUidTable::POWER_CPU_ACTIVE, cpuActivePower);
     return cpuActivePower;
 }
 
 double CpuEntity::CalculateCpuClusterPower(int32_t uid)
 {
     double cpuClusterPower = StatsUtils::DEFAULT_VALUE;
-    auto bss = BatteryStatsService::GetInstance();
-    for (uint16_t i = 0; i < bss->GetBatteryStatsParser()->GetClusterNum(); i++) {
-        double cpuClusterAverageMa =
-            bss->GetBatteryStatsParser()->GetAveragePowerMa(StatsUtils::CURRENT_CPU_CLUSTER, i);
+    const auto& clusterMa = powerProfile_->clusterMa;
+    for (uint16_t i = 0; i < clusterMa.size(); i++) {
+        double cpuClusterAverageMa = clusterMa[i];
         int64_t cpuClusterTimeMs = cpuReader_->GetUidCpuClusterTimeMs(uid, i);
         cpuClusterPower += cpuClusterAverageMa * cpuClusterTimeMs / StatsUtils::MS_IN_HOUR;
     }
-    auto cpuClusterIter = cpuClusterPowerMap_.find(uid);
-    if (cpuClusterIter != cpuClusterPowerMap_.end()) {
-        STATS_HILOGD(COMP_SVC, "Update cpu cluster power consumption: %{public}lfmAh for uid: %{public}d",
-            cpuClusterPower, uid);
-        cpuClusterIter->second = cpuClusterPower;
-    } else {
-        STATS_HILOGD(COMP_SVC, "Create cpu cluster power consumption: %{public}lfmAh for uid: %{public}d",
-            cpuClusterPower, uid);
-        cpuClusterPowerMap_.insert(std::pair<int32_t, double>(uid, cpuClusterPower));
-    }
+    STATS_HILOGD(COMP_SVC, "Update cpu cluster power consumption: %{public}lfmAh for uid: %{public}d",
+        cpuClusterPower, uid);
+    uidTable_->SetPower(uid, BatteryStatsUidTable::POWER_CPU_CLUSTER, cpuClusterPower);
     return cpuClusterPower;
 }
 
 double CpuEntity::CalculateCpuSpeedPower(int32_t uid)
 {
     double cpuSpeedPower = StatsUtils::DEFAULT_VALUE;
-    auto bss = BatteryStatsService::GetInstance();
-    for (uint16_t i = 0; i < bss->GetBatteryStatsParser()->GetClusterNum(); i++) {
-        for (uint16_t j = 0; j < bss->GetBatteryStatsParser()->GetSpeedNum(i); j++) {
-            STATS_HILOGD(COMP_SVC, "Calculate cluster: %{public}d, speed: %{public}d", j, i);
-            std::string statType = StatsUtils::CURRENT_CPU_SPEED + std::to_string(i);
-            double cpuSpeedAverageMa = bss->GetBatteryStatsParser()->GetAveragePowerMa(statType, j);
-            int64_t cpuSpeedTimeMs = cpuReader_->GetUidCpuFreqTimeMs(uid, i, j);
-            cpuSpeedPower += cpuSpeedAverageMa * cpuSpeedTimeMs / StatsUtils::MS_IN_HOUR;
-        }
-    }
-    auto cpuSpeedIter = cpuSpeedPowerMap_.find(uid);
-    if (cpuSpeedIter != cpuSpeedPowerMap_.end()) {
-        STATS_HILOGD(COMP_SVC, "Update cpu speed power consumption: %{public}lfmAh for uid: %{public}d",
-            cpuSpeedPower, uid);
-        cpuSpeedIter->second = cpuSpeedPower;
-    } else {
-        STATS_HILOGD(COMP_SVC, "Create cpu speed power consumption: %{public}lfmAh for uid: %{public}d",
-            cpuSpeedPower, uid);
-        cpuSpeedPowerMap_.insert(std::pair<int32_t, double>(uid, cpuSpeedPower));
-    }
+    const auto& offsets = powerProfile_->speedOffsets;
+    for (uint32_t i = 0; i + 1 < offsets.size(); i++) {
+        const double* speedAverageMa = powerProfile_->speedMa.data() + offsets[i];
+        size_t speedNum = offsets[i + 1] - offsets[i];
+        cpuSpeedPower += cpuReader_->GetUidCpuFreqPowerMaMs(uid, i, speedAverageMa, speedNum) / StatsUtils::MS_IN_HOUR;
+    }
+    STATS_HILOGD(COMP_SVC, "Update cpu speed power consumption: %{public}lfmAh for uid: %{public}d",
+        cpuSpeedPower, uid);
+    uidTable_->SetPower(uid, BatteryStatsUidTable::POWER_CPU_SPEED, cpuSpeedPower);
     return cpuSpeedPower;
 }
 
 double CpuEntity::GetEntityPowerMah(int32_t uidOrUserId)
 {
-    double power = StatsUtils::DEFAULT_VALUE;
-    auto iter = cpuTotalPowerMap_.find(uidOrUserId);
-    if (iter != cpuTotalPowerMap_.end()) {
-        power = iter->second;
-        STATS_HILOGD(COMP_SVC, "Get app cpu total power consumption: %{public}lfmAh for uid: %{public}d",
-            power, uidOrUserId);
-    } else {
-        STATS_HILOGD(COMP_SVC,
-            "No app cpu total power consumption related to uid: %{public}d was found, return 0", uidOrUserId);
-    }
+    double power = uidTable_->GetPower(uidOrUserId, BatteryStatsUidTable::POWER_CPU);
+    STATS_HILOGD(COMP_SVC, "Get app cpu total power consumption: %{public}lfmAh for uid: %{public}d",
+        power, uidOrUserId);
     return power;
 }
 
@@ -189,35 +142,17 @@ double CpuEntity::GetStatsPowerMah(StatsUtils::StatsType statsType, int32_t uid)
     double power = StatsUtils::DEFAULT_VALUE;
 
     if (statsType == StatsUtils::STATS_TYPE_CPU_ACTIVE) {
-        auto cpuActiveIter = cpuActivePowerMap_.find(uid);
-        if (cpuActiveIter != cpuActivePowerMap_.end()) {
-            power = cpuActiveIter->second;
-            STATS_HILOGD(COMP_SVC, "Get cpu active power consumption: %{public}lfmAh for uid: %{public}d",
-                power, uid);
-        } else {
-            STATS_HILOGD(COMP_SVC,
-                "No cpu active power consumption related to uid: %{public}d was found, return 0", uid);
-        }
+        power = uidTable_->GetPower(uid, BatteryStatsUidTable::POWER_CPU_ACTIVE);
+        STATS_HILOGD(COMP_SVC, "Get cpu active power consumption: %{public}lfmAh for uid: %{public}d",
+            power, uid);
     } else if (statsType == StatsUtils::STATS_TYPE_CPU_CLUSTER) {
-        auto cpuClusterIter = cpuClusterPowerMap_.find(uid);
-        if (cpuClusterIter != cpuClusterPowerMap_.end()) {
-            power = cpuClusterIter->second;
-            STATS_HILOGD(COMP_SVC, "Get cpu cluster power consumption: %{public}lfmAh for uid: %{public}d",
-                power, uid);
-        } else {
-            STATS_HILOGD(COMP_SVC,
-                "No cpu cluster power consumption related to uid: %{public}d was found, return 0", uid);
-        }
+        power = uidTable_->GetPower(uid, BatteryStatsUidTable::POWER_CPU_CLUSTER);
+        STATS_HILOGD(COMP_SVC, "Get cpu cluster power consumption: %{public}lfmAh for uid: %{public}d",
+            power, uid);
     } else if (statsType == StatsUtils::STATS_TYPE_CPU_SPEED) {
-        auto cpuSpeedIter = cpuSpeedPowerMap_.find(uid);
-        if (cpuSpeedIter != cpuSpeedPowerMap_.end()) {
-            power = cpuSpeedIter->second;
-            STATS_HILOGD(COMP_SVC, "Get cpu speed power consumption: %{public}lfmAh for uid: %{public}d",
-                power, uid);
-        } else {
-            STATS_HILOGD(COMP_SVC,
-                "No cpu speed power consumption related to uid: %{public}d was found, return 0", uid);
-        }
+        power = uidTable_->GetPower(uid, BatteryStatsUidTable::POWER_CPU_SPEED);
+        STATS_HILOGD(COMP_SVC, "Get cpu speed power consumption: %{public}lfmAh for uid: %{public}d",
+            power, uid);
     }
     return power;
 }
@@ -225,29 +160,19 @@ double CpuEntity::GetStatsPowerMah(StatsUtils::StatsType statsType, int32_t uid)
 void CpuEntity::Reset()
 {
     // Reset app Cpu time
-    for (auto& iter : cpuTimeMap_) {
-        iter.second = StatsUtils::DEFAULT_VALUE;
-    }
+    uidTable_->ResetColumn(BatteryStatsUidTable::DATA_CPU_TIME);
 
     // Reset app Cpu total power consumption
-    for (auto& iter : cpuTotalPowerMap_) {
-        iter.second = StatsUtils::DEFAULT_VALUE;
-    }
+    uidTable_->ResetColumn(BatteryStatsUidTable::POWER_CPU);
 
     // Reset app Cpu active power consumption
-    for (auto& iter : cpuActivePowerMap_) {
-        iter.second = StatsUtils::DEFAULT_VALUE;
-    }
+    uidTable_->ResetColumn(BatteryStatsUidTable::POWER_CPU_ACTIVE);
 
     // Reset app Cpu cluster power consumption
-    for (auto& iter : cpuClusterPowerMap_) {
-        iter.second = StatsUtils::DEFAULT_VALUE;
-    }
+    uidTable_->ResetColumn(BatteryStatsUidTable::POWER_CPU_CLUSTER);
 
     // Reset app Cpu speed power consumption
-    for (auto& iter : cpuSpeedPowerMap_) {
-        iter.second = StatsUtils::DEFAULT_VALUE;
-    }
+    uidTable_->ResetColumn(BatteryStatsUidTable::POWER_CPU_SPEED);
 }
 
 void CpuEntity::DumpInfo(std::string& result, int32_t uid)
@@ -50,20 +50,18 @@ void IdleEntity::Calculate(int32_t uid)
     auto cpuSuspendPower = CalculateCpuSuspendPower();
     auto cpuIdlePower = CalculateCpuIdlePower();
     idleTotalPowerMah_ = cpuSuspendPower + cpuIdlePower;
-    totalPowerMah_ += idleTotalPowerMah_;
+    sums_->totalPowerMah += idleTotalPowerMah_;
     std::shared_ptr<BatteryStatsInfo> statsInfo = std::make_shared<BatteryStatsInfo>();
     statsInfo->SetConsumptioType(BatteryStatsInfo::CONSUMPTION_TYPE_IDLE);
     statsInfo->SetPower(idleTotalPowerMah_);
-    statsInfoList_.push_back(statsInfo);
+    sums_->statsInfoList.push_back(statsInfo);
 
     STATS_HILOGD(COMP_SVC, "Calculate idle total power consumption: %{public}lfmAh", idleTotalPowerMah_);
 }
 
 double IdleEntity::CalculateCpuSuspendPower()
 {
-    auto bss = BatteryStatsService::GetInstance();
-    auto cpuSuspendAverageMa =
-        bss->GetBatteryStatsParser()->GetAveragePowerMa(StatsUtils::CURRENT_CPU_SUSPEND);
+    auto cpuSuspendAverageMa = powerProfile_->averageMa[PowerProfile::ITEM_CPU_SUSPEND];
     auto bootOnBatteryTimeMs = GetActiveTimeMs(StatsUtils::STATS_TYPE_CPU_SUSPEND);
     auto cpuSuspendPowerMah = cpuSuspendAverageMa * bootOnBatteryTimeMs / StatsUtils::MS_IN_HOUR;
     cpuSuspendPowerMah_ = cpuSuspendPowerMah;
@@ -73,9 +71,7 @@ double IdleEntity::CalculateCpuSuspendPower()
 
 double IdleEntity::CalculateCpuIdlePower()
 {
-    auto bss = BatteryStatsService::GetInstance();
-    auto cpuIdleAverageMa =
-        bss->GetBatteryStatsParser()->GetAveragePowerMa(StatsUtils::CURRENT_CPU_IDLE);
+    auto cpuIdleAverageMa = powerProfile_->averageMa[PowerProfile::ITEM_CPU_IDLE];
     auto upOnBatteryTimeMs = GetActiveTimeMs(StatsUtils::STATS_TYPE_PHONE_IDLE);
     auto cpuIdlePowerMah = cpuIdleAverageMa * upOnBatteryTimeMs / StatsUtils::MS_IN_HOUR;
     cpuIdlePowerMah_ = cpuIdlePowerMah;
@@ -96,12 +96,10 @@ int64_t PhoneEntity::GetTotalTimeMs(StatsUtils::StatsType statsType)
 
 void PhoneEntity::Calculate(int32_t uid)
 {
-    auto bss = BatteryStatsService::GetInstance();
     // Calculate phone on power
     double phoneOnPowerMah = StatsUtils::DEFAULT_VALUE;
     for (int32_t i = 0; i < StatsUtils::RADIO_SIGNAL_BIN; i++) {
-        auto phoneOnAverageMa =
-            bss->GetBatteryStatsParser()->GetAveragePowerMa(StatsUtils::CURRENT_RADIO_ON, i);
+        auto phoneOnAverageMa = powerProfile_->radioOnMa[i];
         auto phoneOnLevelTimeMs = GetActiveTimeMs(StatsUtils::STATS_TYPE_PHONE_ACTIVE, i);
         double phoneOnLevelPowerMah = phoneOnAverageMa * phoneOnLevelTimeMs / StatsUtils::MS_IN_HOUR;
         phoneOnPowerMah += phoneOnLevelPowerMah;
@@ -110,18 +108,24 @@ void PhoneEntity::Calculate(int32_t uid)
     // Calculate phone data power
     double phoneDataPowerMah = StatsUtils::DEFAULT_VALUE;
     for (int32_t i = 0; i < StatsUtils::RADIO_SIGNAL_BIN; i++) {
-        auto phoneDataAverageMa =
-            bss->GetBatteryStatsParser()->GetAveragePowerMa(StatsUtils::CURRENT_RADIO_DATA, i);
+        auto phoneDataAverageMa = powerProfile_->radioDataMa[i];
         auto phoneDataLevelTimeMs = GetActiveTimeMs(StatsUtils::STATS_TYPE_PHONE_DATA, i);
         double phoneDataLevelPowerMah = phoneDataAverageMa * phoneDataLevelTimeMs / StatsUtils::MS_IN_HOUR;
         phoneDataPowerMah += phoneDataLevelPowerMah;
     }
-    phonePowerMah_ = phoneOnPowerMah + phoneDataPowerMah;
-    totalPowerMah_ += phonePowerMah_;
+    // Calculate phone traffic power
+    double phoneTrafficPowerMah = StatsUtils::DEFAULT_VALUE;
+    if (traffic_ != nullptr) {
+        phoneTrafficPowerMah = traffic_->GetPowerMah(TrafficSource::NETWORK_CELLULAR,
+            powerProfile_->averageMa[PowerProfile::ITEM_RADIO_RX],
+            powerProfile_->averageMa[PowerProfile::ITEM_RADIO_TX]);
+    }
+    phonePowerMah_ = phoneOnPowerMah + phoneDataPowerMah + phoneTrafficPowerMah;
+    sums_->totalPowerMah += phonePowerMah_;
     std::shared_ptr<BatteryStatsInfo> statsInfo = std::make_shared<BatteryStatsInfo>();
     statsInfo->SetConsumptioType(BatteryStatsInfo::CONSUMPTION_TYPE_PHONE);
     statsInfo->SetPower(phonePowerMah_);
-    statsInfoList_.push_back(statsInfo);
+    sums_->statsInfoList.push_back(statsInfo);
     STATS_HILOGD(COMP_SVC, "Calculate phone active power consumption: %{public}lfmAh", phonePowerMah_);
 }
 
@@ -135,6 +139,20 @@ double PhoneEntity::GetStatsPowerMah(StatsUtils::StatsType statsType, int32_t ui
     return phonePowerMah_;
 }
 
+int64_t PhoneEntity::GetTrafficByte(StatsUtils::StatsType statsType, int32_t uid)
+{
+    if (statsType != StatsUtils::STATS_TYPE_PHONE_ACTIVE && statsType != StatsUtils::STATS_TYPE_PHONE_DATA) {
+        return StatsUtils::DEFAULT_VALUE;
+    }
+    if (traffic_ == nullptr) {
+        STATS_HILOGD(COMP_SVC, "Cellular traffic is not counted, return 0");
+        return StatsUtils::DEFAULT_VALUE;
+    }
+    auto bytes = static_cast<int64_t>(traffic_->GetBytes(TrafficSource::NETWORK_CELLULAR, uid));
+    STATS_HILOGD(COMP_SVC, "Get cellular traffic: %{public}" PRId64 "B for uid: %{public}d", bytes, uid);
+    return bytes;
+}
+
 std::shared_ptr<StatsHelper::ActiveTimer> PhoneEntity::GetOrCreateTimer(StatsUtils::StatsType statsType, int16_t level)
 {
     std::shared_ptr<StatsHelper::ActiveTimer> timer = nullptr;
@@ -197,6 +215,11 @@ void PhoneEntity::Reset()
             iter.second->Reset();
         }
     }
+
+    // Reset cellular traffic
+    if (traffic_) {
+        traffic_->Reset(TrafficSource::NETWORK_CELLULAR);
+    }
 }
 
 void PhoneEntity::DumpInfo(std::string& result, int32_t uid)
@@ -215,7 +238,10 @@ void PhoneEntity::DumpInfo(std::string& result, int32_t uid)
         .append("Phone data time: ")
         .append(ToString(phoneDataTime))
         .append("ms")
-        .append("\n");
+        .append("\n")
+        .append("Phone data traffic: ")
+        .append(ToString(GetTrafficByte(StatsUtils::STATS_TYPE_PHONE_DATA)))
+        .append("B\n");
 }
 } // namespace PowerMgr
 } // namespace OHOS
\ No newline at end of file
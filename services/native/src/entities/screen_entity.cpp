@@ -67,6 +67,8 @@ int64_t ScreenEntity::GetActiveTimeMs(StatsUtils::StatsType statsType, int16_t l
 
 int64_t ScreenEntity::GetBrightnessTotalTimeMs()
 {
+    // The bins are summed at one now, a bin switch in between can't be counted twice
+    StatsHelper::TimeSnapshot timeSnapshot;
     int64_t totalTimeMs = StatsUtils::DEFAULT_VALUE;
     for (auto timerIter : screenBrightnessTimerMap_) {
         totalTimeMs += timerIter.second->GetRunningTimeMs();
@@ -76,29 +78,25 @@ int64_t ScreenEntity::GetBrightnessTotalTimeMs()
 
 void ScreenEntity::Calculate(int32_t uid)
 {
-    auto bss = BatteryStatsService::GetInstance();
-    auto screenOnAverageMa =
-        bss->GetBatteryStatsParser()->GetAveragePowerMa(StatsUtils::CURRENT_SCREEN_ON);
+    auto screenOnAverageMa = powerProfile_->averageMa[PowerProfile::ITEM_SCREEN_ON];
     auto screenOnTimeMs = GetActiveTimeMs(StatsUtils::STATS_TYPE_SCREEN_ON);
     double screenOnPowerMah = screenOnAverageMa * screenOnTimeMs;
 
-    auto brightnessAverageMa =
-        bss->GetBatteryStatsParser()->GetAveragePowerMa(StatsUtils::CURRENT_SCREEN_BRIGHTNESS);
     double brightnessPowerMah = StatsUtils::DEFAULT_VALUE;
     for (auto& iter : screenBrightnessTimerMap_) {
         if (iter.second != nullptr) {
-            auto averageMa = brightnessAverageMa * iter.first;
+            auto averageMa = powerProfile_->brightnessMa[iter.first];
             auto timeMs = GetActiveTimeMs(StatsUtils::STATS_TYPE_SCREEN_BRIGHTNESS, iter.first);
             brightnessPowerMah += averageMa * timeMs;
         }
     }
 
     screenPowerMah_ = (screenOnPowerMah + brightnessPowerMah) / StatsUtils::MS_IN_HOUR;
-    totalPowerMah_ += screenPowerMah_;
+    sums_->totalPowerMah += screenPowerMah_;
     std::shared_ptr<BatteryStatsInfo> statsInfo = std::make_shared<BatteryStatsInfo>();
     statsInfo->SetConsumptioType(BatteryStatsInfo::CONSUMPTION_TYPE_SCREEN);
     statsInfo->SetPower(screenPowerMah_);
-    statsInfoList_.push_back(statsInfo);
+    sums_->statsInfoList.push_back(statsInfo);
     STATS_HILOGD(COMP_SVC, "Calculate screen active power consumption: %{public}lfmAh", screenPowerMah_);
 }
 
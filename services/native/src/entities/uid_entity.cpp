@@ -23,13 +23,27 @@
 #include <sys_mgr_client.h>
 #endif
 
+#include <algorithm>
+
 #include <ohos_account_kits_impl.h>
-#include "battery_stats_service.h"
+#include "battery_stats_core.h"
 #include "stats_log.h"
+#include "string_ex.h"
 
 namespace OHOS {
 namespace PowerMgr {
 namespace {
+constexpr uint32_t ALL_PARTS_DIRTY = UINT32_MAX;
+
+uint32_t GetPartIndex(BatteryStatsInfo::ConsumptionType type)
+{
+    return static_cast<uint32_t>(type - BatteryStatsInfo::CONSUMPTION_TYPE_APP);
+}
+
+bool IsValidPart(BatteryStatsInfo::ConsumptionType type)
+{
+    return type >= BatteryStatsInfo::CONSUMPTION_TYPE_APP && type <= BatteryStatsInfo::CONSUMPTION_TYPE_ALARM;
+}
 }
 
 UidEntity::UidEntity()
@@ -37,49 +51,137 @@ UidEntity::UidEntity()
     consumptionType_ = BatteryStatsInfo::CONSUMPTION_TYPE_APP;
 }
 
+UidEntity::UidState* UidEntity::GetUidStateLocked(int32_t uid)
+{
+    uint32_t slot = uidTable_->GetOrCreateSlot(uid);
+    if (slot == BatteryStatsUidTable::INVALID_SLOT) {
+        return nullptr;
+    }
+    if (slot >= uidStates_.size()) {
+        uidStates_.resize(slot + 1);
+    }
+    return &uidStates_[slot];
+}
+
+void UidEntity::MarkUidDirty(int32_t uid, BatteryStatsInfo::ConsumptionType type, int32_t runningDelta)
+{
+    std::lock_guard<std::mutex> lock(uidEntityMutex_);
+    if (!IsValidPart(type)) {
+        return;
+    }
+    uint32_t partIndex = GetPartIndex(type);
+    uint32_t partBit = 1U << partIndex;
+    if (uid <= StatsUtils::INVALID_VALUE) {
+        // Invalidate the part for all the uids, e.g. when the cpu time has been refreshed
+        for (auto& state : uidStates_) {
+            state.dirtyParts |= partBit;
+        }
+        return;
+    }
+    UidState* state = GetUidStateLocked(uid);
+    if (state == nullptr) {
+        return;
+    }
+    state->dirtyParts |= partBit;
+    // Only the start and stop of a timer move the count, a duplicate stop reports no change
+    auto& runningCount = state->runningCounts[partIndex];
+    if (runningDelta > 0) {
+        runningCount++;
+    } else if (runningDelta < 0 && runningCount > 0) {
+        runningCount--;
+    }
+}
+
 void UidEntity::UpdateUidMap(int32_t uid)
 {
     std::lock_guard<std::mutex> lock(uidEntityMutex_);
     if (uid > StatsUtils::INVALID_VALUE) {
-        auto iter = uidPowerMap_.find(uid);
-        if (iter != uidPowerMap_.end()) {
+        UidState* state = GetUidStateLocked(uid);
+        if (state == nullptr || state->isApp) {
             STATS_HILOGD(COMP_SVC, "Uid has already been added, ignore");
-        } else {
-            STATS_HILOGD(COMP_SVC, "Update %{public}d to uid power map", uid);
-            uidPowerMap_.insert(std::pair<int32_t, double>(uid, StatsUtils::DEFAULT_VALUE));
+            return;
         }
+        STATS_HILOGD(COMP_SVC, "Update %{public}d to uid power map", uid);
+        state->isApp = true;
+        state->dirtyParts = ALL_PARTS_DIRTY;
+        GetUserIdLocked(uid, *state);
     }
 }
 
-std::vector<int32_t> UidEntity::GetUids()
+int32_t UidEntity::GetUserIdLocked(int32_t uid, UidState& state)
+{
+    if (!state.hasUserId) {
+        state.userId = AccountSA::OhosAccountKits::GetInstance().GetDeviceAccountIdByUID(uid);
+        state.hasUserId = true;
+    }
+    return state.userId;
+}
+
+void UidEntity::InvalidateUserIds()
 {
     std::lock_guard<std::mutex> lock(uidEntityMutex_);
+    for (auto& state : uidStates_) {
+        state.hasUserId = false;
+    }
+    STATS_HILOGI(COMP_SVC, "User ids of %{public}zu uids are invalidated", uidStates_.size());
+}
+
+std::vector<int32_t> UidEntity::GetUidsLocked()
+{
     std::vector<int32_t> uids;
-    std::transform(uidPowerMap_.begin(), uidPowerMap_.end(), std::back_inserter(uids), [](const auto& item) {
-        return item.first;
-    });
+    for (uint32_t slot = 0; slot < uidStates_.size(); slot++) {
+        if (uidStates_[slot].isApp) {
+            uids.push_back(uidTable_->GetUid(slot));
+        }
+    }
+    std::sort(uids.begin(), uids.end());
     return uids;
 }
 
-double UidEntity::CalculateForConnectivity(int32_t uid)
+std::vector<int32_t> UidEntity::GetUids()
+{
+    std::lock_guard<std::mutex> lock(uidEntityMutex_);
+    return GetUidsLocked();
+}
+
+double UidEntity::CalculateForPart(int32_t uid, UidState& state, const std::shared_ptr<BatteryStatsEntity>& entity)
+{
+    // The power kept in the uid table is reused until the part is marked dirty or has a running timer
+    auto type = entity->GetConsumptionType();
+    if (IsValidPart(type)) {
+        uint32_t partIndex = GetPartIndex(type);
+        uint32_t partBit = 1U << partIndex;
+        if ((state.dirtyParts & partBit) == 0 && state.runningCounts[partIndex] == 0) {
+            return entity->GetEntityPowerMah(uid);
+        }
+        state.dirtyParts &= ~partBit;
+    }
+    entity->Calculate(uid);
+    return entity->GetEntityPowerMah(uid);
+}
+
+double UidEntity::CalculateForConnectivity(int32_t uid, UidState& state)
 {
     double power = StatsUtils::DEFAULT_VALUE;
-    auto bss = BatteryStatsService::GetInstance();
-    auto core = bss->GetBatteryStatsCore();
+    auto core = core_.lock();
+    if (core == nullptr) {
+        return power;
+    }
     auto bluetoothEntity = core->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_BLUETOOTH);
 
     // Calculate bluetooth power consumption
-    bluetoothEntity->Calculate(uid);
-    power += bluetoothEntity->GetEntityPowerMah(uid);
+    power += CalculateForPart(uid, state, bluetoothEntity);
     STATS_HILOGD(COMP_SVC, "Connectivity power consumption: %{public}lfmAh for uid: %{public}d", power, uid);
     return power;
 }
 
-double UidEntity::CalculateForCommon(int32_t uid)
+double UidEntity::CalculateForCommon(int32_t uid, UidState& state)
 {
     double power = StatsUtils::DEFAULT_VALUE;
-    auto bss = BatteryStatsService::GetInstance();
-    auto core = bss->GetBatteryStatsCore();
+    auto core = core_.lock();
+    if (core == nullptr) {
+        return power;
+    }
     auto cameraEntity = core->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_CAMERA);
     auto flashlightEntity = core->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_FLASHLIGHT);
     auto audioEntity = core->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_AUDIO);
@@ -90,29 +192,21 @@ double UidEntity::CalculateForCommon(int32_t uid)
     auto alarmEntity = core->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_ALARM);
 
     // Calculate camera power consumption
-    cameraEntity->Calculate(uid);
-    power += cameraEntity->GetEntityPowerMah(uid);
+    power += CalculateForPart(uid, state, cameraEntity);
     // Calculate flashlight power consumption
-    flashlightEntity->Calculate(uid);
-    power += flashlightEntity->GetEntityPowerMah(uid);
+    power += CalculateForPart(uid, state, flashlightEntity);
     // Calculate audio power consumption
-    audioEntity->Calculate(uid);
-    power += audioEntity->GetEntityPowerMah(uid);
+    power += CalculateForPart(uid, state, audioEntity);
     // Calculate sensor power consumption
-    sensorEntity->Calculate(uid);
-    power += sensorEntity->GetEntityPowerMah(uid);
+    power += CalculateForPart(uid, state, sensorEntity);
     // Calculate gnss power consumption
-    gnssEntity->Calculate(uid);
-    power += gnssEntity->GetEntityPowerMah(uid);
+    power += CalculateForPart(uid, state, gnssEntity);
     // Calculate cpu power consumption
-    cpuEntity->Calculate(uid);
-    power += cpuEntity->GetEntityPowerMah(uid);
-    // Calculate cpu power consumption
-    wakelockEntity->Calculate(uid);
-    power += wakelockEntity->GetEntityPowerMah(uid);
+    power += CalculateForPart(uid, state, cpuEntity);
+    // Calculate wakelock power consumption
+    power += CalculateForPart(uid, state, wakelockEntity);
     // Calculate alarm power consumption
-    alarmEntity->Calculate(uid);
-    power += alarmEntity->GetEntityPowerMah(uid);
+    power += CalculateForPart(uid, state, alarmEntity);
 
     STATS_HILOGD(COMP_SVC, "Common power consumption: %{public}lfmAh for uid: %{public}d", power, uid);
     return power;
@@ -120,21 +214,30 @@ double UidEntity::CalculateForCommon(int32_t uid)
 
 void UidEntity::Calculate(int32_t uid)
 {
-    auto bss = BatteryStatsService::GetInstance();
     std::lock_guard<std::mutex> lock(uidEntityMutex_);
-    auto core = bss->GetBatteryStatsCore();
+    auto core = core_.lock();
+    if (core == nullptr) {
+        return;
+    }
     auto userEntity = core->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_USER);
-    for (auto& iter : uidPowerMap_) {
+    // The user sums are rebuilt from the app totals on every pass instead of adding them up again
+    if (userEntity != nullptr) {
+        userEntity->Reset();
+    }
+    for (uint32_t slot = 0; slot < uidStates_.size(); slot++) {
+        UidState& state = uidStates_[slot];
+        if (!state.isApp) {
+            continue;
+        }
+        int32_t appUid = uidTable_->GetUid(slot);
         double power = StatsUtils::DEFAULT_VALUE;
-        power += CalculateForConnectivity(iter.first);
-        power += CalculateForCommon(iter.first);
-        iter.second = power;
-        totalPowerMah_ += power;
-        AddtoStatsList(iter.first, power);
-        int32_t uid = iter.first;
-        int32_t userId = AccountSA::OhosAccountKits::GetInstance().GetDeviceAccountIdByUID(uid);
+        power += CalculateForConnectivity(appUid, state);
+        power += CalculateForCommon(appUid, state);
+        uidTable_->SetPower(appUid, BatteryStatsUidTable::POWER_APP, power);
+        sums_->totalPowerMah += power;
+        AddtoStatsList(appUid, power);
         if (userEntity != nullptr) {
-            userEntity->AggregateUserPowerMah(userId, power);
+            userEntity->AggregateUserPowerMah(GetUserIdLocked(appUid, state), power);
         }
     }
 }
@@ -145,30 +248,25 @@ void UidEntity::AddtoStatsList(int32_t uid, double power)
     statsInfo->SetConsumptioType(BatteryStatsInfo::CONSUMPTION_TYPE_APP);
     statsInfo->SetUid(uid);
     statsInfo->SetPower(power);
-    statsInfoList_.push_back(statsInfo);
+    sums_->statsInfoList.push_back(statsInfo);
 }
 
 double UidEntity::GetEntityPowerMah(int32_t uidOrUserId)
 {
     std::lock_guard<std::mutex> lock(uidEntityMutex_);
-    double power = StatsUtils::DEFAULT_VALUE;
-    auto iter = uidPowerMap_.find(uidOrUserId);
-    if (iter != uidPowerMap_.end()) {
-        power = iter->second;
-        STATS_HILOGD(COMP_SVC, "Get app uid power consumption: %{public}lfmAh for uid: %{public}d",
-            power, uidOrUserId);
-    } else {
-        STATS_HILOGD(COMP_SVC,
-            "No app uid power consumption related to uid: %{public}d was found, return 0", uidOrUserId);
-    }
+    double power = uidTable_->GetPower(uidOrUserId, BatteryStatsUidTable::POWER_APP);
+    STATS_HILOGD(COMP_SVC, "Get app uid power consumption: %{public}lfmAh for uid: %{public}d",
+        power, uidOrUserId);
     return power;
 }
 
 double UidEntity::GetPowerForConnectivity(StatsUtils::StatsType statsType, int32_t uid)
 {
     double power = StatsUtils::DEFAULT_VALUE;
-    auto bss = BatteryStatsService::GetInstance();
-    auto core = bss->GetBatteryStatsCore();
+    auto core = core_.lock();
+    if (core == nullptr) {
+        return power;
+    }
     auto bluetoothEntity = core->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_BLUETOOTH);
 
     if (statsType == StatsUtils::STATS_TYPE_BLUETOOTH_BR_SCAN) {
@@ -182,8 +280,10 @@ double UidEntity::GetPowerForConnectivity(StatsUtils::StatsType statsType, int32
 double UidEntity::GetPowerForCommon(StatsUtils::StatsType statsType, int32_t uid)
 {
     double power = StatsUtils::DEFAULT_VALUE;
-    auto bss = BatteryStatsService::GetInstance();
-    auto core = bss->GetBatteryStatsCore();
+    auto core = core_.lock();
+    if (core == nullptr) {
+        return power;
+    }
     auto cameraEntity = core->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_CAMERA);
     auto flashlightEntity = core->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_FLASHLIGHT);
     auto audioEntity = core->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_AUDIO);
@@ -255,16 +355,21 @@ void UidEntity::Reset()
 {
     std::lock_guard<std::mutex> lock(uidEntityMutex_);
     // Reset app Uid total power consumption
-    for (auto& iter : uidPowerMap_) {
-        iter.second = StatsUtils::DEFAULT_VALUE;
+    uidTable_->ResetColumn(BatteryStatsUidTable::POWER_APP);
+    // All the timers and counters are reset, so every part needs to be calculated again
+    for (auto& state : uidStates_) {
+        state.dirtyParts = ALL_PARTS_DIRTY;
+        state.runningCounts.fill(0);
     }
 }
 
 void UidEntity::DumpForBluetooth(int32_t uid, std::string& result)
 {
-    auto bss = BatteryStatsService::GetInstance();
     // Dump for bluetooth realted info
-    auto core = bss->GetBatteryStatsCore();
+    auto core = core_.lock();
+    if (core == nullptr) {
+        return;
+    }
     int64_t bluetoothBrScanTime = core->GetTotalTimeMs(uid, StatsUtils::STATS_TYPE_BLUETOOTH_BR_SCAN);
     int64_t bluetoothBleScanTime = core->GetTotalTimeMs(uid, StatsUtils::STATS_TYPE_BLUETOOTH_BLE_SCAN);
 
@@ -278,8 +383,10 @@ void UidEntity::DumpForBluetooth(int32_t uid, std::string& result)
 
 void UidEntity::DumpForCommon(int32_t uid, std::string& result)
 {
-    auto bss = BatteryStatsService::GetInstance();
-    auto core = bss->GetBatteryStatsCore();
+    auto core = core_.lock();
+    if (core == nullptr) {
+        return;
+    }
     // Dump for camera related info
     int64_t cameraTime = core->GetTotalTimeMs(uid, StatsUtils::STATS_TYPE_CAMERA_ON);
 
@@ -332,10 +439,12 @@ void UidEntity::DumpForCommon(int32_t uid, std::string& result)
 
 void UidEntity::DumpInfo(std::string& result, int32_t uid)
 {
-    auto bss = BatteryStatsService::GetInstance();
     std::lock_guard<std::mutex> lock(uidEntityMutex_);
-    auto core = bss->GetBatteryStatsCore();
-    for (auto& iter : uidPowerMap_) {
+    auto core = core_.lock();
+    if (core == nullptr) {
+        return;
+    }
+    for (int32_t appUid : GetUidsLocked()) {
         std::string bundleName = "NULL";
 #ifdef SYS_MGR_CLIENT_ENABLE
         auto bundleObj =
@@ -349,29 +458,33 @@ void UidEntity::DumpInfo(std::string& result, int32_t uid)
                 STATS_HILOGE(COMP_SVC, "Failed to get bundle manager proxy");
             } else {
                 std::string identity = IPCSkeleton::ResetCallingIdentity();
-                ErrCode res = bmgr->GetNameForUid(iter.first, bundleName);
+                ErrCode res = bmgr->GetNameForUid(appUid, bundleName);
                 IPCSkeleton::SetCallingIdentity(identity);
                 if (res != ERR_OK) {
                     STATS_HILOGE(COMP_SVC, "Failed to get bundle name for uid=%{public}d, ErrCode=%{public}d",
-                        iter.first, static_cast<int32_t>(res));
+                        appUid, static_cast<int32_t>(res));
                 }
             }
         }
 #endif
         result.append("\n")
-            .append(ToString(iter.first))
+            .append(ToString(appUid))
             .append("(Bundle name: ")
             .append(bundleName)
             .append(")")
             .append(":")
             .append("\n");
-        DumpForBluetooth(iter.first, result);
-        DumpForCommon(iter.first, result);
+        DumpForBluetooth(appUid, result);
+        DumpForCommon(appUid, result);
         auto cpuEntity = core->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_CPU);
         if (cpuEntity) {
-            cpuEntity->DumpInfo(result, iter.first);
+            cpuEntity->DumpInfo(result, appUid);
+        }
+        auto wakelockEntity = core->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_WAKELOCK);
+        if (wakelockEntity) {
+            wakelockEntity->DumpInfo(result, appUid);
         }
     }
 }
 } // namespace PowerMgr
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
\ No newline at end of file
@@ -15,6 +15,8 @@
 
 #include "entities/user_entity.h"
 
+#include <algorithm>
+
 #include "ohos_account_kits_impl.h"
 #include "stats_log.h"
 
@@ -31,11 +33,17 @@ UserEntity::UserEntity()
     consumptionType_ = BatteryStatsInfo::CONSUMPTION_TYPE_USER;
 }
 
+std::vector<std::pair<int32_t, double>>::iterator UserEntity::FindUser(int32_t userId)
+{
+    return std::lower_bound(userPowers_.begin(), userPowers_.end(), userId,
+        [](const std::pair<int32_t, double>& userPower, int32_t id) { return userPower.first < id; });
+}
+
 double UserEntity::GetEntityPowerMah(int32_t uidOrUserId)
 {
     double power = StatsUtils::DEFAULT_VALUE;
-    auto iter = userPowerMap_.find(uidOrUserId);
-    if (iter != userPowerMap_.end()) {
+    auto iter = FindUser(uidOrUserId);
+    if (iter != userPowers_.end() && iter->first == uidOrUserId) {
         power = iter->second;
         STATS_HILOGD(COMP_SVC, "Get user power consumption: %{public}lfmAh for user id: %{public}d",
             power, uidOrUserId);
@@ -48,33 +56,33 @@ double UserEntity::GetEntityPowerMah(int32_t uidOrUserId)
 
 void UserEntity::AggregateUserPowerMah(int32_t userId, double power)
 {
-    auto iter = userPowerMap_.find(userId);
-    if (iter != userPowerMap_.end()) {
+    auto iter = FindUser(userId);
+    if (iter != userPowers_.end() && iter->first == userId) {
         iter->second += power;
         STATS_HILOGD(COMP_SVC, "Add user power consumption: %{public}lfmAh for user id: %{public}d",
             power, userId);
     } else {
         STATS_HILOGD(COMP_SVC, "Create user power consumption: %{public}lfmAh for user id: %{public}d",
             power, userId);
-        userPowerMap_.insert(std::pair<int32_t, double>(userId, power));
+        userPowers_.emplace(iter, userId, power);
     }
 }
 
 void UserEntity::Calculate(int32_t uid)
 {
-    for (auto& iter : userPowerMap_) {
+    for (auto& iter : userPowers_) {
         std::shared_ptr<BatteryStatsInfo> statsInfo = std::make_shared<BatteryStatsInfo>();
         statsInfo->SetConsumptioType(BatteryStatsInfo::CONSUMPTION_TYPE_USER);
         statsInfo->SetUserId(iter.first);
         statsInfo->SetPower(iter.second);
-        statsInfoList_.push_back(statsInfo);
+        sums_->statsInfoList.push_back(statsInfo);
     }
 }
 
 void UserEntity::Reset()
 {
     // Reset app user total power consumption
-    for (auto& iter : userPowerMap_) {
+    for (auto& iter : userPowers_) {
         iter.second = StatsUtils::DEFAULT_VALUE;
     }
 }
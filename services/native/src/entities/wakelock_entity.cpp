@@ -16,16 +16,24 @@
 #include "entities/wakelock_entity.h"
 
 #include <cinttypes>
+#include <functional>
+#include <queue>
+#include <utility>
+
+#include "string_ex.h"
 
-#include "battery_stats_service.h"
 #include "stats_log.h"
 
 namespace OHOS {
 namespace PowerMgr {
 namespace {
+constexpr uint32_t LOCK_KEY_UID_SHIFT = 32;
+constexpr uint64_t LOCK_KEY_NAME_MASK = 0xFFFFFFFF;
 }
 
-WakelockEntity::WakelockEntity()
+WakelockEntity::WakelockEntity() : WakelockEntity(Config()) {}
+
+WakelockEntity::WakelockEntity(const Config& config) : config_(config), names_(config.maxNames)
 {
     consumptionType_ = BatteryStatsInfo::CONSUMPTION_TYPE_WAKELOCK;
 }
@@ -37,47 +45,26 @@ int64_t WakelockEntity::GetActiveTimeMs(int32_t uid, StatsUtils::StatsType stats
         return activeTimeMs;
     }
 
-    auto iter = wakelockTimerMap_.find(uid);
-    if (iter != wakelockTimerMap_.end()) {
-        activeTimeMs = iter->second->GetRunningTimeMs();
-        STATS_HILOGD(COMP_SVC, "Get wakelock on time: %{public}" PRId64 "ms for uid: %{public}d", activeTimeMs, uid);
-        return activeTimeMs;
-    }
-    STATS_HILOGD(COMP_SVC, "Didn't find related timer for uid: %{public}d, return 0", uid);
+    activeTimeMs = uidTable_->GetRunningTimeMs(uid, BatteryStatsUidTable::TIMER_WAKELOCK_HOLD);
+    STATS_HILOGD(COMP_SVC, "Get wakelock on time: %{public}" PRId64 "ms for uid: %{public}d", activeTimeMs, uid);
     return activeTimeMs;
 }
 
 void WakelockEntity::Calculate(int32_t uid)
 {
-    auto bss = BatteryStatsService::GetInstance();
-    auto wakelockOnAverageMa =
-        bss->GetBatteryStatsParser()->GetAveragePowerMa(StatsUtils::CURRENT_CPU_AWAKE);
+    auto wakelockOnAverageMa = powerProfile_->averageMa[PowerProfile::ITEM_CPU_AWAKE];
     auto wakelockOnTimeMs = GetActiveTimeMs(uid, StatsUtils::STATS_TYPE_WAKELOCK_HOLD);
     auto wakelockOnPowerMah = wakelockOnAverageMa * wakelockOnTimeMs / StatsUtils::MS_IN_HOUR;
-    auto iter = wakelockPowerMap_.find(uid);
-    if (iter != wakelockPowerMap_.end()) {
-        STATS_HILOGD(COMP_SVC, "Update wakelock on power consumption: %{public}lfmAh for uid: %{public}d",
-            wakelockOnPowerMah, uid);
-        iter->second = wakelockOnPowerMah;
-    } else {
-        STATS_HILOGD(COMP_SVC, "Create wakelock on power consumption: %{public}lfmAh for uid: %{public}d",
-            wakelockOnPowerMah, uid);
-        wakelockPowerMap_.insert(std::pair<int32_t, double>(uid, wakelockOnPowerMah));
-    }
+    STATS_HILOGD(COMP_SVC, "Update wakelock on power consumption: %{public}lfmAh for uid: %{public}d",
+        wakelockOnPowerMah, uid);
+    uidTable_->SetPower(uid, BatteryStatsUidTable::POWER_WAKELOCK, wakelockOnPowerMah);
 }
 
 double WakelockEntity::GetEntityPowerMah(int32_t uidOrUserId)
 {
-    double power = StatsUtils::DEFAULT_VALUE;
-    auto iter = wakelockPowerMap_.find(uidOrUserId);
-    if (iter != wakelockPowerMap_.end()) {
-        power = iter->second;
-        STATS_HILOGD(COMP_SVC, "Get app wakelock power consumption: %{public}lfmAh for uid: %{public}d",
-            power, uidOrUserId);
-    } else {
-        STATS_HILOGD(COMP_SVC,
-            "No app wakelock power consumption related to uid: %{public}d was found, return 0", uidOrUserId);
-    }
+    double power = uidTable_->GetPower(uidOrUserId, BatteryStatsUidTable::POWER_WAKELOCK);
+    STATS_HILOGD(COMP_SVC, "Get app wakelock power consumption: %{public}lfmAh for uid: %{public}d",
+        power, uidOrUserId);
     return power;
 }
 
@@ -85,15 +72,9 @@ double WakelockEntity::GetStatsPowerMah(StatsUtils::StatsType statsType, int32_t
 {
     double power = StatsUtils::DEFAULT_VALUE;
     if (statsType == StatsUtils::STATS_TYPE_WAKELOCK_HOLD) {
-        auto wakelockOnIter = wakelockPowerMap_.find(uid);
-        if (wakelockOnIter != wakelockPowerMap_.end()) {
-            power = wakelockOnIter->second;
-            STATS_HILOGD(COMP_SVC, "Get wakelock on power consumption: %{public}lfmAh for uid: %{public}d",
-                power, uid);
-        } else {
-            STATS_HILOGD(COMP_SVC,
-                "No wakelock on power consumption related to uid: %{public}d was found, return 0", uid);
-        }
+        power = uidTable_->GetPower(uid, BatteryStatsUidTable::POWER_WAKELOCK);
+        STATS_HILOGD(COMP_SVC, "Get wakelock on power consumption: %{public}lfmAh for uid: %{public}d",
+            power, uid);
     }
     return power;
 }
@@ -105,31 +86,211 @@ std::shared_ptr<StatsHelper::ActiveTimer> WakelockEntity::GetOrCreateTimer(int32
         return nullptr;
     }
 
-    auto wakelockOnIter = wakelockTimerMap_.find(uid);
-    if (wakelockOnIter != wakelockTimerMap_.end()) {
-        STATS_HILOGD(COMP_SVC, "Get wakelock on timer for uid: %{public}d", uid);
-        return wakelockOnIter->second;
-    }
-    STATS_HILOGD(COMP_SVC, "Create wakelock on timer for uid: %{public}d", uid);
-    std::shared_ptr<StatsHelper::ActiveTimer> holdTimer = std::make_shared<StatsHelper::ActiveTimer>();
-    wakelockTimerMap_.insert(std::pair<int32_t, std::shared_ptr<StatsHelper::ActiveTimer>>(uid, holdTimer));
-    return holdTimer;
+    STATS_HILOGD(COMP_SVC, "Get wakelock on timer for uid: %{public}d", uid);
+    return uidTable_->GetOrCreateTimer(uid, BatteryStatsUidTable::TIMER_WAKELOCK_HOLD);
 }
 
 void WakelockEntity::Reset()
 {
     // Reset app Wakelock on total power consumption
-    for (auto& iter : wakelockPowerMap_) {
-        iter.second = StatsUtils::DEFAULT_VALUE;
-    }
+    uidTable_->ResetColumn(BatteryStatsUidTable::POWER_WAKELOCK);
 
     STATS_HILOGI(COMP_SVC, "Reset Wakelock on timer.");
     // Reset Wakelock on timer
-    for (auto& iter : wakelockTimerMap_) {
-        if (iter.second) {
-            iter.second->Reset();
+    uidTable_->ResetColumn(BatteryStatsUidTable::TIMER_WAKELOCK_HOLD);
+
+    std::lock_guard<std::mutex> lock(lockMutex_);
+    // The locks held are still held after the reset, the names are interned again as the table is cleared. The
+    // overflow timers stay overflow timers, their shown name is not interned
+    struct HeldLock {
+        int32_t uid;
+        uint32_t nameId;
+        std::string name;
+        uint32_t holdCount;
+    };
+    std::vector<HeldLock> heldLocks;
+    for (const auto& [key, stats] : locks_) {
+        if (stats.holdCount > 0) {
+            uint32_t nameId = static_cast<uint32_t>(key & LOCK_KEY_NAME_MASK);
+            heldLocks.push_back({ static_cast<int32_t>(key >> LOCK_KEY_UID_SHIFT), nameId, names_.GetName(nameId),
+                stats.holdCount });
+        }
+    }
+    locks_.clear();
+    names_.Clear();
+    droppedLockCount_ = 0;
+    for (const auto& heldLock : heldLocks) {
+        LockStats* stats = heldLock.nameId == BatteryStatsNameTable::OTHER_ID ?
+            &locks_[GetLockKey(heldLock.uid, BatteryStatsNameTable::OTHER_ID)] :
+            GetOrCreateLockLocked(heldLock.uid, heldLock.name);
+        stats->holdCount += heldLock.holdCount;
+        stats->timer.StartRunning();
+    }
+    for (const auto& [uid, holdCount] : uidHoldCounts_) {
+        auto timer = uidTable_->GetOrCreateTimer(uid, BatteryStatsUidTable::TIMER_WAKELOCK_HOLD);
+        if (timer != nullptr) {
+            timer->StartRunning();
+        }
+    }
+}
+
+uint64_t WakelockEntity::GetLockKey(int32_t uid, uint32_t nameId)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(uid)) << LOCK_KEY_UID_SHIFT) | nameId;
+}
+
+WakelockEntity::LockStats* WakelockEntity::GetOrCreateLockLocked(int32_t uid, std::string_view name)
+{
+    uint32_t nameId = names_.Intern(name);
+    auto iter = locks_.find(GetLockKey(uid, nameId));
+    if (iter != locks_.end()) {
+        return &iter->second;
+    }
+    if (locks_.size() >= config_.maxLocks && nameId != BatteryStatsNameTable::OTHER_ID) {
+        // Every uid may still get its own overflow timer, so the table grows by at most one timer per uid
+        droppedLockCount_++;
+        nameId = BatteryStatsNameTable::OTHER_ID;
+    }
+    return &locks_[GetLockKey(uid, nameId)];
+}
+
+WakelockEntity::LockStats* WakelockEntity::FindLockLocked(int32_t uid, std::string_view name)
+{
+    uint32_t nameId = BatteryStatsNameTable::OTHER_ID;
+    names_.Find(name, nameId);
+    auto iter = locks_.find(GetLockKey(uid, nameId));
+    if (iter == locks_.end() && nameId != BatteryStatsNameTable::OTHER_ID) {
+        // The lock was counted in the overflow timer when it was taken
+        iter = locks_.find(GetLockKey(uid, BatteryStatsNameTable::OTHER_ID));
+    }
+    return iter == locks_.end() ? nullptr : &iter->second;
+}
+
+bool WakelockEntity::UpdateLockState(int32_t uid, std::string_view name, StatsUtils::StatsState state)
+{
+    if (uid <= StatsUtils::INVALID_VALUE) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(lockMutex_);
+    if (state == StatsUtils::STATS_STATE_ACTIVATED) {
+        LockStats* stats = GetOrCreateLockLocked(uid, name);
+        if (stats->holdCount++ == 0) {
+            stats->timer.StartRunning();
+        }
+        return uidHoldCounts_[uid]++ == 0;
+    } else if (state == StatsUtils::STATS_STATE_DEACTIVATED) {
+        LockStats* stats = FindLockLocked(uid, name);
+        if (stats == nullptr || stats->holdCount == 0) {
+            STATS_HILOGD(COMP_SVC, "Lock is not held, uid: %{public}d", uid);
+            return false;
+        }
+        if (--stats->holdCount == 0) {
+            stats->timer.StopRunning();
+        }
+        auto iter = uidHoldCounts_.find(uid);
+        if (iter == uidHoldCounts_.end() || --iter->second > 0) {
+            return false;
+        }
+        uidHoldCounts_.erase(iter);
+        return true;
+    }
+    return false;
+}
+
+std::vector<int32_t> WakelockEntity::GetHoldingUids()
+{
+    std::lock_guard<std::mutex> lock(lockMutex_);
+    std::vector<int32_t> uids;
+    uids.reserve(uidHoldCounts_.size());
+    for (const auto& [uid, holdCount] : uidHoldCounts_) {
+        uids.push_back(uid);
+    }
+    return uids;
+}
+
+int64_t WakelockEntity::GetLockTimeMs(int32_t uid, std::string_view name)
+{
+    std::lock_guard<std::mutex> lock(lockMutex_);
+    uint32_t nameId = BatteryStatsNameTable::OTHER_ID;
+    if (!names_.Find(name, nameId)) {
+        return StatsUtils::DEFAULT_VALUE;
+    }
+    auto iter = locks_.find(GetLockKey(uid, nameId));
+    return iter == locks_.end() ? StatsUtils::DEFAULT_VALUE : iter->second.timer.GetRunningTimeMs();
+}
+
+std::vector<WakelockEntity::LockInfo> WakelockEntity::GetTopLocks(size_t count, int32_t uid)
+{
+    std::vector<LockInfo> topLocks;
+    if (count == 0) {
+        return topLocks;
+    }
+    std::lock_guard<std::mutex> lock(lockMutex_);
+    // A min-heap of the count longest locks seen so far, the shortest of them is dropped first
+    using Entry = std::pair<int64_t, uint64_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+    for (auto& [key, stats] : locks_) {
+        if (uid > StatsUtils::INVALID_VALUE && static_cast<int32_t>(key >> LOCK_KEY_UID_SHIFT) != uid) {
+            continue;
         }
+        int64_t holdTimeMs = stats.timer.GetRunningTimeMs();
+        if (heap.size() < count) {
+            heap.emplace(holdTimeMs, key);
+        } else if (holdTimeMs > heap.top().first) {
+            heap.pop();
+            heap.emplace(holdTimeMs, key);
+        }
+    }
+    topLocks.resize(heap.size());
+    for (size_t i = topLocks.size(); i > 0; i--) {
+        uint64_t key = heap.top().second;
+        LockInfo& info = topLocks[i - 1];
+        info.uid = static_cast<int32_t>(key >> LOCK_KEY_UID_SHIFT);
+        info.name = names_.GetName(static_cast<uint32_t>(key & LOCK_KEY_NAME_MASK));
+        info.holdTimeMs = heap.top().first;
+        info.isHeld = locks_.find(key)->second.holdCount > 0;
+        heap.pop();
+    }
+    return topLocks;
+}
+
+void WakelockEntity::DumpInfo(std::string& result, int32_t uid)
+{
+    std::vector<LockInfo> topLocks = GetTopLocks(config_.dumpTopCount, uid);
+    if (uid > StatsUtils::INVALID_VALUE) {
+        if (topLocks.empty()) {
+            return;
+        }
+        result.append("Top wakelocks:\n");
+    } else {
+        std::lock_guard<std::mutex> lock(lockMutex_);
+        result.append("Wakelock dump:\n")
+            .append("Lock names: ")
+            .append(ToString(names_.GetSize()))
+            .append("/")
+            .append(ToString(names_.GetCapacity()))
+            .append(", names counted as other: ")
+            .append(ToString(names_.GetOverflowCount()))
+            .append(", locks: ")
+            .append(ToString(locks_.size()))
+            .append("/")
+            .append(ToString(config_.maxLocks))
+            .append(", locks counted as other: ")
+            .append(ToString(droppedLockCount_))
+            .append("\n")
+            .append("Top wakelocks:\n");
+    }
+    for (const auto& info : topLocks) {
+        result.append("  ")
+            .append(ToString(info.uid))
+            .append(" ")
+            .append(info.name)
+            .append(": ")
+            .append(ToString(info.holdTimeMs))
+            .append("ms")
+            .append(info.isHeld ? " (held)" : "")
+            .append("\n");
     }
 }
 } // namespace PowerMgr
-} // namespace OHOS
\ No newline at end of file
+} // namespace OHOS
\ No newline at end of file
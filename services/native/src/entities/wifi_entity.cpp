@@ -32,23 +32,29 @@ WifiEntity::WifiEntity()
 
 void WifiEntity::Calculate(int32_t uid)
 {
-    auto bss = BatteryStatsService::GetInstance();
     // Calculate Wifi on power
-    auto wifiOnAverageMa = bss->GetBatteryStatsParser()->GetAveragePowerMa(StatsUtils::CURRENT_WIFI_ON);
+    auto wifiOnAverageMa = powerProfile_->averageMa[PowerProfile::ITEM_WIFI_ON];
     auto wifiOnTimeMs = GetActiveTimeMs(StatsUtils::STATS_TYPE_WIFI_ON);
     auto wifiOnPowerMah = wifiOnAverageMa * wifiOnTimeMs / StatsUtils::MS_IN_HOUR;
 
     // Calculate Wifi scan power
-    auto wifiScanAverageMa = bss->GetBatteryStatsParser()->GetAveragePowerMa(StatsUtils::CURRENT_WIFI_SCAN);
+    auto wifiScanAverageMa = powerProfile_->averageMa[PowerProfile::ITEM_WIFI_SCAN];
     auto wifiScanCount = GetConsumptionCount(StatsUtils::STATS_TYPE_WIFI_SCAN);
     auto wifiScanPowerMah = wifiScanAverageMa * wifiScanCount;
 
-    wifiPowerMah_ = wifiOnPowerMah + wifiScanPowerMah;
-    totalPowerMah_ += wifiPowerMah_;
+    // Calculate Wifi traffic power
+    double wifiTrafficPowerMah = StatsUtils::DEFAULT_VALUE;
+    if (traffic_ != nullptr) {
+        wifiTrafficPowerMah = traffic_->GetPowerMah(TrafficSource::NETWORK_WIFI,
+            powerProfile_->averageMa[PowerProfile::ITEM_WIFI_RX], powerProfile_->averageMa[PowerProfile::ITEM_WIFI_TX]);
+    }
+
+    wifiPowerMah_ = wifiOnPowerMah + wifiScanPowerMah + wifiTrafficPowerMah;
+    sums_->totalPowerMah += wifiPowerMah_;
     std::shared_ptr<BatteryStatsInfo> statsInfo = std::make_shared<BatteryStatsInfo>();
     statsInfo->SetConsumptioType(BatteryStatsInfo::CONSUMPTION_TYPE_WIFI);
     statsInfo->SetPower(wifiPowerMah_);
-    statsInfoList_.push_back(statsInfo);
+    sums_->statsInfoList.push_back(statsInfo);
     STATS_HILOGD(COMP_SVC, "Calculate wifi power consumption: %{public}lfmAh", wifiPowerMah_);
 }
 
@@ -92,6 +98,20 @@ int64_t WifiEntity::GetConsumptionCount(StatsUtils::StatsType statsType, int32_t
     return count;
 }
 
+int64_t WifiEntity::GetTrafficByte(StatsUtils::StatsType statsType, int32_t uid)
+{
+    if (statsType != StatsUtils::STATS_TYPE_WIFI_ON && statsType != StatsUtils::STATS_TYPE_WIFI_SCAN) {
+        return StatsUtils::DEFAULT_VALUE;
+    }
+    if (traffic_ == nullptr) {
+        STATS_HILOGD(COMP_SVC, "Wifi traffic is not counted, return 0");
+        return StatsUtils::DEFAULT_VALUE;
+    }
+    auto bytes = static_cast<int64_t>(traffic_->GetBytes(TrafficSource::NETWORK_WIFI, uid));
+    STATS_HILOGD(COMP_SVC, "Get wifi traffic: %{public}" PRId64 "B for uid: %{public}d", bytes, uid);
+    return bytes;
+}
+
 std::shared_ptr<StatsHelper::ActiveTimer> WifiEntity::GetOrCreateTimer(StatsUtils::StatsType statsType, int16_t level)
 {
     if (statsType != StatsUtils::STATS_TYPE_WIFI_ON) {
@@ -134,6 +154,11 @@ void WifiEntity::Reset()
     if (wifiScanCounter_) {
         wifiScanCounter_->Reset();
     }
+
+    // Reset Wifi traffic
+    if (traffic_) {
+        traffic_->Reset(TrafficSource::NETWORK_WIFI);
+    }
 }
 
 void WifiEntity::DumpInfo(std::string& result, int32_t uid)
@@ -147,7 +172,10 @@ void WifiEntity::DumpInfo(std::string& result, int32_t uid)
         .append("\n")
         .append("Wifi scan count: ")
         .append(ToString(conut))
-        .append("\n");
+        .append("\n")
+        .append("Wifi traffic: ")
+        .append(ToString(GetTrafficByte(StatsUtils::STATS_TYPE_WIFI_ON)))
+        .append("B\n");
 }
 } // namespace PowerMgr
 } // namespace OHOS
@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "proc_file_reader.h"
+
+#include <cerrno>
+#include <charconv>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "stats_log.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+bool IsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+} // namespace
+
+bool ProcFileReader::Read(const std::string& path)
+{
+    size_ = 0;
+    pos_ = 0;
+    int32_t fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        STATS_HILOGD(COMP_SVC, "Open %{public}s failed, errno: %{public}d", path.c_str(), errno);
+        return false;
+    }
+    if (buffer_.empty()) {
+        buffer_.resize(INITIAL_CAPACITY);
+    }
+    bool ret = true;
+    while (true) {
+        if (size_ == buffer_.size()) {
+            buffer_.resize(buffer_.size() * 2); // Proc files report no size, grow until the whole file fits
+        }
+        ssize_t len = pread(fd, buffer_.data() + size_, buffer_.size() - size_, static_cast<off_t>(size_));
+        if (len < 0 && errno == EINTR) {
+            continue;
+        }
+        if (len < 0) {
+            STATS_HILOGW(COMP_SVC, "Read %{public}s failed, errno: %{public}d", path.c_str(), errno);
+            ret = false;
+            break;
+        }
+        if (len == 0) {
+            break;
+        }
+        size_ += static_cast<size_t>(len);
+    }
+    close(fd);
+    return ret;
+}
+
+bool ProcFileReader::NextLine(std::string_view& line)
+{
+    if (pos_ >= size_) {
+        return false;
+    }
+    std::string_view rest(buffer_.data() + pos_, size_ - pos_);
+    size_t end = rest.find('\n');
+    if (end == std::string_view::npos) {
+        line = rest;
+        pos_ = size_;
+    } else {
+        line = rest.substr(0, end);
+        pos_ += end + 1;
+    }
+    return true;
+}
+
+const char* ProcFileReader::GetData() const
+{
+    return buffer_.data();
+}
+
+size_t ProcFileReader::GetSize() const
+{
+    return size_;
+}
+
+size_t ProcFileReader::GetCapacity() const
+{
+    return buffer_.capacity();
+}
+
+bool ProcFileReader::NextToken(std::string_view& input, char delimiter, std::string_view& token)
+{
+    size_t start = input.find_first_not_of(delimiter);
+    if (start == std::string_view::npos) {
+        input = {};
+        return false;
+    }
+    size_t end = input.find(delimiter, start);
+    if (end == std::string_view::npos) {
+        token = input.substr(start);
+        input = {};
+    } else {
+        token = input.substr(start, end - start);
+        input.remove_prefix(end + 1);
+    }
+    return true;
+}
+
+bool ProcFileReader::ParseInt64(std::string_view token, int64_t& value)
+{
+    size_t pos = 0;
+    while (pos < token.size() && IsSpace(token[pos])) {
+        pos++;
+    }
+    // from_chars accepts a minus sign only, strtoll also takes a plus sign
+    if (pos < token.size() && token[pos] == '+') {
+        pos++;
+        if (pos < token.size() && token[pos] == '-') {
+            return false;
+        }
+    }
+    const char* first = token.data() + pos;
+    const char* last = token.data() + token.size();
+    std::from_chars_result result = std::from_chars(first, last, value);
+    if (result.ec == std::errc::invalid_argument) {
+        STATS_HILOGE(COMP_UTILS, "String have no numbers");
+        return false;
+    }
+    if (result.ec == std::errc::result_out_of_range) {
+        STATS_HILOGE(COMP_UTILS, "Transit result out of range");
+        return false;
+    }
+    return true;
+}
+} // namespace PowerMgr
+} // namespace OHOS
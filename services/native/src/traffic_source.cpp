@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "traffic_source.h"
+
+#include "stats_log.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+static const std::string NET_STATS_FILE = "/proc/net/xt_qtaguid/stats";
+constexpr std::string_view UNTAGGED = "0x0";
+constexpr const char* WIFI_IFACE_PREFIXES[] = { "wlan" };
+constexpr const char* CELLULAR_IFACE_PREFIXES[] = { "rmnet", "ccmni", "seth" };
+
+template<size_t N>
+bool HasPrefix(std::string_view iface, const char* const (&prefixes)[N])
+{
+    for (const char* prefix : prefixes) {
+        if (iface.compare(0, std::string_view(prefix).size(), prefix) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool NextInt64(std::string_view& line, int64_t& value)
+{
+    std::string_view token;
+    return ProcFileReader::NextToken(line, ' ', token) && ProcFileReader::ParseInt64(token, value);
+}
+} // namespace
+
+std::unique_ptr<TrafficSource> TrafficSource::Create()
+{
+    return std::make_unique<NetStatsTrafficSource>(NET_STATS_FILE);
+}
+
+bool TrafficSource::GetNetwork(std::string_view iface, Network& network)
+{
+    if (HasPrefix(iface, WIFI_IFACE_PREFIXES)) {
+        network = NETWORK_WIFI;
+        return true;
+    }
+    if (HasPrefix(iface, CELLULAR_IFACE_PREFIXES)) {
+        network = NETWORK_CELLULAR;
+        return true;
+    }
+    return false;
+}
+
+NetStatsTrafficSource::NetStatsTrafficSource(const std::string& path) : path_(path) {}
+
+const char* NetStatsTrafficSource::GetName() const
+{
+    return "netstats";
+}
+
+bool NetStatsTrafficSource::Read(const Visitor& visitor)
+{
+    if (!fileReader_.Read(path_)) {
+        return false;
+    }
+    std::string_view line;
+    while (fileReader_.NextLine(line)) {
+        // The header line has no numeric index
+        std::string_view iface;
+        std::string_view tag;
+        int64_t index = 0;
+        if (!NextInt64(line, index) || !ProcFileReader::NextToken(line, ' ', iface) ||
+            !ProcFileReader::NextToken(line, ' ', tag) || tag != UNTAGGED) {
+            continue;
+        }
+        Network network = NETWORK_BUTT;
+        if (!GetNetwork(iface, network)) {
+            continue;
+        }
+        int64_t uid = 0;
+        int64_t counterSet = 0;
+        int64_t rxBytes = 0;
+        int64_t rxPackets = 0;
+        int64_t txBytes = 0;
+        if (!NextInt64(line, uid) || !NextInt64(line, counterSet) || !NextInt64(line, rxBytes) ||
+            !NextInt64(line, rxPackets) || !NextInt64(line, txBytes) || uid < 0 || rxBytes < 0 || txBytes < 0) {
+            STATS_HILOGD(COMP_SVC, "Skip malformed netstats line of index: %{public}d", static_cast<int32_t>(index));
+            continue;
+        }
+        if (!visitor(static_cast<int32_t>(uid), network, static_cast<uint64_t>(rxBytes),
+            static_cast<uint64_t>(txBytes))) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_benchmark_memory.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <sys/resource.h>
+
+namespace {
+std::atomic<size_t> g_allocCount {0};
+std::atomic<size_t> g_allocatedBytes {0};
+}
+
+void* operator new(size_t size)
+{
+    g_allocCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+    void* ptr = std::malloc(size);
+    if (ptr == nullptr) {
+        throw std::bad_alloc();
+    }
+    return ptr;
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    std::free(ptr);
+}
+
+namespace OHOS {
+namespace PowerMgr {
+MemoryCounter::MemoryCounter() : allocCount_(g_allocCount.load()), allocatedBytes_(g_allocatedBytes.load()) {}
+
+size_t MemoryCounter::GetAllocCount() const
+{
+    return g_allocCount.load() - allocCount_;
+}
+
+size_t MemoryCounter::GetAllocatedBytes() const
+{
+    return g_allocatedBytes.load() - allocatedBytes_;
+}
+
+void MemoryCounter::Report(benchmark::State& state) const
+{
+    state.counters["allocs_per_op"] = benchmark::Counter(
+        static_cast<double>(GetAllocCount()), benchmark::Counter::kAvgIterations);
+    state.counters["bytes_per_op"] = benchmark::Counter(
+        static_cast<double>(GetAllocatedBytes()), benchmark::Counter::kAvgIterations);
+    struct rusage usage {};
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        // ru_maxrss is in KB on linux
+        state.counters["peak_rss_kb"] = static_cast<double>(usage.ru_maxrss);
+    }
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STATS_BENCHMARK_MEMORY_H
+#define STATS_BENCHMARK_MEMORY_H
+
+#include <cstddef>
+
+#include <benchmark/benchmark.h>
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Counts the allocations of the process from its construction on, every operator new of the benchmark binary
+ * goes through the counters of stats_benchmark_memory.cpp.
+ */
+class MemoryCounter {
+public:
+    MemoryCounter();
+    size_t GetAllocCount() const;
+    size_t GetAllocatedBytes() const;
+    /* Sets allocs_per_op and bytes_per_op of the allocations so far, and peak_rss_kb of the process */
+    void Report(benchmark::State& state) const;
+private:
+    size_t allocCount_;
+    size_t allocatedBytes_;
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // STATS_BENCHMARK_MEMORY_H
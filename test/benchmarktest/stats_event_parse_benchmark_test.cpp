@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <cJSON.h>
+
+#include "stats_cjson_utils.h"
+#include "stats_json_view.h"
+
+using namespace OHOS::PowerMgr;
+
+namespace {
+/**
+ * HiSysEvent records captured with "hisysevent -l" on a phone, one per event type the listener handles
+ * most often. A larger trace can be replayed by pointing STATS_EVENT_TRACE_FILE to a file holding one
+ * record per line.
+ */
+const std::vector<std::string> RECORDED_EVENTS = {
+    R"({"domain_":"POWER","name_":"RUNNINGLOCK","type_":4,"time_":1718170524329,"tz_":"+0800","pid_":1139,)"
+    R"("tid_":1327,"uid_":5528,"PID":3712,"UID":20020048,"STATE":1,"TYPE":1,"NAME":"NotificationSub",)"
+    R"("LOG_LEVEL":2,"TAG":"DUBAI_TAG_RUNNINGLOCK_ADD","MESSAGE":"token=1027","level_":"MINOR",)"
+    R"("id_":"10419832562212311851","info_":"","seq_":5870})",
+    R"({"domain_":"POWER","name_":"RUNNINGLOCK","type_":4,"time_":1718170524411,"tz_":"+0800","pid_":1139,)"
+    R"("tid_":1327,"uid_":5528,"PID":3712,"UID":20020048,"STATE":0,"TYPE":1,"NAME":"NotificationSub",)"
+    R"("LOG_LEVEL":2,"TAG":"DUBAI_TAG_RUNNINGLOCK_REMOVE","MESSAGE":"token=1027","level_":"MINOR",)"
+    R"("id_":"17032748412354877122","info_":"","seq_":5871})",
+    R"({"domain_":"AUDIO","name_":"STREAM_CHANGE","type_":2,"time_":1718170525102,"tz_":"+0800","pid_":1012,)"
+    R"("tid_":1480,"uid_":1041,"ISOUTPUT":1,"STREAMID":100012,"UID":20010036,"PID":4120,"TRANSACTIONID":0,)"
+    R"("PIPE_TYPE":1,"STREAM_TYPE":1,"STATE":2,"DEVICETYPE":2,"NETWORKID":"LocalDevice",)"
+    R"("level_":"MINOR","id_":"2211485960327411832","info_":"","seq_":5874})",
+    R"({"domain_":"BT_SERVICE","name_":"BLE_SCAN_START","type_":4,"time_":1718170525811,"tz_":"+0800",)"
+    R"("pid_":1561,"tid_":1632,"uid_":1002,"PID":2904,"UID":20010021,"TYPE":0,)"
+    R"("level_":"MINOR","id_":"8203310958746512045","info_":"","seq_":5880})",
+    R"({"domain_":"BT_SERVICE","name_":"BLE_SCAN_STOP","type_":4,"time_":1718170527811,"tz_":"+0800",)"
+    R"("pid_":1561,"tid_":1632,"uid_":1002,"PID":2904,"UID":20010021,"TYPE":0,)"
+    R"("level_":"MINOR","id_":"6640293827165509213","info_":"","seq_":5881})",
+    R"({"domain_":"DISPLAY","name_":"BRIGHTNESS_NIT","type_":4,"time_":1718170528123,"tz_":"+0800",)"
+    R"("pid_":1203,"tid_":1301,"uid_":5526,"BRIGHTNESS":143,"REASON":"APP","NIT":355,)"
+    R"("level_":"MINOR","id_":"4477320561958238791","info_":"","seq_":5883})",
+    R"({"domain_":"BATTERY","name_":"BATTERY_CHANGED","type_":4,"time_":1718170529001,"tz_":"+0800",)"
+    R"("pid_":1087,"tid_":1092,"uid_":5527,"LEVEL":87,"CHARGER":0,"VOLTAGE":4197000,"HEALTH":1,)"
+    R"("TEMPERATURE":312,"CURRENT":-312,"CHARGE_COUNTER":4180000,"level_":"MINOR",)"
+    R"("id_":"12918263541012785531","info_":"","seq_":5885})",
+    R"({"domain_":"LOCATION","name_":"GNSS_STATE","type_":4,"time_":1718170529877,"tz_":"+0800",)"
+    R"("pid_":1710,"tid_":1734,"uid_":1021,"STATE":"start","PID":5001,"UID":20010040,)"
+    R"("level_":"MINOR","id_":"9010318827462281734","info_":"","seq_":5887})",
+};
+
+struct ExtractedFields {
+    int32_t uid = -1;
+    int32_t pid = -1;
+    int32_t state = -1;
+    int32_t type = -1;
+    int32_t level = -1;
+    size_t nameLength = 0;
+    size_t tagLength = 0;
+};
+
+std::vector<std::string> LoadTrace()
+{
+    const char* path = std::getenv("STATS_EVENT_TRACE_FILE");
+    if (path == nullptr) {
+        return RECORDED_EVENTS;
+    }
+    std::vector<std::string> trace;
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.empty()) {
+            trace.push_back(line);
+        }
+    }
+    return trace.empty() ? RECORDED_EVENTS : trace;
+}
+
+const std::vector<std::string>& GetTrace()
+{
+    static const std::vector<std::string> trace = LoadTrace();
+    return trace;
+}
+
+int32_t GetCJsonInt(const cJSON* root, const char* key)
+{
+    cJSON* item = cJSON_GetObjectItemCaseSensitive(root, key);
+    return StatsJsonUtils::IsValidJsonNumber(item) ? item->valueint : -1;
+}
+
+size_t GetCJsonStringLength(const cJSON* root, const char* key)
+{
+    cJSON* item = cJSON_GetObjectItemCaseSensitive(root, key);
+    return StatsJsonUtils::IsValidJsonStringAndNoEmpty(item) ? strlen(item->valuestring) : 0;
+}
+
+size_t GetViewStringLength(const StatsJsonView& root, std::string_view key)
+{
+    std::string_view value;
+    return root.GetString(key, value) ? value.size() : 0;
+}
+
+/* Mirrors the listener before the change: copy of AsJson(), full cJSON tree, lookups, free */
+bool ExtractWithCJson(const std::string& record, ExtractedFields& fields)
+{
+    std::string eventDetail = record;
+    cJSON* root = cJSON_Parse(eventDetail.c_str());
+    if (root == nullptr || !cJSON_IsObject(root)) {
+        cJSON_Delete(root);
+        return false;
+    }
+    fields.uid = GetCJsonInt(root, "UID");
+    fields.pid = GetCJsonInt(root, "PID");
+    fields.state = GetCJsonInt(root, "STATE");
+    fields.type = GetCJsonInt(root, "TYPE");
+    fields.level = GetCJsonInt(root, "LEVEL");
+    fields.nameLength = GetCJsonStringLength(root, "NAME");
+    fields.tagLength = GetCJsonStringLength(root, "TAG");
+    cJSON_Delete(root);
+    return true;
+}
+
+/* Mirrors the listener after the change: copy of AsJson(), in-place field index, lookups */
+bool ExtractWithView(const std::string& record, ExtractedFields& fields)
+{
+    std::string eventDetail = record;
+    StatsJsonView root(eventDetail);
+    if (!root.IsValid()) {
+        return false;
+    }
+    root.GetInt("UID", fields.uid);
+    root.GetInt("PID", fields.pid);
+    root.GetInt("STATE", fields.state);
+    root.GetInt("TYPE", fields.type);
+    root.GetInt("LEVEL", fields.level);
+    fields.nameLength = GetViewStringLength(root, "NAME");
+    fields.tagLength = GetViewStringLength(root, "TAG");
+    return true;
+}
+
+template<bool (*Extract)(const std::string&, ExtractedFields&)>
+void BenchmarkExtract(benchmark::State& state)
+{
+    const auto& trace = GetTrace();
+    size_t bytes = 0;
+    for (const auto& record : trace) {
+        bytes += record.size();
+    }
+    for (auto _ : state) {
+        for (const auto& record : trace) {
+            ExtractedFields fields;
+            bool ret = Extract(record, fields);
+            benchmark::DoNotOptimize(ret);
+            benchmark::DoNotOptimize(fields);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * trace.size()));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+}
+
+void StatsEventParseCJson(benchmark::State& state)
+{
+    BenchmarkExtract<ExtractWithCJson>(state);
+}
+
+void StatsEventParseJsonView(benchmark::State& state)
+{
+    BenchmarkExtract<ExtractWithView>(state);
+}
+
+BENCHMARK(StatsEventParseCJson);
+BENCHMARK(StatsEventParseJsonView);
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <dirent.h>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "hisysevent_record.h"
+#include "ohos_account_kits_impl.h"
+
+#include "battery_stats_codec.h"
+#include "battery_stats_core.h"
+#include "battery_stats_listener.h"
+#include "battery_stats_parser.h"
+#include "battery_stats_replayer.h"
+#include "battery_stats_service.h"
+#include "cpu_time_reader.h"
+#include "cpu_time_source.h"
+#include "stats_benchmark_memory.h"
+#include "stats_helper.h"
+
+using namespace OHOS;
+using namespace OHOS::PowerMgr;
+
+/**
+ * Benchmarks of the service hot paths. Every benchmark reports the time per iteration and three counters:
+ * allocs_per_op and bytes_per_op, counted by MemoryCounter, and peak_rss_kb of the process so far.
+ * Run with --benchmark_format=json or --benchmark_out=<file> to keep the numbers run to run. The stats of the
+ * benchmarks are kept in a directory of their own, the stats of the device are neither read nor written.
+ */
+namespace {
+constexpr int32_t FIRST_APP_UID = 20010000;
+constexpr const char* CPU_TIME_FIXTURE = "/data/local/tmp/battery_stats_benchmark_cpu_time";
+constexpr const char* STATS_DIR_TEMPLATE = "/data/local/tmp/battery_stats_benchmark_XXXXXX";
+constexpr int64_t TRACE_SPAN_MS = 24 * 60 * 60 * 1000;
+
+/**
+ * HiSysEvent records captured with "hisysevent -l" on a phone, the pairs leave nothing running once replayed.
+ */
+const std::vector<std::string> RECORDED_EVENTS = {
+    R"({"domain_":"POWER","name_":"RUNNINGLOCK","type_":4,"time_":1718170524329,"tz_":"+0800","pid_":1139,)"
+    R"("tid_":1327,"uid_":5528,"PID":3712,"UID":20020048,"STATE":1,"TYPE":1,"NAME":"NotificationSub",)"
+    R"("LOG_LEVEL":2,"TAG":"DUBAI_TAG_RUNNINGLOCK_ADD","MESSAGE":"token=1027","level_":"MINOR",)"
+    R"("id_":"10419832562212311851","info_":"","seq_":5870})",
+    R"({"domain_":"POWER","name_":"RUNNINGLOCK","type_":4,"time_":1718170524411,"tz_":"+0800","pid_":1139,)"
+    R"("tid_":1327,"uid_":5528,"PID":3712,"UID":20020048,"STATE":0,"TYPE":1,"NAME":"NotificationSub",)"
+    R"("LOG_LEVEL":2,"TAG":"DUBAI_TAG_RUNNINGLOCK_REMOVE","MESSAGE":"token=1027","level_":"MINOR",)"
+    R"("id_":"17032748412354877122","info_":"","seq_":5871})",
+    R"({"domain_":"BT_SERVICE","name_":"BLE_SCAN_START","type_":4,"time_":1718170525811,"tz_":"+0800",)"
+    R"("pid_":1561,"tid_":1632,"uid_":1002,"PID":2904,"UID":20010021,"TYPE":0,)"
+    R"("level_":"MINOR","id_":"8203310958746512045","info_":"","seq_":5880})",
+    R"({"domain_":"BT_SERVICE","name_":"BLE_SCAN_STOP","type_":4,"time_":1718170527811,"tz_":"+0800",)"
+    R"("pid_":1561,"tid_":1632,"uid_":1002,"PID":2904,"UID":20010021,"TYPE":0,)"
+    R"("level_":"MINOR","id_":"6640293827165509213","info_":"","seq_":5881})",
+    R"({"domain_":"DISPLAY","name_":"BRIGHTNESS_NIT","type_":4,"time_":1718170528123,"tz_":"+0800",)"
+    R"("pid_":1203,"tid_":1301,"uid_":5526,"BRIGHTNESS":143,"REASON":"APP","NIT":355,)"
+    R"("level_":"MINOR","id_":"4477320561958238791","info_":"","seq_":5883})",
+    R"({"domain_":"LOCATION","name_":"GNSS_STATE","type_":4,"time_":1718170529877,"tz_":"+0800",)"
+    R"("pid_":1710,"tid_":1734,"uid_":1021,"STATE":"start","PID":5001,"UID":20010040,)"
+    R"("level_":"MINOR","id_":"9010318827462281734","info_":"","seq_":5887})",
+    R"({"domain_":"LOCATION","name_":"GNSS_STATE","type_":4,"time_":1718170531877,"tz_":"+0800",)"
+    R"("pid_":1710,"tid_":1734,"uid_":1021,"STATE":"stop","PID":5001,"UID":20010040,)"
+    R"("level_":"MINOR","id_":"9010318827462281735","info_":"","seq_":5888})",
+};
+
+struct SyntheticEvent {
+    StatsUtils::StatsType type;
+    StatsUtils::StatsState state;
+    int16_t level;
+    int32_t uid;
+};
+
+std::string g_statsDir;
+
+/* A core of its own on the benchmark stats directory, with the power profile of the device */
+std::shared_ptr<BatteryStatsCore> NewCore()
+{
+    auto core = std::make_shared<BatteryStatsCore>(nullptr, g_statsDir);
+    core->Init(BatteryStatsService::GetInstance()->GetBatteryStatsParser()->GetPowerProfile());
+    return core;
+}
+
+bool CreateStatsDir()
+{
+    std::string dir = STATS_DIR_TEMPLATE;
+    if (mkdtemp(&dir[0]) == nullptr) {
+        return false;
+    }
+    g_statsDir = dir;
+    return true;
+}
+
+void RemoveStatsDir()
+{
+    DIR* dir = opendir(g_statsDir.c_str());
+    if (dir == nullptr) {
+        return;
+    }
+    while (struct dirent* entry = readdir(dir)) {
+        std::string name = entry->d_name;
+        if (name != "." && name != "..") {
+            unlink((g_statsDir + "/" + name).c_str());
+        }
+    }
+    closedir(dir);
+    rmdir(g_statsDir.c_str());
+}
+
+/* Every app turns a wakelock, audio, gnss and a ble scan on and off, with a brightness change in between */
+std::vector<SyntheticEvent> MakeEventMix(int32_t uidCount)
+{
+    const StatsUtils::StatsType appTypes[] = {
+        StatsUtils::STATS_TYPE_WAKELOCK_HOLD,
+        StatsUtils::STATS_TYPE_AUDIO_ON,
+        StatsUtils::STATS_TYPE_GNSS_ON,
+        StatsUtils::STATS_TYPE_BLUETOOTH_BLE_SCAN,
+    };
+    std::vector<SyntheticEvent> events;
+    for (int32_t i = 0; i < uidCount; i++) {
+        int32_t uid = FIRST_APP_UID + i;
+        for (auto type : appTypes) {
+            events.push_back({ type, StatsUtils::STATS_STATE_ACTIVATED, StatsUtils::INVALID_VALUE, uid });
+        }
+        events.push_back({ StatsUtils::STATS_TYPE_SCREEN_BRIGHTNESS, StatsUtils::STATS_STATE_ACTIVATED,
+            static_cast<int16_t>(i % 255), StatsUtils::INVALID_VALUE });
+        for (auto type : appTypes) {
+            events.push_back({ type, StatsUtils::STATS_STATE_DEACTIVATED, StatsUtils::INVALID_VALUE, uid });
+        }
+    }
+    return events;
+}
+
+/* Applies the event the way the detector does */
+void ApplyEvent(BatteryStatsCore& core, const SyntheticEvent& event)
+{
+    if (event.type == StatsUtils::STATS_TYPE_WAKELOCK_HOLD) {
+        core.UpdateWakelockStats(event.state, event.uid, "BenchmarkLock");
+    } else {
+        core.UpdateStats(event.type, event.state, event.level, event.uid);
+    }
+}
+
+void PopulateApps(BatteryStatsCore& core, int32_t uidCount)
+{
+    for (const auto& event : MakeEventMix(uidCount)) {
+        ApplyEvent(core, event);
+    }
+}
+
+void StatsCoreUpdateStats(benchmark::State& state)
+{
+    auto core = NewCore();
+    auto events = MakeEventMix(static_cast<int32_t>(state.range(0)));
+    size_t index = 0;
+    MemoryCounter counter;
+    for (auto _ : state) {
+        ApplyEvent(*core, events[index]);
+        index = (index + 1) % events.size();
+    }
+    counter.Report(state);
+    state.SetItemsProcessed(state.iterations());
+}
+
+void StatsCoreComputePower(benchmark::State& state)
+{
+    auto core = NewCore();
+    PopulateApps(*core, static_cast<int32_t>(state.range(0)));
+    MemoryCounter counter;
+    for (auto _ : state) {
+        core->ComputePower();
+    }
+    counter.Report(state);
+}
+
+/* The user id lookup every app took on every compute before the uid entity kept it */
+void StatsUserIdByAccountKits(benchmark::State& state)
+{
+    int32_t uidCount = static_cast<int32_t>(state.range(0));
+    MemoryCounter counter;
+    for (auto _ : state) {
+        for (int32_t i = 0; i < uidCount; i++) {
+            int32_t uid = FIRST_APP_UID + i;
+            benchmark::DoNotOptimize(AccountSA::OhosAccountKits::GetInstance().GetDeviceAccountIdByUID(uid));
+        }
+    }
+    counter.Report(state);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * uidCount);
+}
+
+/* A compute right after a user is added or removed, compare with StatsCoreComputePower */
+void StatsCoreComputePowerUserIdsInvalidated(benchmark::State& state)
+{
+    auto core = NewCore();
+    PopulateApps(*core, static_cast<int32_t>(state.range(0)));
+    MemoryCounter counter;
+    for (auto _ : state) {
+        core->InvalidateUserIds();
+        core->ComputePower();
+    }
+    counter.Report(state);
+}
+
+void PutCpuTimeDump(std::string& buffer, uint16_t clusterCount, uint16_t freqCount, int32_t uidCount)
+{
+    BatteryStatsCodec::PutFixed32(buffer, BinaryCpuTimeSource::MAGIC);
+    BatteryStatsCodec::PutFixed16(buffer, BinaryCpuTimeSource::VERSION);
+    BatteryStatsCodec::PutFixed16(buffer, clusterCount);
+    BatteryStatsCodec::PutFixed16(buffer, freqCount);
+    BatteryStatsCodec::PutFixed16(buffer, 0);
+    BatteryStatsCodec::PutFixed32(buffer, static_cast<uint32_t>(uidCount));
+    for (int32_t i = 0; i < uidCount; i++) {
+        uint64_t timeMs = static_cast<uint64_t>(i + 1) * 10; // 10: a distinct time per uid
+        BatteryStatsCodec::PutFixed32(buffer, static_cast<uint32_t>(FIRST_APP_UID + i));
+        BatteryStatsCodec::PutFixed32(buffer, 0);
+        // Active, cluster and speed times, then user and system time
+        for (size_t field = 0; field < 3u + clusterCount + freqCount; field++) {
+            BatteryStatsCodec::PutFixed64(buffer, timeMs);
+        }
+    }
+}
+
+/* Every refresh parses the same generated dump, the deltas after the first one are zero */
+void StatsCpuTimeReaderUpdate(benchmark::State& state)
+{
+    auto parser = BatteryStatsService::GetInstance()->GetBatteryStatsParser();
+    uint16_t clusterCount = parser->GetClusterNum();
+    uint16_t freqCount = 0;
+    for (uint16_t i = 0; i < clusterCount; i++) {
+        freqCount += parser->GetSpeedNum(i);
+    }
+    std::string dump;
+    PutCpuTimeDump(dump, clusterCount, freqCount, static_cast<int32_t>(state.range(0)));
+    {
+        std::ofstream output(CPU_TIME_FIXTURE, std::ios::trunc | std::ios::binary);
+        output << dump;
+    }
+    bool isOnBattery = StatsHelper::IsOnBattery();
+    StatsHelper::SetOnBattery(true);
+    CpuTimeReader reader(std::make_unique<BinaryCpuTimeSource>(CPU_TIME_FIXTURE));
+    if (!reader.UpdateCpuTime()) {
+        state.SkipWithError("Read cpu time fixture failed");
+    }
+    MemoryCounter counter;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reader.UpdateCpuTime());
+    }
+    counter.Report(state);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    StatsHelper::SetOnBattery(isOnBattery);
+    unlink(CPU_TIME_FIXTURE);
+}
+
+void StatsCoreSaveLoad(benchmark::State& state)
+{
+    auto core = NewCore();
+    PopulateApps(*core, static_cast<int32_t>(state.range(0)));
+    MemoryCounter counter;
+    for (auto _ : state) {
+        if (!core->SaveBatteryStatsData() || !core->LoadBatteryStatsData()) {
+            state.SkipWithError("Save or load battery stats failed");
+            break;
+        }
+    }
+    counter.Report(state);
+}
+
+/* Includes the hand off to the event queue, the consumer thread applies the events meanwhile */
+void StatsListenerOnEvent(benchmark::State& state)
+{
+    std::vector<std::shared_ptr<HiviewDFX::HiSysEventRecord>> records;
+    for (const auto& event : RECORDED_EVENTS) {
+        records.push_back(std::make_shared<HiviewDFX::HiSysEventRecord>(event));
+    }
+    auto listener = std::make_shared<BatteryStatsListener>();
+    size_t index = 0;
+    MemoryCounter counter;
+    for (auto _ : state) {
+        listener->OnEvent(records[index]);
+        index = (index + 1) % records.size();
+    }
+    counter.Report(state);
+    state.SetItemsProcessed(state.iterations());
+}
+
+/* Reads running timers the way a compute does, each on its own clock read or all on one shared snapshot */
+void StatsActiveTimerRead(benchmark::State& state)
+{
+    std::vector<StatsHelper::ActiveTimer> timers(static_cast<size_t>(state.range(0)));
+    for (auto& timer : timers) {
+        timer.StartRunning();
+    }
+    bool isSnapshot = state.range(1) != 0;
+    MemoryCounter counter;
+    for (auto _ : state) {
+        std::optional<StatsHelper::TimeSnapshot> timeSnapshot;
+        if (isSnapshot) {
+            timeSnapshot.emplace();
+        }
+        for (auto& timer : timers) {
+            benchmark::DoNotOptimize(timer.GetRunningTimeMs());
+        }
+    }
+    counter.Report(state);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+}
+
+/* The event mix spread over a day on battery, as BatteryStatsTrace::Read gives it */
+std::vector<BatteryStatsTrace::Record> MakeDayTrace(int32_t uidCount)
+{
+    auto events = MakeEventMix(uidCount);
+    std::vector<BatteryStatsTrace::Record> records;
+    BatteryStatsTrace::Record record;
+    record.type = BatteryStatsTrace::RECORD_POWER_SUPPLY;
+    record.isOnBattery = true;
+    records.push_back(record);
+    int64_t stepMs = TRACE_SPAN_MS / static_cast<int64_t>(events.size());
+    for (const auto& event : events) {
+        record.type = BatteryStatsTrace::RECORD_EVENT;
+        record.bootTimeMs += stepMs;
+        record.upTimeMs += stepMs;
+        record.data = StatsUtils::StatsData();
+        record.data.type = event.type;
+        record.data.state = event.state;
+        record.data.level = event.level;
+        record.data.uid = event.uid;
+        record.data.eventDataName = "BenchmarkLock";
+        records.push_back(record);
+    }
+    return records;
+}
+
+/* A whole day of events through the detector dispatch into a new core on the replay clock */
+void StatsReplayDayTrace(benchmark::State& state)
+{
+    auto records = MakeDayTrace(static_cast<int32_t>(state.range(0)));
+    BatteryStatsReplayer replayer(BatteryStatsService::GetInstance()->GetBatteryStatsParser()->GetPowerProfile());
+    BatteryStatsReplayer::Result result;
+    MemoryCounter counter;
+    for (auto _ : state) {
+        if (!replayer.Replay(records, result)) {
+            state.SkipWithError("Replay trace failed");
+            break;
+        }
+    }
+    counter.Report(state);
+    state.counters["trace_span_s"] = static_cast<double>(result.traceSpanMs) / StatsUtils::MS_IN_SECOND;
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * static_cast<int64_t>(result.eventCount));
+}
+
+BENCHMARK(StatsCoreUpdateStats)->Arg(16)->Arg(256);
+BENCHMARK(StatsCoreComputePower)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(StatsUserIdByAccountKits)->Arg(100)->Arg(1000);
+BENCHMARK(StatsCoreComputePowerUserIdsInvalidated)->Arg(100)->Arg(1000);
+BENCHMARK(StatsCpuTimeReaderUpdate)->Arg(100)->Arg(1000);
+BENCHMARK(StatsCoreSaveLoad)->Arg(10)->Arg(100)->Arg(1000);
+BENCHMARK(StatsListenerOnEvent);
+BENCHMARK(StatsReplayDayTrace)->Arg(100)->Arg(1000);
+BENCHMARK(StatsActiveTimerRead)->Args({ 1000, 0 })->Args({ 1000, 1 });
+} // namespace
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    if (!CreateStatsDir()) {
+        return 1;
+    }
+    // The listener benchmark goes through the service, its core is on the benchmark stats directory as well
+    auto statsService = BatteryStatsService::GetInstance();
+    statsService->SetStatsDir(g_statsDir);
+    statsService->OnStart();
+    benchmark::RunSpecifiedBenchmarks();
+    statsService->OnStop();
+    RemoveStatsDir();
+    return 0;
+}
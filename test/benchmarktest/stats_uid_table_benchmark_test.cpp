@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "battery_stats_uid_table.h"
+#include "stats_benchmark_memory.h"
+#include "stats_helper.h"
+
+using namespace OHOS::PowerMgr;
+
+namespace {
+constexpr int32_t FIRST_APP_UID = 20010000;
+constexpr double AVERAGE_POWER_MA = 36.0;
+constexpr double MS_IN_HOUR = 3600000.0;
+// An app holds a wakelock and uses one or two more parts, never all of them
+constexpr uint8_t TIMERS_PER_UID = 2;
+constexpr BatteryStatsUidTable::PowerColumn TIMER_POWER_COLUMNS[BatteryStatsUidTable::TIMER_COLUMN_END] = {
+    BatteryStatsUidTable::POWER_AUDIO,
+    BatteryStatsUidTable::POWER_BLUETOOTH_BR_SCAN,
+    BatteryStatsUidTable::POWER_BLUETOOTH_BLE_SCAN,
+    BatteryStatsUidTable::POWER_FLASHLIGHT,
+    BatteryStatsUidTable::POWER_GNSS,
+    BatteryStatsUidTable::POWER_SENSOR_GRAVITY,
+    BatteryStatsUidTable::POWER_SENSOR_PROXIMITY,
+    BatteryStatsUidTable::POWER_WAKELOCK,
+};
+
+size_t GetTimerColumn(int32_t uid, uint8_t index)
+{
+    return (static_cast<size_t>(uid) + index) % BatteryStatsUidTable::TIMER_COLUMN_END;
+}
+
+/* Mirrors the entities before the change: one map of timers and one map of power per stats type */
+class MapLayout {
+public:
+    void Add(int32_t uid)
+    {
+        for (uint8_t i = 0; i < TIMERS_PER_UID; i++) {
+            size_t column = GetTimerColumn(uid, i);
+            timerMaps_[column].emplace(uid, std::make_shared<StatsHelper::ActiveTimer>());
+            powerMaps_[column].emplace(uid, 0.0);
+        }
+        appPowerMap_.emplace(uid, 0.0);
+    }
+
+    double Calculate()
+    {
+        double total = 0.0;
+        for (auto& iter : appPowerMap_) {
+            double power = 0.0;
+            for (size_t column = 0; column < timerMaps_.size(); column++) {
+                auto timerIter = timerMaps_[column].find(iter.first);
+                if (timerIter == timerMaps_[column].end()) {
+                    continue;
+                }
+                double partPower = AVERAGE_POWER_MA * timerIter->second->GetRunningTimeMs() / MS_IN_HOUR;
+                powerMaps_[column][iter.first] = partPower;
+                power += partPower;
+            }
+            iter.second = power;
+            total += power;
+        }
+        return total;
+    }
+private:
+    std::vector<std::map<int32_t, std::shared_ptr<StatsHelper::ActiveTimer>>> timerMaps_ =
+        std::vector<std::map<int32_t, std::shared_ptr<StatsHelper::ActiveTimer>>>(
+            BatteryStatsUidTable::TIMER_COLUMN_END);
+    std::vector<std::map<int32_t, double>> powerMaps_ =
+        std::vector<std::map<int32_t, double>>(BatteryStatsUidTable::TIMER_COLUMN_END);
+    std::map<int32_t, double> appPowerMap_;
+};
+
+/* Mirrors the entities after the change: every value lives in the flat uid table */
+class TableLayout {
+public:
+    void Add(int32_t uid)
+    {
+        for (uint8_t i = 0; i < TIMERS_PER_UID; i++) {
+            table_.GetOrCreateTimer(uid, static_cast<BatteryStatsUidTable::TimerColumn>(GetTimerColumn(uid, i)));
+        }
+    }
+
+    double Calculate()
+    {
+        double total = 0.0;
+        uint32_t slotCount = table_.GetSlotCount();
+        for (uint32_t slot = 0; slot < slotCount; slot++) {
+            int32_t uid = table_.GetUid(slot);
+            double power = 0.0;
+            for (uint8_t column = 0; column < BatteryStatsUidTable::TIMER_COLUMN_END; column++) {
+                auto timerColumn = static_cast<BatteryStatsUidTable::TimerColumn>(column);
+                double partPower = AVERAGE_POWER_MA * table_.GetRunningTimeMs(uid, timerColumn) / MS_IN_HOUR;
+                table_.SetPower(uid, TIMER_POWER_COLUMNS[column], partPower);
+                power += partPower;
+            }
+            table_.SetPower(uid, BatteryStatsUidTable::POWER_APP, power);
+            total += power;
+        }
+        return total;
+    }
+private:
+    BatteryStatsUidTable table_;
+};
+
+template<typename Layout>
+void BenchmarkCalculate(benchmark::State& state)
+{
+    int32_t uidCount = static_cast<int32_t>(state.range(0));
+    MemoryCounter counter;
+    Layout layout;
+    for (int32_t i = 0; i < uidCount; i++) {
+        layout.Add(FIRST_APP_UID + i);
+    }
+    size_t allocatedBytes = counter.GetAllocatedBytes();
+    for (auto _ : state) {
+        double total = layout.Calculate();
+        benchmark::DoNotOptimize(total);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * uidCount);
+    state.counters["bytes_per_uid"] = static_cast<double>(allocatedBytes) / uidCount;
+}
+
+void StatsUidMapCalculate(benchmark::State& state)
+{
+    BenchmarkCalculate<MapLayout>(state);
+}
+
+void StatsUidTableCalculate(benchmark::State& state)
+{
+    BenchmarkCalculate<TableLayout>(state);
+}
+
+BENCHMARK(StatsUidMapCalculate)->Arg(100)->Arg(1000)->Arg(10000);
+BENCHMARK(StatsUidTableCalculate)->Arg(100)->Arg(1000)->Arg(10000);
+}
+
+BENCHMARK_MAIN();
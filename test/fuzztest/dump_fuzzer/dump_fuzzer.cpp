@@ -34,7 +34,8 @@ constexpr size_t MIN_PARAM_SIZE = sizeof(uint32_t);  // Minimum size for paramet
 const std::vector<std::string> VALID_COMMANDS = {
     "-h",
     "-batterystats",
-    "-poweraverage"
+    "-poweraverage",
+    "-export"
 };
 
 /**
@@ -45,7 +45,7 @@ void HandleEntityRetrieval(const std::shared_ptr<BatteryStatsCore>& core, const
         auto entity = core->GetEntity(type);
         if (entity != nullptr) {
             entity->Calculate();
-            (void)BatteryStatsEntity::GetStatsInfoList();
+            (void)core->GetBatteryStats();
         }
 
         if (offset + UID_GUARD_BYTES > size) {
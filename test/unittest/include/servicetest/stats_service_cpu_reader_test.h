@@ -0,0 +1,32 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STATS_SERVICE_CPU_READER_TEST_H
+#define STATS_SERVICE_CPU_READER_TEST_H
+
+#include "stats_test.h"
+
+namespace OHOS {
+namespace PowerMgr {
+class StatsServiceCpuReaderTest : public testing::Test, public StatsTest {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // STATS_SERVICE_CPU_READER_TEST_H
@@ -41,6 +41,9 @@ public:
     int32_t GetTotalDataBytesIpc(int32_t statsType, int32_t uid, uint64_t& totalDataBytes);
     int32_t ResetIpc();
     int32_t ShellDumpIpc(const std::vector<std::string>& args, uint32_t argc, std::string& dumpShell);
+    int32_t GetAppStatsBatchIpc(const std::vector<int32_t>& uids, const std::vector<int32_t>& statsTypes,
+        std::vector<double>& appStatsMah, std::vector<double>& appStatsPercent, std::vector<int64_t>& totalTimeSecond,
+        int32_t& tempError);
 
 private:
     static constexpr OHOS::HiviewDFX::HiLogLabel LABEL = {LOG_CORE, 0xD000F00, "StatsTest"};
@@ -270,4 +270,70 @@ HWTEST_F (StatsServiceThreadTest, StatsServiceThreadTest_001, TestSize.Level0)
 
     STATS_HILOGI(LABEL_TEST, "StatsServiceThreadTest_001 end");
 }
+
+/**
+ * @tc.name: StatsServiceThreadTest_002
+ * @tc.desc: test the query throughput with 1 to 16 concurrent readers while the stats keep changing
+ * @tc.type: PERF
+ */
+HWTEST_F (StatsServiceThreadTest, StatsServiceThreadTest_002, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceThreadTest_002 start");
+
+    g_batteryStatsService = OHOS::PowerMgr::BatteryStatsService::GetInstance();
+    ASSERT_NE(g_batteryStatsService, nullptr) << "g_batteryStatsService instance is null";
+
+    g_batteryStatsService->OnStart();
+
+    const int32_t maxReaders = 16;
+    const auto duration = std::chrono::milliseconds(500);
+    std::atomic<bool> writing {true};
+    std::thread writer([&]() {
+        int32_t uid = 10000;
+        while (writing.load()) {
+            g_batteryStatsService->UpdateStats(StatsUtils::STATS_TYPE_ALARM, 0, 1, uid);
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+
+    for (int32_t readers = 1; readers <= maxReaders; readers *= 2) {
+        TestResult readResult;
+        std::atomic<bool> reading {true};
+        std::vector<std::thread> readThreads;
+        readThreads.reserve(readers);
+        auto start = std::chrono::steady_clock::now();
+        for (int32_t i = 0; i < readers; ++i) {
+            readThreads.emplace_back([&]() {
+                while (reading.load()) {
+                    double mah = g_batteryStatsService->GetAppStatsMah(10000);
+                    if (mah >= StatsUtils::DEFAULT_VALUE) {
+                        readResult.success++;
+                    } else {
+                        readResult.failure++;
+                    }
+                }
+            });
+        }
+        std::this_thread::sleep_for(duration);
+        reading = false;
+        for (auto& t : readThreads) {
+            if (t.joinable()) {
+                t.join();
+            }
+        }
+        auto elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        int64_t opsPerSecond = elapsedMs > 0 ? static_cast<int64_t>(readResult.success.load()) * 1000 / elapsedMs : 0;
+        GTEST_LOG_(INFO) << __func__ << ": readers = " << readers << ", queries = " << readResult.success
+            << ", throughput = " << opsPerSecond << " ops/s";
+        EXPECT_EQ(readResult.failure, 0);
+        EXPECT_GT(readResult.success, 0);
+    }
+
+    writing = false;
+    writer.join();
+    g_batteryStatsService->OnStop();
+
+    STATS_HILOGI(LABEL_TEST, "StatsServiceThreadTest_002 end");
+}
 } // namespace
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include "battery_stats_parser.h"
 #include "stats_helper.h"
 #include "stats_hisysevent.h"
+#include "stats_json_view.h"
 #include "stats_utils.h"
 
 using namespace testing::ext;
@@ -58,6 +59,26 @@ HWTEST_F (StatsUtilTest, StatsHiSysEvent_001, TestSize.Level0)
     STATS_HILOGI(LABEL_TEST, "StatsHiSysEvent_001 end");
 }
 
+/**
+ * @tc.name: StatsHiSysEvent_002
+ * @tc.desc: test StatsHiSysEvent GetHiSysEventType function
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsUtilTest, StatsHiSysEvent_002, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsHiSysEvent_002 start");
+    for (int32_t i = 0; i < StatsHiSysEvent::HISYSEVENT_TYPE_END; i++) {
+        EXPECT_EQ(StatsHiSysEvent::GetHiSysEventType(StatsHiSysEvent::HISYSEVENT_LIST[i]), i);
+        EXPECT_TRUE(StatsHiSysEvent::CheckHiSysEvent(StatsHiSysEvent::HISYSEVENT_LIST[i]));
+    }
+    EXPECT_EQ(StatsHiSysEvent::GetHiSysEventType(""), StatsHiSysEvent::HISYSEVENT_TYPE_INVALID);
+    EXPECT_EQ(StatsHiSysEvent::GetHiSysEventType("WIFI"), StatsHiSysEvent::HISYSEVENT_TYPE_INVALID);
+    EXPECT_EQ(StatsHiSysEvent::GetHiSysEventType("RUNNINGLOCK_"), StatsHiSysEvent::HISYSEVENT_TYPE_INVALID);
+    EXPECT_EQ(StatsHiSysEvent::GetHiSysEventType("runninglock"), StatsHiSysEvent::HISYSEVENT_TYPE_INVALID);
+    EXPECT_FALSE(StatsHiSysEvent::CheckHiSysEvent(""));
+    STATS_HILOGI(LABEL_TEST, "StatsHiSysEvent_002 end");
+}
+
 /**
  * @tc.name: StatsUtils_001
  * @tc.desc: test class StatsUtils ConvertStatsType function
@@ -371,4 +392,73 @@ HWTEST_F (StatsUtilTest, StatsParserTest_001, TestSize.Level0)
     EXPECT_TRUE(ret);
     STATS_HILOGI(LABEL_TEST, "StatsParserTest_001 end");
 }
+
+/**
+ * @tc.name: StatsJsonView_001
+ * @tc.desc: test StatsJsonView typed getters on a HiSysEvent record
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsUtilTest, StatsJsonView_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsJsonView_001 start");
+    std::string json = R"({"domain_":"POWER","name_":"RUNNINGLOCK","time_":1718170524329,"UID":20020048,)"
+        R"("PID":-3712,"STATE":1,"NAME":"Notification\"Sub\u00e9","TAG":"","RATIO":0.85,"BIG":9999999999,)"
+        R"("LIST":[1,{"UID":1},"x"],"OBJ":{"a":[true,false,null]},"UID":1})";
+    StatsJsonView root(json);
+    EXPECT_TRUE(root.IsValid());
+    EXPECT_EQ(root.GetFieldCount(), 13U);
+
+    int32_t value = StatsUtils::INVALID_VALUE;
+    EXPECT_TRUE(root.GetInt("UID", value));
+    EXPECT_EQ(value, 20020048);
+    EXPECT_TRUE(root.GetInt("PID", value));
+    EXPECT_EQ(value, -3712);
+    EXPECT_TRUE(root.GetInt("BIG", value));
+    EXPECT_EQ(value, INT32_MAX);
+    EXPECT_TRUE(root.GetInt("RATIO", value));
+    EXPECT_EQ(value, 0);
+    EXPECT_FALSE(root.GetInt("NAME", value));
+    EXPECT_FALSE(root.GetInt("LIST", value));
+    EXPECT_FALSE(root.GetInt("NOT_EXIST", value));
+
+    double ratio = 0;
+    EXPECT_TRUE(root.GetDouble("RATIO", ratio));
+    EXPECT_DOUBLE_EQ(ratio, 0.85);
+
+    std::string_view str;
+    EXPECT_TRUE(root.GetString("name_", str));
+    EXPECT_EQ(str, "RUNNINGLOCK");
+    EXPECT_TRUE(root.GetString("NAME", str));
+    EXPECT_EQ(str, "Notification\"Sub\xc3\xa9");
+    EXPECT_FALSE(root.GetString("TAG", str));
+    EXPECT_FALSE(root.GetString("STATE", str));
+    STATS_HILOGI(LABEL_TEST, "StatsJsonView_001 end");
+}
+
+/**
+ * @tc.name: StatsJsonView_002
+ * @tc.desc: test StatsJsonView rejects malformed documents
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsUtilTest, StatsJsonView_002, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsJsonView_002 start");
+    std::vector<std::string> invalidJsons = {
+        "", "[]", "123", "{", R"({"UID":})", R"({"UID":1,})", R"({"UID" 1})", R"({"UID":01})",
+        R"({"UID":1} trailing)", R"({"NAME":"abc)", R"({"NAME":"\x"})", R"({"NAME":"\ud800"})",
+        R"({"LIST":[1,2})", R"({"FLAG":tru})", R"({UID:1})"
+    };
+    for (auto& json : invalidJsons) {
+        StatsJsonView root(json);
+        EXPECT_FALSE(root.IsValid()) << json;
+        int32_t value = StatsUtils::INVALID_VALUE;
+        EXPECT_FALSE(root.GetInt("UID", value));
+    }
+
+    std::string empty = " { } ";
+    StatsJsonView emptyRoot(empty);
+    EXPECT_TRUE(emptyRoot.IsValid());
+    EXPECT_EQ(emptyRoot.GetFieldCount(), 0U);
+    STATS_HILOGI(LABEL_TEST, "StatsJsonView_002 end");
+}
 }
\ No newline at end of file
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_service_batch_test.h"
+#include "stats_log.h"
+
+#include <hisysevent.h>
+
+#include "battery_stats_listener.h"
+#include "battery_stats_service.h"
+#include "hisysevent_operation.h"
+#include "stats_hisysevent.h"
+#include "stats_service_test_proxy.h"
+#include "stats_service_write_event.h"
+
+using namespace OHOS;
+using namespace OHOS::HiviewDFX;
+using namespace OHOS::PowerMgr;
+using namespace std;
+using namespace testing::ext;
+
+namespace {
+static sptr<BatteryStatsService> g_statsService = nullptr;
+static std::shared_ptr<StatsServiceTestProxy> g_statsServiceProxy = nullptr;
+} // namespace
+
+void StatsServiceBatchTest::SetUpTestCase()
+{
+    ParserAveragePowerFile();
+    g_statsService = BatteryStatsService::GetInstance();
+    g_statsService->OnStart();
+
+    if (g_statsService->listenerPtr_ == nullptr) {
+        g_statsService->listenerPtr_ = std::make_shared<BatteryStatsListener>();
+    }
+
+    if (g_statsServiceProxy == nullptr) {
+        g_statsServiceProxy = std::make_shared<StatsServiceTestProxy>(g_statsService);
+    }
+}
+
+void StatsServiceBatchTest::TearDownTestCase()
+{
+    g_statsService->listenerPtr_ = nullptr;
+    g_statsService->OnStop();
+}
+
+void StatsServiceBatchTest::SetUp()
+{
+    auto statsService = BatteryStatsService::GetInstance();
+    statsService->SetOnBattery(true);
+}
+
+void StatsServiceBatchTest::TearDown()
+{
+    auto statsService = BatteryStatsService::GetInstance();
+    statsService->SetOnBattery(false);
+}
+
+namespace {
+/**
+ * @tc.name: StatsServiceBatchTest_001
+ * @tc.desc: test GetAppStatsBatchIpc matches the per uid queries and rejects too many uids
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceBatchTest, StatsServiceBatchTest_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceBatchTest_001 start");
+    ASSERT_NE(g_statsServiceProxy, nullptr);
+    auto statsService = BatteryStatsService::GetInstance();
+    g_statsServiceProxy->ResetIpc();
+
+    std::vector<int32_t> uids = {10003, 10004, 10005};
+    int32_t pid = 3458;
+    int16_t count = 10;
+
+    for (int16_t i = 0; i < count; i++) {
+        StatsWriteHiSysEvent(statsService,
+            HiSysEvent::Domain::TIME, StatsHiSysEvent::MISC_TIME_STATISTIC_REPORT, HiSysEvent::EventType::STATISTIC,
+            "CALLER_PID", pid, "CALLER_UID", uids[0]);
+        StatsWriteHiSysEvent(statsService,
+            HiSysEvent::Domain::TIME, StatsHiSysEvent::MISC_TIME_STATISTIC_REPORT, HiSysEvent::EventType::STATISTIC,
+            "CALLER_PID", pid, "CALLER_UID", uids[1]);
+    }
+    std::vector<int32_t> statsTypes = {StatsUtils::STATS_TYPE_ALARM, StatsUtils::STATS_TYPE_CAMERA_ON};
+    std::vector<double> appStatsMah;
+    std::vector<double> appStatsPercent;
+    std::vector<int64_t> totalTimeSecond;
+    int32_t tempError;
+    g_statsServiceProxy->GetAppStatsBatchIpc(uids, statsTypes, appStatsMah, appStatsPercent, totalTimeSecond,
+        tempError);
+    EXPECT_EQ(tempError, static_cast<int32_t>(StatsError::ERR_OK));
+    ASSERT_EQ(appStatsMah.size(), uids.size());
+    ASSERT_EQ(appStatsPercent.size(), uids.size());
+    EXPECT_EQ(totalTimeSecond.size(), uids.size() * statsTypes.size());
+    for (size_t i = 0; i < uids.size(); i++) {
+        double powerMah;
+        double powerPercent;
+        g_statsServiceProxy->GetAppStatsMahIpc(uids[i], powerMah, tempError);
+        g_statsServiceProxy->GetAppStatsPercentIpc(uids[i], powerPercent, tempError);
+        GTEST_LOG_(INFO) << __func__ << ": uid " << uids[i] << " batch consumption = " << appStatsMah[i] << " mAh";
+        EXPECT_DOUBLE_EQ(powerMah, appStatsMah[i]);
+        EXPECT_DOUBLE_EQ(powerPercent, appStatsPercent[i]);
+    }
+    EXPECT_GT(appStatsMah[0], StatsUtils::DEFAULT_VALUE);
+    EXPECT_EQ(appStatsMah[2], StatsUtils::DEFAULT_VALUE);
+
+    std::vector<int32_t> tooManyUids(BatteryStatsService::BATCH_MAX_UID_COUNT + 1, uids[0]);
+    appStatsMah.clear();
+    appStatsPercent.clear();
+    totalTimeSecond.clear();
+    g_statsServiceProxy->GetAppStatsBatchIpc(tooManyUids, statsTypes, appStatsMah, appStatsPercent, totalTimeSecond,
+        tempError);
+    EXPECT_EQ(tempError, static_cast<int32_t>(StatsError::ERR_PARAM_INVALID));
+    EXPECT_TRUE(appStatsMah.empty());
+    STATS_HILOGI(LABEL_TEST, "StatsServiceBatchTest_001 end");
+}
+}
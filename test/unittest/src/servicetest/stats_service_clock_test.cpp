@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_service_clock_test.h"
+#include "stats_log.h"
+
+#include <thread>
+
+#include "stats_helper.h"
+
+using namespace OHOS;
+using namespace OHOS::PowerMgr;
+using namespace std;
+using namespace testing::ext;
+
+namespace {
+/**
+ * @tc.name: StatsServiceClockTest_001
+ * @tc.desc: test the timers run on the installed clock and share the now of a time snapshot
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceClockTest, StatsServiceClockTest_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceClockTest_001 start");
+    const int64_t stepMs = 1000;
+    // Static, the threads of the service read the clock as well
+    static FakeStatsClock clock(stepMs, stepMs);
+    bool isOnBattery = StatsHelper::IsOnBattery();
+    StatsHelper::SetClock(&clock);
+    StatsHelper::SetOnBattery(true);
+    clock.SuspendMs(stepMs);
+    EXPECT_EQ(stepMs * 2, StatsHelper::GetBootTimeMs());
+    EXPECT_EQ(stepMs, StatsHelper::GetUpTimeMs());
+
+    StatsHelper::ActiveTimer timer;
+    StatsHelper::ActiveTimer otherTimer;
+    timer.StartRunning();
+    clock.AdvanceMs(stepMs);
+    {
+        StatsHelper::TimeSnapshot timeSnapshot;
+        otherTimer.StartRunning();
+        clock.AdvanceMs(stepMs);
+        EXPECT_EQ(stepMs, timer.GetRunningTimeMs());
+        {
+            // A nested snapshot keeps the outer time
+            StatsHelper::TimeSnapshot nestedSnapshot;
+            EXPECT_EQ(stepMs, timer.GetRunningTimeMs());
+        }
+        EXPECT_EQ(StatsUtils::DEFAULT_VALUE, otherTimer.GetRunningTimeMs());
+    }
+    EXPECT_EQ(stepMs * 2, timer.GetRunningTimeMs());
+    EXPECT_EQ(stepMs, otherTimer.GetRunningTimeMs());
+
+    // A read on another thread doesn't move the start, a stop at the older time of a snapshot counts up to it
+    {
+        StatsHelper::TimeSnapshot timeSnapshot;
+        std::thread([&otherTimer] {
+            clock.AdvanceMs(stepMs);
+            EXPECT_EQ(stepMs * 2, otherTimer.GetRunningTimeMs());
+        }).join();
+        EXPECT_EQ(stepMs, otherTimer.GetRunningTimeMs());
+        EXPECT_TRUE(otherTimer.StopRunning());
+    }
+    EXPECT_EQ(stepMs, otherTimer.GetRunningTimeMs());
+    EXPECT_EQ(stepMs * 3, timer.GetRunningTimeMs());
+
+    // A stop stamped before the start is clamped to the start instead of adding a negative time
+    int64_t startBootTimeMs = StatsHelper::GetBootTimeMs();
+    EXPECT_TRUE(otherTimer.StartRunning());
+    {
+        StatsHelper::TimeSnapshot eventTime(startBootTimeMs - stepMs / 2, StatsHelper::GetUpTimeMs());
+        EXPECT_TRUE(otherTimer.StopRunning());
+    }
+    EXPECT_EQ(stepMs, otherTimer.GetRunningTimeMs());
+
+    StatsHelper::SetOnBattery(false);
+    StatsHelper::SetClock(nullptr);
+    StatsHelper::SetOnBattery(isOnBattery);
+    EXPECT_GT(StatsHelper::GetBootTimeMs(), StatsUtils::DEFAULT_VALUE);
+    STATS_HILOGI(LABEL_TEST, "StatsServiceClockTest_001 end");
+}
+}
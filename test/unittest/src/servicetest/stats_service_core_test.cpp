@@ -16,8 +16,14 @@
 #include "stats_service_core_test.h"
 #include "stats_log.h"
 
+#include <thread>
+#include <unistd.h>
+
 #include "battery_stats_core.h"
+#include "battery_stats_event_queue.h"
+#include "battery_stats_result.h"
 #include "battery_stats_service.h"
+#include "entities/user_entity.h"
 
 using namespace OHOS;
 using namespace OHOS::PowerMgr;
@@ -307,4 +313,290 @@ HWTEST_F (StatsServiceCoreTest, StatsServiceCoreTest_007, TestSize.Level0)
     EXPECT_EQ(StatsUtils::DEFAULT_VALUE, uidEntity->GetStatsPowerMah(StatsUtils::STATS_TYPE_INVALID));
     STATS_HILOGI(LABEL_TEST, "StatsServiceCoreTest_007 end");
 }
-}
\ No newline at end of file
+
+/**
+ * @tc.name: StatsServiceCoreTest_008
+ * @tc.desc: test ComputePower only recalculates the uids with changed timers
+ * @tc.type: FUNC
+ * @tc.require: issueI663DX
+ */
+HWTEST_F (StatsServiceCoreTest, StatsServiceCoreTest_008, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceCoreTest_008 start");
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    int32_t uid = 10003;
+
+    statsCore->UpdateStats(StatsUtils::STATS_TYPE_WAKELOCK_HOLD, StatsUtils::STATS_STATE_ACTIVATED,
+        StatsUtils::INVALID_VALUE, uid);
+    usleep(SERVICE_POWER_CONSUMPTION_DURATION_US);
+    statsCore->ComputePower();
+    double runningPowerBefore = statsCore->GetAppStatsMah(uid);
+    usleep(SERVICE_POWER_CONSUMPTION_DURATION_US);
+    statsCore->ComputePower();
+    double runningPowerAfter = statsCore->GetAppStatsMah(uid);
+    EXPECT_GT(runningPowerAfter, runningPowerBefore);
+
+    statsCore->UpdateStats(StatsUtils::STATS_TYPE_WAKELOCK_HOLD, StatsUtils::STATS_STATE_DEACTIVATED,
+        StatsUtils::INVALID_VALUE, uid);
+    statsCore->ComputePower();
+    double stoppedPowerBefore = statsCore->GetAppStatsMah(uid);
+    usleep(SERVICE_POWER_CONSUMPTION_DURATION_US);
+    statsCore->ComputePower();
+    double stoppedPowerAfter = statsCore->GetAppStatsMah(uid);
+    EXPECT_GE(stoppedPowerBefore, runningPowerAfter);
+    EXPECT_DOUBLE_EQ(stoppedPowerBefore, stoppedPowerAfter);
+
+    statsCore->Reset();
+    statsCore->ComputePower();
+    EXPECT_EQ(StatsUtils::DEFAULT_VALUE, statsCore->GetAppStatsMah(uid));
+    STATS_HILOGI(LABEL_TEST, "StatsServiceCoreTest_008 end");
+}
+
+/**
+ * @tc.name: StatsServiceCoreTest_009
+ * @tc.desc: test the point queries share one computed result until the stats change
+ * @tc.type: FUNC
+ * @tc.require: issueI663DX
+ */
+HWTEST_F (StatsServiceCoreTest, StatsServiceCoreTest_009, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceCoreTest_009 start");
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    statsCore->Reset();
+    int32_t uid = 10003;
+
+    statsCore->UpdateStats(StatsUtils::STATS_TYPE_WAKELOCK_HOLD, StatsUtils::STATS_STATE_ACTIVATED,
+        StatsUtils::INVALID_VALUE, uid);
+    usleep(SERVICE_POWER_CONSUMPTION_DURATION_US);
+    statsCore->UpdateStats(StatsUtils::STATS_TYPE_WAKELOCK_HOLD, StatsUtils::STATS_STATE_DEACTIVATED,
+        StatsUtils::INVALID_VALUE, uid);
+    auto result = statsCore->GetStatsResult();
+    ASSERT_NE(nullptr, result);
+    EXPECT_EQ(result, statsCore->GetStatsResult());
+    double appPower = statsCore->GetAppStatsMah(uid);
+    EXPECT_GT(appPower, StatsUtils::DEFAULT_VALUE);
+    EXPECT_DOUBLE_EQ(appPower, result->GetAppPowerMah(uid));
+    EXPECT_DOUBLE_EQ(appPower / result->GetTotalPowerMah(), statsCore->GetAppStatsPercent(uid));
+    EXPECT_DOUBLE_EQ(StatsUtils::DEFAULT_VALUE, result->GetAppPowerMah(uid + 1));
+    EXPECT_EQ(result, statsCore->GetStatsResult());
+
+    statsCore->UpdateStats(StatsUtils::STATS_TYPE_ALARM, 0, 1, uid);
+    auto newResult = statsCore->GetStatsResult();
+    EXPECT_NE(result, newResult);
+    EXPECT_GT(newResult->GetVersion(), result->GetVersion());
+
+    BatteryStatsInfoList statsInfoList;
+    auto appInfo = std::make_shared<BatteryStatsInfo>();
+    appInfo->SetUid(uid);
+    appInfo->SetConsumptioType(BatteryStatsInfo::CONSUMPTION_TYPE_APP);
+    appInfo->SetPower(1.0);
+    auto screenInfo = std::make_shared<BatteryStatsInfo>();
+    screenInfo->SetConsumptioType(BatteryStatsInfo::CONSUMPTION_TYPE_SCREEN);
+    screenInfo->SetPower(3.0);
+    statsInfoList.push_back(appInfo);
+    statsInfoList.push_back(screenInfo);
+    BatteryStatsResult indexedResult(1, 0, statsInfoList, 4.0);
+    EXPECT_DOUBLE_EQ(1.0, indexedResult.GetAppPowerMah(uid));
+    EXPECT_DOUBLE_EQ(3.0, indexedResult.GetPartPowerMah(BatteryStatsInfo::CONSUMPTION_TYPE_SCREEN));
+    EXPECT_DOUBLE_EQ(StatsUtils::DEFAULT_VALUE, indexedResult.GetPartPowerMah(BatteryStatsInfo::CONSUMPTION_TYPE_WIFI));
+    EXPECT_EQ(2u, indexedResult.GetStatsInfoList().size());
+    statsCore->Reset();
+    STATS_HILOGI(LABEL_TEST, "StatsServiceCoreTest_009 end");
+}
+
+/**
+ * @tc.name: StatsServiceCoreTest_010
+ * @tc.desc: test the user power array and that the cached user ids survive an invalidation
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceCoreTest, StatsServiceCoreTest_010, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceCoreTest_010 start");
+    UserEntity userEntity;
+    userEntity.AggregateUserPowerMah(101, 1.0);
+    userEntity.AggregateUserPowerMah(100, 2.0);
+    userEntity.AggregateUserPowerMah(101, 0.5);
+    EXPECT_DOUBLE_EQ(1.5, userEntity.GetEntityPowerMah(101));
+    EXPECT_DOUBLE_EQ(2.0, userEntity.GetEntityPowerMah(100));
+    EXPECT_DOUBLE_EQ(StatsUtils::DEFAULT_VALUE, userEntity.GetEntityPowerMah(102));
+    userEntity.Reset();
+    EXPECT_DOUBLE_EQ(StatsUtils::DEFAULT_VALUE, userEntity.GetEntityPowerMah(101));
+
+    auto statsCore = BatteryStatsService::GetInstance()->GetBatteryStatsCore();
+    int32_t uid = 20010023;
+    int32_t userId = 100;
+    statsCore->UpdateStats(StatsUtils::STATS_TYPE_AUDIO_ON, StatsUtils::STATS_STATE_ACTIVATED,
+        StatsUtils::INVALID_VALUE, uid);
+    usleep(SERVICE_POWER_CONSUMPTION_DURATION_US);
+    statsCore->UpdateStats(StatsUtils::STATS_TYPE_AUDIO_ON, StatsUtils::STATS_STATE_DEACTIVATED,
+        StatsUtils::INVALID_VALUE, uid);
+    statsCore->ComputePower();
+    auto statsUserEntity = statsCore->GetEntity(BatteryStatsInfo::CONSUMPTION_TYPE_USER);
+    ASSERT_NE(nullptr, statsUserEntity);
+    double userPowerMah = statsUserEntity->GetEntityPowerMah(userId);
+    EXPECT_GE(userPowerMah, statsCore->GetAppStatsMah(uid));
+
+    // The user ids are resolved again on the next calculation and give the same sums
+    statsCore->InvalidateUserIds();
+    statsCore->ComputePower();
+    EXPECT_DOUBLE_EQ(userPowerMah, statsUserEntity->GetEntityPowerMah(userId));
+    STATS_HILOGI(LABEL_TEST, "StatsServiceCoreTest_010 end");
+}
+
+/**
+ * @tc.name: StatsServiceCoreTest_011
+ * @tc.desc: test a shared result is computed again once it is older than the max age and on a power supply change
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceCoreTest, StatsServiceCoreTest_011, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceCoreTest_011 start");
+    auto statsCore = BatteryStatsService::GetInstance()->GetBatteryStatsCore();
+    bool isOnBattery = StatsHelper::IsOnBattery();
+    statsCore->SetOnBattery(true);
+    statsCore->Reset();
+    int32_t uid = 10003;
+
+    // No event moves the version on while the lock is held, the result only ages
+    statsCore->UpdateStats(StatsUtils::STATS_TYPE_WAKELOCK_HOLD, StatsUtils::STATS_STATE_ACTIVATED,
+        StatsUtils::INVALID_VALUE, uid);
+    auto result = statsCore->GetStatsResult();
+    ASSERT_NE(nullptr, result);
+    EXPECT_EQ(result, statsCore->GetStatsResult());
+    usleep((BatteryStatsResult::MAX_AGE_MS + 100) * US_PER_MS);
+    auto agedResult = statsCore->GetStatsResult();
+    ASSERT_NE(nullptr, agedResult);
+    EXPECT_NE(result, agedResult);
+    EXPECT_GT(agedResult->GetAppPowerMah(uid), result->GetAppPowerMah(uid));
+
+    // Plugging in stops the timers, the result from before has to go
+    statsCore->SetOnBattery(false);
+    auto pluggedResult = statsCore->GetStatsResult();
+    ASSERT_NE(nullptr, pluggedResult);
+    EXPECT_NE(agedResult, pluggedResult);
+    EXPECT_GT(pluggedResult->GetVersion(), agedResult->GetVersion());
+
+    statsCore->UpdateStats(StatsUtils::STATS_TYPE_WAKELOCK_HOLD, StatsUtils::STATS_STATE_DEACTIVATED,
+        StatsUtils::INVALID_VALUE, uid);
+    statsCore->SetOnBattery(isOnBattery);
+    statsCore->Reset();
+    STATS_HILOGI(LABEL_TEST, "StatsServiceCoreTest_011 end");
+}
+
+/**
+ * @tc.name: StatsServiceCoreTest_012
+ * @tc.desc: test a stale result is published by the thread applying the events while readers and writers race
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceCoreTest, StatsServiceCoreTest_012, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceCoreTest_012 start");
+    BatteryStatsEventQueue eventQueue(8);
+    std::thread::id applyThread;
+    uint64_t appliedBeforeSync = 0;
+    StatsUtils::StatsData data;
+    data.type = StatsUtils::STATS_TYPE_WAKELOCK_HOLD;
+    EXPECT_FALSE(eventQueue.Sync([] {}));
+    EXPECT_TRUE(eventQueue.Start([&applyThread](const StatsUtils::StatsData&) {
+        applyThread = std::this_thread::get_id();
+    }));
+    const uint64_t pushCount = 4;
+    for (uint64_t i = 0; i < pushCount; i++) {
+        EXPECT_TRUE(eventQueue.Push(data));
+    }
+    std::thread::id syncThread;
+    EXPECT_TRUE(eventQueue.Sync([&eventQueue, &syncThread, &appliedBeforeSync] {
+        syncThread = std::this_thread::get_id();
+        appliedBeforeSync = eventQueue.GetAppliedCount();
+    }));
+    EXPECT_EQ(applyThread, syncThread);
+    EXPECT_EQ(pushCount, appliedBeforeSync);
+    eventQueue.Stop();
+    EXPECT_FALSE(eventQueue.Sync([] {}));
+
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    auto statsQueue = statsService->GetBatteryStatsEventQueue();
+    ASSERT_NE(nullptr, statsQueue);
+    statsCore->Reset();
+    const int32_t uid = 10003;
+    const int32_t eventCount = 200;
+    std::atomic<bool> isDone {false};
+    std::thread writer([&statsQueue, &isDone, uid, eventCount] {
+        StatsUtils::StatsData event;
+        event.type = StatsUtils::STATS_TYPE_WAKELOCK_HOLD;
+        event.uid = uid;
+        for (int32_t i = 0; i < eventCount; i++) {
+            event.state = (i % 2 == 0) ? StatsUtils::STATS_STATE_ACTIVATED : StatsUtils::STATS_STATE_DEACTIVATED;
+            statsQueue->Push(event);
+        }
+        isDone.store(true);
+    });
+    std::vector<std::thread> readers;
+    const int32_t readerCount = 4;
+    for (int32_t i = 0; i < readerCount; i++) {
+        readers.emplace_back([&statsCore, &isDone, uid] {
+            uint64_t lastVersion = 0;
+            while (!isDone.load()) {
+                auto result = statsCore->GetStatsResult();
+                ASSERT_NE(nullptr, result);
+                EXPECT_GE(result->GetVersion(), lastVersion);
+                lastVersion = result->GetVersion();
+                EXPECT_GE(statsCore->GetTotalTimeMs(uid, StatsUtils::STATS_TYPE_WAKELOCK_HOLD),
+                    StatsUtils::DEFAULT_VALUE);
+            }
+        });
+    }
+    writer.join();
+    for (auto& reader : readers) {
+        reader.join();
+    }
+    EXPECT_TRUE(statsQueue->Flush());
+    statsCore->Reset();
+    STATS_HILOGI(LABEL_TEST, "StatsServiceCoreTest_012 end");
+}
+
+/**
+ * @tc.name: StatsServiceCoreTest_013
+ * @tc.desc: test the camera power of a uid keeps growing while its camera is on, a stop of another device aside
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceCoreTest, StatsServiceCoreTest_013, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceCoreTest_013 start");
+    auto statsCore = BatteryStatsService::GetInstance()->GetBatteryStatsCore();
+    bool isOnBattery = StatsHelper::IsOnBattery();
+    statsCore->SetOnBattery(true);
+    statsCore->Reset();
+    int32_t uid = 10003;
+    int32_t otherUid = 10004;
+    auto updateCamera = [&statsCore, uid](StatsUtils::StatsState state, const std::string& deviceId) {
+        statsCore->UpdateStats(StatsUtils::STATS_TYPE_CAMERA_ON, state, StatsUtils::INVALID_VALUE, uid, deviceId);
+    };
+    // An event of another uid moves the version on without touching the camera part of the uid
+    auto getPowerLater = [&statsCore, uid, otherUid]() {
+        usleep(SERVICE_POWER_CONSUMPTION_DURATION_US);
+        statsCore->UpdateStats(StatsUtils::STATS_TYPE_ALARM, 0, 1, otherUid);
+        return statsCore->GetAppStatsMah(uid);
+    };
+
+    // The timer of the other device isn't running, stopping it changes nothing
+    updateCamera(StatsUtils::STATS_STATE_ACTIVATED, "0");
+    updateCamera(StatsUtils::STATS_STATE_DEACTIVATED, "1");
+    double power = statsCore->GetAppStatsMah(uid);
+    double laterPower = getPowerLater();
+    EXPECT_GT(laterPower, power);
+    EXPECT_GT(getPowerLater(), laterPower);
+
+    updateCamera(StatsUtils::STATS_STATE_DEACTIVATED, "0");
+    updateCamera(StatsUtils::STATS_STATE_DEACTIVATED, "0");
+    power = statsCore->GetAppStatsMah(uid);
+    EXPECT_DOUBLE_EQ(power, getPowerLater());
+
+    statsCore->SetOnBattery(isOnBattery);
+    statsCore->Reset();
+    STATS_HILOGI(LABEL_TEST, "StatsServiceCoreTest_013 end");
+}
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_service_cpu_kernel_test.h"
+#include "stats_log.h"
+
+#include <random>
+
+#include "cpu_time_kernel.h"
+#include "cpu_time_matrix.h"
+
+using namespace OHOS;
+using namespace OHOS::PowerMgr;
+using namespace std;
+using namespace testing::ext;
+
+namespace {
+/**
+ * @tc.name: StatsServiceCpuKernelTest_001
+ * @tc.desc: test the vector CpuTimeKernel matches the scalar loops and CpuTimeMatrix keeps the rows apart
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceCpuKernelTest, StatsServiceCpuKernelTest_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceCpuKernelTest_001 start");
+    std::mt19937_64 random(19);
+    const size_t maxCount = 67;
+    for (int32_t round = 0; round < 1000; round++) {
+        size_t count = random() % maxCount;
+        std::vector<int64_t> current(count);
+        std::vector<int64_t> last(count);
+        std::vector<int64_t> totals(count);
+        std::vector<double> weights(count);
+        for (size_t i = 0; i < count; i++) {
+            current[i] = static_cast<int64_t>(random() % 1000000);
+            // Some of the times go backwards
+            last[i] = static_cast<int64_t>(random() % 1100000);
+            totals[i] = static_cast<int64_t>(random() % 1000);
+            weights[i] = static_cast<double>(random() % 100000) / 100;
+        }
+        bool replace = (round % 2) == 0;
+        std::vector<int64_t> vectorLast = last;
+        std::vector<int64_t> vectorTotals = totals;
+        EXPECT_EQ(CpuTimeKernel::AccumulateScalar(current.data(), last.data(), totals.data(), count, replace),
+            CpuTimeKernel::Accumulate(current.data(), vectorLast.data(), vectorTotals.data(), count, replace));
+        EXPECT_EQ(last, vectorLast);
+        EXPECT_EQ(totals, vectorTotals);
+        double dot = CpuTimeKernel::DotScalar(weights.data(), current.data(), count);
+        EXPECT_NEAR(dot, CpuTimeKernel::Dot(weights.data(), current.data(), count), 1e-9 * (dot + 1));
+    }
+    GTEST_LOG_(INFO) << __func__ << ": cpu time kernel isa = " << CpuTimeKernel::GetIsaName();
+
+    CpuTimeMatrix matrix;
+    EXPECT_EQ(nullptr, matrix.GetTotals(10019));
+    EXPECT_TRUE(matrix.Update(10019, { 100, 200 }, CpuTimeMatrix::UPDATE_ACCUMULATE));
+    EXPECT_TRUE(matrix.Update(10020, { 10, 20 }, CpuTimeMatrix::UPDATE_LAST));
+    EXPECT_TRUE(matrix.Update(10019, { 150, 260, 30 }, CpuTimeMatrix::UPDATE_ACCUMULATE));
+    EXPECT_EQ(3, static_cast<int32_t>(matrix.GetWidth()));
+    EXPECT_EQ(2, static_cast<int32_t>(matrix.GetRowCount()));
+    EXPECT_EQ(std::vector<int64_t>({ 150, 260, 30 }),
+        std::vector<int64_t>(matrix.GetTotals(10019), matrix.GetTotals(10019) + matrix.GetWidth()));
+    EXPECT_EQ(std::vector<int64_t>({ 0, 0, 0 }),
+        std::vector<int64_t>(matrix.GetTotals(10020), matrix.GetTotals(10020) + matrix.GetWidth()));
+    // The column left out keeps its time, the one going backwards counts as zero
+    EXPECT_FALSE(matrix.Update(10020, { 5, 25 }, CpuTimeMatrix::UPDATE_REPLACE));
+    EXPECT_EQ(std::vector<int64_t>({ 0, 5, 0 }),
+        std::vector<int64_t>(matrix.GetTotals(10020), matrix.GetTotals(10020) + matrix.GetWidth()));
+    EXPECT_EQ(std::vector<int64_t>({ 5, 25, 0 }),
+        std::vector<int64_t>(matrix.GetLast(10020), matrix.GetLast(10020) + matrix.GetWidth()));
+    STATS_HILOGI(LABEL_TEST, "StatsServiceCpuKernelTest_001 end");
+}
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_service_cpu_reader_test.h"
+#include "stats_log.h"
+
+#include <fstream>
+#include <unistd.h>
+
+#include "battery_stats_codec.h"
+#include "battery_stats_parser.h"
+#include "battery_stats_service.h"
+#include "cpu_time_reader.h"
+#include "cpu_time_source.h"
+#include "stats_helper.h"
+
+using namespace OHOS;
+using namespace OHOS::PowerMgr;
+using namespace std;
+using namespace testing::ext;
+
+namespace {
+static sptr<BatteryStatsService> g_statsService = nullptr;
+
+struct UidCpuTimes {
+    int32_t uid;
+    int64_t activeMs;
+    std::vector<int64_t> clusterMs;
+    int64_t freqMs;
+    int64_t userUs;
+    int64_t systemUs;
+};
+
+void PutCpuTimeDump(std::string& buffer, uint16_t freqCount, const std::vector<UidCpuTimes>& records)
+{
+    uint16_t clusterCount = static_cast<uint16_t>(records.front().clusterMs.size());
+    BatteryStatsCodec::PutFixed32(buffer, BinaryCpuTimeSource::MAGIC);
+    BatteryStatsCodec::PutFixed16(buffer, BinaryCpuTimeSource::VERSION);
+    BatteryStatsCodec::PutFixed16(buffer, clusterCount);
+    BatteryStatsCodec::PutFixed16(buffer, freqCount);
+    BatteryStatsCodec::PutFixed16(buffer, 0);
+    BatteryStatsCodec::PutFixed32(buffer, static_cast<uint32_t>(records.size()));
+    for (const auto& record : records) {
+        BatteryStatsCodec::PutFixed32(buffer, static_cast<uint32_t>(record.uid));
+        BatteryStatsCodec::PutFixed32(buffer, 0);
+        BatteryStatsCodec::PutFixed64(buffer, static_cast<uint64_t>(record.activeMs));
+        for (int64_t clusterMs : record.clusterMs) {
+            BatteryStatsCodec::PutFixed64(buffer, static_cast<uint64_t>(clusterMs));
+        }
+        for (uint16_t i = 0; i < freqCount; i++) {
+            BatteryStatsCodec::PutFixed64(buffer, static_cast<uint64_t>(record.freqMs));
+        }
+        BatteryStatsCodec::PutFixed64(buffer, static_cast<uint64_t>(record.userUs));
+        BatteryStatsCodec::PutFixed64(buffer, static_cast<uint64_t>(record.systemUs));
+    }
+}
+} // namespace
+
+void StatsServiceCpuReaderTest::SetUpTestCase()
+{
+    g_statsService = BatteryStatsService::GetInstance();
+    g_statsService->OnStart();
+}
+
+void StatsServiceCpuReaderTest::TearDownTestCase()
+{
+    g_statsService->OnStop();
+}
+
+void StatsServiceCpuReaderTest::SetUp()
+{
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    statsCore->Reset();
+}
+
+void StatsServiceCpuReaderTest::TearDown()
+{
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    statsCore->Reset();
+}
+
+namespace {
+/**
+ * @tc.name: StatsServiceCpuReaderTest_001
+ * @tc.desc: test CpuTimeReader turns the replayed binary cpu time dumps into increments
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceCpuReaderTest, StatsServiceCpuReaderTest_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceCpuReaderTest_001 start");
+    auto statsService = BatteryStatsService::GetInstance();
+    auto profile = statsService->GetBatteryStatsParser()->GetPowerProfile();
+    uint16_t freqCount = static_cast<uint16_t>(profile->speedOffsets.back());
+    const int32_t uid = 10018;
+    const int32_t newUid = 10019;
+    std::string dumps;
+    PutCpuTimeDump(dumps, freqCount, { { uid, 1000, { 400, 600 }, 10, 5000, 3000 } });
+    PutCpuTimeDump(dumps, freqCount, {
+        { uid, 1500, { 600, 900 }, 15, 8000, 4000 },
+        { newUid, 700, { 300, 400 }, 20, 2000, 1000 },
+    });
+    // The kernel counts the uid again from zero
+    PutCpuTimeDump(dumps, freqCount, { { uid, 100, { 10, 20 }, 1, 100, 100 } });
+    const std::string path = "/data/local/tmp/battery_stats_test_cpu_time_dumps";
+    {
+        std::ofstream output(path, std::ios::trunc | std::ios::binary);
+        ASSERT_TRUE(output.is_open());
+        output << dumps;
+    }
+
+    bool isOnBattery = StatsHelper::IsOnBattery();
+    StatsHelper::SetOnBattery(true);
+    CpuTimeReader reader(std::make_unique<ReplayCpuTimeSource>(path));
+    reader.SetSpeedOffsets(profile->speedOffsets);
+    EXPECT_TRUE(reader.UpdateCpuTime());
+    EXPECT_EQ(1000, reader.GetUidCpuActiveTimeMs(uid));
+    EXPECT_EQ(400, reader.GetUidCpuClusterTimeMs(uid, 0));
+    EXPECT_EQ(600, reader.GetUidCpuClusterTimeMs(uid, 1));
+    EXPECT_EQ(std::vector<int64_t>({ 5000, 3000 }), reader.GetUidCpuTimeMs(uid));
+
+    EXPECT_TRUE(reader.UpdateCpuTime());
+    EXPECT_EQ(1500, reader.GetUidCpuActiveTimeMs(uid));
+    EXPECT_EQ(600, reader.GetUidCpuClusterTimeMs(uid, 0));
+    EXPECT_EQ(900, reader.GetUidCpuClusterTimeMs(uid, 1));
+    EXPECT_EQ(std::vector<int64_t>({ 3000, 1000 }), reader.GetUidCpuTimeMs(uid));
+    EXPECT_EQ(700, reader.GetUidCpuActiveTimeMs(newUid));
+    EXPECT_EQ(400, reader.GetUidCpuClusterTimeMs(newUid, 1));
+    if (freqCount > 0) {
+        EXPECT_EQ(15, reader.GetUidCpuFreqTimeMs(uid, 0, 0));
+        EXPECT_EQ(20, reader.GetUidCpuFreqTimeMs(newUid, 0, 0));
+    }
+
+    EXPECT_TRUE(reader.UpdateCpuTime());
+    EXPECT_EQ(1500, reader.GetUidCpuActiveTimeMs(uid));
+    EXPECT_EQ(600, reader.GetUidCpuClusterTimeMs(uid, 0));
+    EXPECT_EQ(std::vector<int64_t>({ 0, 0 }), reader.GetUidCpuTimeMs(uid));
+    if (freqCount > 0) {
+        EXPECT_EQ(15, reader.GetUidCpuFreqTimeMs(uid, 0, 0));
+    }
+    std::string result;
+    reader.DumpInfo(result, uid);
+    EXPECT_NE(result.find("userSpaceTime=100ms"), std::string::npos);
+
+    // Every dump has been replayed
+    EXPECT_FALSE(reader.UpdateCpuTime());
+    EXPECT_EQ(1500, reader.GetUidCpuActiveTimeMs(uid));
+    StatsHelper::SetOnBattery(isOnBattery);
+    unlink(path.c_str());
+    STATS_HILOGI(LABEL_TEST, "StatsServiceCpuReaderTest_001 end");
+}
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_service_cpu_sampler_test.h"
+#include "stats_log.h"
+
+#include <chrono>
+#include <thread>
+
+#include "cpu_time_sampler.h"
+#include "stats_utils.h"
+
+using namespace OHOS;
+using namespace OHOS::PowerMgr;
+using namespace std;
+using namespace testing::ext;
+
+namespace {
+/**
+ * @tc.name: StatsServiceCpuSamplerTest_001
+ * @tc.desc: test CpuTimeSampler coalesces the requests, holds back the triggered samples and reports staleness
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceCpuSamplerTest, StatsServiceCpuSamplerTest_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceCpuSamplerTest_001 start");
+    CpuTimeSampler::Config config;
+    config.intervalMs = 60 * 1000;
+    config.minIntervalMs = 300;
+    config.queryMaxAgeMs = 200;
+    config.waitTimeoutMs = 2000;
+    CpuTimeSampler sampler(config);
+    EXPECT_EQ(StatsUtils::INVALID_VALUE, sampler.GetStalenessMs());
+    EXPECT_FALSE(sampler.WaitForSample(CpuTimeSampler::TRIGGER_QUERY, config.waitTimeoutMs));
+    std::atomic<int32_t> handled {0};
+    ASSERT_TRUE(sampler.Start([&handled] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        handled++;
+    }));
+
+    // Nothing has been sampled yet, so the first sample is taken at once
+    for (int32_t i = 0; i < 100 && sampler.GetSampleCount() == 0; i++) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_EQ(1, handled.load());
+
+    const int32_t waiterCount = 8;
+    std::atomic<int32_t> sampledWaiters {0};
+    std::vector<std::thread> waiters;
+    for (int32_t i = 0; i < waiterCount; i++) {
+        waiters.emplace_back([&sampler, &sampledWaiters, &config] {
+            if (sampler.WaitForSample(CpuTimeSampler::TRIGGER_POWER_SUPPLY, config.waitTimeoutMs)) {
+                sampledWaiters++;
+            }
+        });
+    }
+    for (auto& waiter : waiters) {
+        waiter.join();
+    }
+    EXPECT_EQ(waiterCount, sampledWaiters.load());
+    EXPECT_LE(handled.load(), 3);
+    int32_t sampled = handled.load();
+    EXPECT_TRUE(sampler.SampleIfStale());
+    EXPECT_EQ(sampled, handled.load());
+    EXPECT_LT(sampler.GetStalenessMs(), config.queryMaxAgeMs);
+
+    uint64_t coalesced = sampler.GetCoalescedCount();
+    for (int32_t i = 0; i < 10; i++) {
+        sampler.RequestSample(CpuTimeSampler::TRIGGER_SCREEN_OFF);
+    }
+    EXPECT_EQ(coalesced + 9, sampler.GetCoalescedCount());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(sampled, handled.load());
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    EXPECT_EQ(sampled + 1, handled.load());
+
+    std::string result;
+    sampler.DumpInfo(result);
+    EXPECT_NE(result.find("Cpu time sampler: samples = "), std::string::npos);
+    EXPECT_NE(result.find("screen off = 1"), std::string::npos);
+    sampler.Stop();
+    EXPECT_FALSE(sampler.IsRunning());
+    sampler.RequestSample(CpuTimeSampler::TRIGGER_SCREEN_OFF);
+    EXPECT_FALSE(sampler.WaitForSample(CpuTimeSampler::TRIGGER_QUERY, config.waitTimeoutMs));
+    EXPECT_EQ(sampled + 1, handled.load());
+    STATS_HILOGI(LABEL_TEST, "StatsServiceCpuSamplerTest_001 end");
+}
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_service_event_log_test.h"
+#include "stats_log.h"
+
+#include "battery_stats_core.h"
+#include "battery_stats_event_log.h"
+
+using namespace OHOS;
+using namespace OHOS::PowerMgr;
+using namespace std;
+using namespace testing::ext;
+
+namespace {
+/**
+ * @tc.name: StatsServiceEventLogTest_001
+ * @tc.desc: test the debug event log keeps the latest records and truncates long text
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceEventLogTest, StatsServiceEventLogTest_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceEventLogTest_001 start");
+    BatteryStatsEventLog log(4);
+    StatsUtils::StatsData data;
+    data.type = StatsUtils::STATS_TYPE_CAMERA_ON;
+    EXPECT_FALSE(log.Append(data, 1));
+    EXPECT_EQ(0, static_cast<int32_t>(log.GetSize()));
+
+    data.type = StatsUtils::STATS_TYPE_WAKELOCK_HOLD;
+    data.uid = 10022;
+    data.eventDataName = "wl_log";
+    data.eventDebugInfo = "tag";
+    for (int64_t i = 0; i < 6; i++) {
+        EXPECT_TRUE(log.Append(data, 100 + i));
+    }
+    EXPECT_EQ(4, static_cast<int32_t>(log.GetSize()));
+    EXPECT_EQ(2, static_cast<int32_t>(log.GetDroppedCount()));
+    std::string dump;
+    log.DumpInfo(dump);
+    EXPECT_EQ(std::string::npos, dump.find("= 101ms"));
+    size_t oldest = dump.find("= 102ms");
+    size_t newest = dump.find("= 105ms");
+    EXPECT_NE(std::string::npos, oldest);
+    EXPECT_NE(std::string::npos, newest);
+    EXPECT_LT(oldest, newest);
+    EXPECT_NE(std::string::npos, dump.find("wakelock name = wl_log"));
+
+    log.AppendText(std::string(BatteryStatsEventLog::TEXT_SIZE * 2, 'x'), 200);
+    EXPECT_EQ(1, static_cast<int32_t>(log.GetTruncatedCount()));
+    dump.clear();
+    log.DumpInfo(dump);
+    EXPECT_NE(std::string::npos, dump.find(std::string(BatteryStatsEventLog::TEXT_SIZE, 'x')));
+    EXPECT_EQ(std::string::npos, dump.find(std::string(BatteryStatsEventLog::TEXT_SIZE + 1, 'x')));
+
+    log.Clear();
+    dump.clear();
+    log.DumpInfo(dump);
+    EXPECT_TRUE(dump.empty());
+
+    log.SetCapacity(2);
+    for (int64_t i = 0; i < 3; i++) {
+        EXPECT_TRUE(log.Append(data, 300 + i));
+    }
+    EXPECT_EQ(2, static_cast<int32_t>(log.GetCapacity()));
+    EXPECT_EQ(2, static_cast<int32_t>(log.GetSize()));
+    EXPECT_EQ(1, static_cast<int32_t>(log.GetDroppedCount()));
+
+    auto core = std::make_shared<BatteryStatsCore>();
+    core->Init(nullptr, 2);
+    for (int64_t i = 0; i < 3; i++) {
+        core->UpdateDebugInfo(data);
+    }
+    dump.clear();
+    core->GetDebugInfo(dump);
+    size_t count = 0;
+    for (size_t pos = dump.find("wl_log"); pos != std::string::npos; pos = dump.find("wl_log", pos + 1)) {
+        count++;
+    }
+    EXPECT_EQ(2, static_cast<int32_t>(count));
+    STATS_HILOGI(LABEL_TEST, "StatsServiceEventLogTest_001 end");
+}
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_service_event_queue_test.h"
+#include "stats_log.h"
+
+#include "battery_stats_event_queue.h"
+#include "stats_helper.h"
+
+using namespace OHOS;
+using namespace OHOS::PowerMgr;
+using namespace std;
+using namespace testing::ext;
+
+namespace {
+/**
+ * @tc.name: StatsServiceEventQueueTest_001
+ * @tc.desc: test BatteryStatsEventQueue push, drop and flush
+ * @tc.type: FUNC
+ * @tc.require: issueI663DX
+ */
+HWTEST_F (StatsServiceEventQueueTest, StatsServiceEventQueueTest_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceEventQueueTest_001 start");
+    uint32_t capacity = 4;
+    auto eventQueue = std::make_shared<BatteryStatsEventQueue>(capacity);
+    std::atomic<uint32_t> handledCount {0};
+    StatsUtils::StatsData data;
+    data.type = StatsUtils::STATS_TYPE_WAKELOCK_HOLD;
+    data.uid = 10003;
+
+    for (uint32_t i = 0; i < capacity; i++) {
+        EXPECT_TRUE(eventQueue->Push(data));
+    }
+    EXPECT_FALSE(eventQueue->Push(data));
+    EXPECT_EQ(capacity, eventQueue->GetDepth());
+    EXPECT_EQ(1U, eventQueue->GetDropCount());
+    EXPECT_FALSE(eventQueue->Flush());
+
+    EXPECT_FALSE(eventQueue->Start(nullptr));
+    EXPECT_TRUE(eventQueue->Start([&handledCount](const StatsUtils::StatsData&) {
+        handledCount++;
+    }));
+    EXPECT_TRUE(eventQueue->IsRunning());
+    // The ring is still full until the consumer got to it
+    EXPECT_TRUE(eventQueue->Flush());
+    EXPECT_TRUE(eventQueue->Push(data));
+    EXPECT_TRUE(eventQueue->Flush());
+    EXPECT_EQ(capacity + 1, handledCount.load());
+    EXPECT_EQ(capacity + 1, eventQueue->GetAppliedCount());
+    EXPECT_EQ(StatsUtils::DEFAULT_VALUE, eventQueue->GetDepth());
+    EXPECT_GE(eventQueue->GetMaxApplyLatencyUs(), eventQueue->GetAverageApplyLatencyUs());
+
+    std::string result;
+    eventQueue->DumpInfo(result);
+    EXPECT_TRUE(result.find("Stats event queue") != string::npos);
+    eventQueue->Stop();
+    EXPECT_FALSE(eventQueue->IsRunning());
+    STATS_HILOGI(LABEL_TEST, "StatsServiceEventQueueTest_001 end");
+}
+
+/**
+ * @tc.name: StatsServiceEventQueueTest_002
+ * @tc.desc: test the queued events are applied at the time they were pushed and drained on stop
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceEventQueueTest, StatsServiceEventQueueTest_002, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceEventQueueTest_002 start");
+    const int64_t stepMs = 1000;
+    // Static, the threads of the service read the clock as well
+    static FakeStatsClock clock(stepMs, stepMs);
+    StatsHelper::SetClock(&clock);
+    BatteryStatsEventQueue eventQueue(8);
+    std::vector<int64_t> applyTimes;
+    StatsUtils::StatsData data;
+    data.type = StatsUtils::STATS_TYPE_WAKELOCK_HOLD;
+    data.uid = 10003;
+
+    // The events wait in the queue while the clock moves on, they still see the time they were pushed at
+    EXPECT_TRUE(eventQueue.Push(data));
+    clock.AdvanceMs(stepMs);
+    EXPECT_TRUE(eventQueue.Push(data));
+    clock.AdvanceMs(stepMs);
+    EXPECT_TRUE(eventQueue.Start([&applyTimes](const StatsUtils::StatsData&) {
+        applyTimes.push_back(StatsHelper::GetBootTimeMs());
+    }));
+    EXPECT_TRUE(eventQueue.Flush());
+    EXPECT_EQ(std::vector<int64_t>({ stepMs, stepMs * 2 }), applyTimes);
+
+    // Stopping applies what was pushed before
+    const uint64_t pushCount = 4;
+    for (uint64_t i = 0; i < pushCount; i++) {
+        EXPECT_TRUE(eventQueue.Push(data));
+    }
+    eventQueue.Stop();
+    EXPECT_EQ(pushCount + 2, eventQueue.GetAppliedCount());
+    EXPECT_EQ(pushCount + 2, applyTimes.size());
+    StatsHelper::SetClock(nullptr);
+    STATS_HILOGI(LABEL_TEST, "StatsServiceEventQueueTest_002 end");
+}
+}
@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_service_history_test.h"
+#include "stats_log.h"
+
+#include "battery_stats_history.h"
+#include "battery_stats_result.h"
+#include "stats_utils.h"
+
+using namespace OHOS;
+using namespace OHOS::PowerMgr;
+using namespace std;
+using namespace testing::ext;
+
+namespace {
+std::shared_ptr<BatteryStatsInfo> MakeStatsInfo(BatteryStatsInfo::ConsumptionType type, int32_t uid, double power)
+{
+    auto info = std::make_shared<BatteryStatsInfo>();
+    info->SetConsumptioType(type);
+    info->SetUid(uid);
+    info->SetPower(power);
+    return info;
+}
+
+BatteryStatsResult MakeHistoryResult(double appAMah, double appBMah, double screenMah)
+{
+    BatteryStatsInfoList list;
+    list.push_back(MakeStatsInfo(BatteryStatsInfo::CONSUMPTION_TYPE_APP, 10023, appAMah));
+    list.push_back(MakeStatsInfo(BatteryStatsInfo::CONSUMPTION_TYPE_APP, 10024, appBMah));
+    list.push_back(MakeStatsInfo(BatteryStatsInfo::CONSUMPTION_TYPE_SCREEN, StatsUtils::INVALID_VALUE, screenMah));
+    return BatteryStatsResult(0, 0, list, appAMah + appBMah + screenMah);
+}
+/**
+ * @tc.name: StatsServiceHistoryTest_001
+ * @tc.desc: test the history buckets, the tier choice and the uid column cap
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceHistoryTest, StatsServiceHistoryTest_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceHistoryTest_001 start");
+    BatteryStatsHistory::Config config;
+    config.fine = {1000, 4};
+    config.coarse = {10000, 4};
+    config.maxUids = 1;
+    BatteryStatsHistory history(config);
+    int64_t baseMs = 100000;
+    // The first result is the baseline
+    history.Record(baseMs, MakeHistoryResult(5.0, 0.0, 10.0));
+    EXPECT_FALSE(history.IsRecordDue(baseMs + 500));
+    EXPECT_TRUE(history.IsRecordDue(baseMs + 1000));
+    history.Record(baseMs + 500, MakeHistoryResult(6.0, 0.0, 11.0));
+    history.Record(baseMs + 2500, MakeHistoryResult(9.0, 0.0, 13.0));
+
+    BatteryStatsHistoryInfo info;
+    EXPECT_FALSE(history.Query(baseMs, baseMs, info));
+    ASSERT_TRUE(history.Query(baseMs, baseMs + 3000, info));
+    EXPECT_EQ(1000, info.bucketSpanMs);
+    ASSERT_EQ(3, static_cast<int32_t>(info.bucketStartMs.size()));
+    EXPECT_EQ(baseMs, info.bucketStartMs[0]);
+    EXPECT_DOUBLE_EQ(2.0, info.totalPowerMah[0]);
+    EXPECT_DOUBLE_EQ(0.0, info.totalPowerMah[1]);
+    EXPECT_DOUBLE_EQ(5.0, info.totalPowerMah[2]);
+    ASSERT_EQ(1, static_cast<int32_t>(info.uids.size()));
+    EXPECT_EQ(10023, info.uids[0]);
+    EXPECT_DOUBLE_EQ(4.0, info.appPowerMah[0]);
+    ASSERT_EQ(1, static_cast<int32_t>(info.consumptionTypes.size()));
+    EXPECT_EQ(BatteryStatsInfo::CONSUMPTION_TYPE_SCREEN, info.consumptionTypes[0]);
+    EXPECT_DOUBLE_EQ(3.0, info.partPowerMah[0]);
+
+    // Beyond the fine ring the coarse buckets answer, the second uid only fits in the "other" column
+    history.Record(baseMs + 6000, MakeHistoryResult(9.0, 2.0, 13.0));
+    ASSERT_TRUE(history.Query(baseMs, baseMs + 7000, info));
+    EXPECT_EQ(10000, info.bucketSpanMs);
+    ASSERT_EQ(1, static_cast<int32_t>(info.bucketStartMs.size()));
+    EXPECT_DOUBLE_EQ(9.0, info.totalPowerMah[0]);
+    ASSERT_EQ(2, static_cast<int32_t>(info.uids.size()));
+    EXPECT_EQ(10023, info.uids[0]);
+    EXPECT_EQ(StatsUtils::INVALID_VALUE, info.uids[1]);
+    EXPECT_DOUBLE_EQ(2.0, info.appPowerMah[1]);
+
+    // After a reset the totals restart from zero
+    history.Rebase();
+    history.Record(baseMs + 6500, MakeHistoryResult(1.0, 0.0, 0.0));
+    ASSERT_TRUE(history.Query(baseMs + 6000, baseMs + 7000, info));
+    EXPECT_EQ(1000, info.bucketSpanMs);
+    ASSERT_EQ(1, static_cast<int32_t>(info.totalPowerMah.size()));
+    EXPECT_DOUBLE_EQ(3.0, info.totalPowerMah[0]);
+    std::string dump;
+    history.DumpInfo(dump);
+    EXPECT_NE(std::string::npos, dump.find("overflow = 1"));
+
+    history.Clear();
+    ASSERT_TRUE(history.Query(baseMs, baseMs + 7000, info));
+    EXPECT_TRUE(info.bucketStartMs.empty());
+    STATS_HILOGI(LABEL_TEST, "StatsServiceHistoryTest_001 end");
+}
+}
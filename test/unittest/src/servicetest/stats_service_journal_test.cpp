@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_service_journal_test.h"
+#include "stats_log.h"
+
+#include <fcntl.h>
+#include <thread>
+#include <unistd.h>
+
+#include "battery_stats_core.h"
+#include "battery_stats_journal.h"
+#include "battery_stats_service.h"
+
+using namespace OHOS;
+using namespace OHOS::PowerMgr;
+using namespace std;
+using namespace testing::ext;
+
+namespace {
+static sptr<BatteryStatsService> g_statsService = nullptr;
+} // namespace
+
+void StatsServiceJournalTest::SetUpTestCase()
+{
+    g_statsService = BatteryStatsService::GetInstance();
+    g_statsService->OnStart();
+}
+
+void StatsServiceJournalTest::TearDownTestCase()
+{
+    g_statsService->OnStop();
+}
+
+void StatsServiceJournalTest::SetUp()
+{
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    statsCore->Reset();
+}
+
+void StatsServiceJournalTest::TearDown()
+{
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    statsCore->Reset();
+}
+
+namespace {
+/**
+ * @tc.name: StatsServiceJournalTest_001
+ * @tc.desc: test the journal replays the timers stopped after the last snapshot
+ * @tc.type: FUNC
+ * @tc.require: issueI663DX
+ */
+HWTEST_F (StatsServiceJournalTest, StatsServiceJournalTest_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceJournalTest_001 start");
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    statsCore->Reset();
+    int32_t uid = 10003;
+
+    statsCore->UpdateStats(StatsUtils::STATS_TYPE_WAKELOCK_HOLD, StatsUtils::STATS_STATE_ACTIVATED,
+        StatsUtils::INVALID_VALUE, uid);
+    usleep(SERVICE_POWER_CONSUMPTION_DURATION_US);
+    statsCore->UpdateStats(StatsUtils::STATS_TYPE_WAKELOCK_HOLD, StatsUtils::STATS_STATE_DEACTIVATED,
+        StatsUtils::INVALID_VALUE, uid);
+    int64_t wakelockTimeMs = statsCore->GetTotalTimeMs(uid, StatsUtils::STATS_TYPE_WAKELOCK_HOLD);
+    EXPECT_GT(wakelockTimeMs, StatsUtils::DEFAULT_VALUE);
+
+    // Stopping flushes the pending records, clearing the memory afterwards simulates a crash
+    statsCore->StopJournal();
+    statsCore->Reset();
+    EXPECT_TRUE(statsCore->LoadBatteryStatsData());
+    EXPECT_EQ(wakelockTimeMs, statsCore->GetTotalTimeMs(uid, StatsUtils::STATS_TYPE_WAKELOCK_HOLD));
+    // Records hold absolute totals, replaying them again changes nothing
+    EXPECT_TRUE(statsCore->LoadBatteryStatsData());
+    EXPECT_EQ(wakelockTimeMs, statsCore->GetTotalTimeMs(uid, StatsUtils::STATS_TYPE_WAKELOCK_HOLD));
+
+    // A reset racing the updates is journaled in their order, the replay ends at the totals in memory
+    EXPECT_TRUE(statsCore->StartJournal());
+    std::thread updater([statsCore, uid] {
+        for (int32_t i = 0; i < 200; i++) {
+            statsCore->UpdateStats(StatsUtils::STATS_TYPE_WAKELOCK_HOLD, StatsUtils::STATS_STATE_ACTIVATED,
+                StatsUtils::INVALID_VALUE, uid);
+            statsCore->UpdateStats(StatsUtils::STATS_TYPE_WAKELOCK_HOLD, StatsUtils::STATS_STATE_DEACTIVATED,
+                StatsUtils::INVALID_VALUE, uid);
+        }
+    });
+    statsCore->Reset();
+    updater.join();
+    wakelockTimeMs = statsCore->GetTotalTimeMs(uid, StatsUtils::STATS_TYPE_WAKELOCK_HOLD);
+    statsCore->StopJournal();
+    statsCore->Reset();
+    EXPECT_TRUE(statsCore->LoadBatteryStatsData());
+    EXPECT_EQ(wakelockTimeMs, statsCore->GetTotalTimeMs(uid, StatsUtils::STATS_TYPE_WAKELOCK_HOLD));
+
+    EXPECT_TRUE(statsCore->StartJournal());
+    statsCore->Reset();
+    STATS_HILOGI(LABEL_TEST, "StatsServiceJournalTest_001 end");
+}
+
+/**
+ * @tc.name: StatsServiceJournalTest_002
+ * @tc.desc: test the journal drops a torn frame, honors the reset record and is truncated by compaction
+ * @tc.type: FUNC
+ * @tc.require: issueI663DX
+ */
+HWTEST_F (StatsServiceJournalTest, StatsServiceJournalTest_002, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceJournalTest_002 start");
+    const std::string path = "/data/local/tmp/battery_stats_test.journal";
+    int32_t uid = 10003;
+    unlink(path.c_str());
+    BatteryStatsJournal::Config config;
+    config.flushIntervalMs = 60000;
+    BatteryStatsJournal journal(path, config);
+    uint32_t compactCount = 0;
+    auto compactHandler = [&compactCount](size_t& snapshotBytes) {
+        snapshotBytes = 100;
+        compactCount++;
+        return true;
+    };
+    EXPECT_TRUE(journal.Start(compactHandler));
+    journal.AppendTimer(StatsUtils::STATS_TYPE_WAKELOCK_HOLD, StatsUtils::INVALID_VALUE, uid, 100);
+    journal.AppendCounter(StatsUtils::STATS_TYPE_ALARM, uid, 3);
+    EXPECT_TRUE(journal.Flush());
+    journal.AppendTimer(StatsUtils::STATS_TYPE_WAKELOCK_HOLD, StatsUtils::INVALID_VALUE, uid, 200);
+    journal.Stop();
+
+    std::vector<BatteryStatsJournal::Record> records;
+    bool hasReset = true;
+    EXPECT_TRUE(BatteryStatsJournal::Replay(path, records, hasReset));
+    EXPECT_FALSE(hasReset);
+    ASSERT_EQ(3u, records.size());
+    EXPECT_EQ(BatteryStatsJournal::RECORD_COUNTER, records[1].type);
+    EXPECT_EQ(uid, records[2].uid);
+    EXPECT_EQ(200, records[2].value);
+
+    // A frame torn by a crash is dropped on replay and cut before new frames are appended
+    const char tornFrame[] = { 0x10, 0x00, 0x00, 0x00, 0x01, 0x02 };
+    int32_t fd = open(path.c_str(), O_WRONLY | O_APPEND);
+    ASSERT_GE(fd, 0);
+    EXPECT_EQ(static_cast<ssize_t>(sizeof(tornFrame)), write(fd, tornFrame, sizeof(tornFrame)));
+    close(fd);
+    EXPECT_TRUE(BatteryStatsJournal::Replay(path, records, hasReset));
+    EXPECT_EQ(3u, records.size());
+    EXPECT_TRUE(journal.Start(compactHandler));
+    EXPECT_TRUE(journal.AppendReset());
+    journal.AppendCounter(StatsUtils::STATS_TYPE_ALARM, uid, 1);
+    EXPECT_TRUE(journal.Flush());
+    EXPECT_TRUE(BatteryStatsJournal::Replay(path, records, hasReset));
+    EXPECT_TRUE(hasReset);
+    ASSERT_EQ(1u, records.size());
+    EXPECT_EQ(1, records[0].value);
+
+    EXPECT_TRUE(journal.Compact());
+    EXPECT_EQ(1u, compactCount);
+    EXPECT_TRUE(BatteryStatsJournal::Replay(path, records, hasReset));
+    EXPECT_FALSE(hasReset);
+    EXPECT_TRUE(records.empty());
+    EXPECT_GT(journal.GetWriteAmplification(), 1.0);
+    std::string result;
+    journal.DumpInfo(result);
+    EXPECT_TRUE(result.find("write amplification") != std::string::npos);
+    journal.Stop();
+    unlink(path.c_str());
+    STATS_HILOGI(LABEL_TEST, "StatsServiceJournalTest_002 end");
+}
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_service_notifier_test.h"
+#include "stats_log.h"
+
+#include <chrono>
+
+#include "battery_stats_callback_stub.h"
+#include "battery_stats_notifier.h"
+#include "battery_stats_result.h"
+#include "stats_utils.h"
+
+using namespace OHOS;
+using namespace OHOS::PowerMgr;
+using namespace std;
+using namespace testing::ext;
+
+namespace {
+std::shared_ptr<BatteryStatsInfo> MakeStatsInfo(BatteryStatsInfo::ConsumptionType type, int32_t uid, double power)
+{
+    auto info = std::make_shared<BatteryStatsInfo>();
+    info->SetConsumptioType(type);
+    info->SetUid(uid);
+    info->SetPower(power);
+    return info;
+}
+
+BatteryStatsResult MakeHistoryResult(double appAMah, double appBMah, double screenMah)
+{
+    BatteryStatsInfoList list;
+    list.push_back(MakeStatsInfo(BatteryStatsInfo::CONSUMPTION_TYPE_APP, 10023, appAMah));
+    list.push_back(MakeStatsInfo(BatteryStatsInfo::CONSUMPTION_TYPE_APP, 10024, appBMah));
+    list.push_back(MakeStatsInfo(BatteryStatsInfo::CONSUMPTION_TYPE_SCREEN, StatsUtils::INVALID_VALUE, screenMah));
+    return BatteryStatsResult(0, 0, list, appAMah + appBMah + screenMah);
+}
+class TestStatsCallback : public BatteryStatsCallbackStub {
+public:
+    ErrCode OnStatsChanged(const std::vector<int32_t>& uids, const std::vector<double>& appStatsMah,
+        double totalPowerMah) override
+    {
+        callCount++;
+        lastUids = uids;
+        lastAppStatsMah = appStatsMah;
+        lastTotalPowerMah = totalPowerMah;
+        return ERR_OK;
+    }
+
+    int32_t callCount = 0;
+    std::vector<int32_t> lastUids;
+    std::vector<double> lastAppStatsMah;
+    double lastTotalPowerMah = 0.0;
+};
+} // namespace
+
+namespace {
+/**
+ * @tc.name: StatsServiceNotifierTest_001
+ * @tc.desc: test the stats notifier interval, threshold and unsubscribe
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceNotifierTest, StatsServiceNotifierTest_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceNotifierTest_001 start");
+    BatteryStatsNotifier::Config config;
+    config.minIntervalMs = 100;
+    config.maxSubscribers = 1;
+    BatteryStatsNotifier notifier(config);
+    sptr<TestStatsCallback> callback = new TestStatsCallback();
+    EXPECT_FALSE(notifier.Subscribe(nullptr, 1000, 0.5));
+    EXPECT_FALSE(notifier.Subscribe(callback, -1, 0.5));
+    ASSERT_TRUE(notifier.Subscribe(callback, 1000, 0.5));
+    EXPECT_FALSE(notifier.Subscribe(new TestStatsCallback(), 1000, 0.5));
+    EXPECT_EQ(1, static_cast<int32_t>(notifier.GetSubscriberCount()));
+
+    // The first push carries every app
+    int64_t nowMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count() + 10;
+    EXPECT_EQ(1, static_cast<int32_t>(notifier.NotifyDue(nowMs, MakeHistoryResult(5.0, 0.0, 10.0))));
+    EXPECT_EQ(2, static_cast<int32_t>(callback->lastUids.size()));
+    EXPECT_DOUBLE_EQ(15.0, callback->lastTotalPowerMah);
+
+    // Not due yet, then due but below the threshold
+    EXPECT_EQ(0, static_cast<int32_t>(notifier.NotifyDue(nowMs + 500, MakeHistoryResult(6.0, 0.0, 10.0))));
+    EXPECT_EQ(0, static_cast<int32_t>(notifier.NotifyDue(nowMs + 1000, MakeHistoryResult(5.2, 0.0, 10.0))));
+    EXPECT_EQ(1, callback->callCount);
+
+    // Only the app which moved by the threshold is sent
+    EXPECT_EQ(1, static_cast<int32_t>(notifier.NotifyDue(nowMs + 2000, MakeHistoryResult(6.0, 0.0, 10.0))));
+    ASSERT_EQ(1, static_cast<int32_t>(callback->lastUids.size()));
+    EXPECT_EQ(10023, callback->lastUids[0]);
+    EXPECT_DOUBLE_EQ(6.0, callback->lastAppStatsMah[0]);
+    EXPECT_DOUBLE_EQ(16.0, callback->lastTotalPowerMah);
+    EXPECT_EQ(2, static_cast<int32_t>(notifier.GetPushCount()));
+
+    EXPECT_TRUE(notifier.Unsubscribe(callback));
+    EXPECT_FALSE(notifier.Unsubscribe(callback));
+    EXPECT_EQ(0, static_cast<int32_t>(notifier.NotifyDue(nowMs + 5000, MakeHistoryResult(9.0, 0.0, 10.0))));
+    EXPECT_EQ(2, callback->callCount);
+    STATS_HILOGI(LABEL_TEST, "StatsServiceNotifierTest_001 end");
+}
+}
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_service_parser_test.h"
+#include "stats_log.h"
+
+#include "battery_stats_parser.h"
+
+using namespace OHOS;
+using namespace OHOS::PowerMgr;
+using namespace std;
+using namespace testing::ext;
+
+namespace {
+/**
+ * @tc.name: StatsServiceParserTest_001
+ * @tc.desc: test the PowerProfile compiled by BatteryStatsParser matches the average power lookups
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceParserTest, StatsServiceParserTest_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceParserTest_001 start");
+    auto parser = std::make_shared<BatteryStatsParser>();
+    EXPECT_EQ(0, static_cast<int32_t>(parser->GetPowerProfile()->clusterMa.size()));
+    EXPECT_DOUBLE_EQ(0.0, parser->GetPowerProfile()->averageMa[PowerProfile::ITEM_WIFI_ON]);
+    ASSERT_TRUE(parser->Init());
+    auto profile = parser->GetPowerProfile();
+    ASSERT_NE(nullptr, profile);
+    EXPECT_DOUBLE_EQ(parser->GetAveragePowerMa(StatsUtils::CURRENT_WIFI_ON),
+        profile->averageMa[PowerProfile::ITEM_WIFI_ON]);
+    EXPECT_DOUBLE_EQ(parser->GetAveragePowerMa(StatsUtils::CURRENT_CPU_SUSPEND),
+        profile->averageMa[PowerProfile::ITEM_CPU_SUSPEND]);
+    EXPECT_DOUBLE_EQ(parser->GetAveragePowerMa(StatsUtils::CURRENT_ALARM_ON),
+        profile->averageMa[PowerProfile::ITEM_ALARM_ON]);
+    double brightnessMa = parser->GetAveragePowerMa(StatsUtils::CURRENT_SCREEN_BRIGHTNESS);
+    EXPECT_DOUBLE_EQ(0.0, profile->brightnessMa[0]);
+    EXPECT_DOUBLE_EQ(brightnessMa * StatsUtils::SCREEN_BRIGHTNESS_BIN,
+        profile->brightnessMa[StatsUtils::SCREEN_BRIGHTNESS_BIN]);
+    for (uint16_t i = 0; i < StatsUtils::RADIO_SIGNAL_BIN; i++) {
+        EXPECT_DOUBLE_EQ(parser->GetAveragePowerMa(StatsUtils::CURRENT_RADIO_ON, i), profile->radioOnMa[i]);
+        EXPECT_DOUBLE_EQ(parser->GetAveragePowerMa(StatsUtils::CURRENT_RADIO_DATA, i), profile->radioDataMa[i]);
+    }
+    uint16_t clusterNum = parser->GetClusterNum();
+    ASSERT_EQ(clusterNum, static_cast<uint16_t>(profile->clusterMa.size()));
+    ASSERT_EQ(clusterNum + 1, static_cast<int32_t>(profile->speedOffsets.size()));
+    for (uint16_t i = 0; i < clusterNum; i++) {
+        EXPECT_DOUBLE_EQ(parser->GetAveragePowerMa(StatsUtils::CURRENT_CPU_CLUSTER, i), profile->clusterMa[i]);
+        std::string speedType = StatsUtils::CURRENT_CPU_SPEED + std::to_string(i);
+        size_t begin = profile->speedOffsets[i];
+        ASSERT_EQ(parser->GetSpeedNum(i), static_cast<uint16_t>(profile->speedOffsets[i + 1] - begin));
+        for (uint16_t j = 0; j < parser->GetSpeedNum(i); j++) {
+            EXPECT_DOUBLE_EQ(parser->GetAveragePowerMa(speedType, j), profile->speedMa[begin + j]);
+        }
+    }
+    STATS_HILOGI(LABEL_TEST, "StatsServiceParserTest_001 end");
+}
+}
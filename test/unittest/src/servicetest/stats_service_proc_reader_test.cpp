@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_service_proc_reader_test.h"
+#include "stats_log.h"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+
+#include "proc_file_reader.h"
+#include "stats_utils.h"
+
+using namespace OHOS;
+using namespace OHOS::PowerMgr;
+using namespace std;
+using namespace testing::ext;
+
+namespace {
+/**
+ * @tc.name: StatsServiceProcReaderTest_001
+ * @tc.desc: test ProcFileReader against line and string splitting on a uid_time_in_state sized file
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceProcReaderTest, StatsServiceProcReaderTest_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceProcReaderTest_001 start");
+    const std::string path = "/data/local/tmp/battery_stats_test_uid_time_in_state";
+    const int32_t uidCount = 800;
+    const int32_t freqCount = 60;
+    {
+        std::ofstream output(path, std::ios::trunc);
+        ASSERT_TRUE(output.is_open());
+        output << "uid:";
+        for (int32_t i = 0; i < freqCount; i++) {
+            output << " " << (300000 + i * 100000);
+        }
+        output << "\n";
+        for (int32_t uid = 0; uid < uidCount; uid++) {
+            output << (10000 + uid) << ":";
+            for (int32_t i = 0; i < freqCount; i++) {
+                output << " " << ((uid * freqCount + i) * 7919 % 10000000);
+            }
+            output << "\n";
+        }
+    }
+
+    auto startTime = std::chrono::steady_clock::now();
+    int64_t expectedSum = 0;
+    std::ifstream input(path);
+    std::string line;
+    while (getline(input, line)) {
+        size_t colon = line.find(':');
+        if (colon == std::string::npos || line.substr(0, colon) == "uid") {
+            continue;
+        }
+        std::istringstream times(line.substr(colon + 1));
+        std::string token;
+        while (times >> token) {
+            int64_t value = 0;
+            if (StatsUtils::ParseStrtollResult(token, value)) {
+                expectedSum += value;
+            }
+        }
+    }
+    auto streamTime = std::chrono::steady_clock::now() - startTime;
+
+    ProcFileReader reader;
+    size_t capacity = 0;
+    for (int32_t round = 0; round < 2; round++) {
+        startTime = std::chrono::steady_clock::now();
+        ASSERT_TRUE(reader.Read(path));
+        int64_t sum = 0;
+        int32_t lines = 0;
+        std::string_view procLine;
+        while (reader.NextLine(procLine)) {
+            std::string_view uidField;
+            std::string_view token;
+            ASSERT_TRUE(ProcFileReader::NextToken(procLine, ':', uidField));
+            if (uidField == "uid") {
+                continue;
+            }
+            lines++;
+            while (ProcFileReader::NextToken(procLine, ' ', token)) {
+                int64_t value = 0;
+                if (ProcFileReader::ParseInt64(token, value)) {
+                    sum += value;
+                }
+            }
+        }
+        auto readerTime = std::chrono::steady_clock::now() - startTime;
+        GTEST_LOG_(INFO) << __func__ << ": stream parse = " <<
+            std::chrono::duration_cast<std::chrono::microseconds>(streamTime).count() << "us, reader parse = " <<
+            std::chrono::duration_cast<std::chrono::microseconds>(readerTime).count() << "us";
+        EXPECT_EQ(uidCount, lines);
+        EXPECT_EQ(expectedSum, sum);
+        if (round > 0) {
+            EXPECT_EQ(capacity, reader.GetCapacity());
+        }
+        capacity = reader.GetCapacity();
+    }
+
+    int64_t value = 0;
+    EXPECT_TRUE(ProcFileReader::ParseInt64(" +42", value));
+    EXPECT_EQ(42, value);
+    EXPECT_TRUE(ProcFileReader::ParseInt64("-7ms", value));
+    EXPECT_EQ(-7, value);
+    EXPECT_FALSE(ProcFileReader::ParseInt64("cpus", value));
+    EXPECT_FALSE(ProcFileReader::ParseInt64("99999999999999999999", value));
+    EXPECT_FALSE(reader.Read("/data/local/tmp/battery_stats_test_not_exist"));
+    unlink(path.c_str());
+    STATS_HILOGI(LABEL_TEST, "StatsServiceProcReaderTest_001 end");
+}
+}
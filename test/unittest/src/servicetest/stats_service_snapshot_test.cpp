@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_service_snapshot_test.h"
+#include "stats_log.h"
+
+#include <unistd.h>
+
+#include "battery_stats_core.h"
+#include "battery_stats_service.h"
+#include "battery_stats_snapshot.h"
+
+using namespace OHOS;
+using namespace OHOS::PowerMgr;
+using namespace std;
+using namespace testing::ext;
+
+namespace {
+static sptr<BatteryStatsService> g_statsService = nullptr;
+} // namespace
+
+void StatsServiceSnapshotTest::SetUpTestCase()
+{
+    g_statsService = BatteryStatsService::GetInstance();
+    g_statsService->OnStart();
+}
+
+void StatsServiceSnapshotTest::TearDownTestCase()
+{
+    g_statsService->OnStop();
+}
+
+void StatsServiceSnapshotTest::SetUp()
+{
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    statsCore->Reset();
+}
+
+void StatsServiceSnapshotTest::TearDown()
+{
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    statsCore->Reset();
+}
+
+namespace {
+/**
+ * @tc.name: StatsServiceSnapshotTest_001
+ * @tc.desc: test BatteryStatsSnapshot encode, decode and corruption check
+ * @tc.type: FUNC
+ * @tc.require: issueI663DX
+ */
+HWTEST_F (StatsServiceSnapshotTest, StatsServiceSnapshotTest_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceSnapshotTest_001 start");
+    BatteryStatsSnapshot snapshot;
+    snapshot.powers = { { 10003, 1.5 }, { BatteryStatsInfo::CONSUMPTION_TYPE_SCREEN, 20.25 } };
+    snapshot.partValues = { { StatsUtils::STATS_TYPE_SCREEN_BRIGHTNESS, 100, 60000 },
+        { StatsUtils::STATS_TYPE_WIFI_SCAN, StatsUtils::INVALID_VALUE, 3 } };
+    snapshot.uids = { 10003, 10005, 20010036 };
+    snapshot.uidColumns = { { StatsUtils::STATS_TYPE_WAKELOCK_HOLD, { 1000, 0, 3600000 } },
+        { StatsUtils::STATS_TYPE_ALARM, { 0, 2, 0 } } };
+    std::string buffer;
+    ASSERT_TRUE(snapshot.Encode(buffer));
+
+    BatteryStatsSnapshot decoded;
+    auto data = reinterpret_cast<const uint8_t*>(buffer.data());
+    ASSERT_TRUE(decoded.Decode(data, buffer.size()));
+    EXPECT_EQ(snapshot.powers, decoded.powers);
+    ASSERT_EQ(snapshot.partValues.size(), decoded.partValues.size());
+    EXPECT_EQ(StatsUtils::STATS_TYPE_SCREEN_BRIGHTNESS, decoded.partValues[0].statsType);
+    EXPECT_EQ(100, decoded.partValues[0].level);
+    EXPECT_EQ(60000, decoded.partValues[0].value);
+    EXPECT_EQ(StatsUtils::INVALID_VALUE, decoded.partValues[1].level);
+    EXPECT_EQ(snapshot.uids, decoded.uids);
+    ASSERT_EQ(snapshot.uidColumns.size(), decoded.uidColumns.size());
+    EXPECT_EQ(StatsUtils::STATS_TYPE_ALARM, decoded.uidColumns[1].statsType);
+    EXPECT_EQ(snapshot.uidColumns[0].values, decoded.uidColumns[0].values);
+
+    EXPECT_FALSE(decoded.Decode(data, buffer.size() - 1));
+    EXPECT_TRUE(decoded.uids.empty());
+    std::string corrupted = buffer;
+    corrupted.back() ^= 1;
+    EXPECT_FALSE(decoded.Decode(reinterpret_cast<const uint8_t*>(corrupted.data()), corrupted.size()));
+    EXPECT_FALSE(decoded.Decode(nullptr, 0));
+
+    snapshot.uids = { 10005, 10003, 20010036 };
+    EXPECT_FALSE(snapshot.Encode(buffer));
+    STATS_HILOGI(LABEL_TEST, "StatsServiceSnapshotTest_001 end");
+}
+
+/**
+ * @tc.name: StatsServiceSnapshotTest_002
+ * @tc.desc: test the snapshot saved at shutdown restores the timer totals
+ * @tc.type: FUNC
+ * @tc.require: issueI663DX
+ */
+HWTEST_F (StatsServiceSnapshotTest, StatsServiceSnapshotTest_002, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceSnapshotTest_002 start");
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    statsCore->Reset();
+    int32_t uid = 10003;
+
+    statsCore->UpdateStats(StatsUtils::STATS_TYPE_WAKELOCK_HOLD, StatsUtils::STATS_STATE_ACTIVATED,
+        StatsUtils::INVALID_VALUE, uid);
+    statsCore->UpdateStats(StatsUtils::STATS_TYPE_WIFI_ON, StatsUtils::STATS_STATE_ACTIVATED);
+    usleep(SERVICE_POWER_CONSUMPTION_DURATION_US);
+    statsCore->UpdateStats(StatsUtils::STATS_TYPE_WAKELOCK_HOLD, StatsUtils::STATS_STATE_DEACTIVATED,
+        StatsUtils::INVALID_VALUE, uid);
+    statsCore->UpdateStats(StatsUtils::STATS_TYPE_WIFI_ON, StatsUtils::STATS_STATE_DEACTIVATED);
+    int64_t wakelockTimeMs = statsCore->GetTotalTimeMs(uid, StatsUtils::STATS_TYPE_WAKELOCK_HOLD);
+    int64_t wifiOnTimeMs = statsCore->GetTotalTimeMs(StatsUtils::STATS_TYPE_WIFI_ON);
+    EXPECT_GT(wakelockTimeMs, StatsUtils::DEFAULT_VALUE);
+    EXPECT_TRUE(statsCore->SaveBatteryStatsData());
+    double appPower = statsCore->GetAppStatsMah(uid);
+
+    // Clear the memory only, a journaled reset would be replayed over the snapshot
+    statsCore->StopJournal();
+    statsCore->Reset();
+    EXPECT_EQ(StatsUtils::DEFAULT_VALUE, statsCore->GetTotalTimeMs(uid, StatsUtils::STATS_TYPE_WAKELOCK_HOLD));
+    EXPECT_TRUE(statsCore->LoadBatteryStatsData());
+    EXPECT_DOUBLE_EQ(appPower, statsCore->GetAppStatsMah(uid));
+    EXPECT_EQ(wakelockTimeMs, statsCore->GetTotalTimeMs(uid, StatsUtils::STATS_TYPE_WAKELOCK_HOLD));
+    EXPECT_EQ(wifiOnTimeMs, statsCore->GetTotalTimeMs(StatsUtils::STATS_TYPE_WIFI_ON));
+
+    std::string result;
+    EXPECT_TRUE(statsCore->ExportBatteryStatsData(result));
+    EXPECT_TRUE(result.find("Software") != std::string::npos);
+    EXPECT_TRUE(statsCore->StartJournal());
+    statsCore->Reset();
+    STATS_HILOGI(LABEL_TEST, "StatsServiceSnapshotTest_002 end");
+}
+}
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_service_table_test.h"
+#include "stats_log.h"
+
+#include "battery_stats_core.h"
+#include "battery_stats_service.h"
+
+using namespace OHOS;
+using namespace OHOS::PowerMgr;
+using namespace std;
+using namespace testing::ext;
+
+namespace {
+static sptr<BatteryStatsService> g_statsService = nullptr;
+} // namespace
+
+void StatsServiceTableTest::SetUpTestCase()
+{
+    g_statsService = BatteryStatsService::GetInstance();
+    g_statsService->OnStart();
+}
+
+void StatsServiceTableTest::TearDownTestCase()
+{
+    g_statsService->OnStop();
+}
+
+void StatsServiceTableTest::SetUp()
+{
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    statsCore->Reset();
+}
+
+void StatsServiceTableTest::TearDown()
+{
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    statsCore->Reset();
+}
+
+namespace {
+/**
+ * @tc.name: StatsServiceTableTest_001
+ * @tc.desc: test the packed stats table round trip and that it holds the entries of GetBatteryStats
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceTableTest, StatsServiceTableTest_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceTableTest_001 start");
+    ParcelableBatteryStatsTable table;
+    table.table_.uids = { 10023, StatsUtils::INVALID_VALUE, StatsUtils::INVALID_VALUE };
+    table.table_.userIds = { StatsUtils::INVALID_VALUE, StatsUtils::INVALID_VALUE, 100 };
+    table.table_.consumptionTypes = { BatteryStatsInfo::CONSUMPTION_TYPE_APP,
+        BatteryStatsInfo::CONSUMPTION_TYPE_SCREEN, BatteryStatsInfo::CONSUMPTION_TYPE_USER };
+    table.table_.powerMah = { 1.5, 20.25, 3.0 };
+    Parcel parcel;
+    ASSERT_TRUE(table.Marshalling(parcel));
+    std::unique_ptr<ParcelableBatteryStatsTable> readTable(ParcelableBatteryStatsTable::Unmarshalling(parcel));
+    ASSERT_NE(nullptr, readTable);
+    EXPECT_EQ(table.table_.uids, readTable->table_.uids);
+    EXPECT_EQ(table.table_.userIds, readTable->table_.userIds);
+    EXPECT_EQ(table.table_.consumptionTypes, readTable->table_.consumptionTypes);
+    EXPECT_EQ(table.table_.powerMah, readTable->table_.powerMah);
+
+    // The columns have to be of the same size
+    table.table_.powerMah.pop_back();
+    Parcel invalidParcel;
+    EXPECT_FALSE(table.Marshalling(invalidParcel));
+    Parcel emptyParcel;
+    ASSERT_TRUE(ParcelableBatteryStatsTable().Marshalling(emptyParcel));
+    readTable.reset(ParcelableBatteryStatsTable::Unmarshalling(emptyParcel));
+    ASSERT_NE(nullptr, readTable);
+    EXPECT_TRUE(readTable->table_.uids.empty());
+
+    // A full device is not cut off by an entry count, only a table beyond the parcel capacity fails
+    const size_t largeSize = 5000;
+    ParcelableBatteryStatsTable largeTable;
+    for (size_t i = 0; i < largeSize; i++) {
+        largeTable.table_.uids.push_back(10000 + static_cast<int32_t>(i));
+        largeTable.table_.userIds.push_back(100);
+        largeTable.table_.consumptionTypes.push_back(BatteryStatsInfo::CONSUMPTION_TYPE_APP);
+        largeTable.table_.powerMah.push_back(static_cast<double>(i));
+    }
+    Parcel largeParcel;
+    ASSERT_TRUE(largeTable.Marshalling(largeParcel));
+    readTable.reset(ParcelableBatteryStatsTable::Unmarshalling(largeParcel));
+    ASSERT_NE(nullptr, readTable);
+    EXPECT_EQ(largeTable.table_.uids, readTable->table_.uids);
+    EXPECT_EQ(largeTable.table_.powerMah, readTable->table_.powerMah);
+    size_t tooLargeSize = largeParcel.GetMaxCapacity() / (sizeof(int32_t) * 3 + sizeof(double)) + 1;
+    largeTable.table_.uids.resize(tooLargeSize);
+    largeTable.table_.userIds.resize(tooLargeSize);
+    largeTable.table_.consumptionTypes.resize(tooLargeSize);
+    largeTable.table_.powerMah.resize(tooLargeSize);
+    Parcel tooLargeParcel;
+    EXPECT_FALSE(largeTable.Marshalling(tooLargeParcel));
+
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    int32_t uid = 10023;
+    statsCore->UpdateStats(StatsUtils::STATS_TYPE_AUDIO_ON, StatsUtils::STATS_STATE_ACTIVATED,
+        StatsUtils::INVALID_VALUE, uid);
+    statsCore->UpdateStats(StatsUtils::STATS_TYPE_AUDIO_ON, StatsUtils::STATS_STATE_DEACTIVATED,
+        StatsUtils::INVALID_VALUE, uid);
+    auto statsInfoList = statsService->GetBatteryStats();
+    BatteryStatsTable statsTable;
+    statsService->GetBatteryStatsTable(statsTable);
+    ASSERT_EQ(statsInfoList.size(), statsTable.uids.size());
+    size_t index = 0;
+    for (const auto& info : statsInfoList) {
+        EXPECT_EQ(info->GetUid(), statsTable.uids[index]);
+        EXPECT_EQ(info->GetUserId(), statsTable.userIds[index]);
+        EXPECT_EQ(info->GetConsumptionType(), statsTable.consumptionTypes[index]);
+        EXPECT_DOUBLE_EQ(info->GetPower(), statsTable.powerMah[index]);
+        index++;
+    }
+    STATS_HILOGI(LABEL_TEST, "StatsServiceTableTest_001 end");
+}
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_service_trace_test.h"
+#include "stats_log.h"
+
+#include <fstream>
+#include <unistd.h>
+
+#include "battery_stats_core.h"
+#include "battery_stats_parser.h"
+#include "battery_stats_replayer.h"
+#include "battery_stats_service.h"
+#include "battery_stats_trace.h"
+
+using namespace OHOS;
+using namespace OHOS::PowerMgr;
+using namespace std;
+using namespace testing::ext;
+
+namespace {
+static sptr<BatteryStatsService> g_statsService = nullptr;
+} // namespace
+
+void StatsServiceTraceTest::SetUpTestCase()
+{
+    g_statsService = BatteryStatsService::GetInstance();
+    g_statsService->OnStart();
+}
+
+void StatsServiceTraceTest::TearDownTestCase()
+{
+    g_statsService->OnStop();
+}
+
+void StatsServiceTraceTest::SetUp()
+{
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    statsCore->Reset();
+}
+
+void StatsServiceTraceTest::TearDown()
+{
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    statsCore->Reset();
+}
+
+namespace {
+/**
+ * @tc.name: StatsServiceTraceTest_001
+ * @tc.desc: test a recorded trace reads back the events and replays to the same timers every time
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceTraceTest, StatsServiceTraceTest_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceTraceTest_001 start");
+    const std::string path = "/data/local/tmp/battery_stats_test_trace";
+    const int32_t uid = 20010029;
+    const int64_t hourMs = 60 * 60 * 1000;
+    // Static, the threads of the service read the clock as well
+    static FakeStatsClock clock(1000, 1000);
+    auto makeData = [uid](StatsUtils::StatsType type, StatsUtils::StatsState state) {
+        StatsUtils::StatsData data;
+        data.type = type;
+        data.state = state;
+        data.uid = uid;
+        data.pid = 3712;
+        data.eventDataName = "TraceLock";
+        return data;
+    };
+    bool isOnBattery = StatsHelper::IsOnBattery();
+    StatsHelper::SetOnBattery(true);
+    StatsHelper::SetClock(&clock);
+    BatteryStatsTrace trace(path);
+    trace.RecordEvent(makeData(StatsUtils::STATS_TYPE_AUDIO_ON, StatsUtils::STATS_STATE_ACTIVATED));
+    EXPECT_TRUE(trace.Start());
+    EXPECT_TRUE(trace.IsRecording());
+    trace.RecordEvent(makeData(StatsUtils::STATS_TYPE_AUDIO_ON, StatsUtils::STATS_STATE_ACTIVATED));
+    clock.AdvanceMs(hourMs);
+    trace.RecordEvent(makeData(StatsUtils::STATS_TYPE_AUDIO_ON, StatsUtils::STATS_STATE_DEACTIVATED));
+    trace.RecordEvent(makeData(StatsUtils::STATS_TYPE_WAKELOCK_HOLD, StatsUtils::STATS_STATE_ACTIVATED));
+    clock.AdvanceMs(hourMs / 2);
+    trace.RecordEvent(makeData(StatsUtils::STATS_TYPE_WAKELOCK_HOLD, StatsUtils::STATS_STATE_DEACTIVATED));
+    // Nothing is counted on the charger
+    trace.RecordPowerSupply(false);
+    trace.RecordEvent(makeData(StatsUtils::STATS_TYPE_AUDIO_ON, StatsUtils::STATS_STATE_ACTIVATED));
+    clock.AdvanceMs(hourMs);
+    trace.RecordEvent(makeData(StatsUtils::STATS_TYPE_AUDIO_ON, StatsUtils::STATS_STATE_DEACTIVATED));
+    trace.Stop();
+    StatsHelper::SetClock(nullptr);
+    EXPECT_FALSE(trace.IsRecording());
+
+    // A torn frame at the end is dropped
+    {
+        std::ofstream output(path, std::ios::app | std::ios::binary);
+        output << "torn";
+    }
+    std::vector<BatteryStatsTrace::Record> records;
+    EXPECT_TRUE(BatteryStatsTrace::Read(path, records));
+    ASSERT_EQ(8u, records.size());
+    EXPECT_EQ(BatteryStatsTrace::RECORD_POWER_SUPPLY, records[0].type);
+    EXPECT_TRUE(records[0].isOnBattery);
+    EXPECT_EQ(BatteryStatsTrace::RECORD_EVENT, records[1].type);
+    EXPECT_EQ(StatsUtils::STATS_TYPE_AUDIO_ON, records[1].data.type);
+    EXPECT_EQ(StatsUtils::STATS_STATE_ACTIVATED, records[1].data.state);
+    EXPECT_EQ(uid, records[1].data.uid);
+    EXPECT_EQ(3712, records[1].data.pid);
+    EXPECT_EQ("TraceLock", records[1].data.eventDataName);
+    EXPECT_EQ(1000, records[1].bootTimeMs);
+    EXPECT_EQ(1000 + hourMs + hourMs / 2, records[5].upTimeMs);
+    EXPECT_FALSE(records[5].isOnBattery);
+
+    // Every replay runs on a core of its own, the core of the service is left alone
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    BatteryStatsReplayer replayer(statsService->GetBatteryStatsParser()->GetPowerProfile());
+    EXPECT_EQ(nullptr, replayer.GetCore());
+    std::shared_ptr<BatteryStatsCore> lastCore;
+    for (int32_t i = 0; i < 2; i++) {
+        BatteryStatsReplayer::Result result;
+        EXPECT_TRUE(replayer.Replay(path, result));
+        EXPECT_EQ(6u, result.eventCount);
+        EXPECT_EQ(2u, result.powerSupplyCount);
+        EXPECT_EQ(hourMs * 5 / 2, result.traceSpanMs);
+        auto replayCore = replayer.GetCore();
+        ASSERT_NE(nullptr, replayCore);
+        EXPECT_NE(statsCore, replayCore);
+        EXPECT_NE(lastCore, replayCore);
+        lastCore = replayCore;
+        EXPECT_EQ(hourMs, replayCore->GetTotalTimeMs(uid, StatsUtils::STATS_TYPE_AUDIO_ON));
+        EXPECT_EQ(hourMs / 2, replayCore->GetTotalTimeMs(uid, StatsUtils::STATS_TYPE_WAKELOCK_HOLD));
+        EXPECT_EQ(StatsUtils::DEFAULT_VALUE, statsCore->GetTotalTimeMs(uid, StatsUtils::STATS_TYPE_AUDIO_ON));
+        EXPECT_TRUE(StatsHelper::IsOnBattery());
+    }
+    StatsHelper::SetOnBattery(isOnBattery);
+    unlink(path.c_str());
+    STATS_HILOGI(LABEL_TEST, "StatsServiceTraceTest_001 end");
+}
+}
@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_service_traffic_test.h"
+#include "stats_log.h"
+
+#include <fstream>
+#include <unistd.h>
+
+#include "battery_stats_traffic.h"
+#include "stats_helper.h"
+#include "traffic_source.h"
+
+using namespace OHOS;
+using namespace OHOS::PowerMgr;
+using namespace std;
+using namespace testing::ext;
+
+namespace {
+/**
+ * @tc.name: StatsServiceTrafficTest_001
+ * @tc.desc: test BatteryStatsTraffic counts the netstats increments per uid and network while on battery
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceTrafficTest, StatsServiceTrafficTest_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceTrafficTest_001 start");
+    const std::string path = "/data/local/tmp/battery_stats_test_netstats";
+    auto writeNetStats = [&path](const std::string& lines) {
+        std::ofstream output(path, std::ios::trunc);
+        output << "idx iface acct_tag_hex uid_tag_int cnt_set rx_bytes rx_packets tx_bytes tx_packets\n" << lines;
+    };
+    const int32_t uid = 20010027;
+    const int32_t otherUid = 20010028;
+    bool isOnBattery = StatsHelper::IsOnBattery();
+    StatsHelper::SetOnBattery(true);
+    // One uid slot, the uids after the first one only show up in the totals
+    BatteryStatsTraffic traffic(std::make_unique<NetStatsTrafficSource>(path), 1);
+
+    writeNetStats("2 wlan0 0x0 20010027 0 1000 10 500 5\n"
+        "3 wlan0 0x0 20010027 1 200 2 100 1\n"
+        "4 rmnet0 0x0 20010027 0 4000 40 3000 30\n"
+        "5 lo 0x0 20010027 0 9999 99 9999 99\n");
+    EXPECT_TRUE(traffic.Update());
+    EXPECT_EQ(0u, traffic.GetBytes(TrafficSource::NETWORK_WIFI, uid));
+
+    // The tagged line is a part of the untagged ones and lo is not counted
+    writeNetStats("2 wlan0 0x0 20010027 0 3000 30 1500 15\n"
+        "3 wlan0 0x0 20010027 1 200 2 100 1\n"
+        "4 wlan0 0x2a00000000 20010027 0 7777 77 7777 77\n"
+        "5 rmnet0 0x0 20010027 0 5000 50 3500 35\n"
+        "6 lo 0x0 20010027 0 19999 199 19999 199\n");
+    EXPECT_TRUE(traffic.Update());
+    EXPECT_EQ(2000u, traffic.GetBytes(TrafficSource::NETWORK_WIFI, BatteryStatsTraffic::DIRECTION_RX, uid));
+    EXPECT_EQ(1000u, traffic.GetBytes(TrafficSource::NETWORK_WIFI, BatteryStatsTraffic::DIRECTION_TX, uid));
+    EXPECT_EQ(1500u, traffic.GetBytes(TrafficSource::NETWORK_CELLULAR, uid));
+
+    // rmnet0 was recreated and counts from zero again
+    writeNetStats("2 wlan0 0x0 20010027 0 3000 30 1500 15\n"
+        "3 wlan0 0x0 20010027 1 200 2 100 1\n"
+        "5 rmnet0 0x0 20010027 0 100 1 50 1\n"
+        "7 wlan0 0x0 20010028 0 800 8 400 4\n");
+    EXPECT_TRUE(traffic.Update());
+    EXPECT_EQ(1650u, traffic.GetBytes(TrafficSource::NETWORK_CELLULAR, uid));
+    EXPECT_EQ(0u, traffic.GetBytes(TrafficSource::NETWORK_WIFI, otherUid));
+    EXPECT_EQ(4200u, traffic.GetBytes(TrafficSource::NETWORK_WIFI));
+
+    // Nothing is counted on the charger, the bytes are only remembered
+    StatsHelper::SetOnBattery(false);
+    writeNetStats("2 wlan0 0x0 20010027 0 4000 40 2000 20\n");
+    EXPECT_TRUE(traffic.Update());
+    EXPECT_EQ(2000u, traffic.GetBytes(TrafficSource::NETWORK_WIFI, BatteryStatsTraffic::DIRECTION_RX, uid));
+    StatsHelper::SetOnBattery(true);
+    writeNetStats("2 wlan0 0x0 20010027 0 5000 50 2500 25\n");
+    EXPECT_TRUE(traffic.Update());
+    EXPECT_EQ(3000u, traffic.GetBytes(TrafficSource::NETWORK_WIFI, BatteryStatsTraffic::DIRECTION_RX, uid));
+    EXPECT_EQ(1500u, traffic.GetBytes(TrafficSource::NETWORK_WIFI, BatteryStatsTraffic::DIRECTION_TX, uid));
+    const double bytesInMb = 1024.0 * 1024.0;
+    EXPECT_DOUBLE_EQ(3000.0 / bytesInMb * 1.0 + 1500.0 / bytesInMb * 2.0,
+        traffic.GetPowerMah(TrafficSource::NETWORK_WIFI, 1.0, 2.0, uid));
+
+    std::string result;
+    traffic.DumpInfo(result);
+    EXPECT_NE(result.find("source = netstats"), std::string::npos);
+    EXPECT_NE(result.find("overflow = 1"), std::string::npos);
+
+    traffic.Reset(TrafficSource::NETWORK_WIFI);
+    EXPECT_EQ(0u, traffic.GetBytes(TrafficSource::NETWORK_WIFI, uid));
+    EXPECT_EQ(0u, traffic.GetBytes(TrafficSource::NETWORK_WIFI));
+    EXPECT_EQ(1650u, traffic.GetBytes(TrafficSource::NETWORK_CELLULAR, uid));
+
+    TrafficSource::Network network = TrafficSource::NETWORK_BUTT;
+    EXPECT_TRUE(TrafficSource::GetNetwork("wlan1", network));
+    EXPECT_EQ(TrafficSource::NETWORK_WIFI, network);
+    EXPECT_TRUE(TrafficSource::GetNetwork("ccmni0", network));
+    EXPECT_EQ(TrafficSource::NETWORK_CELLULAR, network);
+    EXPECT_FALSE(TrafficSource::GetNetwork("lo", network));
+
+    unlink(path.c_str());
+    EXPECT_FALSE(traffic.Update());
+    StatsHelper::SetOnBattery(isOnBattery);
+    STATS_HILOGI(LABEL_TEST, "StatsServiceTrafficTest_001 end");
+}
+}
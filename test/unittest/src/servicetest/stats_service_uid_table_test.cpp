@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_service_uid_table_test.h"
+#include "stats_log.h"
+
+#include "battery_stats_uid_table.h"
+#include "entities/wakelock_entity.h"
+
+using namespace OHOS;
+using namespace OHOS::PowerMgr;
+using namespace std;
+using namespace testing::ext;
+
+namespace {
+/**
+ * @tc.name: StatsServiceUidTableTest_001
+ * @tc.desc: test BatteryStatsUidTable slots, columns and growth
+ * @tc.type: FUNC
+ * @tc.require: issueI663DX
+ */
+HWTEST_F (StatsServiceUidTableTest, StatsServiceUidTableTest_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceUidTableTest_001 start");
+    BatteryStatsUidTable table;
+    int32_t uid = 10003;
+    double power = 12.5;
+    EXPECT_EQ(BatteryStatsUidTable::INVALID_SLOT, table.FindSlot(uid));
+    EXPECT_EQ(BatteryStatsUidTable::INVALID_SLOT, table.GetOrCreateSlot(StatsUtils::INVALID_VALUE));
+    EXPECT_EQ(nullptr, table.GetOrCreateTimer(StatsUtils::INVALID_VALUE, BatteryStatsUidTable::TIMER_AUDIO_ON));
+    EXPECT_EQ(StatsUtils::DEFAULT_VALUE, table.GetPower(uid, BatteryStatsUidTable::POWER_AUDIO));
+
+    uint32_t slot = table.GetOrCreateSlot(uid);
+    EXPECT_EQ(slot, table.GetOrCreateSlot(uid));
+    EXPECT_EQ(uid, table.GetUid(slot));
+    // A timer column is only allocated once a uid uses it
+    size_t slotMemoryUsage = table.GetMemoryUsage();
+    EXPECT_EQ(StatsUtils::DEFAULT_VALUE, table.GetRunningTimeMs(uid, BatteryStatsUidTable::TIMER_AUDIO_ON));
+    EXPECT_EQ(slotMemoryUsage, table.GetMemoryUsage());
+    auto timer = table.GetOrCreateTimer(uid, BatteryStatsUidTable::TIMER_AUDIO_ON);
+    ASSERT_NE(nullptr, timer);
+    EXPECT_GT(table.GetMemoryUsage(), slotMemoryUsage);
+    EXPECT_EQ(timer, table.GetOrCreateTimer(uid, BatteryStatsUidTable::TIMER_AUDIO_ON));
+    EXPECT_NE(timer, table.GetOrCreateTimer(uid, BatteryStatsUidTable::TIMER_GNSS_ON));
+    auto counter = table.GetOrCreateCounter(uid, BatteryStatsUidTable::COUNTER_ALARM);
+    ASSERT_NE(nullptr, counter);
+    counter->AddCount(1);
+    EXPECT_EQ(1, table.GetCount(uid, BatteryStatsUidTable::COUNTER_ALARM));
+
+    table.SetPower(uid, BatteryStatsUidTable::POWER_AUDIO, power);
+    table.SetData(uid, BatteryStatsUidTable::DATA_CPU_TIME, 1);
+    EXPECT_DOUBLE_EQ(power, table.GetPower(uid, BatteryStatsUidTable::POWER_AUDIO));
+    EXPECT_EQ(1, table.GetData(uid, BatteryStatsUidTable::DATA_CPU_TIME));
+    table.ResetColumn(BatteryStatsUidTable::POWER_AUDIO);
+    table.ResetColumn(BatteryStatsUidTable::COUNTER_ALARM);
+    EXPECT_EQ(StatsUtils::DEFAULT_VALUE, table.GetPower(uid, BatteryStatsUidTable::POWER_AUDIO));
+    EXPECT_EQ(StatsUtils::DEFAULT_VALUE, table.GetCount(uid, BatteryStatsUidTable::COUNTER_ALARM));
+    EXPECT_EQ(1, table.GetData(uid, BatteryStatsUidTable::DATA_CPU_TIME));
+
+    uint32_t uidCount = BatteryStatsUidTable::SLOTS_PER_BLOCK * 3;
+    size_t memoryUsage = table.GetMemoryUsage();
+    for (uint32_t i = 1; i <= uidCount; i++) {
+        table.SetPower(uid + static_cast<int32_t>(i), BatteryStatsUidTable::POWER_APP, i);
+    }
+    EXPECT_EQ(uidCount + 1, table.GetSlotCount());
+    EXPECT_GT(table.GetMemoryUsage(), memoryUsage);
+    EXPECT_EQ(slot, table.FindSlot(uid));
+    EXPECT_EQ(timer, table.GetOrCreateTimer(uid, BatteryStatsUidTable::TIMER_AUDIO_ON));
+    for (uint32_t i = 1; i <= uidCount; i++) {
+        EXPECT_DOUBLE_EQ(i, table.GetPower(uid + static_cast<int32_t>(i), BatteryStatsUidTable::POWER_APP));
+    }
+
+    // An entity only sees the table it was given
+    int64_t timeMs = 1000;
+    auto sharedTable = std::make_shared<BatteryStatsUidTable>();
+    WakelockEntity entity;
+    WakelockEntity otherEntity;
+    BatteryStatsEntity::Context context;
+    context.uidTable = sharedTable;
+    entity.SetContext(context);
+    entity.GetOrCreateTimer(uid, StatsUtils::STATS_TYPE_WAKELOCK_HOLD)->AddRunningTimeMs(timeMs);
+    EXPECT_EQ(timeMs, entity.GetActiveTimeMs(uid, StatsUtils::STATS_TYPE_WAKELOCK_HOLD));
+    EXPECT_EQ(timeMs, sharedTable->GetRunningTimeMs(uid, BatteryStatsUidTable::TIMER_WAKELOCK_HOLD));
+    EXPECT_EQ(StatsUtils::DEFAULT_VALUE, otherEntity.GetActiveTimeMs(uid, StatsUtils::STATS_TYPE_WAKELOCK_HOLD));
+    STATS_HILOGI(LABEL_TEST, "StatsServiceUidTableTest_001 end");
+}
+}
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_service_wakelock_test.h"
+#include "stats_log.h"
+
+#include <chrono>
+#include <thread>
+#include <unistd.h>
+
+#include "battery_stats_core.h"
+#include "battery_stats_name_table.h"
+#include "battery_stats_service.h"
+#include "entities/wakelock_entity.h"
+
+using namespace OHOS;
+using namespace OHOS::PowerMgr;
+using namespace std;
+using namespace testing::ext;
+
+namespace {
+static sptr<BatteryStatsService> g_statsService = nullptr;
+} // namespace
+
+void StatsServiceWakelockTest::SetUpTestCase()
+{
+    g_statsService = BatteryStatsService::GetInstance();
+    g_statsService->OnStart();
+}
+
+void StatsServiceWakelockTest::TearDownTestCase()
+{
+    g_statsService->OnStop();
+}
+
+void StatsServiceWakelockTest::SetUp()
+{
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    statsCore->Reset();
+}
+
+void StatsServiceWakelockTest::TearDown()
+{
+    auto statsService = BatteryStatsService::GetInstance();
+    auto statsCore = statsService->GetBatteryStatsCore();
+    statsCore->Reset();
+}
+
+namespace {
+/**
+ * @tc.name: StatsServiceWakelockTest_001
+ * @tc.desc: test the per lock wakelock timers, the overflow bucket and the top locks
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceWakelockTest, StatsServiceWakelockTest_001, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceWakelockTest_001 start");
+    BatteryStatsNameTable table(2);
+    EXPECT_EQ(1U, table.Intern("name_a"));
+    EXPECT_EQ(2U, table.Intern("name_b"));
+    EXPECT_EQ(BatteryStatsNameTable::OTHER_ID, table.Intern("name_c"));
+    EXPECT_EQ(1U, table.Intern(std::string("name_a")));
+    EXPECT_EQ("name_b", table.GetName(2));
+    EXPECT_EQ(1U, table.GetOverflowCount());
+    // A name "other" is a name like any other, it never reaches the overflow id
+    uint32_t id = BatteryStatsNameTable::OTHER_ID;
+    EXPECT_FALSE(table.Find(BatteryStatsNameTable::OTHER_NAME, id));
+    BatteryStatsNameTable otherTable(1);
+    EXPECT_EQ(1U, otherTable.Intern(BatteryStatsNameTable::OTHER_NAME));
+
+    bool isOnBattery = StatsHelper::IsOnBattery();
+    StatsHelper::SetOnBattery(true);
+    WakelockEntity::Config config;
+    config.maxNames = 3;
+    config.maxLocks = 3;
+    WakelockEntity entity(config);
+    int32_t uidA = 10021;
+    int32_t uidB = 10022;
+    entity.UpdateLockState(uidA, "wl_a", StatsUtils::STATS_STATE_ACTIVATED);
+    entity.UpdateLockState(uidA, "wl_a", StatsUtils::STATS_STATE_ACTIVATED);
+    entity.UpdateLockState(uidA, "wl_b", StatsUtils::STATS_STATE_ACTIVATED);
+    entity.UpdateLockState(uidB, "wl_a", StatsUtils::STATS_STATE_ACTIVATED);
+    // Over the lock cap and over the name cap, both are counted under "other" of the uid
+    entity.UpdateLockState(uidB, "wl_c", StatsUtils::STATS_STATE_ACTIVATED);
+    entity.UpdateLockState(uidB, "wl_d", StatsUtils::STATS_STATE_ACTIVATED);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    entity.UpdateLockState(uidA, "wl_b", StatsUtils::STATS_STATE_DEACTIVATED);
+    entity.UpdateLockState(uidB, "wl_a", StatsUtils::STATS_STATE_DEACTIVATED);
+    entity.UpdateLockState(uidB, "wl_c", StatsUtils::STATS_STATE_DEACTIVATED);
+    entity.UpdateLockState(uidB, "wl_d", StatsUtils::STATS_STATE_DEACTIVATED);
+    // Still held once
+    entity.UpdateLockState(uidA, "wl_a", StatsUtils::STATS_STATE_DEACTIVATED);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    auto topLocks = entity.GetTopLocks(10);
+    ASSERT_EQ(4, static_cast<int32_t>(topLocks.size()));
+    EXPECT_EQ(uidA, topLocks[0].uid);
+    EXPECT_EQ("wl_a", topLocks[0].name);
+    EXPECT_TRUE(topLocks[0].isHeld);
+    EXPECT_GE(topLocks[0].holdTimeMs, 40);
+    EXPECT_FALSE(topLocks[1].isHeld);
+    auto uidLocks = entity.GetTopLocks(10, uidB);
+    ASSERT_EQ(2, static_cast<int32_t>(uidLocks.size()));
+    EXPECT_TRUE(uidLocks[0].name == BatteryStatsNameTable::OTHER_NAME ||
+        uidLocks[1].name == BatteryStatsNameTable::OTHER_NAME);
+    EXPECT_EQ(1, static_cast<int32_t>(entity.GetTopLocks(1, uidB).size()));
+    EXPECT_EQ(0, entity.GetLockTimeMs(uidB, "wl_c"));
+    EXPECT_GE(entity.GetLockTimeMs(uidA, "wl_b"), 20);
+    std::string dump;
+    entity.DumpInfo(dump);
+    EXPECT_NE(std::string::npos, dump.find("wl_a"));
+
+    // Only the lock still held survives the reset, from zero
+    entity.Reset();
+    topLocks = entity.GetTopLocks(10);
+    ASSERT_EQ(1, static_cast<int32_t>(topLocks.size()));
+    EXPECT_EQ("wl_a", topLocks[0].name);
+    EXPECT_TRUE(topLocks[0].isHeld);
+    EXPECT_LT(topLocks[0].holdTimeMs, 20);
+    EXPECT_TRUE(entity.UpdateLockState(uidA, "wl_a", StatsUtils::STATS_STATE_DEACTIVATED));
+    EXPECT_FALSE(entity.GetTopLocks(10)[0].isHeld);
+    EXPECT_FALSE(entity.UpdateLockState(uidA, "wl_a", StatsUtils::STATS_STATE_DEACTIVATED));
+
+    // A lock named "other" keeps its own timer, apart from the overflow timer of the uid
+    config.maxLocks = 1;
+    WakelockEntity otherEntity(config);
+    otherEntity.UpdateLockState(uidA, BatteryStatsNameTable::OTHER_NAME, StatsUtils::STATS_STATE_ACTIVATED);
+    otherEntity.UpdateLockState(uidA, "wl_a", StatsUtils::STATS_STATE_ACTIVATED);
+    otherEntity.UpdateLockState(uidA, BatteryStatsNameTable::OTHER_NAME, StatsUtils::STATS_STATE_DEACTIVATED);
+    auto otherLocks = otherEntity.GetTopLocks(10, uidA);
+    ASSERT_EQ(2, static_cast<int32_t>(otherLocks.size()));
+    EXPECT_NE(otherLocks[0].isHeld, otherLocks[1].isHeld);
+    // The held overflow lock is still released by its own name after a reset
+    otherEntity.Reset();
+    EXPECT_TRUE(otherEntity.UpdateLockState(uidA, "wl_a", StatsUtils::STATS_STATE_DEACTIVATED));
+    StatsHelper::SetOnBattery(isOnBattery);
+    STATS_HILOGI(LABEL_TEST, "StatsServiceWakelockTest_001 end");
+}
+
+/**
+ * @tc.name: StatsServiceWakelockTest_002
+ * @tc.desc: test a reset keeps the wakelocks held with their holds, and the uid time runs while any lock is held
+ * @tc.type: FUNC
+ */
+HWTEST_F (StatsServiceWakelockTest, StatsServiceWakelockTest_002, TestSize.Level0)
+{
+    STATS_HILOGI(LABEL_TEST, "StatsServiceWakelockTest_002 start");
+    auto statsCore = BatteryStatsService::GetInstance()->GetBatteryStatsCore();
+    bool isOnBattery = StatsHelper::IsOnBattery();
+    statsCore->SetOnBattery(true);
+    statsCore->Reset();
+    int32_t uid = 10003;
+    int64_t durationMs = SERVICE_POWER_CONSUMPTION_DURATION_US / 1000;
+    auto getUidTimeMs = [&statsCore, uid]() {
+        return statsCore->GetTotalTimeMs(uid, StatsUtils::STATS_TYPE_WAKELOCK_HOLD);
+    };
+
+    statsCore->UpdateWakelockStats(StatsUtils::STATS_STATE_ACTIVATED, uid, "first");
+    statsCore->UpdateWakelockStats(StatsUtils::STATS_STATE_ACTIVATED, uid, "first");
+    statsCore->UpdateWakelockStats(StatsUtils::STATS_STATE_ACTIVATED, uid, "second");
+    usleep(SERVICE_POWER_CONSUMPTION_DURATION_US);
+    statsCore->Reset();
+    auto locks = statsCore->GetTopWakelocks(2, uid);
+    ASSERT_EQ(locks.size(), 2U);
+    for (const auto& lock : locks) {
+        EXPECT_TRUE(lock.isHeld);
+        EXPECT_LT(lock.holdTimeMs, durationMs);
+    }
+    EXPECT_LT(getUidTimeMs(), durationMs);
+
+    // Two holds of the first lock were taken before the reset, the lock is still held after one release
+    statsCore->UpdateWakelockStats(StatsUtils::STATS_STATE_DEACTIVATED, uid, "first");
+    statsCore->UpdateWakelockStats(StatsUtils::STATS_STATE_DEACTIVATED, uid, "second");
+    usleep(SERVICE_POWER_CONSUMPTION_DURATION_US);
+    int64_t timeMs = getUidTimeMs();
+    EXPECT_GE(timeMs, durationMs);
+    locks = statsCore->GetTopWakelocks(1, uid);
+    ASSERT_EQ(locks.size(), 1U);
+    EXPECT_EQ(locks[0].name, "first");
+    EXPECT_TRUE(locks[0].isHeld);
+
+    statsCore->UpdateWakelockStats(StatsUtils::STATS_STATE_DEACTIVATED, uid, "first");
+    timeMs = getUidTimeMs();
+    usleep(SERVICE_POWER_CONSUMPTION_DURATION_US);
+    EXPECT_EQ(getUidTimeMs(), timeMs);
+    locks = statsCore->GetTopWakelocks(1, uid);
+    ASSERT_EQ(locks.size(), 1U);
+    EXPECT_FALSE(locks[0].isHeld);
+
+    statsCore->SetOnBattery(isOnBattery);
+    statsCore->Reset();
+    STATS_HILOGI(LABEL_TEST, "StatsServiceWakelockTest_002 end");
+}
+}
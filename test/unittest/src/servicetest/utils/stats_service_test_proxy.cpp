@@ -435,5 +435,86 @@ ErrCode StatsServiceTestProxy::ShellDumpIpc(
     dumpShell = Str16ToStr8(reply.ReadString16());
     return ERR_OK;
 }
+
+ErrCode StatsServiceTestProxy::GetAppStatsBatchIpc(
+    const std::vector<int32_t>& uids,
+    const std::vector<int32_t>& statsTypes,
+    std::vector<double>& appStatsMah,
+    std::vector<double>& appStatsPercent,
+    std::vector<int64_t>& totalTimeSecond,
+    int32_t& tempError)
+{
+    STATS_RETURN_IF_WITH_RET(stub_ == nullptr, StatsUtils::DEFAULT_VALUE);
+
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_SYNC);
+
+    if (!data.WriteInterfaceToken(BatteryStatsProxy::GetDescriptor())) {
+        HiLog::Error(LABEL, "Write interface token failed!");
+        return ERR_INVALID_VALUE;
+    }
+
+    if (uids.size() > static_cast<size_t>(VECTOR_MAX_SIZE) ||
+        statsTypes.size() > static_cast<size_t>(VECTOR_MAX_SIZE)) {
+        HiLog::Error(LABEL, "The vector/array size exceeds the security limit!");
+        return ERR_INVALID_DATA;
+    }
+    data.WriteInt32(uids.size());
+    for (auto it1 = uids.begin(); it1 != uids.end(); ++it1) {
+        if (!data.WriteInt32((*it1))) {
+            HiLog::Error(LABEL, "Write [(*it1)] failed!");
+            return ERR_INVALID_DATA;
+        }
+    }
+    data.WriteInt32(statsTypes.size());
+    for (auto it1 = statsTypes.begin(); it1 != statsTypes.end(); ++it1) {
+        if (!data.WriteInt32((*it1))) {
+            HiLog::Error(LABEL, "Write [(*it1)] failed!");
+            return ERR_INVALID_DATA;
+        }
+    }
+
+    int32_t result = stub_->SendRequest(
+        static_cast<uint32_t>(IBatteryStatsIpcCode::COMMAND_GET_APP_STATS_BATCH_IPC), data, reply, option);
+    if (FAILED(result)) {
+        HiLog::Error(LABEL, "Send request failed!");
+        return result;
+    }
+
+    ErrCode errCode = reply.ReadInt32();
+    if (FAILED(errCode)) {
+        HiLog::Error(LABEL, "Read result failed, code is: %{public}d.",
+            static_cast<uint32_t>(IBatteryStatsIpcCode::COMMAND_GET_APP_STATS_BATCH_IPC));
+        return errCode;
+    }
+
+    int32_t appStatsMahSize = reply.ReadInt32();
+    if (appStatsMahSize > static_cast<int32_t>(VECTOR_MAX_SIZE)) {
+        HiLog::Error(LABEL, "The vector/array size exceeds the security limit!");
+        return ERR_INVALID_DATA;
+    }
+    for (int32_t i1 = 0; i1 < appStatsMahSize; ++i1) {
+        appStatsMah.push_back(reply.ReadDouble());
+    }
+    int32_t appStatsPercentSize = reply.ReadInt32();
+    if (appStatsPercentSize > static_cast<int32_t>(VECTOR_MAX_SIZE)) {
+        HiLog::Error(LABEL, "The vector/array size exceeds the security limit!");
+        return ERR_INVALID_DATA;
+    }
+    for (int32_t i1 = 0; i1 < appStatsPercentSize; ++i1) {
+        appStatsPercent.push_back(reply.ReadDouble());
+    }
+    int32_t totalTimeSecondSize = reply.ReadInt32();
+    if (totalTimeSecondSize > static_cast<int32_t>(VECTOR_MAX_SIZE)) {
+        HiLog::Error(LABEL, "The vector/array size exceeds the security limit!");
+        return ERR_INVALID_DATA;
+    }
+    for (int32_t i1 = 0; i1 < totalTimeSecondSize; ++i1) {
+        totalTimeSecond.push_back(reply.ReadInt64());
+    }
+    tempError = reply.ReadInt32();
+    return ERR_OK;
+}
 } // namespace PowerMgr
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STATS_CLOCK_H
+#define STATS_CLOCK_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Where StatsHelper takes the boot and up times from. Both clocks are monotonic, the boot time goes on while the
+ * device is suspended and the up time doesn't.
+ */
+class StatsClock {
+public:
+    virtual ~StatsClock() = default;
+    virtual int64_t GetBootTimeMs() const = 0;
+    virtual int64_t GetUpTimeMs() const = 0;
+};
+
+/**
+ * CLOCK_BOOTTIME and CLOCK_MONOTONIC, the clocks of the device.
+ */
+class SystemStatsClock : public StatsClock {
+public:
+    ~SystemStatsClock() override = default;
+    int64_t GetBootTimeMs() const override;
+    int64_t GetUpTimeMs() const override;
+};
+
+/**
+ * A clock which only moves when told to, for the tests and the trace replay.
+ */
+class FakeStatsClock : public StatsClock {
+public:
+    explicit FakeStatsClock(int64_t bootTimeMs = 0, int64_t upTimeMs = 0);
+    ~FakeStatsClock() override = default;
+    int64_t GetBootTimeMs() const override;
+    int64_t GetUpTimeMs() const override;
+    void SetTimeMs(int64_t bootTimeMs, int64_t upTimeMs);
+    // Both clocks move on, like the device running
+    void AdvanceMs(int64_t durationMs);
+    // Only the boot time moves on, like the device being suspended
+    void SuspendMs(int64_t durationMs);
+private:
+    std::atomic<int64_t> bootTimeMs_;
+    std::atomic<int64_t> upTimeMs_;
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // STATS_CLOCK_H
@@ -16,8 +16,11 @@
 #ifndef STATS_HELPER_H
 #define STATS_HELPER_H
 
+#include <atomic>
 #include <cinttypes>
+#include <memory>
 
+#include "stats_clock.h"
 #include "stats_log.h"
 #include "stats_utils.h"
 
@@ -47,23 +50,26 @@ public:
                 STATS_HILOGD(COMP_SVC, "No related active timer is running");
                 return false;
             }
-            auto stopTimeMs = GetOnBatteryBootTimeMs();
-            totalTimeMs_ += stopTimeMs - startTimeMs_;
+            totalTimeMs_ += GetElapsedTimeMs(GetOnBatteryBootTimeMs());
             isRunning_ = false;
             STATS_HILOGD(COMP_SVC, "Active timer is stopped");
             return true;
         }
 
-        int64_t GetRunningTimeMs()
+        // Reading doesn't move the start on, so a stop at an older time still counts up to that time
+        int64_t GetRunningTimeMs() const
         {
             if (isRunning_) {
-                auto tmpStopTimeMs = GetOnBatteryBootTimeMs();
-                totalTimeMs_ += tmpStopTimeMs - startTimeMs_;
-                startTimeMs_ = tmpStopTimeMs;
+                return totalTimeMs_ + GetElapsedTimeMs(GetOnBatteryBootTimeMs());
             }
             return totalTimeMs_;
         }
 
+        bool IsRunning() const
+        {
+            return isRunning_;
+        }
+
         void AddRunningTimeMs(int64_t avtiveTime)
         {
             if (avtiveTime > StatsUtils::DEFAULT_VALUE) {
@@ -81,6 +87,18 @@ public:
             totalTimeMs_ = StatsUtils::DEFAULT_VALUE;
         }
     private:
+        int64_t GetElapsedTimeMs(int64_t nowMs) const
+        {
+            // An event is applied at the time it was queued, which may be older than a start recorded by a direct
+            // call. The stop is clamped to the start, the skew is logged instead of counted as negative time
+            if (nowMs < startTimeMs_) {
+                STATS_HILOGW(COMP_SVC, "Time is %{public}" PRId64 "ms before the start of the active timer",
+                    startTimeMs_ - nowMs);
+                return StatsUtils::DEFAULT_VALUE;
+            }
+            return nowMs - startTimeMs_;
+        }
+
         bool isRunning_ = false;
         int64_t startTimeMs_ = StatsUtils::DEFAULT_VALUE;
         int64_t totalTimeMs_ = StatsUtils::DEFAULT_VALUE;
@@ -123,14 +141,77 @@ public:
     static bool IsOnBatteryScreenOff();
     static int64_t GetBootTimeMs();
     static int64_t GetUpTimeMs();
+    // Replaces the system clock of the process base, e.g. with a fake clock of a test, nullptr restores it. The
+    // clock isn't owned and has to stay alive as long as it may be read
+    static void SetClock(StatsClock* clock);
+
+    /**
+     * The power supply state and the clock the timers run on. The stats of the device run on the process base.
+     * A core of its own, e.g. the one a trace is replayed into, brings its own base and enters it for every call,
+     * so neither its clock nor its power supply changes reach another core.
+     */
+    class TimeBase {
+    public:
+        // Without a clock the base reads the clock of the process base
+        explicit TimeBase(std::shared_ptr<const StatsClock> clock = nullptr);
+        ~TimeBase() = default;
+        TimeBase(const TimeBase&) = delete;
+        TimeBase& operator=(const TimeBase&) = delete;
+    private:
+        friend class StatsHelper;
+        std::shared_ptr<const StatsClock> clock_;
+        int64_t latestUnplugBootTimeMs_ = StatsUtils::DEFAULT_VALUE;
+        int64_t latestUnplugUpTimeMs_ = StatsUtils::DEFAULT_VALUE;
+        int64_t onBatteryBootTimeMs_ = StatsUtils::DEFAULT_VALUE;
+        int64_t onBatteryUpTimeMs_ = StatsUtils::DEFAULT_VALUE;
+        bool onBattery_ = false;
+        bool screenOff_ = false;
+    };
+
+    /**
+     * Runs the calling thread on a base for its scope, nullptr stays on the current one. A time snapshot taken on
+     * another base doesn't hold inside the scope, the times of two clocks never mix.
+     */
+    class TimeBaseScope {
+    public:
+        explicit TimeBaseScope(TimeBase* base);
+        ~TimeBaseScope();
+        TimeBaseScope(const TimeBaseScope&) = delete;
+        TimeBaseScope& operator=(const TimeBaseScope&) = delete;
+    private:
+        bool isEntered_ = false;
+        TimeBase* outerBase_ = nullptr;
+        uint32_t outerSnapshotDepth_ = 0;
+        int64_t outerSnapshotBootTimeMs_ = StatsUtils::DEFAULT_VALUE;
+        int64_t outerSnapshotUpTimeMs_ = StatsUtils::DEFAULT_VALUE;
+    };
+
+    /**
+     * Freezes the time of the calling thread for its scope. The timers read in it share one now, so a computation
+     * sees them all at the same instant and the clock is read once. A nested snapshot keeps the outer time.
+     */
+    class TimeSnapshot {
+    public:
+        TimeSnapshot();
+        // Pins the given time instead, e.g. the time an event was queued at, also inside another snapshot
+        TimeSnapshot(int64_t bootTimeMs, int64_t upTimeMs);
+        ~TimeSnapshot();
+        TimeSnapshot(const TimeSnapshot&) = delete;
+        TimeSnapshot& operator=(const TimeSnapshot&) = delete;
+    private:
+        int64_t outerBootTimeMs_;
+        int64_t outerUpTimeMs_;
+    };
 private:
-    static int64_t latestUnplugBootTimeMs_;
-    static int64_t latestUnplugUpTimeMs_;
-    static int64_t onBatteryBootTimeMs_;
-    static int64_t onBatteryUpTimeMs_;
-    static bool onBattery_;
-    static bool screenOff_;
+    static std::atomic<StatsClock*> clock_;
+    static TimeBase processBase_;
+    static thread_local TimeBase* currentBase_;
+    static thread_local uint32_t snapshotDepth_;
+    static thread_local int64_t snapshotBootTimeMs_;
+    static thread_local int64_t snapshotUpTimeMs_;
+    static TimeBase& GetTimeBase();
+    static const StatsClock& GetClock();
 };
 } // namespace PowerMgr
 } // namespace OHOS
-#endif // STATS_HELPER_H
\ No newline at end of file
+#endif // STATS_HELPER_H
\ No newline at end of file
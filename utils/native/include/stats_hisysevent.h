@@ -17,6 +17,7 @@
 #define STATS_HISYSEVENT_H
 
 #include <string>
+#include <string_view>
 
 namespace OHOS {
 namespace PowerMgr {
@@ -140,6 +141,7 @@ public:
     };
 
     static bool CheckHiSysEvent(const std::string& eventName);
+    static HiSysEventType GetHiSysEventType(std::string_view eventName);
 };
 } // namespace PowerMgr
 } // namespace OHOS
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STATS_JSON_VIEW_H
+#define STATS_JSON_VIEW_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace OHOS {
+namespace PowerMgr {
+/**
+ * Read-only view over the top-level members of a flat JSON object, such as a HiSysEvent record.
+ * The document is scanned once in place: keys and values are kept as views into the caller's buffer,
+ * escaped strings are decoded in place, nested objects and arrays are validated and skipped.
+ * No heap memory is allocated, the buffer must outlive the view.
+ */
+class StatsJsonView {
+public:
+    static constexpr size_t MAX_FIELD_COUNT = 128;
+
+    explicit StatsJsonView(std::string& json);
+    ~StatsJsonView() = default;
+    StatsJsonView(const StatsJsonView&) = delete;
+    StatsJsonView& operator=(const StatsJsonView&) = delete;
+    bool IsValid() const;
+    size_t GetFieldCount() const;
+    bool GetInt(std::string_view key, int32_t& value) const;
+    bool GetDouble(std::string_view key, double& value) const;
+    bool GetString(std::string_view key, std::string_view& value) const;
+private:
+    enum class ValueType : uint8_t {
+        NUMBER = 0,
+        STRING,
+        OTHER
+    };
+    struct Field {
+        std::string_view key;
+        std::string_view value;
+        ValueType type = ValueType::OTHER;
+    };
+    std::array<Field, MAX_FIELD_COUNT> fields_;
+    size_t fieldCount_ = 0;
+    bool valid_ = false;
+    char* pos_ = nullptr;
+    char* end_ = nullptr;
+    bool Parse();
+    bool ParseString(std::string_view& value);
+    bool ParseNumber(std::string_view& value);
+    bool SkipValue(uint32_t depth);
+    bool SkipLiteral(std::string_view literal);
+    void SkipWhitespace();
+    const Field* FindField(std::string_view key) const;
+};
+} // namespace PowerMgr
+} // namespace OHOS
+#endif // STATS_JSON_VIEW_H
@@ -57,6 +57,10 @@ public:
     static constexpr const char* CURRENT_CPU_ACTIVE = "cpu_active";
     static constexpr const char* CURRENT_CPU_SUSPEND = "cpu_suspend";
     static constexpr const char* CURRENT_ALARM_ON = "alarm_on";
+    static constexpr const char* CURRENT_WIFI_RX = "wifi_rx";
+    static constexpr const char* CURRENT_WIFI_TX = "wifi_tx";
+    static constexpr const char* CURRENT_RADIO_RX = "radio_rx";
+    static constexpr const char* CURRENT_RADIO_TX = "radio_tx";
 
     enum StatsType {
         STATS_TYPE_INVALID = -1,
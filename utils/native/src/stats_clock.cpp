@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_clock.h"
+
+#include <cinttypes>
+#include <ctime>
+
+#include "stats_log.h"
+#include "stats_utils.h"
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+int64_t GetClockTimeMs(clockid_t clockId)
+{
+    struct timespec rawTime;
+    if (clock_gettime(clockId, &rawTime) != 0) {
+        STATS_HILOGE(COMP_SVC, "Get time of clock %{public}d failed, return default time", clockId);
+        return StatsUtils::DEFAULT_VALUE;
+    }
+    return static_cast<int64_t>(rawTime.tv_sec * StatsUtils::MS_IN_SECOND + rawTime.tv_nsec / StatsUtils::NS_IN_MS);
+}
+} // namespace
+
+int64_t SystemStatsClock::GetBootTimeMs() const
+{
+    return GetClockTimeMs(CLOCK_BOOTTIME);
+}
+
+int64_t SystemStatsClock::GetUpTimeMs() const
+{
+    return GetClockTimeMs(CLOCK_MONOTONIC);
+}
+
+FakeStatsClock::FakeStatsClock(int64_t bootTimeMs, int64_t upTimeMs) : bootTimeMs_(bootTimeMs), upTimeMs_(upTimeMs)
+{
+}
+
+int64_t FakeStatsClock::GetBootTimeMs() const
+{
+    return bootTimeMs_.load(std::memory_order_relaxed);
+}
+
+int64_t FakeStatsClock::GetUpTimeMs() const
+{
+    return upTimeMs_.load(std::memory_order_relaxed);
+}
+
+void FakeStatsClock::SetTimeMs(int64_t bootTimeMs, int64_t upTimeMs)
+{
+    bootTimeMs_.store(bootTimeMs, std::memory_order_relaxed);
+    upTimeMs_.store(upTimeMs, std::memory_order_relaxed);
+}
+
+void FakeStatsClock::AdvanceMs(int64_t durationMs)
+{
+    bootTimeMs_.fetch_add(durationMs, std::memory_order_relaxed);
+    upTimeMs_.fetch_add(durationMs, std::memory_order_relaxed);
+}
+
+void FakeStatsClock::SuspendMs(int64_t durationMs)
+{
+    bootTimeMs_.fetch_add(durationMs, std::memory_order_relaxed);
+}
+} // namespace PowerMgr
+} // namespace OHOS
@@ -14,62 +14,122 @@
  */
 #include "stats_helper.h"
 
-#include <ctime>
-
 #include "battery_stats_info.h"
 
 namespace OHOS {
 namespace PowerMgr {
-int64_t StatsHelper::latestUnplugBootTimeMs_ = StatsUtils::DEFAULT_VALUE;
-int64_t StatsHelper::latestUnplugUpTimeMs_ = StatsUtils::DEFAULT_VALUE;
-int64_t StatsHelper::onBatteryBootTimeMs_ = StatsUtils::DEFAULT_VALUE;
-int64_t StatsHelper::onBatteryUpTimeMs_ = StatsUtils::DEFAULT_VALUE;
-bool StatsHelper::onBattery_ = false;
-bool StatsHelper::screenOff_ = false;
+std::atomic<StatsClock*> StatsHelper::clock_ {nullptr};
+StatsHelper::TimeBase StatsHelper::processBase_;
+thread_local StatsHelper::TimeBase* StatsHelper::currentBase_ = nullptr;
+thread_local uint32_t StatsHelper::snapshotDepth_ = 0;
+thread_local int64_t StatsHelper::snapshotBootTimeMs_ = StatsUtils::DEFAULT_VALUE;
+thread_local int64_t StatsHelper::snapshotUpTimeMs_ = StatsUtils::DEFAULT_VALUE;
+
+void StatsHelper::SetClock(StatsClock* clock)
+{
+    clock_.store(clock);
+    STATS_HILOGI(COMP_SVC, "Stats clock is %{public}s", clock != nullptr ? "replaced" : "restored");
+}
+
+const StatsClock& StatsHelper::GetClock()
+{
+    static const SystemStatsClock systemClock;
+    const TimeBase& base = GetTimeBase();
+    if (base.clock_ != nullptr) {
+        return *base.clock_;
+    }
+    const StatsClock* clock = clock_.load(std::memory_order_acquire);
+    return clock != nullptr ? *clock : systemClock;
+}
+
+StatsHelper::TimeBase& StatsHelper::GetTimeBase()
+{
+    return currentBase_ != nullptr ? *currentBase_ : processBase_;
+}
+
+StatsHelper::TimeBase::TimeBase(std::shared_ptr<const StatsClock> clock) : clock_(std::move(clock)) {}
+
+StatsHelper::TimeBaseScope::TimeBaseScope(TimeBase* base)
+{
+    if (base == nullptr || base == &GetTimeBase()) {
+        return;
+    }
+    isEntered_ = true;
+    outerBase_ = currentBase_;
+    outerSnapshotDepth_ = snapshotDepth_;
+    outerSnapshotBootTimeMs_ = snapshotBootTimeMs_;
+    outerSnapshotUpTimeMs_ = snapshotUpTimeMs_;
+    currentBase_ = base;
+    snapshotDepth_ = 0;
+}
+
+StatsHelper::TimeBaseScope::~TimeBaseScope()
+{
+    if (!isEntered_) {
+        return;
+    }
+    currentBase_ = outerBase_;
+    snapshotDepth_ = outerSnapshotDepth_;
+    snapshotBootTimeMs_ = outerSnapshotBootTimeMs_;
+    snapshotUpTimeMs_ = outerSnapshotUpTimeMs_;
+}
 
 int64_t StatsHelper::GetBootTimeMs()
 {
-    int64_t bootTimeMs = StatsUtils::DEFAULT_VALUE;
-    struct timespec rawBootTime;
-    int errCode = clock_gettime(CLOCK_BOOTTIME, &rawBootTime);
-    if (errCode != 0) {
-        STATS_HILOGE(COMP_SVC, "Get boot time failed, return default time");
-    } else {
-        bootTimeMs = static_cast<int64_t>(rawBootTime.tv_sec * StatsUtils::MS_IN_SECOND +
-            rawBootTime.tv_nsec / StatsUtils::NS_IN_MS);
-        STATS_HILOGD(COMP_SVC, "Get boot time: %{public}" PRId64 "", bootTimeMs);
+    if (snapshotDepth_ > 0) {
+        return snapshotBootTimeMs_;
     }
-    return bootTimeMs;
+    return GetClock().GetBootTimeMs();
 }
 
 int64_t StatsHelper::GetUpTimeMs()
 {
-    int64_t upTimeMs = StatsUtils::DEFAULT_VALUE;
-    struct timespec rawUpTime;
-    int errCode = clock_gettime(CLOCK_MONOTONIC, &rawUpTime);
-    if (errCode != 0) {
-        STATS_HILOGE(COMP_SVC, "Get up time failed, return default time");
-    } else {
-        upTimeMs = static_cast<int64_t>(rawUpTime.tv_sec * StatsUtils::MS_IN_SECOND +
-            rawUpTime.tv_nsec / StatsUtils::NS_IN_MS);
-        STATS_HILOGD(COMP_SVC, "Get up time: %{public}" PRId64 "", upTimeMs);
+    if (snapshotDepth_ > 0) {
+        return snapshotUpTimeMs_;
     }
-    return upTimeMs;
+    return GetClock().GetUpTimeMs();
+}
+
+StatsHelper::TimeSnapshot::TimeSnapshot()
+    : outerBootTimeMs_(snapshotBootTimeMs_), outerUpTimeMs_(snapshotUpTimeMs_)
+{
+    if (snapshotDepth_ == 0) {
+        const StatsClock& clock = GetClock();
+        snapshotBootTimeMs_ = clock.GetBootTimeMs();
+        snapshotUpTimeMs_ = clock.GetUpTimeMs();
+    }
+    snapshotDepth_++;
+}
+
+StatsHelper::TimeSnapshot::TimeSnapshot(int64_t bootTimeMs, int64_t upTimeMs)
+    : outerBootTimeMs_(snapshotBootTimeMs_), outerUpTimeMs_(snapshotUpTimeMs_)
+{
+    snapshotBootTimeMs_ = bootTimeMs;
+    snapshotUpTimeMs_ = upTimeMs;
+    snapshotDepth_++;
+}
+
+StatsHelper::TimeSnapshot::~TimeSnapshot()
+{
+    snapshotDepth_--;
+    snapshotBootTimeMs_ = outerBootTimeMs_;
+    snapshotUpTimeMs_ = outerUpTimeMs_;
 }
 
 void StatsHelper::SetOnBattery(bool onBattery)
 {
-    if (onBattery_ != onBattery) {
-        onBattery_ = onBattery;
+    TimeBase& base = GetTimeBase();
+    if (base.onBattery_ != onBattery) {
+        base.onBattery_ = onBattery;
         // when onBattery is ture, status is unplugin.
         int64_t currentBootTimeMs = GetBootTimeMs();
         int64_t currentUpTimeMs = GetUpTimeMs();
         if (onBattery) {
-            latestUnplugBootTimeMs_ = currentBootTimeMs;
-            latestUnplugUpTimeMs_ = currentUpTimeMs;
+            base.latestUnplugBootTimeMs_ = currentBootTimeMs;
+            base.latestUnplugUpTimeMs_ = currentUpTimeMs;
         } else {
-            onBatteryBootTimeMs_ += currentBootTimeMs - latestUnplugBootTimeMs_;
-            onBatteryUpTimeMs_ += currentUpTimeMs - latestUnplugUpTimeMs_;
+            base.onBatteryBootTimeMs_ += currentBootTimeMs - base.latestUnplugBootTimeMs_;
+            base.onBatteryUpTimeMs_ += currentUpTimeMs - base.latestUnplugUpTimeMs_;
         }
         STATS_HILOGI(COMP_SVC, "Update battery state:  %{public}d", onBattery);
     }
@@ -77,41 +137,45 @@ void StatsHelper::SetOnBattery(bool onBattery)
 
 void StatsHelper::SetScreenOff(bool screenOff)
 {
-    if (screenOff_ != screenOff) {
-        screenOff_ = screenOff;
+    TimeBase& base = GetTimeBase();
+    if (base.screenOff_ != screenOff) {
+        base.screenOff_ = screenOff;
         STATS_HILOGD(COMP_SVC, "Update screen off state: %{public}d", screenOff);
     }
 }
 
 bool StatsHelper::IsOnBattery()
 {
-    return onBattery_;
+    return GetTimeBase().onBattery_;
 }
 
 bool StatsHelper::IsOnBatteryScreenOff()
 {
-    return onBattery_ && screenOff_;
+    const TimeBase& base = GetTimeBase();
+    return base.onBattery_ && base.screenOff_;
 }
 
 int64_t StatsHelper::GetOnBatteryBootTimeMs()
 {
-    int64_t onBatteryBootTimeMs = onBatteryBootTimeMs_;
+    const TimeBase& base = GetTimeBase();
+    int64_t onBatteryBootTimeMs = base.onBatteryBootTimeMs_;
     int64_t currentBootTimeMs = GetBootTimeMs();
-    if (IsOnBattery()) {
-        onBatteryBootTimeMs += currentBootTimeMs - latestUnplugBootTimeMs_;
+    if (base.onBattery_) {
+        onBatteryBootTimeMs += currentBootTimeMs - base.latestUnplugBootTimeMs_;
     }
     STATS_HILOGD(COMP_SVC, "Get on battery boot time: %{public}" PRId64 ", currentBootTimeMs: %{public}" PRId64 "," \
         "latestUnplugBootTimeMs_: %{public}" PRId64 "",
-        onBatteryBootTimeMs, currentBootTimeMs, latestUnplugBootTimeMs_);
+        onBatteryBootTimeMs, currentBootTimeMs, base.latestUnplugBootTimeMs_);
     return onBatteryBootTimeMs;
 }
 
 int64_t StatsHelper::GetOnBatteryUpTimeMs()
 {
-    int64_t onBatteryUpTimeMs = onBatteryUpTimeMs_;
+    const TimeBase& base = GetTimeBase();
+    int64_t onBatteryUpTimeMs = base.onBatteryUpTimeMs_;
     int64_t currentUpTimeMs = GetUpTimeMs();
-    if (IsOnBattery()) {
-        onBatteryUpTimeMs += currentUpTimeMs - latestUnplugUpTimeMs_;
+    if (base.onBattery_) {
+        onBatteryUpTimeMs += currentUpTimeMs - base.latestUnplugUpTimeMs_;
     }
     STATS_HILOGD(COMP_SVC, "Get on battery up time: %{public}" PRId64 "", onBatteryUpTimeMs);
     return onBatteryUpTimeMs;
@@ -15,19 +15,64 @@
 
 #include "stats_hisysevent.h"
 
+#include <algorithm>
+#include <array>
+
 namespace OHOS {
 namespace PowerMgr {
 namespace {
-const uint32_t COMPARE_SUCCESS = 0;
+struct HiSysEventName {
+    std::string_view name;
+    StatsHiSysEvent::HiSysEventType type = StatsHiSysEvent::HISYSEVENT_TYPE_INVALID;
+};
+using HiSysEventNameTable = std::array<HiSysEventName, StatsHiSysEvent::HISYSEVENT_TYPE_END>;
+
+constexpr HiSysEventNameTable BuildSortedHiSysEventNames()
+{
+    HiSysEventNameTable table {};
+    for (size_t i = 0; i < table.size(); i++) {
+        table[i].name = StatsHiSysEvent::HISYSEVENT_LIST[i];
+        table[i].type = static_cast<StatsHiSysEvent::HiSysEventType>(i);
+    }
+    // std::sort is not constexpr in C++17, the table is small enough for an insertion sort
+    for (size_t i = 1; i < table.size(); i++) {
+        HiSysEventName current = table[i];
+        size_t j = i;
+        for (; j > 0 && current.name < table[j - 1].name; j--) {
+            table[j] = table[j - 1];
+        }
+        table[j] = current;
+    }
+    return table;
 }
-bool StatsHiSysEvent::CheckHiSysEvent(const std::string& eventName)
+
+constexpr bool HasUniqueHiSysEventNames(const HiSysEventNameTable& table)
 {
-    for (int32_t i = 0; i < HISYSEVENT_TYPE_END; i++) {
-        if (eventName.compare(HISYSEVENT_LIST[i]) == COMPARE_SUCCESS) {
-            return true;
+    for (size_t i = 0; i < table.size(); i++) {
+        if (table[i].name.empty() || (i > 0 && table[i].name == table[i - 1].name)) {
+            return false;
         }
     }
-    return false;
+    return true;
+}
+
+constexpr HiSysEventNameTable SORTED_HISYSEVENT_NAMES = BuildSortedHiSysEventNames();
+static_assert(HasUniqueHiSysEventNames(SORTED_HISYSEVENT_NAMES), "HISYSEVENT_LIST must not contain duplicate names");
+}
+
+bool StatsHiSysEvent::CheckHiSysEvent(const std::string& eventName)
+{
+    return GetHiSysEventType(eventName) != HISYSEVENT_TYPE_INVALID;
+}
+
+StatsHiSysEvent::HiSysEventType StatsHiSysEvent::GetHiSysEventType(std::string_view eventName)
+{
+    auto iter = std::lower_bound(SORTED_HISYSEVENT_NAMES.begin(), SORTED_HISYSEVENT_NAMES.end(), eventName,
+        [](const HiSysEventName& entry, std::string_view name) { return entry.name < name; });
+    if (iter == SORTED_HISYSEVENT_NAMES.end() || iter->name != eventName) {
+        return HISYSEVENT_TYPE_INVALID;
+    }
+    return iter->type;
 }
 } // namespace PowerMgr
 } // namespace OHOS
\ No newline at end of file
@@ -0,0 +1,464 @@
+/*
+ * Copyright (c) 2026 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "stats_json_view.h"
+
+#include <climits>
+#include <cstdlib>
+
+namespace OHOS {
+namespace PowerMgr {
+namespace {
+constexpr uint32_t MAX_NESTING_DEPTH = 128;
+constexpr size_t MAX_FAST_INT_DIGITS = 18;
+constexpr size_t UNICODE_ESCAPE_LENGTH = 4;
+constexpr uint32_t HEX_RADIX = 16;
+constexpr uint32_t DECIMAL_RADIX = 10;
+constexpr uint32_t HIGH_SURROGATE_BEGIN = 0xD800;
+constexpr uint32_t LOW_SURROGATE_BEGIN = 0xDC00;
+constexpr uint32_t LOW_SURROGATE_END = 0xDFFF;
+constexpr uint32_t SURROGATE_OFFSET = 0x10000;
+constexpr uint32_t SURROGATE_SHIFT = 10;
+constexpr uint32_t UTF8_ONE_BYTE_MAX = 0x7F;
+constexpr uint32_t UTF8_TWO_BYTE_MAX = 0x7FF;
+constexpr uint32_t UTF8_THREE_BYTE_MAX = 0xFFFF;
+
+inline bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+inline bool IsWhitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+int32_t HexValue(char c)
+{
+    if (IsDigit(c)) {
+        return c - '0';
+    }
+    if (c >= 'a' && c <= 'f') {
+        return c - 'a' + DECIMAL_RADIX;
+    }
+    if (c >= 'A' && c <= 'F') {
+        return c - 'A' + DECIMAL_RADIX;
+    }
+    return -1;
+}
+
+bool ParseHex4(const char* begin, const char* end, uint32_t& codePoint)
+{
+    if (end - begin < static_cast<ptrdiff_t>(UNICODE_ESCAPE_LENGTH)) {
+        return false;
+    }
+    codePoint = 0;
+    for (size_t i = 0; i < UNICODE_ESCAPE_LENGTH; i++) {
+        int32_t digit = HexValue(begin[i]);
+        if (digit < 0) {
+            return false;
+        }
+        codePoint = codePoint * HEX_RADIX + static_cast<uint32_t>(digit);
+    }
+    return true;
+}
+
+char* EncodeUtf8(uint32_t codePoint, char* out)
+{
+    if (codePoint <= UTF8_ONE_BYTE_MAX) {
+        *out++ = static_cast<char>(codePoint);
+    } else if (codePoint <= UTF8_TWO_BYTE_MAX) {
+        *out++ = static_cast<char>(0xC0 | (codePoint >> 6));
+        *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else if (codePoint <= UTF8_THREE_BYTE_MAX) {
+        *out++ = static_cast<char>(0xE0 | (codePoint >> 12));
+        *out++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+    } else {
+        *out++ = static_cast<char>(0xF0 | (codePoint >> 18));
+        *out++ = static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+        *out++ = static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+        *out++ = static_cast<char>(0x80 | (codePoint & 0x3F));
+    }
+    return out;
+}
+}
+
+StatsJsonView::StatsJsonView(std::string& json)
+{
+    pos_ = json.data();
+    end_ = json.data() + json.size();
+    valid_ = Parse();
+    pos_ = nullptr;
+    end_ = nullptr;
+    if (!valid_) {
+        fieldCount_ = 0;
+    }
+}
+
+bool StatsJsonView::IsValid() const
+{
+    return valid_;
+}
+
+size_t StatsJsonView::GetFieldCount() const
+{
+    return fieldCount_;
+}
+
+bool StatsJsonView::GetInt(std::string_view key, int32_t& value) const
+{
+    const Field* field = FindField(key);
+    if (field == nullptr || field->type != ValueType::NUMBER) {
+        return false;
+    }
+    // Fast path for plain integers, which are what HiSysEvent records carry in practice
+    std::string_view token = field->value;
+    bool negative = token.front() == '-';
+    size_t begin = negative ? 1 : 0;
+    if (token.size() - begin <= MAX_FAST_INT_DIGITS) {
+        int64_t result = 0;
+        size_t i = begin;
+        for (; i < token.size() && IsDigit(token[i]); i++) {
+            result = result * DECIMAL_RADIX + (token[i] - '0');
+        }
+        if (i == token.size()) {
+            result = negative ? -result : result;
+            if (result > INT_MAX) {
+                value = INT_MAX;
+            } else if (result < INT_MIN) {
+                value = INT_MIN;
+            } else {
+                value = static_cast<int32_t>(result);
+            }
+            return true;
+        }
+    }
+    // Fractions and exponents saturate the same way cJSON computes valueint
+    double number = std::strtod(token.data(), nullptr);
+    if (number >= INT_MAX) {
+        value = INT_MAX;
+    } else if (number <= static_cast<double>(INT_MIN)) {
+        value = INT_MIN;
+    } else {
+        value = static_cast<int32_t>(number);
+    }
+    return true;
+}
+
+bool StatsJsonView::GetDouble(std::string_view key, double& value) const
+{
+    const Field* field = FindField(key);
+    if (field == nullptr || field->type != ValueType::NUMBER) {
+        return false;
+    }
+    // The token is always followed by a delimiter or the terminating null character of the buffer
+    value = std::strtod(field->value.data(), nullptr);
+    return true;
+}
+
+bool StatsJsonView::GetString(std::string_view key, std::string_view& value) const
+{
+    const Field* field = FindField(key);
+    if (field == nullptr || field->type != ValueType::STRING || field->value.empty()) {
+        return false;
+    }
+    value = field->value;
+    return true;
+}
+
+const StatsJsonView::Field* StatsJsonView::FindField(std::string_view key) const
+{
+    // Duplicate keys resolve to the first member, like cJSON_GetObjectItemCaseSensitive
+    for (size_t i = 0; i < fieldCount_; i++) {
+        if (fields_[i].key == key) {
+            return &fields_[i];
+        }
+    }
+    return nullptr;
+}
+
+bool StatsJsonView::Parse()
+{
+    SkipWhitespace();
+    if (pos_ == end_ || *pos_ != '{') {
+        return false;
+    }
+    pos_++;
+    SkipWhitespace();
+    if (pos_ != end_ && *pos_ == '}') {
+        pos_++;
+        SkipWhitespace();
+        return pos_ == end_;
+    }
+    while (true) {
+        Field field {};
+        if (pos_ == end_ || *pos_ != '"' || !ParseString(field.key)) {
+            return false;
+        }
+        SkipWhitespace();
+        if (pos_ == end_ || *pos_ != ':') {
+            return false;
+        }
+        pos_++;
+        SkipWhitespace();
+        if (pos_ == end_) {
+            return false;
+        }
+        if (*pos_ == '"') {
+            if (!ParseString(field.value)) {
+                return false;
+            }
+            field.type = ValueType::STRING;
+        } else if (*pos_ == '-' || IsDigit(*pos_)) {
+            if (!ParseNumber(field.value)) {
+                return false;
+            }
+            field.type = ValueType::NUMBER;
+        } else if (!SkipValue(1)) {
+            return false;
+        }
+        // Members beyond the capacity are validated but not indexed
+        if (fieldCount_ < MAX_FIELD_COUNT) {
+            fields_[fieldCount_++] = field;
+        }
+        SkipWhitespace();
+        if (pos_ == end_) {
+            return false;
+        }
+        if (*pos_ == '}') {
+            pos_++;
+            break;
+        }
+        if (*pos_ != ',') {
+            return false;
+        }
+        pos_++;
+        SkipWhitespace();
+    }
+    SkipWhitespace();
+    return pos_ == end_;
+}
+
+bool StatsJsonView::ParseString(std::string_view& value)
+{
+    // pos_ points to the opening quote, scan with a local cursor since char stores may alias pos_
+    char* begin = pos_ + 1;
+    char* cursor = begin;
+    while (cursor != end_ && *cursor != '"' && *cursor != '\\') {
+        cursor++;
+    }
+    pos_ = cursor;
+    if (pos_ == end_) {
+        return false;
+    }
+    if (*pos_ == '"') {
+        value = std::string_view(begin, pos_ - begin);
+        pos_++;
+        return true;
+    }
+    // Decode the escape sequences in place, the decoded text is never longer than the source
+    char* out = pos_;
+    while (pos_ != end_ && *pos_ != '"') {
+        if (*pos_ != '\\') {
+            *out++ = *pos_++;
+            continue;
+        }
+        if (++pos_ == end_) {
+            return false;
+        }
+        switch (*pos_++) {
+            case '"':
+                *out++ = '"';
+                break;
+            case '\\':
+                *out++ = '\\';
+                break;
+            case '/':
+                *out++ = '/';
+                break;
+            case 'b':
+                *out++ = '\b';
+                break;
+            case 'f':
+                *out++ = '\f';
+                break;
+            case 'n':
+                *out++ = '\n';
+                break;
+            case 'r':
+                *out++ = '\r';
+                break;
+            case 't':
+                *out++ = '\t';
+                break;
+            case 'u': {
+                uint32_t codePoint = 0;
+                if (!ParseHex4(pos_, end_, codePoint)) {
+                    return false;
+                }
+                pos_ += UNICODE_ESCAPE_LENGTH;
+                if (codePoint >= LOW_SURROGATE_BEGIN && codePoint <= LOW_SURROGATE_END) {
+                    return false;
+                }
+                if (codePoint >= HIGH_SURROGATE_BEGIN && codePoint < LOW_SURROGATE_BEGIN) {
+                    uint32_t lowSurrogate = 0;
+                    if (end_ - pos_ < 2 || pos_[0] != '\\' || pos_[1] != 'u' ||
+                        !ParseHex4(pos_ + 2, end_, lowSurrogate) ||
+                        lowSurrogate < LOW_SURROGATE_BEGIN || lowSurrogate > LOW_SURROGATE_END) {
+                        return false;
+                    }
+                    pos_ += 2 + UNICODE_ESCAPE_LENGTH;
+                    codePoint = SURROGATE_OFFSET + ((codePoint - HIGH_SURROGATE_BEGIN) << SURROGATE_SHIFT) +
+                        (lowSurrogate - LOW_SURROGATE_BEGIN);
+                }
+                out = EncodeUtf8(codePoint, out);
+                break;
+            }
+            default:
+                return false;
+        }
+    }
+    if (pos_ == end_) {
+        return false;
+    }
+    value = std::string_view(begin, out - begin);
+    pos_++;
+    return true;
+}
+
+bool StatsJsonView::ParseNumber(std::string_view& value)
+{
+    char* begin = pos_;
+    char* cursor = pos_;
+    if (*cursor == '-') {
+        cursor++;
+    }
+    if (cursor == end_ || !IsDigit(*cursor)) {
+        return false;
+    }
+    if (*cursor == '0') {
+        cursor++;
+    } else {
+        while (cursor != end_ && IsDigit(*cursor)) {
+            cursor++;
+        }
+    }
+    if (cursor != end_ && *cursor == '.') {
+        cursor++;
+        if (cursor == end_ || !IsDigit(*cursor)) {
+            return false;
+        }
+        while (cursor != end_ && IsDigit(*cursor)) {
+            cursor++;
+        }
+    }
+    if (cursor != end_ && (*cursor == 'e' || *cursor == 'E')) {
+        cursor++;
+        if (cursor != end_ && (*cursor == '+' || *cursor == '-')) {
+            cursor++;
+        }
+        if (cursor == end_ || !IsDigit(*cursor)) {
+            return false;
+        }
+        while (cursor != end_ && IsDigit(*cursor)) {
+            cursor++;
+        }
+    }
+    pos_ = cursor;
+    value = std::string_view(begin, cursor - begin);
+    return true;
+}
+
+bool StatsJsonView::SkipValue(uint32_t depth)
+{
+    if (pos_ == end_ || depth > MAX_NESTING_DEPTH) {
+        return false;
+    }
+    std::string_view unused;
+    switch (*pos_) {
+        case '"':
+            return ParseString(unused);
+        case 't':
+            return SkipLiteral("true");
+        case 'f':
+            return SkipLiteral("false");
+        case 'n':
+            return SkipLiteral("null");
+        case '{':
+        case '[': {
+            char close = (*pos_ == '{') ? '}' : ']';
+            bool isObject = (close == '}');
+            pos_++;
+            SkipWhitespace();
+            if (pos_ != end_ && *pos_ == close) {
+                pos_++;
+                return true;
+            }
+            while (true) {
+                if (isObject) {
+                    if (pos_ == end_ || *pos_ != '"' || !ParseString(unused)) {
+                        return false;
+                    }
+                    SkipWhitespace();
+                    if (pos_ == end_ || *pos_ != ':') {
+                        return false;
+                    }
+                    pos_++;
+                    SkipWhitespace();
+                }
+                if (!SkipValue(depth + 1)) {
+                    return false;
+                }
+                SkipWhitespace();
+                if (pos_ == end_) {
+                    return false;
+                }
+                if (*pos_ == close) {
+                    pos_++;
+                    return true;
+                }
+                if (*pos_ != ',') {
+                    return false;
+                }
+                pos_++;
+                SkipWhitespace();
+            }
+        }
+        default:
+            return ParseNumber(unused);
+    }
+}
+
+bool StatsJsonView::SkipLiteral(std::string_view literal)
+{
+    if (static_cast<size_t>(end_ - pos_) < literal.size() ||
+        std::string_view(pos_, literal.size()) != literal) {
+        return false;
+    }
+    pos_ += literal.size();
+    return true;
+}
+
+void StatsJsonView::SkipWhitespace()
+{
+    char* cursor = pos_;
+    while (cursor != end_ && IsWhitespace(*cursor)) {
+        cursor++;
+    }
+    pos_ = cursor;
+}
+} // namespace PowerMgr
+} // namespace OHOS